@@ -328,3 +328,37 @@ bool DebuggerMarshalls::VisualProfilerFrame::deserialize(const Array &p_arr) {
 	CHECK_END(p_arr, idx, "VisualProfilerFrame");
 	return true;
 }
+
+Array DebuggerMarshalls::MemoryProfilerFrame::serialize() {
+	Array arr;
+	arr.push_back(frame_number);
+	arr.push_back(categories.size() * 5);
+	for (int i = 0; i < categories.size(); i++) {
+		arr.push_back(categories[i].name);
+		arr.push_back(categories[i].live_bytes);
+		arr.push_back(categories[i].live_allocations);
+		arr.push_back(categories[i].allocated_bytes_per_second);
+		arr.push_back(categories[i].allocations_per_second);
+	}
+	return arr;
+}
+
+bool DebuggerMarshalls::MemoryProfilerFrame::deserialize(const Array &p_arr) {
+	CHECK_SIZE(p_arr, 2, "MemoryProfilerFrame");
+	frame_number = p_arr[0];
+	int size = p_arr[1];
+	CHECK_SIZE(p_arr, size + 2, "MemoryProfilerFrame");
+	int idx = 2;
+	categories.resize(size / 5);
+	MemoryCategoryInfo *w = categories.ptrw();
+	for (int i = 0; i < size / 5; i++) {
+		w[i].name = p_arr[idx];
+		w[i].live_bytes = p_arr[idx + 1];
+		w[i].live_allocations = p_arr[idx + 2];
+		w[i].allocated_bytes_per_second = p_arr[idx + 3];
+		w[i].allocations_per_second = p_arr[idx + 4];
+		idx += 5;
+	}
+	CHECK_END(p_arr, idx, "MemoryProfilerFrame");
+	return true;
+}
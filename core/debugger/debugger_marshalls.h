@@ -154,6 +154,23 @@ struct DebuggerMarshalls {
 		Array serialize();
 		bool deserialize(const Array &p_arr);
 	};
+
+	// Memory Profiler
+	struct MemoryCategoryInfo {
+		String name;
+		uint64_t live_bytes = 0;
+		uint64_t live_allocations = 0;
+		uint64_t allocated_bytes_per_second = 0;
+		uint64_t allocations_per_second = 0;
+	};
+
+	struct MemoryProfilerFrame {
+		uint64_t frame_number = 0;
+		Vector<MemoryCategoryInfo> categories;
+
+		Array serialize();
+		bool deserialize(const Array &p_arr);
+	};
 };
 
 #endif // DEBUGGER_MARSHARLLS_H
@@ -36,7 +36,9 @@
 #include "core/debugger/script_debugger.h"
 #include "core/input/input.h"
 #include "core/object/script_language.h"
+#include "core/os/memory_tracker.h"
 #include "core/os/os.h"
+#include "core/templates/local_vector.h"
 #include "scene/main/node.h"
 #include "servers/display_server.h"
 
@@ -421,6 +423,75 @@ struct RemoteDebugger::PerformanceProfiler {
 	}
 };
 
+// Only registered in builds with memory tracking.
+struct RemoteDebugger::MemoryProfiler {
+	struct CategoryTotals {
+		uint64_t allocated_bytes = 0;
+		uint64_t allocation_count = 0;
+	};
+
+	LocalVector<CategoryTotals> last_totals;
+	uint64_t last_snapshot_time = 0;
+	uint64_t interval_usec = 1000000;
+
+	void toggle(bool p_enable, const Array &p_opts) {
+		if (!p_enable) {
+			return;
+		}
+		// The first option is the interval between snapshots, in seconds.
+		if (p_opts.size() > 0) {
+			interval_usec = MAX(0.1, double(p_opts[0])) * 1000000;
+		}
+		_update_totals(OS::get_singleton()->get_ticks_usec(), nullptr);
+	}
+
+	void add(const Array &p_data) {}
+
+	void tick(float p_frame_time, float p_idle_time, float p_physics_time, float p_physics_frame_time) {
+		uint64_t time = OS::get_singleton()->get_ticks_usec();
+		if (time - last_snapshot_time < interval_usec) {
+			return;
+		}
+
+		DebuggerMarshalls::MemoryProfilerFrame frame;
+		frame.frame_number = Engine::get_singleton()->get_process_frames();
+		_update_totals(time, &frame);
+		EngineDebugger::get_singleton()->send_message("memory:profile_frame", frame.serialize());
+	}
+
+	void _update_totals(uint64_t p_time, DebuggerMarshalls::MemoryProfilerFrame *r_frame) {
+		double elapsed = double(p_time - last_snapshot_time) / 1000000.0;
+		last_snapshot_time = p_time;
+
+		int count = MemoryTracker::get_category_count();
+		// Categories registered since the last snapshot have no previous totals,
+		// so they report no rate until the next one.
+		int known_count = last_totals.size();
+		last_totals.resize(count);
+		for (int i = 0; i < count; i++) {
+			CategoryTotals totals;
+			totals.allocated_bytes = MemoryTracker::get_category_allocated_bytes(i);
+			totals.allocation_count = MemoryTracker::get_category_allocation_count(i);
+
+			if (r_frame) {
+				DebuggerMarshalls::MemoryCategoryInfo info;
+				info.name = MemoryTracker::get_category_name(i);
+				info.live_bytes = MemoryTracker::get_category_live_bytes(i);
+				info.live_allocations = MemoryTracker::get_category_live_allocations(i);
+				if (elapsed > 0 && i < known_count) {
+					info.allocated_bytes_per_second = (totals.allocated_bytes - last_totals[i].allocated_bytes) / elapsed;
+					info.allocations_per_second = (totals.allocation_count - last_totals[i].allocation_count) / elapsed;
+				}
+				if (info.live_bytes || info.allocated_bytes_per_second) {
+					r_frame->categories.push_back(info);
+				}
+			}
+
+			last_totals[i] = totals;
+		}
+	}
+};
+
 void RemoteDebugger::_send_resource_usage() {
 	DebuggerMarshalls::ResourceUsage usage;
 
@@ -945,6 +1016,12 @@ RemoteDebugger::RemoteDebugger(Ref<RemoteDebuggerPeer> p_peer) {
 		profiler_enable("performance", true);
 	}
 
+	// Memory Profiler (per-category heap usage)
+	if (MemoryTracker::is_enabled()) {
+		memory_profiler = memnew(MemoryProfiler);
+		_bind_profiler("memory", memory_profiler);
+	}
+
 	// Core and profiler captures.
 	Capture core_cap(this,
 			[](void *p_user, const String &p_cmd, const Array &p_data, bool &r_captured) {
@@ -977,10 +1054,16 @@ RemoteDebugger::~RemoteDebugger() {
 	if (EngineDebugger::has_profiler("performance")) {
 		EngineDebugger::get_singleton()->unregister_profiler("performance");
 	}
+	if (EngineDebugger::has_profiler("memory")) {
+		EngineDebugger::get_singleton()->unregister_profiler("memory");
+	}
 	memdelete(servers_profiler);
 	memdelete(network_profiler);
 	memdelete(visual_profiler);
 	if (performance_profiler) {
 		memdelete(performance_profiler);
 	}
+	if (memory_profiler) {
+		memdelete(memory_profiler);
+	}
 }
@@ -54,11 +54,13 @@ private:
 	struct ScriptsProfiler;
 	struct VisualProfiler;
 	struct PerformanceProfiler;
+	struct MemoryProfiler;
 
 	NetworkProfiler *network_profiler = nullptr;
 	ServersProfiler *servers_profiler = nullptr;
 	VisualProfiler *visual_profiler = nullptr;
 	PerformanceProfiler *performance_profiler = nullptr;
+	MemoryProfiler *memory_profiler = nullptr;
 
 	Ref<RemoteDebuggerPeer> peer;
 
@@ -1157,236 +1157,323 @@ bool Expression::_compile_expression() {
 	return false;
 }
 
-bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression::ENode *p_node, Variant &r_ret, String &r_error_str) {
-	switch (p_node->type) {
-		case Expression::ENode::TYPE_INPUT: {
-			const Expression::InputNode *in = static_cast<const Expression::InputNode *>(p_node);
-			if (in->index < 0 || in->index >= p_inputs.size()) {
-				r_error_str = vformat(RTR("Invalid input %i (not passed) in expression"), in->index);
-				return true;
-			}
-			r_ret = p_inputs[in->index];
-		} break;
-		case Expression::ENode::TYPE_CONSTANT: {
-			const Expression::ConstantNode *c = static_cast<const Expression::ConstantNode *>(p_node);
-			r_ret = c->value;
+Expression::Operand Expression::_add_constant(const Variant &p_value) {
+	Operand operand;
+	operand.mode = Operand::MODE_CONSTANT;
+	operand.index = constants.size();
+	constants.push_back(p_value);
+	return operand;
+}
 
-		} break;
-		case Expression::ENode::TYPE_SELF: {
-			if (!p_instance) {
-				r_error_str = RTR("self can't be used because instance is null (not passed)");
-				return true;
-			}
-			r_ret = p_instance;
-		} break;
-		case Expression::ENode::TYPE_OPERATOR: {
-			const Expression::OperatorNode *op = static_cast<const Expression::OperatorNode *>(p_node);
+Expression::Operand Expression::_add_instruction(const Instruction &p_instruction, const Vector<Operand> &p_operands) {
+	Instruction instruction = p_instruction;
+	instruction.first_operand = operands.size();
+	instruction.operand_count = p_operands.size();
+	operands.append_array(p_operands);
+	max_operands = MAX(max_operands, p_operands.size());
+
+	// Each instruction has its own register.
+	Operand operand;
+	operand.mode = Operand::MODE_REGISTER;
+	operand.index = program.size();
+	program.push_back(instruction);
+	return operand;
+}
 
-			Variant a;
-			bool ret = _execute(p_inputs, p_instance, op->nodes[0], a, r_error_str);
-			if (ret) {
-				return true;
-			}
+bool Expression::_are_constants(const Vector<Operand> &p_operands) {
+	for (int i = 0; i < p_operands.size(); i++) {
+		if (p_operands[i].mode != Operand::MODE_CONSTANT) {
+			return false;
+		}
+	}
+	return true;
+}
 
-			Variant b;
+Expression::Operand Expression::_compile(ENode *p_node) {
+	Instruction instruction;
+	instruction.type = p_node->type;
+	Vector<Operand> args;
 
+	switch (p_node->type) {
+		case ENode::TYPE_INPUT: {
+			Operand operand;
+			operand.mode = Operand::MODE_INPUT;
+			operand.index = static_cast<const InputNode *>(p_node)->index;
+			return operand;
+		}
+		case ENode::TYPE_CONSTANT: {
+			return _add_constant(static_cast<const ConstantNode *>(p_node)->value);
+		}
+		case ENode::TYPE_SELF: {
+			Operand operand;
+			operand.mode = Operand::MODE_SELF;
+			return operand;
+		}
+		case ENode::TYPE_OPERATOR: {
+			const OperatorNode *op = static_cast<const OperatorNode *>(p_node);
+			instruction.op = op->op;
+			args.push_back(_compile(op->nodes[0]));
 			if (op->nodes[1]) {
-				ret = _execute(p_inputs, p_instance, op->nodes[1], b, r_error_str);
-				if (ret) {
-					return true;
-				}
+				args.push_back(_compile(op->nodes[1]));
 			}
 
-			bool valid = true;
-			Variant::evaluate(op->op, a, b, r_ret, valid);
-			if (!valid) {
-				r_error_str = vformat(RTR("Invalid operands to operator %s, %s and %s."), Variant::get_operator_name(op->op), Variant::get_type_name(a.get_type()), Variant::get_type_name(b.get_type()));
-				return true;
+			if (_are_constants(args)) {
+				Variant value;
+				bool valid = true;
+				Variant::evaluate(op->op, constants[args[0].index], args.size() > 1 ? constants[args[1].index] : Variant(), value, valid);
+				if (valid && value.get_type() < Variant::OBJECT) {
+					return _add_constant(value);
+				}
 			}
-
 		} break;
-		case Expression::ENode::TYPE_INDEX: {
-			const Expression::IndexNode *index = static_cast<const Expression::IndexNode *>(p_node);
-
-			Variant base;
-			bool ret = _execute(p_inputs, p_instance, index->base, base, r_error_str);
-			if (ret) {
-				return true;
-			}
-
-			Variant idx;
-
-			ret = _execute(p_inputs, p_instance, index->index, idx, r_error_str);
-			if (ret) {
-				return true;
+		case ENode::TYPE_INDEX: {
+			const IndexNode *index = static_cast<const IndexNode *>(p_node);
+			args.push_back(_compile(index->base));
+			args.push_back(_compile(index->index));
+
+			if (_are_constants(args) && constants[args[0].index].get_type() < Variant::OBJECT) {
+				bool valid;
+				Variant value = constants[args[0].index].get(constants[args[1].index], &valid);
+				if (valid) {
+					return _add_constant(value);
+				}
 			}
-
-			bool valid;
-			r_ret = base.get(idx, &valid);
-			if (!valid) {
-				r_error_str = vformat(RTR("Invalid index of type %s for base type %s"), Variant::get_type_name(idx.get_type()), Variant::get_type_name(base.get_type()));
-				return true;
+		} break;
+		case ENode::TYPE_NAMED_INDEX: {
+			const NamedIndexNode *index = static_cast<const NamedIndexNode *>(p_node);
+			instruction.name = index->name;
+			args.push_back(_compile(index->base));
+
+			if (_are_constants(args) && constants[args[0].index].get_type() < Variant::OBJECT) {
+				bool valid;
+				Variant value = constants[args[0].index].get_named(index->name, valid);
+				if (valid) {
+					return _add_constant(value);
+				}
 			}
-
 		} break;
-		case Expression::ENode::TYPE_NAMED_INDEX: {
-			const Expression::NamedIndexNode *index = static_cast<const Expression::NamedIndexNode *>(p_node);
-
-			Variant base;
-			bool ret = _execute(p_inputs, p_instance, index->base, base, r_error_str);
-			if (ret) {
-				return true;
+		case ENode::TYPE_ARRAY: {
+			// Never folded, every execution returns a new array.
+			const ArrayNode *array = static_cast<const ArrayNode *>(p_node);
+			for (int i = 0; i < array->array.size(); i++) {
+				args.push_back(_compile(array->array[i]));
 			}
-
-			bool valid;
-			r_ret = base.get_named(index->name, valid);
-			if (!valid) {
-				r_error_str = vformat(RTR("Invalid named index '%s' for base type %s"), String(index->name), Variant::get_type_name(base.get_type()));
-				return true;
+		} break;
+		case ENode::TYPE_DICTIONARY: {
+			const DictionaryNode *dictionary = static_cast<const DictionaryNode *>(p_node);
+			for (int i = 0; i < dictionary->dict.size(); i++) {
+				args.push_back(_compile(dictionary->dict[i]));
 			}
-
 		} break;
-		case Expression::ENode::TYPE_ARRAY: {
-			const Expression::ArrayNode *array = static_cast<const Expression::ArrayNode *>(p_node);
+		case ENode::TYPE_CONSTRUCTOR: {
+			const ConstructorNode *constructor = static_cast<const ConstructorNode *>(p_node);
+			instruction.data_type = constructor->data_type;
+			for (int i = 0; i < constructor->arguments.size(); i++) {
+				args.push_back(_compile(constructor->arguments[i]));
+			}
 
-			Array arr;
-			arr.resize(array->array.size());
-			for (int i = 0; i < array->array.size(); i++) {
+			if (_are_constants(args) && constructor->data_type < Variant::OBJECT) {
+				Vector<const Variant *> argp;
+				for (int i = 0; i < args.size(); i++) {
+					argp.push_back(&constants[args[i].index]);
+				}
 				Variant value;
-				bool ret = _execute(p_inputs, p_instance, array->array[i], value, r_error_str);
-
-				if (ret) {
-					return true;
+				Callable::CallError ce;
+				Variant::construct(constructor->data_type, value, (const Variant **)argp.ptr(), argp.size(), ce);
+				if (ce.error == Callable::CallError::CALL_OK) {
+					return _add_constant(value);
 				}
-				arr[i] = value;
 			}
-
-			r_ret = arr;
-
 		} break;
-		case Expression::ENode::TYPE_DICTIONARY: {
-			const Expression::DictionaryNode *dictionary = static_cast<const Expression::DictionaryNode *>(p_node);
-
-			Dictionary d;
-			for (int i = 0; i < dictionary->dict.size(); i += 2) {
-				Variant key;
-				bool ret = _execute(p_inputs, p_instance, dictionary->dict[i + 0], key, r_error_str);
+		case ENode::TYPE_BUILTIN_FUNC: {
+			// Not folded, some utility functions have side effects or are random.
+			const BuiltinFuncNode *bifunc = static_cast<const BuiltinFuncNode *>(p_node);
+			instruction.name = bifunc->func;
+			for (int i = 0; i < bifunc->arguments.size(); i++) {
+				args.push_back(_compile(bifunc->arguments[i]));
+			}
+		} break;
+		case ENode::TYPE_CALL: {
+			const CallNode *call = static_cast<const CallNode *>(p_node);
+			instruction.name = call->method;
+			args.push_back(_compile(call->base));
+			for (int i = 0; i < call->arguments.size(); i++) {
+				args.push_back(_compile(call->arguments[i]));
+			}
 
-				if (ret) {
-					return true;
+			if (_are_constants(args) && constants[args[0].index].get_type() < Variant::OBJECT) {
+				Vector<const Variant *> argp;
+				for (int i = 1; i < args.size(); i++) {
+					argp.push_back(&constants[args[i].index]);
 				}
-
+				Variant base = constants[args[0].index];
 				Variant value;
-				ret = _execute(p_inputs, p_instance, dictionary->dict[i + 1], value, r_error_str);
-				if (ret) {
-					return true;
+				Callable::CallError ce;
+				base.call(call->method, (const Variant **)argp.ptr(), argp.size(), value, ce);
+				if (ce.error == Callable::CallError::CALL_OK && value.get_type() < Variant::OBJECT) {
+					return _add_constant(value);
 				}
-
-				d[key] = value;
 			}
-
-			r_ret = d;
 		} break;
-		case Expression::ENode::TYPE_CONSTRUCTOR: {
-			const Expression::ConstructorNode *constructor = static_cast<const Expression::ConstructorNode *>(p_node);
+	}
 
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
-			arr.resize(constructor->arguments.size());
-			argp.resize(constructor->arguments.size());
+	return _add_instruction(instruction, args);
+}
 
-			for (int i = 0; i < constructor->arguments.size(); i++) {
-				Variant value;
-				bool ret = _execute(p_inputs, p_instance, constructor->arguments[i], value, r_error_str);
+void Expression::_clear_program() {
+	constants.clear();
+	operands.clear();
+	program.clear();
+	registers.clear();
+	result = Operand();
+	max_operands = 0;
+}
 
-				if (ret) {
-					return true;
-				}
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
+_FORCE_INLINE_ const Variant *Expression::_get_operand(const Operand &p_operand, const Array &p_inputs, const Variant *p_self, const Variant *p_registers, String &r_error_str) const {
+	switch (p_operand.mode) {
+		case Operand::MODE_CONSTANT: {
+			return &constants[p_operand.index];
+		}
+		case Operand::MODE_REGISTER: {
+			return &p_registers[p_operand.index];
+		}
+		case Operand::MODE_INPUT: {
+			if (p_operand.index < 0 || p_operand.index >= p_inputs.size()) {
+				r_error_str = vformat(RTR("Invalid input %i (not passed) in expression"), p_operand.index);
+				return nullptr;
 			}
+			return &p_inputs[p_operand.index];
+		}
+		case Operand::MODE_SELF: {
+			if (!p_self) {
+				r_error_str = RTR("self can't be used because instance is null (not passed)");
+			}
+			return p_self;
+		}
+	}
+	return nullptr;
+}
 
-			Callable::CallError ce;
-			Variant::construct(constructor->data_type, r_ret, (const Variant **)argp.ptr(), argp.size(), ce);
-
-			if (ce.error != Callable::CallError::CALL_OK) {
-				r_error_str = vformat(RTR("Invalid arguments to construct '%s'"), Variant::get_type_name(constructor->data_type));
+bool Expression::_execute(const Array &p_inputs, Object *p_instance, Variant *p_registers, Variant &r_ret, String &r_error_str) {
+	Variant self;
+	if (p_instance) {
+		self = p_instance;
+	}
+	const Variant *self_ptr = p_instance ? &self : nullptr;
+	const Variant **args = (const Variant **)alloca(sizeof(const Variant *) * MAX(max_operands, 1));
+
+	for (int i = 0; i < program.size(); i++) {
+		const Instruction &instruction = program[i];
+		for (int j = 0; j < instruction.operand_count; j++) {
+			args[j] = _get_operand(operands[instruction.first_operand + j], p_inputs, self_ptr, p_registers, r_error_str);
+			if (!args[j]) {
 				return true;
 			}
+		}
 
-		} break;
-		case Expression::ENode::TYPE_BUILTIN_FUNC: {
-			const Expression::BuiltinFuncNode *bifunc = static_cast<const Expression::BuiltinFuncNode *>(p_node);
-
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
-			arr.resize(bifunc->arguments.size());
-			argp.resize(bifunc->arguments.size());
+		Variant &dst = p_registers[i];
 
-			for (int i = 0; i < bifunc->arguments.size(); i++) {
-				Variant value;
-				bool ret = _execute(p_inputs, p_instance, bifunc->arguments[i], value, r_error_str);
-				if (ret) {
+		switch (instruction.type) {
+			case ENode::TYPE_OPERATOR: {
+				const Variant nil;
+				const Variant &b = instruction.operand_count > 1 ? *args[1] : nil;
+				bool valid = true;
+				Variant::evaluate(instruction.op, *args[0], b, dst, valid);
+				if (!valid) {
+					r_error_str = vformat(RTR("Invalid operands to operator %s, %s and %s."), Variant::get_operator_name(instruction.op), Variant::get_type_name(args[0]->get_type()), Variant::get_type_name(b.get_type()));
 					return true;
 				}
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
-			}
-
-			r_ret = Variant(); //may not return anything
-			Callable::CallError ce;
-			Variant::call_utility_function(bifunc->func, &r_ret, (const Variant **)argp.ptr(), argp.size(), ce);
-			if (ce.error != Callable::CallError::CALL_OK) {
-				r_error_str = "Builtin Call Failed. " + Variant::get_call_error_text(bifunc->func, (const Variant **)argp.ptr(), argp.size(), ce);
-				return true;
-			}
-
-		} break;
-		case Expression::ENode::TYPE_CALL: {
-			const Expression::CallNode *call = static_cast<const Expression::CallNode *>(p_node);
-
-			Variant base;
-			bool ret = _execute(p_inputs, p_instance, call->base, base, r_error_str);
-
-			if (ret) {
-				return true;
-			}
-
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
-			arr.resize(call->arguments.size());
-			argp.resize(call->arguments.size());
-
-			for (int i = 0; i < call->arguments.size(); i++) {
-				Variant value;
-				ret = _execute(p_inputs, p_instance, call->arguments[i], value, r_error_str);
-
-				if (ret) {
+			} break;
+			case ENode::TYPE_INDEX: {
+				bool valid;
+				dst = args[0]->get(*args[1], &valid);
+				if (!valid) {
+					r_error_str = vformat(RTR("Invalid index of type %s for base type %s"), Variant::get_type_name(args[1]->get_type()), Variant::get_type_name(args[0]->get_type()));
 					return true;
 				}
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
-			}
-
-			Callable::CallError ce;
-			base.call(call->method, (const Variant **)argp.ptr(), argp.size(), r_ret, ce);
+			} break;
+			case ENode::TYPE_NAMED_INDEX: {
+				bool valid;
+				dst = args[0]->get_named(instruction.name, valid);
+				if (!valid) {
+					r_error_str = vformat(RTR("Invalid named index '%s' for base type %s"), String(instruction.name), Variant::get_type_name(args[0]->get_type()));
+					return true;
+				}
+			} break;
+			case ENode::TYPE_ARRAY: {
+				Array arr;
+				arr.resize(instruction.operand_count);
+				for (int j = 0; j < instruction.operand_count; j++) {
+					arr[j] = *args[j];
+				}
+				dst = arr;
+			} break;
+			case ENode::TYPE_DICTIONARY: {
+				Dictionary d;
+				for (int j = 0; j < instruction.operand_count; j += 2) {
+					d[*args[j + 0]] = *args[j + 1];
+				}
+				dst = d;
+			} break;
+			case ENode::TYPE_CONSTRUCTOR: {
+				Callable::CallError ce;
+				Variant::construct(instruction.data_type, dst, args, instruction.operand_count, ce);
+				if (ce.error != Callable::CallError::CALL_OK) {
+					r_error_str = vformat(RTR("Invalid arguments to construct '%s'"), Variant::get_type_name(instruction.data_type));
+					return true;
+				}
+			} break;
+			case ENode::TYPE_BUILTIN_FUNC: {
+				dst = Variant(); //may not return anything
+				Callable::CallError ce;
+				Variant::call_utility_function(instruction.name, &dst, args, instruction.operand_count, ce);
+				if (ce.error != Callable::CallError::CALL_OK) {
+					r_error_str = "Builtin Call Failed. " + Variant::get_call_error_text(instruction.name, args, instruction.operand_count, ce);
+					return true;
+				}
+			} break;
+			case ENode::TYPE_CALL: {
+				// Methods may modify their base, only registers can be called on in place.
+				const Operand &base_operand = operands[instruction.first_operand];
+				Variant base_copy;
+				Variant *base;
+				if (base_operand.mode == Operand::MODE_REGISTER) {
+					base = &p_registers[base_operand.index];
+				} else {
+					base_copy = *args[0];
+					base = &base_copy;
+				}
 
-			if (ce.error != Callable::CallError::CALL_OK) {
-				r_error_str = vformat(RTR("On call to '%s':"), String(call->method));
-				return true;
+				Callable::CallError ce;
+				base->call(instruction.name, args + 1, instruction.operand_count - 1, dst, ce);
+				if (ce.error != Callable::CallError::CALL_OK) {
+					r_error_str = vformat(RTR("On call to '%s':"), String(instruction.name));
+					return true;
+				}
+			} break;
+			default: {
+				ERR_FAIL_V_MSG(true, "Invalid expression instruction.");
 			}
+		}
+	}
 
-		} break;
+	const Variant *ret = _get_operand(result, p_inputs, self_ptr, p_registers, r_error_str);
+	if (!ret) {
+		return true;
 	}
+	r_ret = *ret;
 	return false;
 }
 
 Error Expression::parse(const String &p_expression, const Vector<String> &p_input_names) {
+	ERR_FAIL_COND_V_MSG(registers_in_use.load(std::memory_order_acquire), ERR_BUSY, "Can't parse an expression while it's being executed.");
+
 	if (nodes) {
 		memdelete(nodes);
 		nodes = nullptr;
 		root = nullptr;
 	}
+	_clear_program();
 
 	error_str = String();
 	error_set = false;
@@ -1405,18 +1492,47 @@ Error Expression::parse(const String &p_expression, const Vector<String> &p_inpu
 		return ERR_INVALID_PARAMETER;
 	}
 
+	result = _compile(root);
+	registers.resize(program.size());
+
+	// The tree is no longer needed once compiled.
+	memdelete(nodes);
+	nodes = nullptr;
+	root = nullptr;
+
 	return OK;
 }
 
 Variant Expression::execute(Array p_inputs, Object *p_base, bool p_show_error) {
 	ERR_FAIL_COND_V_MSG(error_set, Variant(), "There was previously a parse error: " + error_str + ".");
 
-	execution_error = false;
+	// The registers belong to one execution at a time. Executions nested in a method called by the
+	// expression, or running at the same time on other threads, use registers of their own.
+	LocalVector<Variant> own_registers;
+	Variant *regs = registers.ptr();
+	bool shared = !registers_in_use.exchange(true, std::memory_order_acquire);
+	if (!shared) {
+		own_registers.resize(registers.size());
+		regs = own_registers.ptr();
+	}
+
 	Variant output;
 	String error_txt;
-	bool err = _execute(p_inputs, p_base, root, output, error_txt);
+	bool err = _execute(p_inputs, p_base, regs, output, error_txt);
+
+	if (shared) {
+		// Keep values that are cheap to hold on to, so they are reused by the next execution.
+		// Don't keep objects and containers alive past the call.
+		for (uint32_t i = 0; i < registers.size(); i++) {
+			if (registers[i].get_type() >= Variant::OBJECT) {
+				registers[i] = Variant();
+			}
+		}
+		registers_in_use.store(false, std::memory_order_release);
+	}
+
+	execution_error = err;
 	if (err) {
-		execution_error = true;
 		error_str = error_txt;
 		ERR_FAIL_COND_V_MSG(p_show_error, Variant(), error_str);
 	}
@@ -32,6 +32,9 @@
 #define EXPRESSION_H
 
 #include "core/object/reference.h"
+#include "core/templates/local_vector.h"
+
+#include <atomic>
 
 class Expression : public Reference {
 	GDCLASS(Expression, Reference);
@@ -255,8 +258,48 @@ private:
 
 	Vector<String> input_names;
 
+	// The parsed tree is compiled to a flat program. Each instruction writes to its
+	// own register, and subtrees made only of constants are folded at parse time.
+	// Registers are kept between calls to execute(), so evaluating an expression
+	// again doesn't allocate.
+	struct Operand {
+		enum Mode {
+			MODE_CONSTANT,
+			MODE_REGISTER,
+			MODE_INPUT,
+			MODE_SELF,
+		};
+
+		Mode mode = MODE_CONSTANT;
+		int index = 0;
+	};
+
+	struct Instruction {
+		ENode::Type type = ENode::TYPE_OPERATOR;
+		Variant::Operator op = Variant::OP_ADD;
+		Variant::Type data_type = Variant::NIL;
+		StringName name;
+		int first_operand = 0;
+		int operand_count = 0;
+	};
+
+	Vector<Variant> constants;
+	Vector<Operand> operands;
+	Vector<Instruction> program;
+	Operand result;
+	int max_operands = 0;
+	LocalVector<Variant> registers;
+	std::atomic<bool> registers_in_use = { false }; // Claimed by the execution using registers.
+
+	static bool _are_constants(const Vector<Operand> &p_operands);
+	Operand _add_constant(const Variant &p_value);
+	Operand _add_instruction(const Instruction &p_instruction, const Vector<Operand> &p_operands);
+	Operand _compile(ENode *p_node);
+	void _clear_program();
+	_FORCE_INLINE_ const Variant *_get_operand(const Operand &p_operand, const Array &p_inputs, const Variant *p_self, const Variant *p_registers, String &r_error_str) const;
+
 	bool execution_error = false;
-	bool _execute(const Array &p_inputs, Object *p_instance, Expression::ENode *p_node, Variant &r_ret, String &r_error_str);
+	bool _execute(const Array &p_inputs, Object *p_instance, Variant *p_registers, Variant &r_ret, String &r_error_str);
 
 protected:
 	static void _bind_methods();
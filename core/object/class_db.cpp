@@ -32,6 +32,7 @@
 
 #include "core/config/engine.h"
 #include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
 #include "core/version.h"
 
 #define OBJTYPE_RLOCK RWLockRead _rw_lockr_(lock);
@@ -242,6 +243,228 @@ HashMap<StringName, ClassDB::ClassInfo> ClassDB::classes;
 HashMap<StringName, StringName> ClassDB::resource_base_extensions;
 HashMap<StringName, StringName> ClassDB::compat_classes;
 
+// Each table is a minimal perfect hash: names are split into small buckets by
+// their hash, and every bucket gets a displacement that sends its names to free
+// slots. A lookup is then a single probe, no matter how deep the class is.
+struct ClassDB::LookupTable {
+	enum Kind {
+		KIND_NONE,
+		KIND_PROPERTY,
+		KIND_CONSTANT,
+		KIND_METHOD,
+		KIND_SIGNAL,
+	};
+
+	struct Entry {
+		StringName name;
+		MethodBind *method = nullptr; // Closest method with this name.
+		const PropertySetGet *property = nullptr; // Closest property with this name.
+		Kind kind = KIND_NONE; // What get_property() finds first when walking up the classes.
+		int constant = 0;
+	};
+
+	LocalVector<Entry> entries;
+	LocalVector<uint32_t> displacements;
+	uint32_t seed = 0;
+
+	static _FORCE_INLINE_ uint32_t mix(uint32_t p_hash, uint32_t p_seed) {
+		uint32_t h = p_hash ^ p_seed;
+		h ^= h >> 16;
+		h *= 0x85ebca6b;
+		h ^= h >> 13;
+		h *= 0xc2b2ae35;
+		h ^= h >> 16;
+		return h;
+	}
+
+	_FORCE_INLINE_ const Entry *find(const StringName &p_name) const {
+		const uint32_t hash = p_name.hash();
+		const uint32_t displacement = displacements[hash & (displacements.size() - 1)];
+		const Entry &entry = entries[(mix(hash, seed) ^ displacement) & (entries.size() - 1)];
+		return (entry.name == p_name && p_name != StringName()) ? &entry : nullptr;
+	}
+};
+
+// Tables dropped because a class changed after they were built. Lookups don't
+// take the lock, so they are only freed on cleanup.
+static LocalVector<ClassDB::LookupTable *> retired_lookup_tables;
+
+// Seeds tried before giving up on a table (slots double every 16 of them).
+#define LOOKUP_TABLE_MAX_ATTEMPTS 64
+
+ClassDB::LookupTable *ClassDB::_build_lookup_table(const ClassInfo *p_class) {
+	// Flatten the class and its ancestors, closest class first.
+	HashMap<StringName, LookupTable::Entry> flat;
+	for (const ClassInfo *check = p_class; check; check = check->inherits_ptr) {
+		const StringName *k = nullptr;
+		while ((k = check->property_setget.next(k))) {
+			LookupTable::Entry &e = flat[*k];
+			if (!e.property) {
+				e.property = check->property_setget.getptr(*k);
+			}
+			if (e.kind == LookupTable::KIND_NONE) {
+				e.kind = LookupTable::KIND_PROPERTY;
+			}
+		}
+		k = nullptr;
+		while ((k = check->constant_map.next(k))) {
+			LookupTable::Entry &e = flat[*k];
+			if (e.kind == LookupTable::KIND_NONE) {
+				e.kind = LookupTable::KIND_CONSTANT;
+				e.constant = check->constant_map[*k];
+			}
+		}
+		k = nullptr;
+		while ((k = check->method_map.next(k))) {
+			LookupTable::Entry &e = flat[*k];
+			if (!e.method) {
+				e.method = check->method_map[*k];
+			}
+			if (e.kind == LookupTable::KIND_NONE) {
+				e.kind = LookupTable::KIND_METHOD;
+			}
+		}
+		k = nullptr;
+		while ((k = check->signal_map.next(k))) {
+			LookupTable::Entry &e = flat[*k];
+			if (e.kind == LookupTable::KIND_NONE) {
+				e.kind = LookupTable::KIND_SIGNAL;
+			}
+		}
+	}
+
+	LocalVector<const StringName *> names;
+	LocalVector<uint32_t> hashes;
+	const StringName *k = nullptr;
+	while ((k = flat.next(k))) {
+		names.push_back(k);
+		hashes.push_back(k->hash());
+	}
+
+	// Slots only depend on the name hash, so two names sharing one can never be
+	// placed apart. Leave such a class without a table, lookups walk the chain instead.
+	hashes.sort();
+	for (uint32_t i = 1; i < hashes.size(); i++) {
+		if (hashes[i] == hashes[i - 1]) {
+			return nullptr;
+		}
+	}
+
+	LookupTable *table = memnew(LookupTable);
+	const uint32_t count = names.size();
+	const uint32_t bucket_count = next_power_of_2(count / 4 + 1);
+	table->displacements.resize(bucket_count);
+
+	LocalVector<LocalVector<uint32_t>> buckets;
+	buckets.resize(bucket_count);
+	uint32_t max_bucket_size = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		LocalVector<uint32_t> &bucket = buckets[names[i]->hash() & (bucket_count - 1)];
+		bucket.push_back(i);
+		max_bucket_size = MAX(max_bucket_size, bucket.size());
+	}
+
+	uint32_t slot_count = next_power_of_2(count + count / 4 + 1);
+	LocalVector<uint8_t> used;
+	for (uint32_t attempt = 0;; attempt++) {
+		if (attempt == LOOKUP_TABLE_MAX_ATTEMPTS) {
+			memdelete(table);
+			return nullptr;
+		}
+		if (attempt > 0 && attempt % 16 == 0) {
+			// Very unlikely, but make room rather than trying seeds forever.
+			slot_count *= 2;
+		}
+		const uint32_t mask = slot_count - 1;
+		table->seed = attempt * 0x9e3779b9;
+		used.resize(slot_count);
+		memset(used.ptr(), 0, slot_count);
+
+		bool placed = true;
+		// Place the biggest buckets first, while there is the most room left.
+		for (uint32_t size = max_bucket_size; placed && size > 0; size--) {
+			for (uint32_t b = 0; placed && b < bucket_count; b++) {
+				const LocalVector<uint32_t> &bucket = buckets[b];
+				if (bucket.size() != size) {
+					continue;
+				}
+				placed = false;
+				for (uint32_t displacement = 0; !placed && displacement < slot_count; displacement++) {
+					placed = true;
+					for (uint32_t i = 0; placed && i < size; i++) {
+						const uint32_t slot = (LookupTable::mix(names[bucket[i]]->hash(), table->seed) ^ displacement) & mask;
+						placed = !used[slot];
+						used[slot] = 1; // Undone below if the bucket doesn't fit.
+						if (!placed) {
+							for (uint32_t j = 0; j < i; j++) {
+								used[(LookupTable::mix(names[bucket[j]]->hash(), table->seed) ^ displacement) & mask] = 0;
+							}
+						}
+					}
+					if (placed) {
+						table->displacements[b] = displacement;
+					}
+				}
+			}
+		}
+		if (placed) {
+			break;
+		}
+	}
+
+	table->entries.resize(slot_count);
+	for (uint32_t i = 0; i < count; i++) {
+		const uint32_t hash = names[i]->hash();
+		const uint32_t slot = (LookupTable::mix(hash, table->seed) ^ table->displacements[hash & (bucket_count - 1)]) & (slot_count - 1);
+		table->entries[slot] = flat[*names[i]];
+		table->entries[slot].name = *names[i];
+	}
+
+	return table;
+}
+
+void ClassDB::_invalidate_lookup_tables(const ClassInfo *p_class) {
+	if (!p_class->lookup) {
+		// Registered after the tables were built, so none of its inheriters has one either.
+		return;
+	}
+	const StringName *k = nullptr;
+	while ((k = classes.next(k))) {
+		ClassInfo &ti = classes[*k];
+		if (ti.lookup) {
+			retired_lookup_tables.push_back(ti.lookup);
+			ti.lookup = nullptr;
+		}
+	}
+}
+
+void ClassDB::build_lookup_tables() {
+	OBJTYPE_WLOCK;
+
+	const StringName *k = nullptr;
+	while ((k = classes.next(k))) {
+		ClassInfo &ti = classes[*k];
+		if (ti.lookup) {
+			retired_lookup_tables.push_back(ti.lookup);
+		}
+		ti.lookup = _build_lookup_table(&ti);
+	}
+}
+
+const ClassDB::PropertySetGet *ClassDB::_get_property_setget(const ClassInfo *p_class, const StringName &p_property) {
+	for (const ClassInfo *check = p_class; check; check = check->inherits_ptr) {
+		if (check->lookup) {
+			const LookupTable::Entry *e = check->lookup->find(p_property);
+			return e ? e->property : nullptr;
+		}
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			return psg;
+		}
+	}
+	return nullptr;
+}
+
 bool ClassDB::_is_parent_class(const StringName &p_class, const StringName &p_inherits) {
 	if (!classes.has(p_class)) {
 		return false;
@@ -692,6 +915,10 @@ MethodBind *ClassDB::get_method(StringName p_class, StringName p_name) {
 	ClassInfo *type = classes.getptr(p_class);
 
 	while (type) {
+		if (type->lookup) {
+			const LookupTable::Entry *e = type->lookup->find(p_name);
+			return e ? e->method : nullptr;
+		}
 		MethodBind **method = type->method_map.getptr(p_name);
 		if (method && *method) {
 			return *method;
@@ -712,6 +939,7 @@ void ClassDB::bind_integer_constant(const StringName &p_class, const StringName
 		ERR_FAIL();
 	}
 
+	_invalidate_lookup_tables(type);
 	type->constant_map[p_name] = p_constant;
 
 	String enum_name = p_enum;
@@ -906,6 +1134,7 @@ void ClassDB::add_signal(StringName p_class, const MethodInfo &p_signal) {
 	}
 #endif
 
+	_invalidate_lookup_tables(type);
 	type->signal_map[sname] = p_signal;
 }
 
@@ -1037,6 +1266,7 @@ void ClassDB::add_property(StringName p_class, const PropertyInfo &p_pinfo, cons
 	psg.index = p_index;
 	psg.type = p_pinfo.type;
 
+	_invalidate_lookup_tables(type);
 	type->property_setget[p_pinfo.name] = psg;
 }
 
@@ -1097,50 +1327,44 @@ bool ClassDB::get_property_info(StringName p_class, StringName p_property, Prope
 bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid) {
 	ERR_FAIL_NULL_V(p_object, false);
 
-	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			if (!psg->setter) {
-				if (r_valid) {
-					*r_valid = false;
-				}
-				return true; //return true but do nothing
-			}
-
-			Callable::CallError ce;
+	const PropertySetGet *psg = _get_property_setget(classes.getptr(p_object->get_class_name()), p_property);
+	if (!psg) {
+		return false;
+	}
 
-			if (psg->index >= 0) {
-				Variant index = psg->index;
-				const Variant *arg[2] = { &index, &p_value };
-				//p_object->call(psg->setter,arg,2,ce);
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 2, ce);
-				} else {
-					p_object->call(psg->setter, arg, 2, ce);
-				}
+	if (!psg->setter) {
+		if (r_valid) {
+			*r_valid = false;
+		}
+		return true; //return true but do nothing
+	}
 
-			} else {
-				const Variant *arg[1] = { &p_value };
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 1, ce);
-				} else {
-					p_object->call(psg->setter, arg, 1, ce);
-				}
-			}
+	Callable::CallError ce;
 
-			if (r_valid) {
-				*r_valid = ce.error == Callable::CallError::CALL_OK;
-			}
+	if (psg->index >= 0) {
+		Variant index = psg->index;
+		const Variant *arg[2] = { &index, &p_value };
+		//p_object->call(psg->setter,arg,2,ce);
+		if (psg->_setptr) {
+			psg->_setptr->call(p_object, arg, 2, ce);
+		} else {
+			p_object->call(psg->setter, arg, 2, ce);
+		}
 
-			return true;
+	} else {
+		const Variant *arg[1] = { &p_value };
+		if (psg->_setptr) {
+			psg->_setptr->call(p_object, arg, 1, ce);
+		} else {
+			p_object->call(psg->setter, arg, 1, ce);
 		}
+	}
 
-		check = check->inherits_ptr;
+	if (r_valid) {
+		*r_valid = ce.error == Callable::CallError::CALL_OK;
 	}
 
-	return false;
+	return true;
 }
 
 bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value) {
@@ -1149,7 +1373,31 @@ bool ClassDB::get_property(Object *p_object, const StringName &p_property, Varia
 	ClassInfo *type = classes.getptr(p_object->get_class_name());
 	ClassInfo *check = type;
 	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		const PropertySetGet *psg = nullptr;
+		if (check->lookup) {
+			const LookupTable::Entry *e = check->lookup->find(p_property);
+			if (!e) {
+				return false;
+			}
+			switch (e->kind) {
+				case LookupTable::KIND_PROPERTY:
+					psg = e->property;
+					break;
+				case LookupTable::KIND_CONSTANT:
+					r_value = e->constant;
+					return true;
+				case LookupTable::KIND_METHOD:
+					r_value = Callable(p_object, p_property);
+					return true;
+				case LookupTable::KIND_SIGNAL:
+					r_value = Signal(p_object, p_property);
+					return true;
+				default:
+					return false;
+			}
+		} else {
+			psg = check->property_setget.getptr(p_property);
+		}
 		if (psg) {
 			if (!psg->getter) {
 				return true; //return true but do nothing
@@ -1195,19 +1443,13 @@ bool ClassDB::get_property(Object *p_object, const StringName &p_property, Varia
 }
 
 int ClassDB::get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid) {
-	ClassInfo *type = classes.getptr(p_class);
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			if (r_is_valid) {
-				*r_is_valid = true;
-			}
-
-			return psg->index;
+	const PropertySetGet *psg = _get_property_setget(classes.getptr(p_class), p_property);
+	if (psg) {
+		if (r_is_valid) {
+			*r_is_valid = true;
 		}
 
-		check = check->inherits_ptr;
+		return psg->index;
 	}
 	if (r_is_valid) {
 		*r_is_valid = false;
@@ -1217,19 +1459,13 @@ int ClassDB::get_property_index(const StringName &p_class, const StringName &p_p
 }
 
 Variant::Type ClassDB::get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid) {
-	ClassInfo *type = classes.getptr(p_class);
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			if (r_is_valid) {
-				*r_is_valid = true;
-			}
-
-			return psg->type;
+	const PropertySetGet *psg = _get_property_setget(classes.getptr(p_class), p_property);
+	if (psg) {
+		if (r_is_valid) {
+			*r_is_valid = true;
 		}
 
-		check = check->inherits_ptr;
+		return psg->type;
 	}
 	if (r_is_valid) {
 		*r_is_valid = false;
@@ -1239,39 +1475,53 @@ Variant::Type ClassDB::get_property_type(const StringName &p_class, const String
 }
 
 StringName ClassDB::get_property_setter(StringName p_class, const StringName &p_property) {
-	ClassInfo *type = classes.getptr(p_class);
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			return psg->setter;
-		}
-
-		check = check->inherits_ptr;
+	const PropertySetGet *psg = _get_property_setget(classes.getptr(p_class), p_property);
+	if (psg) {
+		return psg->setter;
 	}
 
 	return StringName();
 }
 
 StringName ClassDB::get_property_getter(StringName p_class, const StringName &p_property) {
-	ClassInfo *type = classes.getptr(p_class);
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			return psg->getter;
-		}
-
-		check = check->inherits_ptr;
+	const PropertySetGet *psg = _get_property_setget(classes.getptr(p_class), p_property);
+	if (psg) {
+		return psg->getter;
 	}
 
 	return StringName();
 }
 
+MethodBind *ClassDB::get_property_setter_method(const StringName &p_class, const StringName &p_property, int *r_index) {
+	const PropertySetGet *psg = _get_property_setget(classes.getptr(p_class), p_property);
+	if (!psg) {
+		return nullptr;
+	}
+	if (r_index) {
+		*r_index = psg->index;
+	}
+	return psg->_setptr;
+}
+
+MethodBind *ClassDB::get_property_getter_method(const StringName &p_class, const StringName &p_property, int *r_index) {
+	const PropertySetGet *psg = _get_property_setget(classes.getptr(p_class), p_property);
+	if (!psg || !psg->getter) {
+		return nullptr;
+	}
+	if (r_index) {
+		*r_index = psg->index;
+	}
+	// Indexed getters are called by name, see get_property().
+	return psg->index >= 0 ? get_method(p_class, psg->getter) : psg->_getptr;
+}
+
 bool ClassDB::has_property(const StringName &p_class, const StringName &p_property, bool p_no_inheritance) {
 	ClassInfo *type = classes.getptr(p_class);
 	ClassInfo *check = type;
 	while (check) {
+		if (check->lookup && !p_no_inheritance) {
+			return _get_property_setget(check, p_property) != nullptr;
+		}
 		if (check->property_setget.has(p_property)) {
 			return true;
 		}
@@ -1298,6 +1548,10 @@ bool ClassDB::has_method(StringName p_class, StringName p_method, bool p_no_inhe
 	ClassInfo *type = classes.getptr(p_class);
 	ClassInfo *check = type;
 	while (check) {
+		if (check->lookup && !p_no_inheritance) {
+			const LookupTable::Entry *e = check->lookup->find(p_method);
+			return e && e->method;
+		}
 		if (check->method_map.has(p_method)) {
 			return true;
 		}
@@ -1353,6 +1607,7 @@ MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, const c
 	type->method_order.push_back(mdname);
 #endif
 
+	_invalidate_lookup_tables(type);
 	type->method_map[mdname] = p_bind;
 
 	Vector<Variant> defvals;
@@ -1564,7 +1819,14 @@ void ClassDB::cleanup() {
 		while ((m = ti.method_map.next(m))) {
 			memdelete(ti.method_map[*m]);
 		}
+		if (ti.lookup) {
+			memdelete(ti.lookup);
+		}
+	}
+	for (uint32_t i = 0; i < retired_lookup_tables.size(); i++) {
+		memdelete(retired_lookup_tables[i]);
 	}
+	retired_lookup_tables.clear();
 	classes.clear();
 	resource_base_extensions.clear();
 	compat_classes.clear();
@@ -110,10 +110,15 @@ public:
 		Variant::Type type;
 	};
 
+	// What a name resolves to in a class and all of its ancestors, built once
+	// registration is done so lookups don't walk the inheritance chain.
+	struct LookupTable;
+
 	struct ClassInfo {
 		APIType api = API_NONE;
 		ClassInfo *inherits_ptr = nullptr;
 		void *class_ptr = nullptr;
+		LookupTable *lookup = nullptr;
 
 		HashMap<StringName, MethodBind *> method_map;
 		HashMap<StringName, int> constant_map;
@@ -169,6 +174,10 @@ private:
 	static StringName _get_parent_class(const StringName &p_class);
 	static bool _is_parent_class(const StringName &p_class, const StringName &p_inherits);
 
+	static LookupTable *_build_lookup_table(const ClassInfo *p_class);
+	static void _invalidate_lookup_tables(const ClassInfo *p_class);
+	static const PropertySetGet *_get_property_setget(const ClassInfo *p_class, const StringName &p_property);
+
 public:
 	// DO NOT USE THIS!!!!!! NEEDS TO BE PUBLIC BUT DO NOT USE NO MATTER WHAT!!!
 	template <class T>
@@ -352,6 +361,9 @@ public:
 	static Variant::Type get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
 	static StringName get_property_setter(StringName p_class, const StringName &p_property);
 	static StringName get_property_getter(StringName p_class, const StringName &p_property);
+	// Methods set_property() and get_property() end up calling, for callers that cache them.
+	static MethodBind *get_property_setter_method(const StringName &p_class, const StringName &p_property, int *r_index = nullptr);
+	static MethodBind *get_property_getter_method(const StringName &p_class, const StringName &p_property, int *r_index = nullptr);
 
 	static bool has_method(StringName p_class, StringName p_method, bool p_no_inheritance = false);
 	static void set_method_flags(StringName p_class, StringName p_method, int p_flags);
@@ -390,6 +402,7 @@ public:
 
 	static void set_current_api(APIType p_api);
 	static APIType get_current_api();
+	static void build_lookup_tables();
 	static void cleanup_defaults();
 	static void cleanup();
 };
@@ -1819,61 +1819,109 @@ void postinitialize_handler(Object *p_object) {
 }
 
 void ObjectDB::debug_objects(DebugFunc p_func) {
-	spin_lock.lock();
-
-	for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-		if (object_slots[i].validator) {
-			p_func(object_slots[i].object);
-
-			count--;
+	uint32_t chunks = chunk_count.load(std::memory_order_acquire);
+	for (uint32_t i = 0; i < chunks; i++) {
+		ObjectSlot *chunk = slot_chunks[i].load(std::memory_order_acquire);
+		for (uint32_t j = 0; j < OBJECTDB_SLOT_CHUNK_SIZE; j++) {
+			if (chunk[j].validator.load(std::memory_order_acquire)) {
+				p_func(chunk[j].object.load(std::memory_order_acquire));
+			}
 		}
 	}
-	spin_lock.unlock();
 }
 
 void Object::get_argument_options(const StringName &p_function, int p_idx, List<String> *r_options) const {
 }
 
-SpinLock ObjectDB::spin_lock;
-uint32_t ObjectDB::slot_count = 0;
-uint32_t ObjectDB::slot_max = 0;
-ObjectDB::ObjectSlot *ObjectDB::object_slots = nullptr;
-uint64_t ObjectDB::validator_counter = 0;
+std::atomic<ObjectDB::ObjectSlot *> ObjectDB::slot_chunks[OBJECTDB_MAX_CHUNKS] = {};
+std::atomic<uint32_t> ObjectDB::chunk_count(0);
+std::atomic<uint64_t> ObjectDB::free_list(0);
+std::atomic<uint32_t> ObjectDB::slot_count(0);
+BinaryMutex ObjectDB::grow_mutex;
 
 int ObjectDB::get_object_count() {
-	return slot_count;
+	return slot_count.load(std::memory_order_relaxed);
 }
 
-ObjectID ObjectDB::add_instance(Object *p_object) {
-	spin_lock.lock();
-	if (unlikely(slot_count == slot_max)) {
-		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
+uint32_t ObjectDB::_pop_free_slot() {
+	uint64_t head = free_list.load(std::memory_order_acquire);
+	while (true) {
+		uint32_t first = head & 0xFFFFFFFF;
+		if (first == 0) {
+			return 0;
+		}
+		uint32_t slot = first - 1;
+		// Chunks are never freed, so reading a slot another thread just popped is harmless, the tag makes the exchange fail.
+		uint32_t next = slot_chunks[slot >> OBJECTDB_SLOT_CHUNK_BITS].load(std::memory_order_acquire)[slot & OBJECTDB_SLOT_CHUNK_MASK].next_free.load(std::memory_order_relaxed);
+		uint64_t new_head = (((head >> 32) + 1) << 32) | next;
+		if (free_list.compare_exchange_weak(head, new_head, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			return first;
+		}
+	}
+}
 
-		uint32_t new_slot_max = slot_max > 0 ? slot_max * 2 : 1;
-		object_slots = (ObjectSlot *)memrealloc(object_slots, sizeof(ObjectSlot) * new_slot_max);
-		for (uint32_t i = slot_max; i < new_slot_max; i++) {
-			object_slots[i].object = nullptr;
-			object_slots[i].is_reference = false;
-			object_slots[i].next_free = i;
-			object_slots[i].validator = 0;
+void ObjectDB::_push_free_slots(uint32_t p_first, uint32_t p_last) {
+	ObjectSlot &last = slot_chunks[p_last >> OBJECTDB_SLOT_CHUNK_BITS].load(std::memory_order_relaxed)[p_last & OBJECTDB_SLOT_CHUNK_MASK];
+	uint64_t head = free_list.load(std::memory_order_relaxed);
+	while (true) {
+		last.next_free.store(head & 0xFFFFFFFF, std::memory_order_relaxed);
+		uint64_t new_head = (((head >> 32) + 1) << 32) | (p_first + 1);
+		if (free_list.compare_exchange_weak(head, new_head, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+			return;
 		}
-		slot_max = new_slot_max;
 	}
+}
+
+uint32_t ObjectDB::_grow() {
+	MutexLock lock(grow_mutex);
+
+	// Another thread may have grown the table while this one waited.
+	uint32_t first = _pop_free_slot();
+	if (first != 0) {
+		return first;
+	}
+
+	uint32_t chunk_index = chunk_count.load(std::memory_order_relaxed);
+	CRASH_COND(chunk_index == OBJECTDB_MAX_CHUNKS);
+
+	ObjectSlot *chunk = (ObjectSlot *)memalloc(sizeof(ObjectSlot) * OBJECTDB_SLOT_CHUNK_SIZE);
+	uint32_t chunk_base = chunk_index << OBJECTDB_SLOT_CHUNK_BITS;
+	for (uint32_t i = 0; i < OBJECTDB_SLOT_CHUNK_SIZE; i++) {
+		memnew_placement(&chunk[i], ObjectSlot);
+		chunk[i].validator.store(0, std::memory_order_relaxed);
+		chunk[i].object.store(nullptr, std::memory_order_relaxed);
+		chunk[i].next_free.store(chunk_base + i + 2, std::memory_order_relaxed);
+		chunk[i].generation = 0;
+	}
+
+	slot_chunks[chunk_index].store(chunk, std::memory_order_release);
+	chunk_count.store(chunk_index + 1, std::memory_order_release);
+
+	// Keep the first slot for the caller, the rest are already linked and go to the free list at once.
+	_push_free_slots(chunk_base + 1, chunk_base + OBJECTDB_SLOT_CHUNK_SIZE - 1);
+
+	return chunk_base + 1;
+}
 
-	uint32_t slot = object_slots[slot_count].next_free;
-	if (object_slots[slot].object != nullptr) {
-		spin_lock.unlock();
-		ERR_FAIL_COND_V(object_slots[slot].object != nullptr, ObjectID());
+ObjectID ObjectDB::add_instance(Object *p_object) {
+	uint32_t first = _pop_free_slot();
+	if (unlikely(first == 0)) {
+		first = _grow();
 	}
-	object_slots[slot].object = p_object;
-	object_slots[slot].is_reference = p_object->is_reference();
-	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
-	if (unlikely(validator_counter == 0)) {
-		validator_counter = 1;
+
+	uint32_t slot = first - 1;
+	ObjectSlot &object_slot = slot_chunks[slot >> OBJECTDB_SLOT_CHUNK_BITS].load(std::memory_order_acquire)[slot & OBJECTDB_SLOT_CHUNK_MASK];
+	ERR_FAIL_COND_V(object_slot.object.load(std::memory_order_relaxed) != nullptr, ObjectID());
+
+	uint64_t validator = (object_slot.generation + 1) & OBJECTDB_VALIDATOR_MASK;
+	if (unlikely(validator == 0)) {
+		validator = 1;
 	}
-	object_slots[slot].validator = validator_counter;
+	object_slot.generation = validator;
+	object_slot.object.store(p_object, std::memory_order_release);
+	object_slot.validator.store(validator, std::memory_order_release);
 
-	uint64_t id = validator_counter;
+	uint64_t id = validator;
 	id <<= OBJECTDB_SLOT_MAX_COUNT_BITS;
 	id |= uint64_t(slot);
 
@@ -1881,9 +1929,7 @@ ObjectID ObjectDB::add_instance(Object *p_object) {
 		id |= OBJECTDB_REFERENCE_BIT;
 	}
 
-	slot_count++;
-
-	spin_lock.unlock();
+	slot_count.fetch_add(1, std::memory_order_relaxed);
 
 	return ObjectID(id);
 }
@@ -1892,33 +1938,24 @@ void ObjectDB::remove_instance(Object *p_object) {
 	uint64_t t = p_object->get_instance_id();
 	uint32_t slot = t & OBJECTDB_SLOT_MAX_COUNT_MASK; //slot is always valid on valid object
 
-	spin_lock.lock();
+	ObjectSlot &object_slot = slot_chunks[slot >> OBJECTDB_SLOT_CHUNK_BITS].load(std::memory_order_acquire)[slot & OBJECTDB_SLOT_CHUNK_MASK];
 
 #ifdef DEBUG_ENABLED
 
-	if (object_slots[slot].object != p_object) {
-		spin_lock.unlock();
-		ERR_FAIL_COND(object_slots[slot].object != p_object);
-	}
+	ERR_FAIL_COND(object_slot.object.load(std::memory_order_relaxed) != p_object);
 	{
 		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (object_slots[slot].validator != validator) {
-			spin_lock.unlock();
-			ERR_FAIL_COND(object_slots[slot].validator != validator);
-		}
+		ERR_FAIL_COND(object_slot.validator.load(std::memory_order_relaxed) != validator);
 	}
 
 #endif
-	//decrease slot count
-	slot_count--;
-	//set the free slot properly
-	object_slots[slot_count].next_free = slot;
 	//invalidate, so checks against it fail
-	object_slots[slot].validator = 0;
-	object_slots[slot].is_reference = false;
-	object_slots[slot].object = nullptr;
+	object_slot.validator.store(0, std::memory_order_release);
+	object_slot.object.store(nullptr, std::memory_order_release);
+
+	slot_count.fetch_sub(1, std::memory_order_relaxed);
 
-	spin_lock.unlock();
+	_push_free_slots(slot, slot);
 }
 
 void ObjectDB::setup() {
@@ -1926,9 +1963,7 @@ void ObjectDB::setup() {
 }
 
 void ObjectDB::cleanup() {
-	if (slot_count > 0) {
-		spin_lock.lock();
-
+	if (slot_count.load(std::memory_order_acquire) > 0) {
 		WARN_PRINT("ObjectDB instances leaked at exit (run with --verbose for details).");
 		if (OS::get_singleton()->is_stdout_verbose()) {
 			// Ensure calling the native classes because if a leaked instance has a script
@@ -1938,9 +1973,14 @@ void ObjectDB::cleanup() {
 			MethodBind *resource_get_path = ClassDB::get_method("Resource", "get_path");
 			Callable::CallError call_error;
 
-			for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-				if (object_slots[i].validator) {
-					Object *obj = object_slots[i].object;
+			for (uint32_t i = 0; i < chunk_count.load(std::memory_order_acquire); i++) {
+				ObjectSlot *chunk = slot_chunks[i].load(std::memory_order_acquire);
+				for (uint32_t j = 0; j < OBJECTDB_SLOT_CHUNK_SIZE; j++) {
+					uint64_t validator = chunk[j].validator.load(std::memory_order_acquire);
+					if (!validator) {
+						continue;
+					}
+					Object *obj = chunk[j].object.load(std::memory_order_acquire);
 
 					String extra_info;
 					if (obj->is_class("Node")) {
@@ -1950,18 +1990,19 @@ void ObjectDB::cleanup() {
 						extra_info = " - Resource path: " + String(resource_get_path->call(obj, nullptr, 0, call_error));
 					}
 
-					uint64_t id = uint64_t(i) | (uint64_t(object_slots[i].validator) << OBJECTDB_VALIDATOR_BITS) | (object_slots[i].is_reference ? OBJECTDB_REFERENCE_BIT : 0);
+					uint64_t slot = (uint64_t(i) << OBJECTDB_SLOT_CHUNK_BITS) | j;
+					uint64_t id = slot | (validator << OBJECTDB_SLOT_MAX_COUNT_BITS) | (obj->is_reference() ? OBJECTDB_REFERENCE_BIT : 0);
 					print_line("Leaked instance: " + String(obj->get_class()) + ":" + itos(id) + extra_info);
-
-					count--;
 				}
 			}
 			print_line("Hint: Leaked instances typically happen when nodes are removed from the scene tree (with `remove_child()`) but not freed (with `free()` or `queue_free()`).");
 		}
-		spin_lock.unlock();
 	}
 
-	if (object_slots) {
-		memfree(object_slots);
+	for (uint32_t i = 0; i < chunk_count.load(std::memory_order_acquire); i++) {
+		memfree(slot_chunks[i].load(std::memory_order_relaxed));
+		slot_chunks[i].store(nullptr, std::memory_order_relaxed);
 	}
+	chunk_count.store(0, std::memory_order_release);
+	free_list.store(0, std::memory_order_release);
 }
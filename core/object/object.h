@@ -32,6 +32,7 @@
 #define OBJECT_H
 
 #include "core/object/object_id.h"
+#include "core/os/mutex.h"
 #include "core/os/rw_lock.h"
 #include "core/os/spin_lock.h"
 #include "core/templates/hash_map.h"
@@ -739,24 +740,34 @@ class ObjectDB {
 #define OBJECTDB_SLOT_MAX_COUNT_BITS 24
 #define OBJECTDB_SLOT_MAX_COUNT_MASK ((uint64_t(1) << OBJECTDB_SLOT_MAX_COUNT_BITS) - 1)
 #define OBJECTDB_REFERENCE_BIT (uint64_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS + OBJECTDB_VALIDATOR_BITS))
-
-	struct ObjectSlot { //128 bits per slot
-		uint64_t validator : OBJECTDB_VALIDATOR_BITS;
-		uint64_t next_free : OBJECTDB_SLOT_MAX_COUNT_BITS;
-		uint64_t is_reference : 1;
-		Object *object;
+#define OBJECTDB_SLOT_CHUNK_BITS 12
+#define OBJECTDB_SLOT_CHUNK_SIZE (1 << OBJECTDB_SLOT_CHUNK_BITS)
+#define OBJECTDB_SLOT_CHUNK_MASK (OBJECTDB_SLOT_CHUNK_SIZE - 1)
+#define OBJECTDB_MAX_CHUNKS (1 << (OBJECTDB_SLOT_MAX_COUNT_BITS - OBJECTDB_SLOT_CHUNK_BITS))
+
+	// Slots live in chunks that are never moved or freed until cleanup, so they can be read without locking.
+	// A free slot has a validator of zero, generation keeps counting across reuses so stale IDs fail.
+	struct ObjectSlot {
+		std::atomic<uint64_t> validator;
+		std::atomic<Object *> object;
+		std::atomic<uint32_t> next_free; // Index + 1 of the next free slot, 0 ends the list.
+		uint64_t generation;
 	};
 
-	static SpinLock spin_lock;
-	static uint32_t slot_count;
-	static uint32_t slot_max;
-	static ObjectSlot *object_slots;
-	static uint64_t validator_counter;
+	static std::atomic<ObjectSlot *> slot_chunks[OBJECTDB_MAX_CHUNKS];
+	static std::atomic<uint32_t> chunk_count;
+	static std::atomic<uint64_t> free_list; // Tag in the high 32 bits avoids ABA, index + 1 of the first free slot in the low ones.
+	static std::atomic<uint32_t> slot_count;
+	static BinaryMutex grow_mutex;
 
 	friend class Object;
 	friend void unregister_core_types();
 	static void cleanup();
 
+	static uint32_t _pop_free_slot();
+	static void _push_free_slots(uint32_t p_first, uint32_t p_last);
+	static uint32_t _grow();
+
 	static ObjectID add_instance(Object *p_object);
 	static void remove_instance(Object *p_object);
 
@@ -770,20 +781,22 @@ public:
 		uint64_t id = p_instance_id;
 		uint32_t slot = id & OBJECTDB_SLOT_MAX_COUNT_MASK;
 
-		ERR_FAIL_COND_V(slot >= slot_max, nullptr); //this should never happen unless RID is corrupted
-
-		spin_lock.lock();
+		ObjectSlot *chunk = slot_chunks[slot >> OBJECTDB_SLOT_CHUNK_BITS].load(std::memory_order_acquire);
+		ERR_FAIL_COND_V(!chunk, nullptr); //this should never happen unless RID is corrupted
 
+		ObjectSlot &object_slot = chunk[slot & OBJECTDB_SLOT_CHUNK_MASK];
 		uint64_t validator = (id >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
 
-		if (unlikely(object_slots[slot].validator != validator)) {
-			spin_lock.unlock();
+		if (unlikely(object_slot.validator.load(std::memory_order_acquire) != validator)) {
 			return nullptr;
 		}
 
-		Object *object = object_slots[slot].object;
+		Object *object = object_slot.object.load(std::memory_order_acquire);
 
-		spin_lock.unlock();
+		// The slot may have been freed and reused meanwhile, the validator tells.
+		if (unlikely(object_slot.validator.load(std::memory_order_relaxed) != validator)) {
+			return nullptr;
+		}
 
 		return object;
 	}
@@ -31,13 +31,16 @@
 #include "memory.h"
 
 #include "core/error/error_macros.h"
+#include "core/os/memory_tracker.h"
+#include "core/os/small_object_allocator.h"
 #include "core/templates/safe_refcount.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 void *operator new(size_t p_size, const char *p_description) {
-	return Memory::alloc_static(p_size, false);
+	return Memory::alloc_static(p_size, false, p_description);
 }
 
 void *operator new(size_t p_size, void *(*p_allocfunc)(size_t p_size)) {
@@ -65,19 +68,75 @@ SafeNumeric<uint64_t> Memory::max_usage;
 
 SafeNumeric<uint64_t> Memory::alloc_count;
 
-void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
-#ifdef DEBUG_ENABLED
+// Small blocks come from the small object allocator when it's enabled. It may have been enabled
+// after a block was allocated, so frees and reallocs check who owns the block instead.
+
+_FORCE_INLINE_ void *Memory::_alloc_block(size_t p_bytes) {
+	alloc_count.increment();
+	if (SmallObjectAllocator::is_enabled() && p_bytes <= SmallObjectAllocator::MAX_SIZE) {
+		void *block = SmallObjectAllocator::alloc(p_bytes);
+		if (likely(block)) {
+			return block;
+		}
+		// No span could be reserved, or it lies outside of the addresses the allocator can map.
+	}
+
+	return malloc(p_bytes);
+}
+
+_FORCE_INLINE_ void Memory::_free_block(void *p_block) {
+	alloc_count.decrement();
+	if (SmallObjectAllocator::owns(p_block)) {
+		SmallObjectAllocator::free(p_block);
+		return;
+	}
+
+	free(p_block);
+}
+
+void *Memory::_realloc_block(void *p_block, size_t p_bytes) {
+	if (!SmallObjectAllocator::owns(p_block)) {
+		return realloc(p_block, p_bytes);
+	}
+
+	if (p_bytes == 0) {
+		_free_block(p_block);
+		return nullptr;
+	}
+
+	size_t block_size = SmallObjectAllocator::get_block_size(p_block);
+	if (p_bytes <= block_size) {
+		return p_block;
+	}
+
+	void *new_block = _alloc_block(p_bytes);
+	if (!new_block) {
+		return nullptr;
+	}
+	memcpy(new_block, p_block, block_size);
+	_free_block(p_block);
+	return new_block;
+}
+
+#ifdef MEMORY_TRACKING_ENABLED
+// Tracked blocks keep their category in the high bits of the size stored in the pad.
+#define PAD_CATEGORY_SHIFT 48
+#define PAD_SIZE_MASK ((uint64_t(1) << PAD_CATEGORY_SHIFT) - 1)
+#else
+#define PAD_SIZE_MASK UINT64_MAX
+#endif
+
+void *Memory::alloc_static(size_t p_bytes, bool p_pad_align, const char *p_description) {
+#if defined(DEBUG_ENABLED) || defined(MEMORY_TRACKING_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
 #endif
 
-	void *mem = malloc(p_bytes + (prepad ? PAD_ALIGN : 0));
+	void *mem = _alloc_block(p_bytes + (prepad ? PAD_ALIGN : 0));
 
 	ERR_FAIL_COND_V(!mem, nullptr);
 
-	alloc_count.increment();
-
 	if (prepad) {
 		uint64_t *s = (uint64_t *)mem;
 		*s = p_bytes;
@@ -88,20 +147,26 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 		uint64_t new_mem_usage = mem_usage.add(p_bytes);
 		max_usage.exchange_if_greater(new_mem_usage);
 #endif
+
+#ifdef MEMORY_TRACKING_ENABLED
+		uint32_t category = MemoryTracker::get_category(p_description);
+		MemoryTracker::track_alloc(category, p_bytes);
+		*s |= uint64_t(category) << PAD_CATEGORY_SHIFT;
+#endif
 		return s8 + PAD_ALIGN;
 	} else {
 		return mem;
 	}
 }
 
-void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
+void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align, const char *p_description) {
 	if (p_memory == nullptr) {
-		return alloc_static(p_bytes, p_pad_align);
+		return alloc_static(p_bytes, p_pad_align, p_description);
 	}
 
 	uint8_t *mem = (uint8_t *)p_memory;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(MEMORY_TRACKING_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -110,33 +175,45 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 	if (prepad) {
 		mem -= PAD_ALIGN;
 		uint64_t *s = (uint64_t *)mem;
+		uint64_t old_bytes = *s & PAD_SIZE_MASK;
+		uint64_t pad_tag = *s & ~PAD_SIZE_MASK;
 
 #ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			uint64_t new_mem_usage = mem_usage.add(p_bytes - *s);
+		if (p_bytes > old_bytes) {
+			uint64_t new_mem_usage = mem_usage.add(p_bytes - old_bytes);
 			max_usage.exchange_if_greater(new_mem_usage);
 		} else {
-			mem_usage.sub(*s - p_bytes);
+			mem_usage.sub(old_bytes - p_bytes);
 		}
 #endif
 
+#ifdef MEMORY_TRACKING_ENABLED
+		// Blocks stay in the category they were allocated in.
+		uint32_t category = pad_tag >> PAD_CATEGORY_SHIFT;
 		if (p_bytes == 0) {
-			free(mem);
+			MemoryTracker::track_free(category, old_bytes);
+		} else {
+			MemoryTracker::track_realloc(category, old_bytes, p_bytes);
+		}
+#endif
+
+		if (p_bytes == 0) {
+			_free_block(mem);
 			return nullptr;
 		} else {
-			*s = p_bytes;
+			*s = p_bytes | pad_tag;
 
-			mem = (uint8_t *)realloc(mem, p_bytes + PAD_ALIGN);
+			mem = (uint8_t *)_realloc_block(mem, p_bytes + PAD_ALIGN);
 			ERR_FAIL_COND_V(!mem, nullptr);
 
 			s = (uint64_t *)mem;
 
-			*s = p_bytes;
+			*s = p_bytes | pad_tag;
 
 			return mem + PAD_ALIGN;
 		}
 	} else {
-		mem = (uint8_t *)realloc(mem, p_bytes);
+		mem = (uint8_t *)_realloc_block(mem, p_bytes);
 
 		ERR_FAIL_COND_V(mem == nullptr && p_bytes > 0, nullptr);
 
@@ -149,25 +226,28 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_ptr;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(MEMORY_TRACKING_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
 #endif
 
-	alloc_count.decrement();
-
 	if (prepad) {
 		mem -= PAD_ALIGN;
 
 #ifdef DEBUG_ENABLED
 		uint64_t *s = (uint64_t *)mem;
-		mem_usage.sub(*s);
+		mem_usage.sub(*s & PAD_SIZE_MASK);
+#endif
+
+#ifdef MEMORY_TRACKING_ENABLED
+		uint64_t pad = *(uint64_t *)mem;
+		MemoryTracker::track_free(pad >> PAD_CATEGORY_SHIFT, pad & PAD_SIZE_MASK);
 #endif
 
-		free(mem);
+		_free_block(mem);
 	} else {
-		free(mem);
+		_free_block(mem);
 	}
 }
 
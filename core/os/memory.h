@@ -49,9 +49,14 @@ class Memory {
 
 	static SafeNumeric<uint64_t> alloc_count;
 
+	static void *_alloc_block(size_t p_bytes);
+	static void _free_block(void *p_block);
+	static void *_realloc_block(void *p_block, size_t p_bytes);
+
 public:
-	static void *alloc_static(size_t p_bytes, bool p_pad_align = false);
-	static void *realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align = false);
+	// p_description is only used to tag blocks in builds with memory tracking.
+	static void *alloc_static(size_t p_bytes, bool p_pad_align = false, const char *p_description = nullptr);
+	static void *realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align = false, const char *p_description = nullptr);
 	static void free_static(void *p_ptr, bool p_pad_align = false);
 
 	static uint64_t get_mem_available();
@@ -78,8 +83,13 @@ void operator delete(void *p_mem, void *(*p_allocfunc)(size_t p_size));
 void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_description);
 #endif
 
+#ifdef MEMORY_TRACKING_ENABLED
+#define memalloc(m_size) Memory::alloc_static(m_size, false, __FILE__)
+#define memrealloc(m_mem, m_size) Memory::realloc_static(m_mem, m_size, false, __FILE__)
+#else
 #define memalloc(m_size) Memory::alloc_static(m_size)
 #define memrealloc(m_mem, m_size) Memory::realloc_static(m_mem, m_size)
+#endif
 #define memfree(m_size) Memory::free_static(m_size)
 
 _ALWAYS_INLINE_ void postinitialize_handler(void *) {}
@@ -90,7 +100,11 @@ _ALWAYS_INLINE_ T *_post_initialize(T *p_obj) {
 	return p_obj;
 }
 
+#ifdef MEMORY_TRACKING_ENABLED
+#define memnew(m_class) _post_initialize(new (__FILE__) m_class)
+#else
 #define memnew(m_class) _post_initialize(new ("") m_class)
+#endif
 
 _ALWAYS_INLINE_ void *operator new(size_t p_size, void *p_pointer, size_t check, const char *p_description) {
 	//void *failptr=0;
@@ -0,0 +1,281 @@
+/*************************************************************************/
+/*  memory_tracker.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "memory_tracker.h"
+
+#include "core/error/error_macros.h"
+#include "core/os/spin_lock.h"
+
+#include <string.h>
+#include <atomic>
+
+enum {
+	// Must be larger than the amount of source files allocating memory.
+	DESCRIPTION_TABLE_BITS = 13,
+	DESCRIPTION_TABLE_SIZE = 1 << DESCRIPTION_TABLE_BITS,
+};
+
+struct TrackedCategory {
+	char name[MemoryTracker::MAX_CATEGORY_NAME_LENGTH];
+	bool generic;
+	std::atomic<uint64_t> live_bytes;
+	std::atomic<uint64_t> live_allocations;
+	std::atomic<uint64_t> allocated_bytes;
+	std::atomic<uint64_t> allocation_count;
+};
+
+struct DescriptionEntry {
+	std::atomic<const char *> description;
+	uint32_t category;
+};
+
+// Blocks are tracked before static constructors run, so all the state is zero-initialized.
+static TrackedCategory categories[MemoryTracker::MAX_CATEGORIES];
+static std::atomic<uint32_t> category_count;
+static DescriptionEntry description_table[DESCRIPTION_TABLE_SIZE];
+static SpinLock register_lock;
+static thread_local uint32_t scope_category = MemoryTracker::INVALID_CATEGORY;
+
+static const char *untagged_description = "untagged";
+
+// Top level directories of the tree, used to make absolute call site paths relative.
+static const char *source_roots[] = {
+	"core", "drivers", "editor", "main", "modules", "platform", "scene", "servers", "tests", "thirdparty", nullptr
+};
+
+// Containers and strings are used by everything, their blocks go to the current scope.
+static const char *generic_categories[] = {
+	"untagged", "core/os", "core/string", "core/templates", "core/variant", nullptr
+};
+
+static _FORCE_INLINE_ bool _is_separator(char p_char) {
+	return p_char == '/' || p_char == '\\';
+}
+
+static const char *_get_relative_path(const char *p_path) {
+	if (!_is_separator(p_path[0]) && (p_path[0] == 0 || p_path[1] != ':')) {
+		while (p_path[0] == '.' && _is_separator(p_path[1])) {
+			p_path += 2;
+		}
+		return p_path;
+	}
+
+	for (const char *c = p_path; *c; c++) {
+		if (!_is_separator(*c)) {
+			continue;
+		}
+		for (int i = 0; source_roots[i]; i++) {
+			size_t len = strlen(source_roots[i]);
+			if (strncmp(c + 1, source_roots[i], len) == 0 && _is_separator(c[len + 1])) {
+				return c + 1;
+			}
+		}
+	}
+	return p_path;
+}
+
+// Call site files are named after their directory, anything else is used as is.
+static void _make_category_name(const char *p_description, char *r_name) {
+	const char *path = _get_relative_path(p_description);
+
+	size_t len = 0;
+	for (size_t i = 0; path[i]; i++) {
+		if (_is_separator(path[i])) {
+			len = i;
+		}
+	}
+	if (len == 0) {
+		len = strlen(path);
+	}
+	if (len > MemoryTracker::MAX_CATEGORY_NAME_LENGTH - 1) {
+		len = MemoryTracker::MAX_CATEGORY_NAME_LENGTH - 1;
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		r_name[i] = path[i] == '\\' ? '/' : path[i];
+	}
+	r_name[len] = 0;
+}
+
+static bool _is_generic_category(const char *p_name) {
+	for (int i = 0; generic_categories[i]; i++) {
+		if (strcmp(p_name, generic_categories[i]) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Must be called with register_lock held.
+static uint32_t _find_or_add_category(const char *p_name) {
+	uint32_t count = category_count.load(std::memory_order_relaxed);
+	for (uint32_t i = 0; i < count; i++) {
+		if (strcmp(categories[i].name, p_name) == 0) {
+			return i;
+		}
+	}
+	if (count == MemoryTracker::MAX_CATEGORIES) {
+		return 0; // Out of categories, the first one is always "untagged".
+	}
+
+	TrackedCategory &category = categories[count];
+	strcpy(category.name, p_name);
+	category.generic = _is_generic_category(p_name);
+	category_count.store(count + 1, std::memory_order_release);
+	return count;
+}
+
+static uint32_t _register_description(const char *p_description, uint32_t p_index) {
+	register_lock.lock();
+
+	if (category_count.load(std::memory_order_relaxed) == 0) {
+		_find_or_add_category(untagged_description);
+	}
+
+	uint32_t category = 0;
+	for (uint32_t i = 0; i < DESCRIPTION_TABLE_SIZE; i++) {
+		DescriptionEntry &entry = description_table[(p_index + i) & (DESCRIPTION_TABLE_SIZE - 1)];
+		const char *description = entry.description.load(std::memory_order_relaxed);
+		if (description == p_description) {
+			category = entry.category; // Registered by another thread meanwhile.
+			break;
+		}
+		if (!description) {
+			char name[MemoryTracker::MAX_CATEGORY_NAME_LENGTH];
+			_make_category_name(p_description, name);
+			category = _find_or_add_category(name);
+			entry.category = category;
+			entry.description.store(p_description, std::memory_order_release);
+			break;
+		}
+	}
+
+	register_lock.unlock();
+	return category;
+}
+
+// Descriptions are string literals, so they are looked up by address. Different literals with the
+// same contents (e.g. __FILE__ in headers) end up in the same category.
+static uint32_t _get_description_category(const char *p_description) {
+	if (!p_description || !p_description[0]) {
+		p_description = untagged_description;
+	}
+
+	uint32_t index = uint32_t((uint64_t(uintptr_t(p_description)) * 0x9E3779B97F4A7C15) >> (64 - DESCRIPTION_TABLE_BITS));
+	for (uint32_t i = 0; i < DESCRIPTION_TABLE_SIZE; i++) {
+		const DescriptionEntry &entry = description_table[(index + i) & (DESCRIPTION_TABLE_SIZE - 1)];
+		const char *description = entry.description.load(std::memory_order_acquire);
+		if (description == p_description) {
+			return entry.category;
+		}
+		if (!description) {
+			break;
+		}
+	}
+	return _register_description(p_description, index);
+}
+
+MemoryTracker::Scope::Scope(const char *p_category) {
+	previous = scope_category;
+	scope_category = _get_description_category(p_category);
+}
+
+MemoryTracker::Scope::~Scope() {
+	scope_category = previous;
+}
+
+bool MemoryTracker::is_enabled() {
+#ifdef MEMORY_TRACKING_ENABLED
+	return true;
+#else
+	return false;
+#endif
+}
+
+uint32_t MemoryTracker::get_category(const char *p_description) {
+	uint32_t category = _get_description_category(p_description);
+	if (categories[category].generic && scope_category != INVALID_CATEGORY) {
+		return scope_category;
+	}
+	return category;
+}
+
+void MemoryTracker::track_alloc(uint32_t p_category, uint64_t p_bytes) {
+	TrackedCategory &category = categories[p_category];
+	category.live_bytes.fetch_add(p_bytes, std::memory_order_relaxed);
+	category.live_allocations.fetch_add(1, std::memory_order_relaxed);
+	category.allocated_bytes.fetch_add(p_bytes, std::memory_order_relaxed);
+	category.allocation_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MemoryTracker::track_realloc(uint32_t p_category, uint64_t p_old_bytes, uint64_t p_new_bytes) {
+	TrackedCategory &category = categories[p_category];
+	if (p_new_bytes > p_old_bytes) {
+		category.live_bytes.fetch_add(p_new_bytes - p_old_bytes, std::memory_order_relaxed);
+		category.allocated_bytes.fetch_add(p_new_bytes - p_old_bytes, std::memory_order_relaxed);
+	} else {
+		category.live_bytes.fetch_sub(p_old_bytes - p_new_bytes, std::memory_order_relaxed);
+	}
+}
+
+void MemoryTracker::track_free(uint32_t p_category, uint64_t p_bytes) {
+	TrackedCategory &category = categories[p_category];
+	category.live_bytes.fetch_sub(p_bytes, std::memory_order_relaxed);
+	category.live_allocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+int MemoryTracker::get_category_count() {
+	return category_count.load(std::memory_order_acquire);
+}
+
+const char *MemoryTracker::get_category_name(int p_category) {
+	ERR_FAIL_INDEX_V(p_category, get_category_count(), "");
+	return categories[p_category].name;
+}
+
+uint64_t MemoryTracker::get_category_live_bytes(int p_category) {
+	ERR_FAIL_INDEX_V(p_category, get_category_count(), 0);
+	return categories[p_category].live_bytes.load(std::memory_order_relaxed);
+}
+
+uint64_t MemoryTracker::get_category_live_allocations(int p_category) {
+	ERR_FAIL_INDEX_V(p_category, get_category_count(), 0);
+	return categories[p_category].live_allocations.load(std::memory_order_relaxed);
+}
+
+uint64_t MemoryTracker::get_category_allocated_bytes(int p_category) {
+	ERR_FAIL_INDEX_V(p_category, get_category_count(), 0);
+	return categories[p_category].allocated_bytes.load(std::memory_order_relaxed);
+}
+
+uint64_t MemoryTracker::get_category_allocation_count(int p_category) {
+	ERR_FAIL_INDEX_V(p_category, get_category_count(), 0);
+	return categories[p_category].allocation_count.load(std::memory_order_relaxed);
+}
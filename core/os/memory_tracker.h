@@ -0,0 +1,80 @@
+/*************************************************************************/
+/*  memory_tracker.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef MEMORY_TRACKER_H
+#define MEMORY_TRACKER_H
+
+#include "core/typedefs.h"
+
+// Per-category heap accounting, recorded by Memory in builds with memory_tracking=yes.
+// Blocks are tagged with the description passed by memnew/memalloc, which is the source file of
+// the call site, and categories are named after its directory (e.g. "scene/3d" or "modules/gdscript").
+// Generic containers (Vector, String, Variant...) allocate from core, so their blocks are attributed
+// to the innermost Scope of the allocating thread instead, when there's one.
+class MemoryTracker {
+public:
+	enum {
+		MAX_CATEGORIES = 1024,
+		MAX_CATEGORY_NAME_LENGTH = 64,
+		INVALID_CATEGORY = 0xFFFF,
+	};
+
+	class Scope {
+		uint32_t previous;
+
+	public:
+		Scope(const char *p_category);
+		~Scope();
+	};
+
+	static bool is_enabled();
+
+	// Never allocates, it's called by Memory for every block.
+	static uint32_t get_category(const char *p_description);
+	static void track_alloc(uint32_t p_category, uint64_t p_bytes);
+	static void track_realloc(uint32_t p_category, uint64_t p_old_bytes, uint64_t p_new_bytes);
+	static void track_free(uint32_t p_category, uint64_t p_bytes);
+
+	static int get_category_count();
+	static const char *get_category_name(int p_category);
+	static uint64_t get_category_live_bytes(int p_category);
+	static uint64_t get_category_live_allocations(int p_category);
+	// Totals since startup, sample them twice to get allocation rates.
+	static uint64_t get_category_allocated_bytes(int p_category);
+	static uint64_t get_category_allocation_count(int p_category);
+};
+
+#ifdef MEMORY_TRACKING_ENABLED
+#define MEMORY_TRACKING_SCOPE(m_category) MemoryTracker::Scope _memory_tracking_scope(m_category)
+#else
+#define MEMORY_TRACKING_SCOPE(m_category)
+#endif
+
+#endif // MEMORY_TRACKER_H
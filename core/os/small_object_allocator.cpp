@@ -0,0 +1,324 @@
+/*************************************************************************/
+/*  small_object_allocator.cpp                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "small_object_allocator.h"
+
+#include "core/error/error_macros.h"
+#include "core/os/mutex.h"
+#include "core/templates/safe_refcount.h"
+
+#include <stdlib.h>
+#include <atomic>
+
+enum {
+	SPAN_SHIFT = 16,
+	// The span map covers 48-bit addresses.
+	SPAN_MAP_LEAF_BITS = 16,
+	SPAN_MAP_ROOT_BITS = 48 - SPAN_SHIFT - SPAN_MAP_LEAF_BITS,
+	SPANS_PER_REGION = 16,
+};
+
+static_assert((1 << SPAN_SHIFT) == SmallObjectAllocator::SPAN_SIZE, "SPAN_SHIFT doesn't match SPAN_SIZE.");
+
+// Steps of 16 bytes up to 128, of 32 bytes up to 256, and of 64 bytes up to 512.
+static const uint32_t size_class_block_sizes[SmallObjectAllocator::SIZE_CLASS_COUNT] = {
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256,
+	320, 384, 448, 512
+};
+
+static _FORCE_INLINE_ uint32_t _get_size_class(size_t p_bytes) {
+	if (p_bytes <= 128) {
+		return p_bytes == 0 ? 0 : (p_bytes - 1) / 16;
+	} else if (p_bytes <= 256) {
+		return 8 + (p_bytes - 129) / 32;
+	} else {
+		return 12 + (p_bytes - 257) / 64;
+	}
+}
+
+struct FreeBlock {
+	FreeBlock *next;
+};
+
+struct SizeClassPool {
+	BinaryMutex mutex;
+	FreeBlock *free_list = nullptr;
+	uint32_t free_count = 0;
+	SafeNumeric<int64_t> used_blocks;
+	SafeNumeric<uint64_t> reserved_blocks;
+};
+
+struct ThreadCache {
+	FreeBlock *free_lists[SmallObjectAllocator::SIZE_CLASS_COUNT];
+	uint32_t free_counts[SmallObjectAllocator::SIZE_CLASS_COUNT];
+	// Allocations minus frees not reported to the pools yet, frees of blocks from other threads can make it negative.
+	int64_t used_blocks[SmallObjectAllocator::SIZE_CLASS_COUNT];
+};
+
+bool SmallObjectAllocator::enabled = false;
+static uint32_t thread_cache_size = SmallObjectAllocator::DEFAULT_THREAD_CACHE_SIZE;
+
+static SizeClassPool pools[SmallObjectAllocator::SIZE_CLASS_COUNT];
+static thread_local ThreadCache thread_cache;
+
+// Threads that weren't started through Thread (drivers, thirdparty libraries) don't flush their cache
+// explicitly. Kept apart from the cache so the cache itself stays trivially destructible.
+struct ThreadCacheFlusher {
+	bool armed = false;
+
+	~ThreadCacheFlusher() {
+		if (armed) {
+			SmallObjectAllocator::flush_thread_cache();
+		}
+	}
+};
+
+static thread_local ThreadCacheFlusher thread_cache_flusher;
+
+// Size class + 1 of each span, indexed by address. Zero means the address doesn't belong to a span.
+static std::atomic<uint8_t *> span_map[1 << SPAN_MAP_ROOT_BITS];
+static BinaryMutex span_mutex;
+static uint8_t *region_next_span = nullptr;
+static uint32_t region_spans_left = 0;
+
+static _FORCE_INLINE_ uint8_t *_get_span_map_leaf(uintptr_t p_span_index) {
+	uintptr_t root_index = p_span_index >> SPAN_MAP_LEAF_BITS;
+	if (root_index >= ((uintptr_t)1 << SPAN_MAP_ROOT_BITS)) {
+		return nullptr;
+	}
+	return span_map[root_index].load(std::memory_order_acquire);
+}
+
+static _FORCE_INLINE_ uint32_t _get_span_size_class(const void *p_ptr) {
+	uintptr_t span_index = (uintptr_t)p_ptr >> SPAN_SHIFT;
+	return _get_span_map_leaf(span_index)[span_index & ((1 << SPAN_MAP_LEAF_BITS) - 1)] - 1;
+}
+
+// Failures are reported by Memory, printing errors from here could allocate while the pools are locked.
+static uint8_t *_allocate_span(uint32_t p_size_class) {
+	MutexLock lock(span_mutex);
+
+	if (region_spans_left == 0) {
+		// Spans must be aligned to their size to be found from the addresses of their blocks.
+		uint8_t *region = (uint8_t *)malloc(SmallObjectAllocator::SPAN_SIZE * (SPANS_PER_REGION + 1));
+		if (!region) {
+			return nullptr;
+		}
+
+		uintptr_t first_span = ((uintptr_t)region + SmallObjectAllocator::SPAN_SIZE - 1) & ~(uintptr_t)(SmallObjectAllocator::SPAN_SIZE - 1);
+		uintptr_t last_span_index = (first_span >> SPAN_SHIFT) + SPANS_PER_REGION - 1;
+		if ((last_span_index >> SPAN_MAP_LEAF_BITS) >= ((uintptr_t)1 << SPAN_MAP_ROOT_BITS)) {
+			// Outside of the range covered by the span map.
+			::free(region);
+			return nullptr;
+		}
+
+		region_next_span = (uint8_t *)first_span;
+		region_spans_left = SPANS_PER_REGION;
+	}
+
+	uintptr_t span_index = (uintptr_t)region_next_span >> SPAN_SHIFT;
+	uint8_t *leaf = _get_span_map_leaf(span_index);
+	if (!leaf) {
+		leaf = (uint8_t *)calloc(1 << SPAN_MAP_LEAF_BITS, 1);
+		if (!leaf) {
+			return nullptr;
+		}
+		span_map[span_index >> SPAN_MAP_LEAF_BITS].store(leaf, std::memory_order_release);
+	}
+	leaf[span_index & ((1 << SPAN_MAP_LEAF_BITS) - 1)] = p_size_class + 1;
+
+	uint8_t *span = region_next_span;
+	region_next_span += SmallObjectAllocator::SPAN_SIZE;
+	region_spans_left--;
+	return span;
+}
+
+static _FORCE_INLINE_ void _report_used_blocks(ThreadCache &r_cache, uint32_t p_size_class) {
+	if (r_cache.used_blocks[p_size_class] != 0) {
+		pools[p_size_class].used_blocks.add(r_cache.used_blocks[p_size_class]);
+		r_cache.used_blocks[p_size_class] = 0;
+	}
+}
+
+static FreeBlock *_refill_thread_cache(ThreadCache &r_cache, uint32_t p_size_class) {
+	// Only touched here, so the flusher is set up once a thread has blocks to give back.
+	thread_cache_flusher.armed = true;
+
+	SizeClassPool &pool = pools[p_size_class];
+	MutexLock lock(pool.mutex);
+
+	_report_used_blocks(r_cache, p_size_class);
+
+	if (pool.free_count == 0) {
+		uint8_t *span = _allocate_span(p_size_class);
+		if (!span) {
+			return nullptr;
+		}
+
+		uint32_t block_size = size_class_block_sizes[p_size_class];
+		uint32_t block_count = SmallObjectAllocator::SPAN_SIZE / block_size;
+		for (uint32_t i = block_count; i > 0; i--) {
+			FreeBlock *block = (FreeBlock *)(span + (i - 1) * block_size);
+			block->next = pool.free_list;
+			pool.free_list = block;
+		}
+		pool.free_count += block_count;
+		pool.reserved_blocks.add(block_count);
+	}
+
+	uint32_t count = MIN(pool.free_count, MAX(thread_cache_size / 2, 1u));
+	FreeBlock *first = pool.free_list;
+	FreeBlock *last = first;
+	for (uint32_t i = 1; i < count; i++) {
+		last = last->next;
+	}
+	pool.free_list = last->next;
+	pool.free_count -= count;
+
+	last->next = r_cache.free_lists[p_size_class];
+	r_cache.free_lists[p_size_class] = first;
+	r_cache.free_counts[p_size_class] += count;
+	return first;
+}
+
+static void _drain_thread_cache(ThreadCache &r_cache, uint32_t p_size_class, uint32_t p_count) {
+	SizeClassPool &pool = pools[p_size_class];
+
+	if (p_count == 0) {
+		MutexLock lock(pool.mutex);
+		_report_used_blocks(r_cache, p_size_class);
+		return;
+	}
+
+	FreeBlock *first = r_cache.free_lists[p_size_class];
+	FreeBlock *last = first;
+	for (uint32_t i = 1; i < p_count; i++) {
+		last = last->next;
+	}
+	r_cache.free_lists[p_size_class] = last->next;
+	r_cache.free_counts[p_size_class] -= p_count;
+
+	MutexLock lock(pool.mutex);
+	_report_used_blocks(r_cache, p_size_class);
+	last->next = pool.free_list;
+	pool.free_list = first;
+	pool.free_count += p_count;
+}
+
+void SmallObjectAllocator::configure(bool p_enabled, uint32_t p_thread_cache_size) {
+	thread_cache_size = p_thread_cache_size;
+	enabled = p_enabled;
+}
+
+void *SmallObjectAllocator::alloc(size_t p_bytes) {
+	uint32_t size_class = _get_size_class(p_bytes);
+	ThreadCache &cache = thread_cache;
+
+	FreeBlock *block = cache.free_lists[size_class];
+	if (unlikely(!block)) {
+		block = _refill_thread_cache(cache, size_class);
+		if (!block) {
+			return nullptr;
+		}
+	}
+
+	cache.free_lists[size_class] = block->next;
+	cache.free_counts[size_class]--;
+	cache.used_blocks[size_class]++;
+	return block;
+}
+
+void SmallObjectAllocator::free(void *p_ptr) {
+	uint32_t size_class = _get_span_size_class(p_ptr);
+	ThreadCache &cache = thread_cache;
+
+	FreeBlock *block = (FreeBlock *)p_ptr;
+	block->next = cache.free_lists[size_class];
+	cache.free_lists[size_class] = block;
+	cache.free_counts[size_class]++;
+	cache.used_blocks[size_class]--;
+
+	if (unlikely(cache.free_counts[size_class] > thread_cache_size)) {
+		// Keep half of the cache, so alternating frees and allocations don't go to the pool every time.
+		_drain_thread_cache(cache, size_class, cache.free_counts[size_class] - thread_cache_size / 2);
+	}
+}
+
+bool SmallObjectAllocator::owns(const void *p_ptr) {
+	uintptr_t span_index = (uintptr_t)p_ptr >> SPAN_SHIFT;
+	const uint8_t *leaf = _get_span_map_leaf(span_index);
+	return leaf && leaf[span_index & ((1 << SPAN_MAP_LEAF_BITS) - 1)] != 0;
+}
+
+size_t SmallObjectAllocator::get_block_size(const void *p_ptr) {
+	return size_class_block_sizes[_get_span_size_class(p_ptr)];
+}
+
+void SmallObjectAllocator::flush_thread_cache() {
+	ThreadCache &cache = thread_cache;
+	for (uint32_t i = 0; i < SIZE_CLASS_COUNT; i++) {
+		if (cache.free_counts[i] > 0 || cache.used_blocks[i] != 0) {
+			_drain_thread_cache(cache, i, cache.free_counts[i]);
+		}
+	}
+}
+
+uint32_t SmallObjectAllocator::get_size_class_block_size(int p_size_class) {
+	ERR_FAIL_INDEX_V(p_size_class, SIZE_CLASS_COUNT, 0);
+	return size_class_block_sizes[p_size_class];
+}
+
+uint64_t SmallObjectAllocator::get_size_class_used_blocks(int p_size_class) {
+	ERR_FAIL_INDEX_V(p_size_class, SIZE_CLASS_COUNT, 0);
+	return MAX(pools[p_size_class].used_blocks.get(), 0);
+}
+
+uint64_t SmallObjectAllocator::get_size_class_reserved_blocks(int p_size_class) {
+	ERR_FAIL_INDEX_V(p_size_class, SIZE_CLASS_COUNT, 0);
+	return pools[p_size_class].reserved_blocks.get();
+}
+
+uint64_t SmallObjectAllocator::get_used_bytes() {
+	uint64_t bytes = 0;
+	for (int i = 0; i < SIZE_CLASS_COUNT; i++) {
+		bytes += get_size_class_used_blocks(i) * size_class_block_sizes[i];
+	}
+	return bytes;
+}
+
+uint64_t SmallObjectAllocator::get_reserved_bytes() {
+	uint64_t bytes = 0;
+	for (int i = 0; i < SIZE_CLASS_COUNT; i++) {
+		bytes += get_size_class_reserved_blocks(i) * size_class_block_sizes[i];
+	}
+	return bytes;
+}
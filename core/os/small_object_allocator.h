@@ -0,0 +1,77 @@
+/*************************************************************************/
+/*  small_object_allocator.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SMALL_OBJECT_ALLOCATOR_H
+#define SMALL_OBJECT_ALLOCATOR_H
+
+#include "core/typedefs.h"
+
+#include <stddef.h>
+
+// Size-class slab allocator for the small blocks requested through Memory (memnew, memalloc, CowData...).
+// Each thread keeps a cache of free blocks per size class, so most allocations and frees don't need any
+// synchronization. Blocks are carved from spans that are never given back to the system.
+class SmallObjectAllocator {
+public:
+	enum {
+		MAX_SIZE = 512,
+		SIZE_CLASS_COUNT = 16,
+		SPAN_SIZE = 65536,
+		DEFAULT_THREAD_CACHE_SIZE = 64,
+	};
+
+private:
+	static bool enabled;
+
+public:
+	_FORCE_INLINE_ static bool is_enabled() { return enabled; }
+	static void configure(bool p_enabled, uint32_t p_thread_cache_size);
+
+	// Allocates a block of at least p_bytes, which must not be larger than MAX_SIZE.
+	static void *alloc(size_t p_bytes);
+	static void free(void *p_ptr);
+	// Whether p_ptr was returned by alloc(), even if the allocator was disabled since.
+	static bool owns(const void *p_ptr);
+	static size_t get_block_size(const void *p_ptr);
+
+	// Gives the blocks cached by the calling thread back. Thread calls it when its callback returns,
+	// other threads do it from a thread_local destructor as they exit. Blocks freed by destructors
+	// that run after that one stay in the exiting thread's cache.
+	static void flush_thread_cache();
+
+	// Stats are updated when threads exchange blocks with the shared pools, so they lag a little behind.
+	static uint32_t get_size_class_block_size(int p_size_class);
+	static uint64_t get_size_class_used_blocks(int p_size_class);
+	static uint64_t get_size_class_reserved_blocks(int p_size_class);
+	static uint64_t get_used_bytes();
+	static uint64_t get_reserved_bytes();
+};
+
+#endif // SMALL_OBJECT_ALLOCATOR_H
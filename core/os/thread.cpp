@@ -31,6 +31,7 @@
 #include "thread.h"
 
 #include "core/object/script_language.h"
+#include "core/os/small_object_allocator.h"
 
 #if !defined(NO_THREADS)
 
@@ -74,6 +75,7 @@ void Thread::callback(Thread *p_self, const Settings &p_settings, Callback p_cal
 	if (term_func) {
 		term_func();
 	}
+	SmallObjectAllocator::flush_thread_cache();
 }
 
 void Thread::start(Thread::Callback p_callback, void *p_user, const Settings &p_settings) {
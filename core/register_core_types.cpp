@@ -70,6 +70,7 @@
 #include "core/os/main_loop.h"
 #include "core/string/optimized_translation.h"
 #include "core/string/translation.h"
+#include "core/templates/job_scheduler.h"
 
 static Ref<ResourceFormatSaverBinary> resource_saver_binary;
 static Ref<ResourceFormatLoaderBinary> resource_loader_binary;
@@ -90,6 +91,8 @@ static _EngineDebugger *_engine_debugger = nullptr;
 
 static IP *ip = nullptr;
 
+static JobScheduler *job_scheduler = nullptr;
+
 static _Geometry2D *_geometry_2d = nullptr;
 static _Geometry3D *_geometry_3d = nullptr;
 
@@ -102,6 +105,9 @@ void register_core_types() {
 	//consistency check
 	static_assert(sizeof(Callable) <= 16);
 
+	job_scheduler = memnew(JobScheduler);
+	job_scheduler->init();
+
 	ObjectDB::setup();
 
 	StringName::setup();
@@ -326,4 +332,6 @@ void unregister_core_types() {
 	ResourceCache::clear();
 	CoreStringNames::free();
 	StringName::cleanup();
+
+	memdelete(job_scheduler);
 }
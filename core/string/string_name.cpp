@@ -33,20 +33,22 @@
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 
+#include <string.h>
+
 StaticCString StaticCString::create(const char *p_ptr) {
 	StaticCString scs;
 	scs.ptr = p_ptr;
 	return scs;
 }
 
-StringName::_Data *StringName::_table[STRING_TABLE_LEN];
+std::atomic<StringName::_Data *> StringName::_table[STRING_TABLE_LEN];
+StringName::_Shard StringName::_shards[STRING_TABLE_SHARD_COUNT];
 
 StringName _scs_create(const char *p_chr) {
 	return (p_chr[0] ? StringName(StaticCString::create(p_chr)) : StringName());
 }
 
 bool StringName::configured = false;
-Mutex StringName::mutex;
 
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
@@ -57,22 +59,29 @@ void StringName::setup() {
 }
 
 void StringName::cleanup() {
-	MutexLock lock(mutex);
-
 	int lost_strings = 0;
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		while (_table[i]) {
-			_Data *d = _table[i];
-			lost_strings++;
-			if (OS::get_singleton()->is_stdout_verbose()) {
-				if (d->cname) {
-					print_line("Orphan StringName: " + String(d->cname));
-				} else {
-					print_line("Orphan StringName: " + String(d->name));
+	for (int i = 0; i < STRING_TABLE_SHARD_COUNT; i++) {
+		MutexLock lock(_shards[i].mutex);
+
+		for (int j = i; j < STRING_TABLE_LEN; j += STRING_TABLE_SHARD_COUNT) {
+			_Data *d = _table[j];
+			while (d) {
+				_Data *next = d->next;
+				if (d->refcount.get() > 0) {
+					lost_strings++;
+					if (OS::get_singleton()->is_stdout_verbose()) {
+						print_line("Orphan StringName: " + d->get_name());
+					}
 				}
+				memdelete(d);
+				d = next;
 			}
+			_table[j] = nullptr;
+		}
 
-			_table[i] = _table[i]->next;
+		while (_shards[i].retired) {
+			_Data *d = _shards[i].retired;
+			_shards[i].retired = d->next_retired;
 			memdelete(d);
 		}
 	}
@@ -81,25 +90,122 @@ void StringName::cleanup() {
 	}
 }
 
-void StringName::unref() {
-	ERR_FAIL_COND(!configured);
+// Compares without building a String out of static names.
+static _FORCE_INLINE_ bool _name_equals(const char *p_cname, const String &p_name, const char *p_other) {
+	return p_cname ? strcmp(p_cname, p_other) == 0 : p_name == p_other;
+}
 
-	if (_data && _data->refcount.unref()) {
-		MutexLock lock(mutex);
+static _FORCE_INLINE_ bool _name_equals(const char *p_cname, const String &p_name, const char32_t *p_other) {
+	return p_cname ? String(p_cname) == p_other : p_name == p_other;
+}
 
-		if (_data->prev) {
-			_data->prev->next = _data->next;
-		} else {
-			if (_table[_data->idx] != _data) {
-				ERR_PRINT("BUG!");
-			}
-			_table[_data->idx] = _data->next;
+static _FORCE_INLINE_ bool _name_equals(const char *p_cname, const String &p_name, const String &p_other) {
+	return p_cname ? p_other == p_cname : p_name == p_other;
+}
+
+template <class T>
+StringName::_Data *StringName::_find(const T &p_name, uint32_t p_hash) {
+	uint32_t idx = p_hash & STRING_TABLE_MASK;
+	_Shard &shard = _shards[idx & STRING_TABLE_SHARD_MASK];
+
+	shard.readers.fetch_add(1);
+
+	_Data *data = _table[idx];
+	while (data) {
+		// Compare hash first. Dead entries fail to ref, a live one with the same name may follow.
+		if (data->hash == p_hash && _name_equals(data->cname, data->name, p_name) && data->refcount.ref()) {
+			break;
 		}
+		data = data->next;
+	}
+
+	shard.readers.fetch_sub(1);
+
+	return data;
+}
+
+template <class T>
+StringName::_Data *StringName::_intern(const T &p_name, uint32_t p_hash, const char *p_static_cname) {
+	_Data *data = _find(p_name, p_hash);
+	if (data) {
+		return data;
+	}
+
+	uint32_t idx = p_hash & STRING_TABLE_MASK;
+	uint32_t shard_idx = idx & STRING_TABLE_SHARD_MASK;
+	_Shard &shard = _shards[shard_idx];
+
+	MutexLock lock(shard.mutex);
+
+	// Another thread may have added it meanwhile.
+	data = _find(p_name, p_hash);
+	if (data) {
+		return data;
+	}
+
+	if (shard.dead_count.get() >= STRING_TABLE_SWEEP_THRESHOLD) {
+		_sweep_shard(shard_idx);
+	}
+	if (shard.retired) {
+		_free_retired(shard);
+	}
+
+	data = memnew(_Data);
+	if (p_static_cname) {
+		data->cname = p_static_cname;
+	} else {
+		data->name = p_name;
+	}
+	data->refcount.init();
+	data->hash = p_hash;
+	data->next = _table[idx].load();
+	_table[idx] = data;
 
-		if (_data->next) {
-			_data->next->prev = _data->prev;
+	return data;
+}
+
+void StringName::_sweep_shard(uint32_t p_shard) {
+	_Shard &shard = _shards[p_shard];
+	shard.dead_count.set(0);
+
+	for (uint32_t i = p_shard; i < STRING_TABLE_LEN; i += STRING_TABLE_SHARD_COUNT) {
+		std::atomic<_Data *> *link = &_table[i];
+		_Data *data = *link;
+		while (data) {
+			_Data *next = data->next;
+			if (data->refcount.get() == 0) {
+				// Lookups still walking this entry keep going through its next pointer, which stays valid.
+				*link = next;
+				data->next_retired = shard.retired;
+				shard.retired = data;
+			} else {
+				link = &data->next;
+			}
+			data = next;
 		}
-		memdelete(_data);
+	}
+}
+
+void StringName::_free_retired(_Shard &p_shard) {
+	// The readers count and the links are sequentially consistent, so seeing no readers after the
+	// entries were unlinked means no lookup can still reach them.
+	if (p_shard.readers.load() != 0) {
+		return; // Try again on the next insertion.
+	}
+
+	while (p_shard.retired) {
+		_Data *d = p_shard.retired;
+		p_shard.retired = d->next_retired;
+		memdelete(d);
+	}
+}
+
+void StringName::unref() {
+	ERR_FAIL_COND(!configured);
+
+	if (_data && _data->refcount.unref()) {
+		// The entry stays in the table until the next insertion in its shard unlinks it.
+		_shards[_data->hash & STRING_TABLE_MASK & STRING_TABLE_SHARD_MASK].dead_count.increment();
 	}
 
 	_data = nullptr;
@@ -162,41 +268,7 @@ StringName::StringName(const char *p_name) {
 		return; //empty, ignore
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			return;
-		}
-	}
-
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_data = _intern(p_name, String::hash(p_name), nullptr);
 }
 
 StringName::StringName(const StaticCString &p_static_string) {
@@ -206,41 +278,7 @@ StringName::StringName(const StaticCString &p_static_string) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_static_string.ptr);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_static_string.ptr) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			return;
-		}
-	}
-
-	_data = memnew(_Data);
-
-	_data->refcount.init();
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_data = _intern(p_static_string.ptr, String::hash(p_static_string.ptr), p_static_string.ptr);
 }
 
 StringName::StringName(const String &p_name) {
@@ -252,39 +290,7 @@ StringName::StringName(const String &p_name) {
 		return;
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = p_name.hash();
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			return;
-		}
-	}
-
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_data = _intern(p_name, p_name.hash(), nullptr);
 }
 
 StringName StringName::search(const char *p_name) {
@@ -295,23 +301,9 @@ StringName StringName::search(const char *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		return StringName(_data);
+	_Data *data = _find(p_name, String::hash(p_name));
+	if (data) {
+		return StringName(data);
 	}
 
 	return StringName(); //does not exist
@@ -325,24 +317,9 @@ StringName StringName::search(const char32_t *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		return StringName(_data);
+	_Data *data = _find(p_name, String::hash(p_name));
+	if (data) {
+		return StringName(data);
 	}
 
 	return StringName(); //does not exist
@@ -351,24 +328,9 @@ StringName StringName::search(const char32_t *p_name) {
 StringName StringName::search(const String &p_name) {
 	ERR_FAIL_COND_V(p_name == "", StringName());
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = p_name.hash();
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && p_name == _data->get_name()) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		return StringName(_data);
+	_Data *data = _find(p_name, p_name.hash());
+	if (data) {
+		return StringName(data);
 	}
 
 	return StringName(); //does not exist
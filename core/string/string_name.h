@@ -44,9 +44,14 @@ struct StaticCString {
 
 class StringName {
 	enum {
-		STRING_TABLE_BITS = 12,
+		STRING_TABLE_BITS = 14,
 		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MASK = STRING_TABLE_LEN - 1,
+		STRING_TABLE_SHARD_BITS = 6,
+		STRING_TABLE_SHARD_COUNT = 1 << STRING_TABLE_SHARD_BITS,
+		STRING_TABLE_SHARD_MASK = STRING_TABLE_SHARD_COUNT - 1,
+		// Dead entries in a shard before they are unlinked, one per bucket keeps sweeping cheap.
+		STRING_TABLE_SWEEP_THRESHOLD = STRING_TABLE_LEN / STRING_TABLE_SHARD_COUNT,
 	};
 
 	struct _Data {
@@ -55,14 +60,24 @@ class StringName {
 		String name;
 
 		String get_name() const { return cname ? String(cname) : name; }
-		int idx = 0;
 		uint32_t hash = 0;
-		_Data *prev = nullptr;
-		_Data *next = nullptr;
+		std::atomic<_Data *> next = { nullptr };
+		_Data *next_retired = nullptr;
 		_Data() {}
 	};
 
-	static _Data *_table[STRING_TABLE_LEN];
+	// Lookups walk the buckets without locking. Entries are never revived once their refcount drops
+	// to zero, so releasing is just an atomic decrement. Dead entries are unlinked in batches by insertions
+	// in their shard, and freed once no lookup in that shard is running anymore.
+	struct _Shard {
+		BinaryMutex mutex; // Serializes insertions and unlinking.
+		std::atomic<uint32_t> readers = { 0 }; // Sequentially consistent, see _free_retired().
+		SafeNumeric<uint32_t> dead_count;
+		_Data *retired = nullptr;
+	};
+
+	static std::atomic<_Data *> _table[STRING_TABLE_LEN];
+	static _Shard _shards[STRING_TABLE_SHARD_COUNT];
 
 	_Data *_data = nullptr;
 
@@ -71,11 +86,17 @@ class StringName {
 		uint32_t hash;
 	};
 
+	template <class T>
+	static _Data *_find(const T &p_name, uint32_t p_hash);
+	template <class T>
+	static _Data *_intern(const T &p_name, uint32_t p_hash, const char *p_static_cname);
+	static void _sweep_shard(uint32_t p_shard);
+	static void _free_retired(_Shard &p_shard);
+
 	void unref();
 	friend void register_core_types();
 	friend void unregister_core_types();
 	friend class Main;
-	static Mutex mutex;
 	static void setup();
 	static void cleanup();
 	static bool configured;
@@ -32,9 +32,59 @@
 
 #include "core/config/project_settings.h"
 #include "core/os/os.h"
+#include "core/templates/local_vector.h"
+
+#include <thread>
+
+// Threads pushing to a lock-free queue remember which producer they use in it, the queue
+// is identified by its serial so a new queue at the same address doesn't match.
+struct CommandQueueMTProducerCache {
+	uint64_t queue_serial = 0;
+	uint32_t producer_index = 0;
+};
+
+static SafeNumeric<uint64_t> last_queue_serial;
+static SafeNumeric<uint64_t> last_producer_token;
+static thread_local uint64_t producer_token = 0;
+static thread_local CommandQueueMTProducerCache producer_cache;
+
+// Lock-free queues alive, so exiting threads only give slots back to queues that still exist.
+static Mutex lock_free_queues_mutex;
+static LocalVector<CommandQueueMT *> lock_free_queues;
+
+// Producer slots claimed by a thread, given back when it exits. Otherwise short-lived threads
+// (e.g. import or worker threads) would use up the slots and leave everyone on the shared one.
+struct CommandQueueMTProducerClaims {
+	struct Claim {
+		CommandQueueMT *queue = nullptr;
+		uint64_t serial = 0;
+		uint32_t index = 0;
+	};
+
+	LocalVector<Claim> claims;
+
+	~CommandQueueMTProducerClaims() {
+		if (claims.is_empty()) {
+			return;
+		}
+
+		MutexLock lock(lock_free_queues_mutex);
+		for (uint32_t i = 0; i < claims.size(); i++) {
+			const Claim &claim = claims[i];
+			if (lock_free_queues.find(claim.queue) != -1 && claim.queue->serial == claim.serial) {
+				claim.queue->_release_producer(claim.index);
+			}
+		}
+	}
+};
+
+static thread_local CommandQueueMTProducerClaims producer_claims;
 
 void CommandQueueMT::lock() {
-	mutex.lock();
+	if (mutex.try_lock() != OK) {
+		contention_count.increment();
+		mutex.lock();
+	}
 }
 
 void CommandQueueMT::unlock() {
@@ -61,6 +111,7 @@ CommandQueueMT::SyncSemaphore *CommandQueueMT::_alloc_sync_sem() {
 		unlock();
 
 		if (idx == -1) {
+			contention_count.increment();
 			wait_for_flush();
 		} else {
 			break;
@@ -94,19 +145,318 @@ tryagain:
 	return true;
 }
 
-CommandQueueMT::CommandQueueMT(bool p_sync) {
+CommandQueueMT::Producer *CommandQueueMT::_lock_producer() {
+	if (producer_cache.queue_serial == serial) {
+		if (producer_cache.producer_index < MAX_PRODUCERS) {
+			return &producers[producer_cache.producer_index];
+		}
+		overflow_mutex.lock();
+		return &overflow_producer;
+	}
+
+	if (producer_token == 0) {
+		producer_token = last_producer_token.increment();
+	}
+
+	uint32_t producer_index = MAX_PRODUCERS;
+	uint32_t count = MIN(producer_count.get(), (uint32_t)MAX_PRODUCERS);
+	for (uint32_t i = 0; i < count; i++) {
+		if (producers[i].owner.load(std::memory_order_relaxed) == producer_token) {
+			producer_index = i;
+			break;
+		}
+	}
+
+	const bool claiming = producer_index == MAX_PRODUCERS;
+	while (producer_index == MAX_PRODUCERS) {
+		// First push from this thread, take a slot given back by a thread that exited, or a new one.
+		count = MIN(producer_count.get(), (uint32_t)MAX_PRODUCERS);
+		for (uint32_t i = 0; i < count && producer_index == MAX_PRODUCERS; i++) {
+			uint64_t expected = 0;
+			if (producers[i].owner.load(std::memory_order_relaxed) == 0 && producers[i].owner.compare_exchange_strong(expected, producer_token, std::memory_order_acquire)) {
+				producer_index = i;
+			}
+		}
+		if (producer_index != MAX_PRODUCERS || count == MAX_PRODUCERS) {
+			break;
+		}
+
+		uint32_t new_index = producer_count.postincrement();
+		if (new_index >= MAX_PRODUCERS) {
+			break;
+		}
+		uint64_t expected = 0;
+		if (producers[new_index].owner.compare_exchange_strong(expected, producer_token, std::memory_order_acquire)) {
+			producer_index = new_index;
+		}
+		// Otherwise another thread took it while looking for free slots, look again.
+	}
+
+	if (claiming && producer_index < MAX_PRODUCERS) {
+		CommandQueueMTProducerClaims::Claim claim;
+		claim.queue = this;
+		claim.serial = serial;
+		claim.index = producer_index;
+		producer_claims.claims.push_back(claim);
+	}
+
+	producer_cache.queue_serial = serial;
+	producer_cache.producer_index = MIN(producer_index, (uint32_t)MAX_PRODUCERS);
+
+	if (producer_index < MAX_PRODUCERS) {
+		return &producers[producer_index];
+	}
+
+	// Too many threads, the remaining ones share a producer.
+	if (overflow_mutex.try_lock() != OK) {
+		contention_count.increment();
+		overflow_mutex.lock();
+	}
+	return &overflow_producer;
+}
+
+void CommandQueueMT::_unlock_producer(Producer *p_producer) {
+	if (p_producer == &overflow_producer) {
+		overflow_mutex.unlock();
+	}
+}
+
+void CommandQueueMT::_release_producer(uint32_t p_index) {
+	// Called by the owning thread as it exits. Its staged commands stay in the list until flushed,
+	// they only need the block, not the producer.
+	Producer *producer = &producers[p_index];
+	if (producer->batch_first) {
+		_publish_batch(producer);
+	}
+	producer->batch_depth = 0;
+	if (producer->block) {
+		_release_block(producer->block);
+		producer->block = nullptr;
+	}
+	producer->owner.store(0, std::memory_order_release);
+}
+
+uint8_t *CommandQueueMT::_stage_lock_free(uint32_t p_size) {
+	CRASH_COND_MSG(p_size > STAGING_BLOCK_SIZE, "Command too big for the command queue.");
+
+	Producer *producer = _lock_producer();
+	StagingBlock *block = producer->block;
+
+	if (!block || block->used + p_size > STAGING_BLOCK_SIZE) {
+		if (block) {
+			_release_block(block);
+		}
+
+		block_mutex.lock();
+		// Commands of an unfinished batch can't be flushed, waiting would never end then.
+		while (!free_blocks && allocated_block_count >= max_block_count && !producer->batch_first) {
+			block_mutex.unlock();
+			contention_count.increment();
+			wait_for_flush();
+			block_mutex.lock();
+		}
+		block = free_blocks;
+		if (block) {
+			free_blocks = block->next_free;
+		} else {
+			block = memnew_placement(memalloc(sizeof(StagingBlock)), StagingBlock);
+			block->next_allocated = allocated_blocks;
+			allocated_blocks = block;
+			allocated_block_count++;
+		}
+		block_mutex.unlock();
+
+		block->refs.set(1);
+		block->used = 0;
+		block->producer = producer;
+		block->next_free = nullptr;
+		producer->block = block;
+	}
+
+	uint8_t *mem = &block->data[block->used];
+	block->used += p_size;
+	block->refs.add(2);
+
+	CommandNode *node = reinterpret_cast<CommandNode *>(mem);
+	node->next.store(nullptr, std::memory_order_relaxed);
+	node->block = block;
+
+	// Stays locked until the command is committed, if it's the shared producer.
+	return mem;
+}
+
+void CommandQueueMT::_commit_lock_free(CommandBase *p_cmd, bool p_sync_command) {
+	CommandNode *node = reinterpret_cast<CommandNode *>(reinterpret_cast<uint8_t *>(p_cmd) - COMMAND_NODE_SIZE);
+	Producer *producer = node->block->producer;
+
+	if (producer->batch_last) {
+		producer->batch_last->next.store(node, std::memory_order_relaxed);
+	} else {
+		producer->batch_first = node;
+	}
+	producer->batch_last = node;
+	producer->batch_count++;
+	producer->pushed.increment();
+
+	if (producer->batch_depth == 0 || p_sync_command) {
+		_publish_batch(producer);
+	}
+
+	_unlock_producer(producer);
+}
+
+void CommandQueueMT::_publish_batch(Producer *p_producer) {
+	CommandNode *prev = tail.exchange(p_producer->batch_last, std::memory_order_acq_rel);
+	// Until this store, the consumer sees the list as non-empty but can't reach the batch.
+	prev->next.store(p_producer->batch_first, std::memory_order_release);
+
+	if (sync) {
+		for (uint32_t i = 0; i < p_producer->batch_count; i++) {
+			sync->post();
+		}
+	}
+
+	p_producer->batch_first = nullptr;
+	p_producer->batch_last = nullptr;
+	p_producer->batch_count = 0;
+}
+
+bool CommandQueueMT::_flush_one_lock_free() {
+	CommandNode *next = head->next.load(std::memory_order_acquire);
+
+	if (!next) {
+		if (tail.load(std::memory_order_acquire) == head) {
+			return false;
+		}
+
+		// A producer is between exchanging the tail and linking its batch, it won't take long.
+		contention_count.increment();
+		while (!(next = head->next.load(std::memory_order_acquire))) {
+			std::this_thread::yield();
+		}
+	}
+
+	CommandNode *prev = head;
+	head = next;
+	if (prev != &head_stub) {
+		_release_block(prev->block);
+	}
+
+	// Calling may flush the queue again (from the same thread), so the head is advanced first.
+	CommandBase *cmd = reinterpret_cast<CommandBase *>(reinterpret_cast<uint8_t *>(next) + COMMAND_NODE_SIZE);
+	cmd->call();
+	cmd->post();
+	cmd->~CommandBase();
+	commands_flushed.increment();
+
+	_release_block(next->block);
+	return true;
+}
+
+void CommandQueueMT::_release_block(StagingBlock *p_block) {
+	if (p_block->refs.decrement() > 0) {
+		return;
+	}
+
+	block_mutex.lock();
+	p_block->next_free = free_blocks;
+	free_blocks = p_block;
+	block_mutex.unlock();
+}
+
+void CommandQueueMT::_update_peak_pending_commands() {
+	uint32_t pending = get_pending_command_count();
+	if (pending > peak_pending_commands.get()) {
+		peak_pending_commands.set(pending);
+	}
+}
+
+void CommandQueueMT::begin_batch() {
+	if (!lock_free) {
+		return;
+	}
+
+	Producer *producer = _lock_producer();
+	if (producer != &overflow_producer) {
+		producer->batch_depth++;
+	}
+	_unlock_producer(producer);
+}
+
+void CommandQueueMT::end_batch() {
+	if (!lock_free) {
+		return;
+	}
+
+	Producer *producer = _lock_producer();
+	if (producer != &overflow_producer) {
+		ERR_FAIL_COND_MSG(producer->batch_depth == 0, "end_batch() called without begin_batch().");
+		producer->batch_depth--;
+		if (producer->batch_depth == 0 && producer->batch_first) {
+			_publish_batch(producer);
+		}
+	}
+	_unlock_producer(producer);
+}
+
+uint32_t CommandQueueMT::get_pending_command_count() const {
+	// Read before the pushed counts, so it can't be ahead of them.
+	uint64_t flushed = commands_flushed.get();
+
+	uint64_t pushed = commands_pushed.get() + overflow_producer.pushed.get();
+	uint32_t count = MIN(producer_count.get(), (uint32_t)MAX_PRODUCERS);
+	for (uint32_t i = 0; i < count; i++) {
+		pushed += producers[i].pushed.get();
+	}
+
+	return pushed - flushed;
+}
+
+CommandQueueMT::CommandQueueMT(bool p_sync, Mode p_mode) {
 	command_mem_size = GLOBAL_DEF_RST("memory/limits/command_queue/multithreading_queue_size_kb", DEFAULT_COMMAND_MEM_SIZE_KB);
 	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/command_queue/multithreading_queue_size_kb", PropertyInfo(Variant::INT, "memory/limits/command_queue/multithreading_queue_size_kb", PROPERTY_HINT_RANGE, "1,4096,1,or_greater"));
 	command_mem_size *= 1024;
-	command_mem = (uint8_t *)memalloc(command_mem_size);
+
+	bool lock_free_setting = GLOBAL_DEF_RST("memory/limits/command_queue/lock_free", false);
+	lock_free = p_mode == MODE_PROJECT_SETTING ? lock_free_setting : p_mode == MODE_LOCK_FREE;
+
+	if (lock_free) {
+		serial = last_queue_serial.increment();
+		// Every producer may hold a block and the head of the list may pin one more, they must not be left waiting.
+		max_block_count = MAX(command_mem_size / STAGING_BLOCK_SIZE, (uint32_t)MAX_PRODUCERS + 2);
+		MutexLock lock(lock_free_queues_mutex);
+		lock_free_queues.push_back(this);
+		head_stub.next.store(nullptr, std::memory_order_relaxed);
+		head_stub.block = nullptr;
+		head = &head_stub;
+		tail.store(&head_stub, std::memory_order_relaxed);
+	} else {
+		command_mem = (uint8_t *)memalloc(command_mem_size);
+	}
+
 	if (p_sync) {
 		sync = memnew(Semaphore);
 	}
 }
 
 CommandQueueMT::~CommandQueueMT() {
+	if (lock_free) {
+		MutexLock lock(lock_free_queues_mutex);
+		lock_free_queues.erase(this);
+	}
+
 	if (sync) {
 		memdelete(sync);
 	}
-	memfree(command_mem);
+	if (command_mem) {
+		memfree(command_mem);
+	}
+
+	StagingBlock *block = allocated_blocks;
+	while (block) {
+		StagingBlock *next = block->next_allocated;
+		block->~StagingBlock();
+		memfree(block);
+		block = next;
+	}
 }
@@ -34,9 +34,12 @@
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
 #include "core/os/semaphore.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/simple_type.h"
 #include "core/typedefs.h"
 
+#include <atomic>
+
 #define COMMA(N) _COMMA_##N
 #define _COMMA_0
 #define _COMMA_1 ,
@@ -252,9 +255,7 @@
 		cmd->instance = p_instance;                                          \
 		cmd->method = p_method;                                              \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                 \
-		unlock();                                                            \
-		if (sync)                                                            \
-			sync->post();                                                    \
+		commit_and_unlock(cmd);                                              \
 	}
 
 #define CMD_RET_TYPE(N) CommandRet##N<T, M, COMMA_SEP_LIST(TYPE_ARG, N) COMMA(N) R>
@@ -269,9 +270,7 @@
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                                   \
 		cmd->ret = r_ret;                                                                      \
 		cmd->sync_sem = ss;                                                                    \
-		unlock();                                                                              \
-		if (sync)                                                                              \
-			sync->post();                                                                      \
+		commit_and_unlock(cmd, true);                                                          \
 		ss->sem.wait();                                                                        \
 		ss->in_use = false;                                                                    \
 	}
@@ -287,9 +286,7 @@
 		cmd->method = p_method;                                                       \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                          \
 		cmd->sync_sem = ss;                                                           \
-		unlock();                                                                     \
-		if (sync)                                                                     \
-			sync->post();                                                             \
+		commit_and_unlock(cmd, true);                                                 \
 		ss->sem.wait();                                                               \
 		ss->in_use = false;                                                           \
 	}
@@ -297,6 +294,8 @@
 #define MAX_CMD_PARAMS 15
 
 class CommandQueueMT {
+	friend struct CommandQueueMTProducerClaims;
+
 	struct SyncSemaphore {
 		Semaphore sem;
 		bool in_use = false;
@@ -329,9 +328,19 @@ class CommandQueueMT {
 
 	/***** BASE *******/
 
+public:
+	enum Mode {
+		MODE_PROJECT_SETTING,
+		MODE_LOCKED,
+		MODE_LOCK_FREE,
+	};
+
+private:
 	enum {
 		DEFAULT_COMMAND_MEM_SIZE_KB = 256,
-		SYNC_SEMAPHORES = 8
+		SYNC_SEMAPHORES = 8,
+		STAGING_BLOCK_SIZE = 16384,
+		MAX_PRODUCERS = 32
 	};
 
 	uint8_t *command_mem = nullptr;
@@ -343,6 +352,72 @@ class CommandQueueMT {
 	Mutex mutex;
 	Semaphore *sync = nullptr;
 
+	/***** LOCK-FREE *******/
+
+	// In lock-free mode, each thread pushing commands (producer) stages them in a block of its own,
+	// then appends them to a singly linked list by exchanging the tail, so producers never wait on
+	// each other. The flushing thread (consumer, there must be only one) walks the list from the head.
+
+	struct StagingBlock;
+	struct Producer;
+
+	struct CommandNode {
+		std::atomic<CommandNode *> next;
+		StagingBlock *block;
+	};
+
+	enum {
+		COMMAND_NODE_SIZE = (sizeof(CommandNode) + 8 - 1) & ~(8 - 1)
+	};
+
+	struct StagingBlock {
+		// Each staged command holds two references, one until it's called and one until it stops
+		// being the head of the list. The producer holds one while it stages commands into it.
+		SafeNumeric<uint32_t> refs;
+		uint32_t used = 0;
+		Producer *producer = nullptr;
+		StagingBlock *next_free = nullptr;
+		StagingBlock *next_allocated = nullptr;
+		alignas(8) uint8_t data[STAGING_BLOCK_SIZE];
+	};
+
+	struct Producer {
+		std::atomic<uint64_t> owner = { 0 }; // Token of the thread using it, 0 while free.
+		SafeNumeric<uint64_t> pushed;
+		StagingBlock *block = nullptr;
+		// Commands staged but not appended to the list yet.
+		CommandNode *batch_first = nullptr;
+		CommandNode *batch_last = nullptr;
+		uint32_t batch_count = 0;
+		uint32_t batch_depth = 0;
+	};
+
+	bool lock_free = false;
+	uint64_t serial = 0;
+	Producer producers[MAX_PRODUCERS];
+	SafeNumeric<uint32_t> producer_count;
+	// Shared by the threads that didn't get a producer of their own.
+	Producer overflow_producer;
+	Mutex overflow_mutex;
+
+	CommandNode head_stub;
+	CommandNode *head = nullptr;
+	std::atomic<CommandNode *> tail;
+
+	Mutex block_mutex;
+	StagingBlock *free_blocks = nullptr;
+	StagingBlock *allocated_blocks = nullptr;
+	uint32_t allocated_block_count = 0;
+	// Producers wait for a flush instead of allocating past this, like the locked queue does when full.
+	uint32_t max_block_count = 0;
+
+	/***** STATS *******/
+
+	SafeNumeric<uint64_t> commands_pushed; // Locked mode only, producers count their own.
+	SafeNumeric<uint64_t> commands_flushed;
+	SafeNumeric<uint32_t> peak_pending_commands;
+	SafeNumeric<uint64_t> contention_count;
+
 	template <class T>
 	T *allocate() {
 		// alloc size is size+T+safeguard
@@ -409,6 +484,11 @@ class CommandQueueMT {
 
 	template <class T>
 	T *allocate_and_lock() {
+		if (lock_free) {
+			uint8_t *mem = _stage_lock_free(COMMAND_NODE_SIZE + ((sizeof(T) + 8 - 1) & ~(8 - 1)));
+			return memnew_placement(mem + COMMAND_NODE_SIZE, T);
+		}
+
 		lock();
 		T *ret;
 
@@ -422,7 +502,24 @@ class CommandQueueMT {
 		return ret;
 	}
 
+	void commit_and_unlock(CommandBase *p_cmd, bool p_sync_command = false) {
+		if (lock_free) {
+			_commit_lock_free(p_cmd, p_sync_command);
+			return;
+		}
+
+		commands_pushed.increment();
+		unlock();
+		if (sync) {
+			sync->post();
+		}
+	}
+
 	bool flush_one(bool p_lock = true) {
+		if (lock_free) {
+			return _flush_one_lock_free();
+		}
+
 		if (p_lock) {
 			lock();
 		}
@@ -466,6 +563,7 @@ class CommandQueueMT {
 		cmd->post();
 		cmd->~CommandBase();
 		*(uint32_t *)&command_mem[size_ptr] &= ~1;
+		commands_flushed.increment();
 
 		if (p_lock) {
 			unlock();
@@ -479,6 +577,16 @@ class CommandQueueMT {
 	SyncSemaphore *_alloc_sync_sem();
 	bool dealloc_one();
 
+	Producer *_lock_producer();
+	void _unlock_producer(Producer *p_producer);
+	void _release_producer(uint32_t p_index);
+	uint8_t *_stage_lock_free(uint32_t p_size);
+	void _commit_lock_free(CommandBase *p_cmd, bool p_sync_command);
+	void _publish_batch(Producer *p_producer);
+	bool _flush_one_lock_free();
+	void _release_block(StagingBlock *p_block);
+	void _update_peak_pending_commands();
+
 public:
 	/* NORMAL PUSH COMMANDS */
 	DECL_PUSH(0)
@@ -499,19 +607,48 @@ public:
 	}
 
 	_FORCE_INLINE_ void flush_if_pending() {
+		if (lock_free) {
+			// The tail only moves past the head when something was pushed.
+			if (unlikely(tail.load(std::memory_order_acquire) != head)) {
+				flush_all();
+			}
+			return;
+		}
+
 		if (unlikely(read_ptr_and_epoch != write_ptr_and_epoch)) {
 			flush_all();
 		}
 	}
 	void flush_all() {
 		//ERR_FAIL_COND(sync);
+		_update_peak_pending_commands();
+
+		if (lock_free) {
+			while (_flush_one_lock_free()) {
+			}
+			return;
+		}
+
 		lock();
 		while (flush_one(false)) {
 		}
 		unlock();
 	}
 
-	CommandQueueMT(bool p_sync);
+	// In lock-free mode, the commands a thread pushes between begin_batch() and end_batch() are
+	// appended to the queue at once, when the batch ends. Commands that wait for the flushing
+	// thread (push_and_sync(), push_and_ret()) end the batch early. In locked mode, this does nothing.
+	void begin_batch();
+	void end_batch();
+
+	bool is_lock_free() const { return lock_free; }
+
+	uint32_t get_pending_command_count() const;
+	uint32_t get_peak_pending_command_count() const { return peak_pending_commands.get(); }
+	// Times a thread had to wait for another one to access the queue.
+	uint64_t get_contention_count() const { return contention_count.get(); }
+
+	CommandQueueMT(bool p_sync, Mode p_mode = MODE_PROJECT_SETTING);
 	~CommandQueueMT();
 };
 
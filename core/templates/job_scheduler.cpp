@@ -0,0 +1,336 @@
+/*************************************************************************/
+/*  job_scheduler.cpp                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "job_scheduler.h"
+
+#include "core/os/os.h"
+
+#if !defined(NO_THREADS)
+#include <thread>
+#endif
+
+JobScheduler *JobScheduler::singleton = nullptr;
+thread_local int JobScheduler::current_worker = -1;
+
+bool JobScheduler::Deque::push(Job *p_job) {
+	int64_t b = bottom.load(std::memory_order_relaxed);
+	int64_t t = top.load(std::memory_order_acquire);
+	if (b - t >= DEQUE_SIZE) {
+		return false; // Full, caller runs the job inline.
+	}
+	jobs[b & (DEQUE_SIZE - 1)].store(p_job, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	bottom.store(b + 1, std::memory_order_relaxed);
+	return true;
+}
+
+JobScheduler::Job *JobScheduler::Deque::pop() {
+	int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+	bottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t t = top.load(std::memory_order_relaxed);
+
+	if (t > b) {
+		// Empty.
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Job *job = jobs[b & (DEQUE_SIZE - 1)].load(std::memory_order_relaxed);
+	if (t == b) {
+		// Last job, race against thieves for it.
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			job = nullptr;
+		}
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+	return job;
+}
+
+JobScheduler::Job *JobScheduler::Deque::steal() {
+	int64_t t = top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t b = bottom.load(std::memory_order_acquire);
+
+	if (t >= b) {
+		return nullptr;
+	}
+
+	Job *job = jobs[t & (DEQUE_SIZE - 1)].load(std::memory_order_relaxed);
+	if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+		return nullptr; // Lost the race, try elsewhere.
+	}
+	return job;
+}
+
+bool JobScheduler::_push(Job *p_job) {
+	if (worker_count == 0) {
+		return false; // Nobody to run it, caller runs the job inline.
+	}
+	if (current_worker >= 0) {
+		return workers[current_worker].deque.push(p_job);
+	}
+
+	MutexLock lock(injection_mutex);
+	if (injection_write - injection_read >= INJECTION_QUEUE_SIZE) {
+		return false;
+	}
+	injection_queue[injection_write & (INJECTION_QUEUE_SIZE - 1)] = p_job;
+	injection_write++;
+	injection_count.increment();
+	return true;
+}
+
+JobScheduler::Job *JobScheduler::_pop_injected() {
+	if (injection_count.get() == 0) {
+		return nullptr;
+	}
+
+	MutexLock lock(injection_mutex);
+	if (injection_read == injection_write) {
+		return nullptr;
+	}
+	Job *job = injection_queue[injection_read & (INJECTION_QUEUE_SIZE - 1)];
+	injection_read++;
+	injection_count.decrement();
+	return job;
+}
+
+JobScheduler::Job *JobScheduler::_find_job(uint32_t &r_seed) {
+	Job *job = nullptr;
+	if (current_worker >= 0) {
+		job = workers[current_worker].deque.pop();
+		if (job) {
+			return job;
+		}
+	}
+
+	job = _pop_injected();
+	if (job) {
+		return job;
+	}
+
+	if (worker_count == 0) {
+		return nullptr;
+	}
+
+	// Xorshift, so thieves do not all hammer the same victim.
+	r_seed ^= r_seed << 13;
+	r_seed ^= r_seed >> 17;
+	r_seed ^= r_seed << 5;
+
+	uint32_t from = r_seed % worker_count;
+	for (uint32_t i = 0; i < worker_count; i++) {
+		uint32_t victim = (from + i) % worker_count;
+		if (int(victim) == current_worker) {
+			continue;
+		}
+		job = workers[victim].deque.steal();
+		if (job) {
+			return job;
+		}
+	}
+
+	return nullptr;
+}
+
+void JobScheduler::_wake_workers(uint32_t p_amount) {
+	// Pairs with the fence in _worker_function, either the worker sees the new jobs or we see it sleeping.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	uint32_t to_wake = MIN(p_amount, sleeping.get());
+	for (uint32_t i = 0; i < to_wake; i++) {
+		wakeup.post();
+	}
+}
+
+void JobScheduler::_finish(Counter *p_counter) {
+	if (!p_counter || p_counter->pending.decrement() != 0) {
+		return;
+	}
+
+	// Closing the counter is the last access to it, the owner may reuse it right after.
+	Job *held = p_counter->waiting.exchange(Counter::_closed(), std::memory_order_acq_rel);
+
+	uint32_t pushed = 0;
+	while (held) {
+		Job *next = held->next_waiting;
+		held->next_waiting = nullptr;
+		if (_push(held)) {
+			pushed++;
+		} else {
+			_execute(held);
+		}
+		held = next;
+	}
+	_wake_workers(pushed);
+}
+
+void JobScheduler::_execute(Job *p_job) {
+	Counter *counter = p_job->counter;
+	p_job->execute();
+	_finish(counter);
+}
+
+void JobScheduler::submit(Job **p_jobs, uint32_t p_count, Counter *p_after) {
+	uint32_t pushed = 0;
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		Job *job = p_jobs[i];
+
+		if (p_after) {
+			Job *head = p_after->waiting.load(std::memory_order_acquire);
+			bool held = false;
+			while (head != Counter::_closed()) {
+				job->next_waiting = head;
+				if (p_after->waiting.compare_exchange_weak(head, job, std::memory_order_release, std::memory_order_acquire)) {
+					held = true;
+					break;
+				}
+			}
+			if (held) {
+				continue;
+			}
+			job->next_waiting = nullptr;
+		}
+
+		if (_push(job)) {
+			pushed++;
+		} else {
+			_execute(job);
+		}
+	}
+
+	_wake_workers(pushed);
+}
+
+void JobScheduler::wait(const Counter *p_counter) {
+	uint32_t seed = current_worker >= 0 ? current_worker + 1 : uint32_t(Thread::get_caller_id()) | 1;
+
+	while (!p_counter->is_done()) {
+		Job *job = _find_job(seed);
+		if (job) {
+			_execute(job);
+		} else {
+#if !defined(NO_THREADS)
+			std::this_thread::yield();
+#endif
+		}
+	}
+}
+
+void JobScheduler::_worker_function(void *p_user) {
+	Worker *worker = static_cast<Worker *>(p_user);
+	JobScheduler *scheduler = singleton;
+	current_worker = worker->index;
+
+	while (true) {
+		Job *job = nullptr;
+		for (int i = 0; i < SPIN_ROUNDS && !job; i++) {
+			job = scheduler->_find_job(worker->steal_seed);
+		}
+
+		if (!job) {
+			if (scheduler->exit.is_set()) {
+				break;
+			}
+
+			scheduler->sleeping.increment();
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			job = scheduler->_find_job(worker->steal_seed);
+			if (!job && !scheduler->exit.is_set()) {
+				scheduler->wakeup.wait();
+			}
+			scheduler->sleeping.decrement();
+		}
+
+		if (job) {
+			scheduler->_execute(job);
+		}
+	}
+
+	current_worker = -1;
+}
+
+void JobScheduler::init(int p_worker_count) {
+	ERR_FAIL_COND(workers != nullptr);
+
+#if !defined(NO_THREADS)
+	if (p_worker_count < 0) {
+		// The threads waiting on counters help too, so leave a core for them.
+		p_worker_count = OS::get_singleton()->get_processor_count() - 1;
+	}
+	worker_count = MAX(p_worker_count, 1);
+#else
+	worker_count = 0;
+#endif
+
+	injection_queue.resize(INJECTION_QUEUE_SIZE);
+	injection_read = 0;
+	injection_write = 0;
+	exit.clear();
+
+	if (worker_count == 0) {
+		return;
+	}
+
+	workers = memnew_arr(Worker, worker_count);
+	for (uint32_t i = 0; i < worker_count; i++) {
+		workers[i].index = i;
+		workers[i].steal_seed = i + 1;
+		workers[i].thread.start(&JobScheduler::_worker_function, &workers[i]);
+	}
+}
+
+void JobScheduler::finish() {
+	if (workers == nullptr) {
+		return;
+	}
+
+	exit.set();
+	for (uint32_t i = 0; i < worker_count; i++) {
+		wakeup.post();
+	}
+	for (uint32_t i = 0; i < worker_count; i++) {
+		workers[i].thread.wait_to_finish();
+	}
+
+	memdelete_arr(workers);
+	workers = nullptr;
+	worker_count = 0;
+}
+
+JobScheduler::JobScheduler() {
+	singleton = this;
+}
+
+JobScheduler::~JobScheduler() {
+	finish();
+	singleton = nullptr;
+}
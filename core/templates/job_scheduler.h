@@ -0,0 +1,170 @@
+/*************************************************************************/
+/*  job_scheduler.h                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef JOB_SCHEDULER_H
+#define JOB_SCHEDULER_H
+
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+#include <atomic>
+
+// Engine-wide work-stealing scheduler.
+//
+// Every worker thread owns a fixed-size deque. Jobs pushed from a worker go to
+// its own deque (LIFO for the owner, FIFO for thieves), jobs pushed from any other
+// thread go to a shared injection queue. Idle workers steal from each other.
+//
+// Jobs and counters are owned by the caller, so dispatching never allocates.
+// Threads that wait on a counter keep executing queued jobs instead of blocking,
+// which makes nested dispatch (a job waiting on other jobs) safe.
+
+class JobScheduler {
+public:
+	class Counter;
+
+	struct Job {
+		Counter *counter = nullptr;
+		Job *next_waiting = nullptr;
+
+		virtual void execute() = 0;
+		virtual ~Job() = default;
+	};
+
+	// Counts the pending jobs of a group. Jobs submitted with a counter as
+	// dependency are held back until that counter reaches zero.
+	class Counter {
+		friend class JobScheduler;
+
+		SafeNumeric<uint32_t> pending;
+		std::atomic<Job *> waiting;
+
+		_FORCE_INLINE_ static Job *_closed() { return reinterpret_cast<Job *>(uintptr_t(1)); }
+
+	public:
+		// Must only be called while no job is referencing this counter.
+		_FORCE_INLINE_ void reset(uint32_t p_pending) {
+			pending.set(p_pending);
+			waiting.store(p_pending == 0 ? _closed() : nullptr, std::memory_order_release);
+		}
+
+		// Done once every job finished and the held back jobs were released.
+		_FORCE_INLINE_ bool is_done() const {
+			return waiting.load(std::memory_order_acquire) == _closed();
+		}
+
+		Counter() {
+			waiting.store(_closed(), std::memory_order_relaxed);
+		}
+	};
+
+private:
+	enum {
+		DEQUE_SIZE = 4096,
+		INJECTION_QUEUE_SIZE = 4096,
+		SPIN_ROUNDS = 64,
+	};
+
+	// Chase-Lev deque with a fixed capacity. Only the owner pushes and pops,
+	// any thread may steal.
+	struct Deque {
+		std::atomic<int64_t> top;
+		std::atomic<int64_t> bottom;
+		std::atomic<Job *> jobs[DEQUE_SIZE];
+
+		bool push(Job *p_job);
+		Job *pop();
+		Job *steal();
+
+		Deque() {
+			top.store(0, std::memory_order_relaxed);
+			bottom.store(0, std::memory_order_relaxed);
+		}
+	};
+
+	struct Worker {
+		Thread thread;
+		Deque deque;
+		uint32_t index = 0;
+		uint32_t steal_seed = 0;
+	};
+
+	static JobScheduler *singleton;
+	static thread_local int current_worker;
+
+	Worker *workers = nullptr;
+	uint32_t worker_count = 0;
+
+	Mutex injection_mutex;
+	LocalVector<Job *> injection_queue;
+	uint32_t injection_read = 0;
+	uint32_t injection_write = 0;
+	SafeNumeric<uint32_t> injection_count;
+
+	Semaphore wakeup;
+	SafeNumeric<uint32_t> sleeping;
+	SafeFlag exit;
+
+	static void _worker_function(void *p_user);
+
+	bool _push(Job *p_job);
+	Job *_pop_injected();
+	Job *_find_job(uint32_t &r_seed);
+	void _wake_workers(uint32_t p_amount);
+	void _execute(Job *p_job);
+	void _finish(Counter *p_counter);
+
+public:
+	_FORCE_INLINE_ static JobScheduler *get_singleton() { return singleton; }
+
+	// Amount of worker threads, not counting the threads that wait on counters.
+	_FORCE_INLINE_ uint32_t get_worker_count() const { return worker_count; }
+	// Index of the calling worker thread, or -1 if called from a thread the scheduler does not own.
+	_FORCE_INLINE_ static int get_current_worker() { return current_worker; }
+
+	// Submits p_count jobs. Their counter (if any) must already account for them.
+	// If p_after is not done yet, the jobs are held back until it is.
+	void submit(Job **p_jobs, uint32_t p_count, Counter *p_after = nullptr);
+	_FORCE_INLINE_ void submit(Job *p_job, Counter *p_after = nullptr) { submit(&p_job, 1, p_after); }
+
+	// Runs pending jobs on the calling thread until p_counter is done.
+	void wait(const Counter *p_counter);
+
+	void init(int p_worker_count = -1);
+	void finish();
+
+	JobScheduler();
+	~JobScheduler();
+};
+
+#endif // JOB_SCHEDULER_H
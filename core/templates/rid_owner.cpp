@@ -31,3 +31,9 @@
 #include "rid_owner.h"
 
 SafeNumeric<uint64_t> RID_AllocBase::base_id{ 1 };
+SafeNumeric<uint32_t> RID_AllocBase::stripe_counter;
+
+uint32_t RID_AllocBase::_get_thread_stripe() {
+	static thread_local uint32_t stripe = stripe_counter.postincrement();
+	return stripe;
+}
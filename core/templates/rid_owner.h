@@ -35,6 +35,7 @@
 #include "core/os/spin_lock.h"
 #include "core/string/print_string.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
@@ -45,6 +46,7 @@
 
 class RID_AllocBase {
 	static SafeNumeric<uint64_t> base_id;
+	static SafeNumeric<uint32_t> stripe_counter;
 
 protected:
 	static RID _make_from_id(uint64_t p_id) {
@@ -57,86 +59,239 @@ protected:
 		return base_id.increment();
 	}
 
+	// Reserves p_count consecutive ids and returns the first one.
+	static uint64_t _gen_ids(uint32_t p_count) {
+		return base_id.add(p_count) - p_count + 1;
+	}
+
 	static RID _gen_rid() {
 		return _make_from_id(_gen_id());
 	}
 
+	// Each thread sticks to one free list stripe, so threads allocating and freeing at once rarely touch the same list.
+	static uint32_t _get_thread_stripe();
+
 public:
 	virtual ~RID_AllocBase() {}
 };
 
 template <class T, bool THREAD_SAFE = false>
 class RID_Alloc : public RID_AllocBase {
-	T **chunks = nullptr;
-	uint32_t **free_list_chunks = nullptr;
-	uint32_t **validator_chunks = nullptr;
+	static constexpr uint32_t FREE_LIST_STRIPES = THREAD_SAFE ? 8 : 1;
+
+	struct Chunk {
+		T *elements;
+		std::atomic<uint32_t> *validators;
+		std::atomic<uint32_t> *next_free; // Index + 1 of the next free element, 0 ends the list.
+	};
+
+	struct FreeList {
+		std::atomic<uint64_t> head = { 0 }; // ABA tag in the high 32 bits, index + 1 of the first free element in the low ones.
+		uint8_t padding[64 - sizeof(std::atomic<uint64_t>)]; // Keep stripes on separate cache lines.
+	};
+
+	// Chunks never move once published. When the chunk table grows, the old table is retired
+	// instead of freed, so getornull() and the free lists can read it without locking.
+	std::atomic<Chunk *> chunks = { nullptr };
+	std::atomic<uint32_t> max_alloc = { 0 };
+	std::atomic<uint32_t> alloc_count = { 0 };
+	uint32_t chunk_count = 0;
+	uint32_t chunk_capacity = 0;
+	LocalVector<Chunk *> retired_chunks;
+
+	FreeList free_lists[FREE_LIST_STRIPES];
 
 	uint32_t elements_in_chunk;
-	uint32_t max_alloc = 0;
-	uint32_t alloc_count = 0;
 
 	const char *description = nullptr;
 
-	SpinLock spin_lock;
+	SpinLock grow_lock;
 
-	_FORCE_INLINE_ RID _allocate_rid(const T *p_initializer) {
+	_FORCE_INLINE_ const Chunk &_get_chunk(uint32_t p_index) const {
+		return chunks.load(std::memory_order_acquire)[p_index / elements_in_chunk];
+	}
+
+	_FORCE_INLINE_ void _add_alloc_count(int32_t p_amount) {
 		if (THREAD_SAFE) {
-			spin_lock.lock();
+			alloc_count.fetch_add(p_amount, std::memory_order_relaxed);
+		} else {
+			alloc_count.store(alloc_count.load(std::memory_order_relaxed) + p_amount, std::memory_order_relaxed);
 		}
+	}
+
+	_FORCE_INLINE_ uint32_t _get_stripe() const {
+		return THREAD_SAFE ? _get_thread_stripe() % FREE_LIST_STRIPES : 0;
+	}
 
-		if (alloc_count == max_alloc) {
-			//allocate a new chunk
-			uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
-
-			//grow chunks
-			chunks = (T **)memrealloc(chunks, sizeof(T *) * (chunk_count + 1));
-			chunks[chunk_count] = (T *)memalloc(sizeof(T) * elements_in_chunk); //but don't initialize
-
-			//grow validators
-			validator_chunks = (uint32_t **)memrealloc(validator_chunks, sizeof(uint32_t *) * (chunk_count + 1));
-			validator_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
-			//grow free lists
-			free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * (chunk_count + 1));
-			free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
-
-			//initialize
-			for (uint32_t i = 0; i < elements_in_chunk; i++) {
-				//dont initialize chunk
-				validator_chunks[chunk_count][i] = 0xFFFFFFFF;
-				free_list_chunks[chunk_count][i] = alloc_count + i;
+	// Returns index + 1 of a free element, or 0 if the list is empty.
+	uint32_t _pop_free(FreeList &p_list) {
+		uint64_t head = p_list.head.load(std::memory_order_acquire);
+		while (true) {
+			uint32_t first = uint32_t(head & 0xFFFFFFFF);
+			if (first == 0) {
+				return 0;
 			}
 
-			max_alloc += elements_in_chunk;
+			// If another thread pops this element meanwhile, the next read here is stale but the tag makes the exchange fail.
+			uint32_t index = first - 1;
+			uint32_t next = _get_chunk(index).next_free[index % elements_in_chunk].load(std::memory_order_relaxed);
+			uint64_t new_head = (((head >> 32) + 1) << 32) | next;
+
+			if (!THREAD_SAFE) {
+				p_list.head.store(new_head, std::memory_order_relaxed);
+				return first;
+			}
+			if (p_list.head.compare_exchange_weak(head, new_head, std::memory_order_acq_rel, std::memory_order_acquire)) {
+				return first;
+			}
 		}
+	}
 
-		uint32_t free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+	// Pushes a chain of free elements, already linked from p_first to p_last.
+	void _push_free(FreeList &p_list, uint32_t p_first, uint32_t p_last) {
+		std::atomic<uint32_t> &last_next = _get_chunk(p_last).next_free[p_last % elements_in_chunk];
+		uint64_t head = p_list.head.load(std::memory_order_relaxed);
+		while (true) {
+			last_next.store(uint32_t(head & 0xFFFFFFFF), std::memory_order_relaxed);
+			uint64_t new_head = (((head >> 32) + 1) << 32) | (p_first + 1);
 
-		uint32_t free_chunk = free_index / elements_in_chunk;
-		uint32_t free_element = free_index % elements_in_chunk;
+			if (!THREAD_SAFE) {
+				p_list.head.store(new_head, std::memory_order_relaxed);
+				return;
+			}
+			if (p_list.head.compare_exchange_weak(head, new_head, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+				return;
+			}
+		}
+	}
+
+	uint32_t _grow(uint32_t p_stripe) {
+		if (THREAD_SAFE) {
+			grow_lock.lock();
+
+			// Another thread may have grown or freed meanwhile.
+			for (uint32_t i = 0; i < FREE_LIST_STRIPES; i++) {
+				uint32_t first = _pop_free(free_lists[i]);
+				if (first) {
+					grow_lock.unlock();
+					return first - 1;
+				}
+			}
+		}
+
+		Chunk *table = chunks.load(std::memory_order_relaxed);
+		if (chunk_count == chunk_capacity) {
+			//grow chunk table, old one stays valid for readers
+			chunk_capacity = chunk_capacity > 0 ? chunk_capacity * 2 : 1;
+			Chunk *new_table = (Chunk *)memalloc(sizeof(Chunk) * chunk_capacity);
+			for (uint32_t i = 0; i < chunk_count; i++) {
+				new_table[i] = table[i];
+			}
+			if (table) {
+				retired_chunks.push_back(table);
+			}
+			table = new_table;
+		}
+
+		uint32_t chunk_base = chunk_count * elements_in_chunk;
+
+		Chunk &chunk = table[chunk_count];
+		chunk.elements = (T *)memalloc(sizeof(T) * elements_in_chunk); //but don't initialize
+		chunk.validators = (std::atomic<uint32_t> *)memalloc(sizeof(std::atomic<uint32_t>) * elements_in_chunk);
+		chunk.next_free = (std::atomic<uint32_t> *)memalloc(sizeof(std::atomic<uint32_t>) * elements_in_chunk);
+
+		for (uint32_t i = 0; i < elements_in_chunk; i++) {
+			memnew_placement(&chunk.validators[i], std::atomic<uint32_t>(0xFFFFFFFF));
+			memnew_placement(&chunk.next_free[i], std::atomic<uint32_t>(chunk_base + i + 2));
+		}
+
+		chunk_count++;
+		chunks.store(table, std::memory_order_release);
+		max_alloc.store(chunk_base + elements_in_chunk, std::memory_order_release);
+
+		// The first element goes to the caller, the rest are already linked.
+		if (elements_in_chunk > 1) {
+			_push_free(free_lists[p_stripe], chunk_base + 1, chunk_base + elements_in_chunk - 1);
+		}
+
+		if (THREAD_SAFE) {
+			grow_lock.unlock();
+		}
+
+		return chunk_base;
+	}
+
+	_FORCE_INLINE_ uint32_t _allocate_index(uint32_t p_stripe) {
+		for (uint32_t i = 0; i < FREE_LIST_STRIPES; i++) {
+			uint32_t first = _pop_free(free_lists[(p_stripe + i) % FREE_LIST_STRIPES]);
+			if (first) {
+				return first - 1;
+			}
+		}
+
+		return _grow(p_stripe);
+	}
+
+	_FORCE_INLINE_ RID _initialize_index(uint32_t p_index, uint64_t p_id, const T *p_initializer) {
+		const Chunk &chunk = _get_chunk(p_index);
+		uint32_t element = p_index % elements_in_chunk;
 
 		if (p_initializer) {
-			T *ptr = &chunks[free_chunk][free_element];
+			T *ptr = &chunk.elements[element];
 			memnew_placement(ptr, T(*p_initializer));
 		}
 
-		uint32_t validator = (uint32_t)(_gen_id() & 0x7FFFFFFF);
+		uint32_t validator = (uint32_t)(p_id & 0x7FFFFFFF);
 		uint64_t id = validator;
 		id <<= 32;
-		id |= free_index;
-
-		validator_chunks[free_chunk][free_element] = validator;
+		id |= p_index;
 
 		if (!p_initializer) {
-			validator_chunks[free_chunk][free_element] |= 0x80000000; //mark uninitialized bit
+			validator |= 0x80000000; //mark uninitialized bit
 		}
 
-		alloc_count++;
+		chunk.validators[element].store(validator, std::memory_order_release);
 
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
+		return _make_from_id(id);
+	}
+
+	_FORCE_INLINE_ RID _allocate_rid(const T *p_initializer) {
+		uint32_t index = _allocate_index(_get_stripe());
+		_add_alloc_count(1);
+		return _initialize_index(index, _gen_id(), p_initializer);
+	}
+
+	void _allocate_rids(const T *p_initializers, uint32_t p_count, RID *r_rids) {
+		uint32_t stripe = _get_stripe();
+		uint64_t id = _gen_ids(p_count);
+		for (uint32_t i = 0; i < p_count; i++) {
+			uint32_t index = _allocate_index(stripe);
+			r_rids[i] = _initialize_index(index, id + i, p_initializers ? &p_initializers[i] : nullptr);
 		}
+		_add_alloc_count(p_count);
+	}
 
-		return _make_from_id(id);
+	// Validates and destroys the element, returns its index or -1 on failure.
+	_FORCE_INLINE_ int64_t _free_element(const RID &p_rid) {
+		uint64_t id = p_rid.get_id();
+		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
+		ERR_FAIL_COND_V(idx >= max_alloc.load(std::memory_order_acquire), -1);
+
+		const Chunk &chunk = _get_chunk(idx);
+		uint32_t element = idx % elements_in_chunk;
+
+		uint32_t validator = uint32_t(id >> 32);
+		uint32_t current = chunk.validators[element].load(std::memory_order_acquire);
+		if (unlikely(current & 0x80000000)) {
+			ERR_FAIL_V_MSG(-1, "Attempted to free an uninitialized or invalid RID");
+		} else if (unlikely(current != validator)) {
+			ERR_FAIL_V(-1);
+		}
+
+		chunk.elements[element].~T();
+		chunk.validators[element].store(0xFFFFFFFF, std::memory_order_release); // go invalid
+
+		return idx;
 	}
 
 public:
@@ -149,63 +304,51 @@ public:
 		return _allocate_rid(nullptr);
 	}
 
+	// Batch versions, to allocate many RIDs (like a whole streamed cell) in one call.
+	void make_rids(const T *p_values, uint32_t p_count, RID *r_rids) {
+		_allocate_rids(p_values, p_count, r_rids);
+	}
+
+	void allocate_rids(uint32_t p_count, RID *r_rids) {
+		_allocate_rids(nullptr, p_count, r_rids);
+	}
+
 	_FORCE_INLINE_ T *getornull(const RID &p_rid, bool p_initialize = false) {
 		if (p_rid == RID()) {
 			return nullptr;
 		}
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
 
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		if (unlikely(idx >= max_alloc.load(std::memory_order_acquire))) {
 			return nullptr;
 		}
 
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
+		const Chunk &chunk = _get_chunk(idx);
+		uint32_t element = idx % elements_in_chunk;
 
 		uint32_t validator = uint32_t(id >> 32);
+		uint32_t current = chunk.validators[element].load(std::memory_order_acquire);
 
 		if (unlikely(p_initialize)) {
-			if (unlikely(!(validator_chunks[idx_chunk][idx_element] & 0x80000000))) {
-				if (THREAD_SAFE) {
-					spin_lock.unlock();
-				}
+			if (unlikely(!(current & 0x80000000))) {
 				ERR_FAIL_V_MSG(nullptr, "Initializing already initialized RID");
 			}
 
-			if (unlikely((validator_chunks[idx_chunk][idx_element] & 0x7FFFFFFF) != validator)) {
-				if (THREAD_SAFE) {
-					spin_lock.unlock();
-				}
+			if (unlikely((current & 0x7FFFFFFF) != validator)) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to initialize the wrong RID");
-				return nullptr;
 			}
 
-			validator_chunks[idx_chunk][idx_element] &= 0x7FFFFFFF; //initialized
+			chunk.validators[element].store(validator, std::memory_order_release); //initialized
 
-		} else if (unlikely(validator_chunks[idx_chunk][idx_element] != validator)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
-			if (validator_chunks[idx_chunk][idx_element] & 0x80000000) {
+		} else if (unlikely(current != validator)) {
+			if ((current & 0x80000000) && current != 0xFFFFFFFF) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to use an uninitialized RID");
 			}
 			return nullptr;
 		}
 
-		T *ptr = &chunks[idx_chunk][idx_element];
-
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
-
-		return ptr;
+		return &chunk.elements[element];
 	}
 	void initialize_rid(RID p_rid, const T &p_value) {
 		T *mem = getornull(p_rid, true);
@@ -214,119 +357,80 @@ public:
 	}
 
 	_FORCE_INLINE_ bool owns(const RID &p_rid) {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		if (unlikely(idx >= max_alloc.load(std::memory_order_acquire))) {
 			return false;
 		}
 
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
-
 		uint32_t validator = uint32_t(id >> 32);
 
-		bool owned = (validator_chunks[idx_chunk][idx_element] & 0x7FFFFFFF) == validator;
-
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
-
-		return owned;
+		return (_get_chunk(idx).validators[idx % elements_in_chunk].load(std::memory_order_acquire) & 0x7FFFFFFF) == validator;
 	}
 
 	_FORCE_INLINE_ void free(const RID &p_rid) {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-
-		uint64_t id = p_rid.get_id();
-		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
-			ERR_FAIL();
+		int64_t idx = _free_element(p_rid);
+		if (idx < 0) {
+			return;
 		}
 
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
+		_add_alloc_count(-1);
+		_push_free(free_lists[_get_stripe()], idx, idx);
+	}
 
-		uint32_t validator = uint32_t(id >> 32);
-		if (unlikely(validator_chunks[idx_chunk][idx_element] & 0x80000000)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
+	void free_rids(const RID *p_rids, uint32_t p_count) {
+		// Link the freed elements together, so they go back to the free list at once.
+		int64_t first = -1;
+		int64_t last = -1;
+		uint32_t freed = 0;
+		for (uint32_t i = 0; i < p_count; i++) {
+			int64_t idx = _free_element(p_rids[i]);
+			if (idx < 0) {
+				continue;
 			}
-			ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID");
-		} else if (unlikely(validator_chunks[idx_chunk][idx_element] != validator)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
+			if (last >= 0) {
+				_get_chunk(idx).next_free[idx % elements_in_chunk].store(first + 1, std::memory_order_relaxed);
+			} else {
+				last = idx;
 			}
-			ERR_FAIL();
+			first = idx;
+			freed++;
 		}
 
-		chunks[idx_chunk][idx_element].~T();
-		validator_chunks[idx_chunk][idx_element] = 0xFFFFFFFF; // go invalid
-
-		alloc_count--;
-		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
-
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
+		if (freed) {
+			_add_alloc_count(-int32_t(freed));
+			_push_free(free_lists[_get_stripe()], first, last);
 		}
 	}
 
 	_FORCE_INLINE_ uint32_t get_rid_count() const {
-		return alloc_count;
+		return alloc_count.load(std::memory_order_relaxed);
 	}
 
-	_FORCE_INLINE_ T *get_ptr_by_index(uint32_t p_index) {
-		ERR_FAIL_UNSIGNED_INDEX_V(p_index, alloc_count, nullptr);
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-		uint64_t idx = free_list_chunks[p_index / elements_in_chunk][p_index % elements_in_chunk];
-		T *ptr = &chunks[idx / elements_in_chunk][idx % elements_in_chunk];
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
-		return ptr;
+	// Iterating without allocating: indices are not dense, so go up to get_max_index()
+	// and skip the ones whose element is free or uninitialized (nullptr).
+	_FORCE_INLINE_ uint32_t get_max_index() const {
+		return max_alloc.load(std::memory_order_acquire);
 	}
 
-	_FORCE_INLINE_ RID get_rid_by_index(uint32_t p_index) {
-		ERR_FAIL_INDEX_V(p_index, alloc_count, RID());
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-		uint64_t idx = free_list_chunks[p_index / elements_in_chunk][p_index % elements_in_chunk];
-		uint64_t validator = validator_chunks[idx / elements_in_chunk][idx % elements_in_chunk];
-
-		RID rid = _make_from_id((validator << 32) | idx);
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
+	_FORCE_INLINE_ T *get_ptr_by_index(uint32_t p_index) {
+		ERR_FAIL_UNSIGNED_INDEX_V(p_index, max_alloc.load(std::memory_order_acquire), nullptr);
+		const Chunk &chunk = _get_chunk(p_index);
+		uint32_t element = p_index % elements_in_chunk;
+		if (chunk.validators[element].load(std::memory_order_acquire) & 0x80000000) {
+			return nullptr;
 		}
-		return rid;
+		return &chunk.elements[element];
 	}
 
 	void get_owned_list(List<RID> *p_owned) {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
-			if (validator != 0xFFFFFFFF) {
+		uint32_t count = max_alloc.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < count; i++) {
+			uint64_t validator = _get_chunk(i).validators[i % elements_in_chunk].load(std::memory_order_acquire);
+			if (!(validator & 0x80000000)) {
 				p_owned->push_back(_make_from_id((validator << 32) | i));
 			}
 		}
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
 	}
 
 	void set_description(const char *p_descrption) {
@@ -338,36 +442,39 @@ public:
 	}
 
 	~RID_Alloc() {
-		if (alloc_count) {
+		uint32_t leaked = alloc_count.load(std::memory_order_acquire);
+		if (leaked) {
 			if (description) {
-				print_error("ERROR: " + itos(alloc_count) + " RID allocations of type '" + description + "' were leaked at exit.");
+				print_error("ERROR: " + itos(leaked) + " RID allocations of type '" + description + "' were leaked at exit.");
 			} else {
 #ifdef NO_SAFE_CAST
-				print_error("ERROR: " + itos(alloc_count) + " RID allocations of type 'unknown' were leaked at exit.");
+				print_error("ERROR: " + itos(leaked) + " RID allocations of type 'unknown' were leaked at exit.");
 #else
-				print_error("ERROR: " + itos(alloc_count) + " RID allocations of type '" + typeid(T).name() + "' were leaked at exit.");
+				print_error("ERROR: " + itos(leaked) + " RID allocations of type '" + typeid(T).name() + "' were leaked at exit.");
 #endif
 			}
+		}
 
-			for (size_t i = 0; i < max_alloc; i++) {
-				uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
-				if (validator != 0xFFFFFFFF) {
-					chunks[i / elements_in_chunk][i % elements_in_chunk].~T();
+		Chunk *table = chunks.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			if (leaked) {
+				for (uint32_t j = 0; j < elements_in_chunk; j++) {
+					uint32_t validator = table[i].validators[j].load(std::memory_order_relaxed);
+					if (!(validator & 0x80000000)) {
+						table[i].elements[j].~T();
+					}
 				}
 			}
+			memfree(table[i].elements);
+			memfree(table[i].validators);
+			memfree(table[i].next_free);
 		}
 
-		uint32_t chunk_count = max_alloc / elements_in_chunk;
-		for (uint32_t i = 0; i < chunk_count; i++) {
-			memfree(chunks[i]);
-			memfree(validator_chunks[i]);
-			memfree(free_list_chunks[i]);
+		if (table) {
+			memfree(table);
 		}
-
-		if (chunks) {
-			memfree(chunks);
-			memfree(free_list_chunks);
-			memfree(validator_chunks);
+		for (uint32_t i = 0; i < retired_chunks.size(); i++) {
+			memfree(retired_chunks[i]);
 		}
 	}
 };
@@ -389,6 +496,14 @@ public:
 		alloc.initialize_rid(p_rid, p_ptr);
 	}
 
+	_FORCE_INLINE_ void make_rids(T *const *p_ptrs, uint32_t p_count, RID *r_rids) {
+		alloc.make_rids(p_ptrs, p_count, r_rids);
+	}
+
+	_FORCE_INLINE_ void allocate_rids(uint32_t p_count, RID *r_rids) {
+		alloc.allocate_rids(p_count, r_rids);
+	}
+
 	_FORCE_INLINE_ T *getornull(const RID &p_rid) {
 		T **ptr = alloc.getornull(p_rid);
 		if (unlikely(!ptr)) {
@@ -411,16 +526,21 @@ public:
 		alloc.free(p_rid);
 	}
 
+	_FORCE_INLINE_ void free_rids(const RID *p_rids, uint32_t p_count) {
+		alloc.free_rids(p_rids, p_count);
+	}
+
 	_FORCE_INLINE_ uint32_t get_rid_count() const {
 		return alloc.get_rid_count();
 	}
 
-	_FORCE_INLINE_ RID get_rid_by_index(uint32_t p_index) {
-		return alloc.get_rid_by_index(p_index);
+	_FORCE_INLINE_ uint32_t get_max_index() const {
+		return alloc.get_max_index();
 	}
 
 	_FORCE_INLINE_ T *get_ptr_by_index(uint32_t p_index) {
-		return *alloc.get_ptr_by_index(p_index);
+		T **ptr = alloc.get_ptr_by_index(p_index);
+		return ptr ? *ptr : nullptr;
 	}
 
 	_FORCE_INLINE_ void get_owned_list(List<RID> *p_owned) {
@@ -452,6 +572,14 @@ public:
 		alloc.initialize_rid(p_rid, p_ptr);
 	}
 
+	_FORCE_INLINE_ void make_rids(const T *p_values, uint32_t p_count, RID *r_rids) {
+		alloc.make_rids(p_values, p_count, r_rids);
+	}
+
+	_FORCE_INLINE_ void allocate_rids(uint32_t p_count, RID *r_rids) {
+		alloc.allocate_rids(p_count, r_rids);
+	}
+
 	_FORCE_INLINE_ T *getornull(const RID &p_rid) {
 		return alloc.getornull(p_rid);
 	}
@@ -464,12 +592,16 @@ public:
 		alloc.free(p_rid);
 	}
 
+	_FORCE_INLINE_ void free_rids(const RID *p_rids, uint32_t p_count) {
+		alloc.free_rids(p_rids, p_count);
+	}
+
 	_FORCE_INLINE_ uint32_t get_rid_count() const {
 		return alloc.get_rid_count();
 	}
 
-	_FORCE_INLINE_ RID get_rid_by_index(uint32_t p_index) {
-		return alloc.get_rid_by_index(p_index);
+	_FORCE_INLINE_ uint32_t get_max_index() const {
+		return alloc.get_max_index();
 	}
 
 	_FORCE_INLINE_ T *get_ptr_by_index(uint32_t p_index) {
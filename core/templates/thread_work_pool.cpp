@@ -30,50 +30,37 @@
 
 #include "thread_work_pool.h"
 
-#include "core/os/os.h"
-
-void ThreadWorkPool::_thread_function(void *p_user) {
-	ThreadData *thread = static_cast<ThreadData *>(p_user);
-	while (true) {
-		thread->start.wait();
-		if (thread->exit.load()) {
-			break;
-		}
-		thread->work->work();
-		thread->completed.post();
-	}
-}
-
 void ThreadWorkPool::init(int p_thread_count) {
-	ERR_FAIL_COND(threads != nullptr);
-	if (p_thread_count < 0) {
-		p_thread_count = OS::get_singleton()->get_processor_count();
+	ERR_FAIL_COND(thread_count != 0);
+	ERR_FAIL_COND_MSG(!JobScheduler::get_singleton(), "The job scheduler must be initialized before any ThreadWorkPool.");
+
+	uint32_t workers = JobScheduler::get_singleton()->get_worker_count();
+	if (p_thread_count > 0) {
+		// The caller is one of the threads.
+		workers = MIN(workers, uint32_t(p_thread_count - 1));
 	}
 
-	thread_count = p_thread_count;
-	threads = memnew_arr(ThreadData, thread_count);
+	thread_count = workers + 1;
 
+	// One lane more than workers for the share of the caller. It is queued like
+	// the others, so the counter covers it when this pool is a dependency.
+	lanes.resize(thread_count);
+	lane_jobs.resize(thread_count);
 	for (uint32_t i = 0; i < thread_count; i++) {
-		threads[i].exit.store(false);
-		threads[i].thread.start(&ThreadWorkPool::_thread_function, &threads[i]);
+		lane_jobs[i] = &lanes[i];
 	}
 }
 
 void ThreadWorkPool::finish() {
-	if (threads == nullptr) {
+	if (thread_count == 0) {
 		return;
 	}
 
-	for (uint32_t i = 0; i < thread_count; i++) {
-		threads[i].exit.store(true);
-		threads[i].start.post();
-	}
-	for (uint32_t i = 0; i < thread_count; i++) {
-		threads[i].thread.wait_to_finish();
-	}
+	ERR_FAIL_COND_MSG(current_work != nullptr, "Finishing a ThreadWorkPool that is still working.");
 
-	memdelete_arr(threads);
-	threads = nullptr;
+	lanes.clear();
+	lane_jobs.clear();
+	thread_count = 0;
 }
 
 ThreadWorkPool::~ThreadWorkPool() {
@@ -32,10 +32,16 @@
 #define THREAD_WORK_POOL_H
 
 #include "core/os/memory.h"
-#include "core/os/semaphore.h"
-#include "core/os/thread.h"
+#include "core/templates/job_scheduler.h"
+#include "core/templates/local_vector.h"
 
 #include <atomic>
+#include <cstddef>
+
+// Parallel-for front end of the engine-wide JobScheduler. It owns no threads,
+// so any number of pools can be dispatched at the same time, and a pool may be
+// dispatched from within a job of another pool. The calling thread takes part
+// in the work when it ends it.
 
 class ThreadWorkPool {
 	std::atomic<uint32_t> index;
@@ -63,29 +69,41 @@ class ThreadWorkPool {
 		}
 	};
 
-	struct ThreadData {
-		Thread thread;
-		Semaphore start;
-		Semaphore completed;
-		std::atomic<bool> exit;
-		BaseWork *work;
+	struct Lane : public JobScheduler::Job {
+		BaseWork *work = nullptr;
+		virtual void execute() override {
+			work->work();
+		}
 	};
 
-	ThreadData *threads = nullptr;
-	uint32_t thread_count = 0;
+	enum {
+		WORK_STORAGE_SIZE = 64
+	};
+
+	// Work is constructed in place, so dispatching does not allocate.
+	alignas(std::max_align_t) uint8_t work_storage[WORK_STORAGE_SIZE];
 	BaseWork *current_work = nullptr;
+	ThreadWorkPool *dependency = nullptr;
 
-	static void _thread_function(void *p_user);
+	LocalVector<Lane> lanes;
+	LocalVector<JobScheduler::Job *> lane_jobs;
+	JobScheduler::Counter counter;
+	uint32_t thread_count = 0;
 
 public:
+	// If p_after is given, the work only starts once the work of p_after has been
+	// done. p_after must not be dispatched again before this work ends.
 	template <class C, class M, class U>
-	void begin_work(uint32_t p_elements, C *p_instance, M p_method, U p_userdata) {
-		ERR_FAIL_COND(!threads); //never initialized
+	void begin_work(uint32_t p_elements, C *p_instance, M p_method, U p_userdata, ThreadWorkPool *p_after = nullptr) {
+		ERR_FAIL_COND(thread_count == 0); //never initialized
 		ERR_FAIL_COND(current_work != nullptr);
 
+		static_assert(sizeof(Work<C, M, U>) <= WORK_STORAGE_SIZE, "Work does not fit in the in-place storage.");
+
 		index.store(0, std::memory_order_release);
 
-		Work<C, M, U> *w = memnew((Work<C, M, U>));
+		typedef Work<C, M, U> WorkType;
+		WorkType *w = memnew_placement(work_storage, WorkType);
 		w->instance = p_instance;
 		w->userdata = p_userdata;
 		w->method = p_method;
@@ -93,11 +111,21 @@ public:
 		w->max_elements = p_elements;
 
 		current_work = w;
+		dependency = p_after;
 
-		for (uint32_t i = 0; i < thread_count; i++) {
-			threads[i].work = w;
-			threads[i].start.post();
+		uint32_t lane_count = MIN(p_elements, lanes.size());
+		counter.reset(lane_count);
+
+		if (lane_count == 0) {
+			return; // Nothing to do.
+		}
+
+		for (uint32_t i = 0; i < lane_count; i++) {
+			lanes[i].work = w;
+			lanes[i].counter = &counter;
 		}
+
+		JobScheduler::get_singleton()->submit(lane_jobs.ptr(), lane_count, dependency ? &dependency->counter : nullptr);
 	}
 
 	bool is_working() const {
@@ -117,13 +145,14 @@ public:
 
 	void end_work() {
 		ERR_FAIL_COND(current_work == nullptr);
-		for (uint32_t i = 0; i < thread_count; i++) {
-			threads[i].completed.wait();
-			threads[i].work = nullptr;
-		}
 
-		memdelete(current_work);
+		// Take part in the work by running queued lanes (this pool's or others) until all of ours are done.
+		// Running the work directly instead would leave it out of the counter that dependent pools wait on.
+		JobScheduler::get_singleton()->wait(&counter);
+
+		current_work->~BaseWork();
 		current_work = nullptr;
+		dependency = nullptr;
 	}
 
 	template <class C, class M, class U>
@@ -132,10 +161,11 @@ public:
 		end_work();
 	}
 
+	// Amount of threads that may run the work at the same time, including the caller.
 	_FORCE_INLINE_ int get_thread_count() const { return thread_count; }
 	void init(int p_thread_count = -1);
 	void finish();
 	~ThreadWorkPool();
 };
 
-#endif // THREAD_POOL_H
+#endif // THREAD_WORK_POOL_H
@@ -30,82 +30,331 @@
 
 #include "dictionary.h"
 
-#include "core/templates/ordered_hash_map.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Insertion-ordered open-addressing table, laid out like CPython's compact dict:
+// entries are appended to a dense array in insertion order, and a separate
+// power-of-two index array maps hashes to entry positions with linear probing.
+//
+// The entry array is split into segments that double in size, so entries never
+// move when the table grows. Pointers returned by getptr() and operator[] stay
+// valid across insertions; erase() may compact the entries and invalidate them.
 struct DictionaryPrivate {
+	struct Entry {
+		Variant key;
+		Variant value;
+		uint32_t hash = 0;
+		bool erased = false;
+	};
+
+	static const uint32_t FIRST_SEGMENT_SHIFT = 3; // 8 entries, then 16, 32...
+	static const uint32_t INDEX_EMPTY = 0xFFFFFFFF;
+	static const uint32_t INDEX_ERASED = 0xFFFFFFFE;
+	static const uint32_t NOT_FOUND = 0xFFFFFFFF;
+
 	SafeRefCount refcount;
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> variant_map;
-};
 
-void Dictionary::get_key_list(List<Variant> *p_keys) const {
-	if (_p->variant_map.is_empty()) {
-		return;
+	LocalVector<Entry *> segments;
+	uint32_t entry_count = 0; // Appended entries, including erased ones.
+	uint32_t erased_count = 0;
+
+	uint32_t *indices = nullptr;
+	uint32_t index_capacity = 0;
+	uint32_t index_used = 0; // Slots that are not empty, including erased markers.
+
+	_FORCE_INLINE_ static uint32_t _get_segment(uint32_t p_entry) {
+		// Floored log2, the argument is never zero.
+		uint32_t x = (p_entry >> FIRST_SEGMENT_SHIFT) + 1;
+#if defined(__GNUC__)
+		return 31 - __builtin_clz(x);
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse(&index, x);
+		return index;
+#else
+		uint32_t segment = 0;
+		while (x >>= 1) {
+			segment++;
+		}
+		return segment;
+#endif
 	}
 
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		p_keys->push_back(E.key());
+	_FORCE_INLINE_ Entry &get_entry(uint32_t p_entry) const {
+		uint32_t segment = _get_segment(p_entry);
+		uint32_t segment_start = ((1 << segment) - 1) << FIRST_SEGMENT_SHIFT;
+		return segments[segment][p_entry - segment_start];
 	}
-}
 
-Variant Dictionary::get_key_at_index(int p_index) const {
-	int index = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		if (index == p_index) {
-			return E.key();
+	_FORCE_INLINE_ uint32_t size() const {
+		return entry_count - erased_count;
+	}
+
+	// Returns the entry position of the key, or NOT_FOUND. The index slot is written to r_slot when found.
+	uint32_t find(const Variant &p_key, uint32_t p_hash, uint32_t *r_slot = nullptr) const {
+		if (index_capacity == 0) {
+			return NOT_FOUND;
+		}
+		uint32_t mask = index_capacity - 1;
+		uint32_t slot = p_hash & mask;
+		while (true) {
+			uint32_t index = indices[slot];
+			if (index == INDEX_EMPTY) {
+				return NOT_FOUND;
+			}
+			if (index != INDEX_ERASED) {
+				const Entry &entry = get_entry(index);
+				if (entry.hash == p_hash && VariantComparator::compare(entry.key, p_key)) {
+					if (r_slot) {
+						*r_slot = slot;
+					}
+					return index;
+				}
+			}
+			slot = (slot + 1) & mask;
 		}
-		index++;
 	}
 
-	return Variant();
-}
+	_FORCE_INLINE_ uint32_t find(const Variant &p_key) const {
+		return find(p_key, VariantHasher::hash(p_key));
+	}
 
-Variant Dictionary::get_value_at_index(int p_index) const {
-	int index = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		if (index == p_index) {
-			return E.value();
+	void _rebuild_index(uint32_t p_min_entries) {
+		// Keep the load factor under 2/3.
+		uint32_t capacity = 8;
+		while (capacity * 2 <= p_min_entries * 3) {
+			capacity <<= 1;
+		}
+		if (capacity != index_capacity) {
+			if (indices) {
+				memfree(indices);
+			}
+			indices = (uint32_t *)memalloc(sizeof(uint32_t) * capacity);
+			index_capacity = capacity;
+		}
+		for (uint32_t i = 0; i < index_capacity; i++) {
+			indices[i] = INDEX_EMPTY;
+		}
+
+		uint32_t mask = index_capacity - 1;
+		for (uint32_t i = 0; i < entry_count; i++) {
+			const Entry &entry = get_entry(i);
+			if (entry.erased) {
+				continue;
+			}
+			uint32_t slot = entry.hash & mask;
+			while (indices[slot] != INDEX_EMPTY) {
+				slot = (slot + 1) & mask;
+			}
+			indices[slot] = i;
 		}
-		index++;
+		index_used = size();
 	}
 
-	return Variant();
+	Variant &insert(const Variant &p_key, uint32_t p_hash) {
+		if ((index_used + 1) * 3 >= index_capacity * 2) {
+			_rebuild_index(size() + 1);
+		}
+
+		uint32_t segment = _get_segment(entry_count);
+		if (segment >= segments.size()) {
+			segments.push_back((Entry *)memalloc(sizeof(Entry) << (segment + FIRST_SEGMENT_SHIFT)));
+		}
+
+		uint32_t position = entry_count;
+		Entry *entry = memnew_placement(&get_entry(position), Entry);
+		entry->key = p_key;
+		entry->hash = p_hash;
+		entry_count++;
+
+		uint32_t mask = index_capacity - 1;
+		uint32_t slot = p_hash & mask;
+		while (indices[slot] != INDEX_EMPTY && indices[slot] != INDEX_ERASED) {
+			slot = (slot + 1) & mask;
+		}
+		if (indices[slot] == INDEX_EMPTY) {
+			index_used++;
+		}
+		indices[slot] = position;
+
+		return entry->value;
+	}
+
+	bool erase(const Variant &p_key) {
+		uint32_t slot;
+		uint32_t position = find(p_key, VariantHasher::hash(p_key), &slot);
+		if (position == NOT_FOUND) {
+			return false;
+		}
+
+		indices[slot] = INDEX_ERASED;
+		Entry &entry = get_entry(position);
+		entry.erased = true;
+		entry.key = Variant();
+		entry.value = Variant();
+		erased_count++;
+
+		// Drop erased entries from the end, so stack-like use never needs compacting.
+		while (entry_count > 0 && get_entry(entry_count - 1).erased) {
+			get_entry(entry_count - 1).~Entry();
+			entry_count--;
+			erased_count--;
+		}
+
+		if (erased_count > 8 && erased_count * 2 > entry_count) {
+			_compact();
+		}
+		return true;
+	}
+
+	void _compact() {
+		uint32_t live = 0;
+		for (uint32_t i = 0; i < entry_count; i++) {
+			Entry &entry = get_entry(i);
+			if (entry.erased) {
+				continue;
+			}
+			if (live != i) {
+				Entry &target = get_entry(live);
+				target.key = entry.key;
+				target.value = entry.value;
+				target.hash = entry.hash;
+				target.erased = false;
+			}
+			live++;
+		}
+		for (uint32_t i = live; i < entry_count; i++) {
+			get_entry(i).~Entry();
+		}
+		entry_count = live;
+		erased_count = 0;
+
+		// Release segments that are no longer reached.
+		uint32_t needed = entry_count > 0 ? _get_segment(entry_count - 1) + 1 : 0;
+		for (uint32_t i = needed; i < segments.size(); i++) {
+			memfree(segments[i]);
+		}
+		segments.resize(needed);
+
+		_rebuild_index(entry_count);
+	}
+
+	uint32_t next_live(uint32_t p_from) const {
+		for (uint32_t i = p_from; i < entry_count; i++) {
+			if (!get_entry(i).erased) {
+				return i;
+			}
+		}
+		return NOT_FOUND;
+	}
+
+	uint32_t get_position(int p_index) const {
+		if (p_index < 0 || uint32_t(p_index) >= size()) {
+			return NOT_FOUND;
+		}
+		if (erased_count == 0) {
+			return p_index;
+		}
+		uint32_t position = next_live(0);
+		for (int i = 0; i < p_index; i++) {
+			position = next_live(position + 1);
+		}
+		return position;
+	}
+
+	void clear() {
+		for (uint32_t i = 0; i < entry_count; i++) {
+			get_entry(i).~Entry();
+		}
+		for (uint32_t i = 0; i < segments.size(); i++) {
+			memfree(segments[i]);
+		}
+		segments.clear();
+		entry_count = 0;
+		erased_count = 0;
+
+		if (indices) {
+			memfree(indices);
+			indices = nullptr;
+		}
+		index_capacity = 0;
+		index_used = 0;
+	}
+
+	~DictionaryPrivate() {
+		clear();
+	}
+};
+
+void Dictionary::get_key_list(List<Variant> *p_keys) const {
+	for (uint32_t i = 0; i < _p->entry_count; i++) {
+		const DictionaryPrivate::Entry &entry = _p->get_entry(i);
+		if (!entry.erased) {
+			p_keys->push_back(entry.key);
+		}
+	}
+}
+
+Variant Dictionary::get_key_at_index(int p_index) const {
+	uint32_t position = _p->get_position(p_index);
+	if (position == DictionaryPrivate::NOT_FOUND) {
+		return Variant();
+	}
+	return _p->get_entry(position).key;
+}
+
+Variant Dictionary::get_value_at_index(int p_index) const {
+	uint32_t position = _p->get_position(p_index);
+	if (position == DictionaryPrivate::NOT_FOUND) {
+		return Variant();
+	}
+	return _p->get_entry(position).value;
 }
 
 Variant &Dictionary::operator[](const Variant &p_key) {
-	return _p->variant_map[p_key];
+	uint32_t hash = VariantHasher::hash(p_key);
+	uint32_t position = _p->find(p_key, hash);
+	if (position != DictionaryPrivate::NOT_FOUND) {
+		return _p->get_entry(position).value;
+	}
+	return _p->insert(p_key, hash);
 }
 
 const Variant &Dictionary::operator[](const Variant &p_key) const {
-	return _p->variant_map[p_key];
+	uint32_t position = _p->find(p_key);
+	CRASH_COND(position == DictionaryPrivate::NOT_FOUND);
+	return _p->get_entry(position).value;
 }
 
 const Variant *Dictionary::getptr(const Variant &p_key) const {
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::ConstElement E = ((const OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> *)&_p->variant_map)->find(p_key);
-
-	if (!E) {
+	uint32_t position = _p->find(p_key);
+	if (position == DictionaryPrivate::NOT_FOUND) {
 		return nullptr;
 	}
-	return &E.get();
+	return &_p->get_entry(position).value;
 }
 
 Variant *Dictionary::getptr(const Variant &p_key) {
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.find(p_key);
-
-	if (!E) {
+	uint32_t position = _p->find(p_key);
+	if (position == DictionaryPrivate::NOT_FOUND) {
 		return nullptr;
 	}
-	return &E.get();
+	return &_p->get_entry(position).value;
 }
 
 Variant Dictionary::get_valid(const Variant &p_key) const {
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::ConstElement E = ((const OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> *)&_p->variant_map)->find(p_key);
-
-	if (!E) {
+	const Variant *result = getptr(p_key);
+	if (!result) {
 		return Variant();
 	}
-	return E.get();
+	return *result;
 }
 
 Variant Dictionary::get(const Variant &p_key, const Variant &p_default) const {
@@ -118,15 +367,15 @@ Variant Dictionary::get(const Variant &p_key, const Variant &p_default) const {
 }
 
 int Dictionary::size() const {
-	return _p->variant_map.size();
+	return _p->size();
 }
 
 bool Dictionary::is_empty() const {
-	return !_p->variant_map.size();
+	return !_p->size();
 }
 
 bool Dictionary::has(const Variant &p_key) const {
-	return _p->variant_map.has(p_key);
+	return _p->find(p_key) != DictionaryPrivate::NOT_FOUND;
 }
 
 bool Dictionary::has_all(const Array &p_keys) const {
@@ -139,7 +388,7 @@ bool Dictionary::has_all(const Array &p_keys) const {
 }
 
 bool Dictionary::erase(const Variant &p_key) {
-	return _p->variant_map.erase(p_key);
+	return _p->erase(p_key);
 }
 
 bool Dictionary::operator==(const Dictionary &p_dictionary) const {
@@ -168,7 +417,7 @@ void Dictionary::_ref(const Dictionary &p_from) const {
 }
 
 void Dictionary::clear() {
-	_p->variant_map.clear();
+	_p->clear();
 }
 
 void Dictionary::_unref() const {
@@ -182,9 +431,12 @@ void Dictionary::_unref() const {
 uint32_t Dictionary::hash() const {
 	uint32_t h = hash_djb2_one_32(Variant::DICTIONARY);
 
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		h = hash_djb2_one_32(E.key().hash(), h);
-		h = hash_djb2_one_32(E.value().hash(), h);
+	for (uint32_t i = 0; i < _p->entry_count; i++) {
+		const DictionaryPrivate::Entry &entry = _p->get_entry(i);
+		if (!entry.erased) {
+			h = hash_djb2_one_32(entry.key.hash(), h);
+			h = hash_djb2_one_32(entry.value.hash(), h);
+		}
 	}
 
 	return h;
@@ -192,16 +444,19 @@ uint32_t Dictionary::hash() const {
 
 Array Dictionary::keys() const {
 	Array varr;
-	if (_p->variant_map.is_empty()) {
+	if (_p->size() == 0) {
 		return varr;
 	}
 
 	varr.resize(size());
 
 	int i = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		varr[i] = E.key();
-		i++;
+	for (uint32_t j = 0; j < _p->entry_count; j++) {
+		const DictionaryPrivate::Entry &entry = _p->get_entry(j);
+		if (!entry.erased) {
+			varr[i] = entry.key;
+			i++;
+		}
 	}
 
 	return varr;
@@ -209,42 +464,51 @@ Array Dictionary::keys() const {
 
 Array Dictionary::values() const {
 	Array varr;
-	if (_p->variant_map.is_empty()) {
+	if (_p->size() == 0) {
 		return varr;
 	}
 
 	varr.resize(size());
 
 	int i = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		varr[i] = E.get();
-		i++;
+	for (uint32_t j = 0; j < _p->entry_count; j++) {
+		const DictionaryPrivate::Entry &entry = _p->get_entry(j);
+		if (!entry.erased) {
+			varr[i] = entry.value;
+			i++;
+		}
 	}
 
 	return varr;
 }
 
 const Variant *Dictionary::next(const Variant *p_key) const {
+	uint32_t position;
 	if (p_key == nullptr) {
 		// caller wants to get the first element
-		if (_p->variant_map.front()) {
-			return &_p->variant_map.front().key();
+		position = _p->next_live(0);
+	} else {
+		position = _p->find(*p_key);
+		if (position == DictionaryPrivate::NOT_FOUND) {
+			return nullptr;
 		}
-		return nullptr;
+		position = _p->next_live(position + 1);
 	}
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.find(*p_key);
 
-	if (E && E.next()) {
-		return &E.next().key();
+	if (position == DictionaryPrivate::NOT_FOUND) {
+		return nullptr;
 	}
-	return nullptr;
+	return &_p->get_entry(position).key;
 }
 
 Dictionary Dictionary::duplicate(bool p_deep) const {
 	Dictionary n;
 
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		n[E.key()] = p_deep ? E.value().duplicate(true) : E.value();
+	for (uint32_t i = 0; i < _p->entry_count; i++) {
+		const DictionaryPrivate::Entry &entry = _p->get_entry(i);
+		if (!entry.erased) {
+			n[entry.key] = p_deep ? entry.value.duplicate(true) : entry.value;
+		}
 	}
 
 	return n;
@@ -255,7 +519,7 @@ void Dictionary::operator=(const Dictionary &p_dictionary) {
 }
 
 const void *Dictionary::id() const {
-	return _p->variant_map.id();
+	return _p;
 }
 
 Dictionary::Dictionary(const Dictionary &p_from) {
@@ -40,6 +40,9 @@
 #include "scene/gui/control.h"
 #include "scene/main/node.h"
 
+PagedAllocator<Variant::Pools::BucketSmall, true> Variant::Pools::_bucket_small;
+PagedAllocator<Variant::Pools::BucketMedium, true> Variant::Pools::_bucket_medium;
+
 String Variant::get_type_name(Variant::Type p_type) {
 	switch (p_type) {
 		case NIL: {
@@ -1077,7 +1080,8 @@ void Variant::reference(const Variant &p_variant) {
 			memnew_placement(_data._mem, Rect2i(*reinterpret_cast<const Rect2i *>(p_variant._data._mem)));
 		} break;
 		case TRANSFORM2D: {
-			_data._transform2d = memnew(Transform2D(*p_variant._data._transform2d));
+			_data._transform2d = (Transform2D *)Pools::_bucket_small.alloc();
+			memnew_placement(_data._transform2d, Transform2D(*p_variant._data._transform2d));
 		} break;
 		case VECTOR3: {
 			memnew_placement(_data._mem, Vector3(*reinterpret_cast<const Vector3 *>(p_variant._data._mem)));
@@ -1090,18 +1094,21 @@ void Variant::reference(const Variant &p_variant) {
 		} break;
 
 		case AABB: {
-			_data._aabb = memnew(::AABB(*p_variant._data._aabb));
+			_data._aabb = (::AABB *)Pools::_bucket_small.alloc();
+			memnew_placement(_data._aabb, ::AABB(*p_variant._data._aabb));
 		} break;
 		case QUAT: {
 			memnew_placement(_data._mem, Quat(*reinterpret_cast<const Quat *>(p_variant._data._mem)));
 
 		} break;
 		case BASIS: {
-			_data._basis = memnew(Basis(*p_variant._data._basis));
+			_data._basis = (Basis *)Pools::_bucket_medium.alloc();
+			memnew_placement(_data._basis, Basis(*p_variant._data._basis));
 
 		} break;
 		case TRANSFORM: {
-			_data._transform = memnew(Transform(*p_variant._data._transform));
+			_data._transform = (Transform *)Pools::_bucket_medium.alloc();
+			memnew_placement(_data._transform, Transform(*p_variant._data._transform));
 		} break;
 
 		// misc types
@@ -1281,16 +1288,20 @@ void Variant::_clear_internal() {
 		RECT2
 		*/
 		case TRANSFORM2D: {
-			memdelete(_data._transform2d);
+			_data._transform2d->~Transform2D();
+			Pools::_bucket_small.free((Pools::BucketSmall *)_data._transform2d);
 		} break;
 		case AABB: {
-			memdelete(_data._aabb);
+			_data._aabb->~AABB();
+			Pools::_bucket_small.free((Pools::BucketSmall *)_data._aabb);
 		} break;
 		case BASIS: {
-			memdelete(_data._basis);
+			_data._basis->~Basis();
+			Pools::_bucket_medium.free((Pools::BucketMedium *)_data._basis);
 		} break;
 		case TRANSFORM: {
-			memdelete(_data._transform);
+			_data._transform->~Transform();
+			Pools::_bucket_medium.free((Pools::BucketMedium *)_data._transform);
 		} break;
 
 			// misc types
@@ -2487,12 +2498,14 @@ Variant::Variant(const Plane &p_plane) {
 
 Variant::Variant(const ::AABB &p_aabb) {
 	type = AABB;
-	_data._aabb = memnew(::AABB(p_aabb));
+	_data._aabb = (::AABB *)Pools::_bucket_small.alloc();
+	memnew_placement(_data._aabb, ::AABB(p_aabb));
 }
 
 Variant::Variant(const Basis &p_matrix) {
 	type = BASIS;
-	_data._basis = memnew(Basis(p_matrix));
+	_data._basis = (Basis *)Pools::_bucket_medium.alloc();
+	memnew_placement(_data._basis, Basis(p_matrix));
 }
 
 Variant::Variant(const Quat &p_quat) {
@@ -2502,12 +2515,14 @@ Variant::Variant(const Quat &p_quat) {
 
 Variant::Variant(const Transform &p_transform) {
 	type = TRANSFORM;
-	_data._transform = memnew(Transform(p_transform));
+	_data._transform = (Transform *)Pools::_bucket_medium.alloc();
+	memnew_placement(_data._transform, Transform(p_transform));
 }
 
 Variant::Variant(const Transform2D &p_transform) {
 	type = TRANSFORM2D;
-	_data._transform2d = memnew(Transform2D(p_transform));
+	_data._transform2d = (Transform2D *)Pools::_bucket_small.alloc();
+	memnew_placement(_data._transform2d, Transform2D(p_transform));
 }
 
 Variant::Variant(const Color &p_color) {
@@ -727,6 +727,8 @@ public:
 	bool free(RID p_rid) override { return true; }
 	void update() override {}
 
+	uint64_t get_render_info(RS::RenderInfo p_info) override { return 0; }
+
 	RasterizerCanvasDummy() {}
 	~RasterizerCanvasDummy() {}
 };
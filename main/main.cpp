@@ -44,7 +44,9 @@
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
 #include "core/os/dir_access.h"
+#include "core/os/memory_tracker.h"
 #include "core/os/os.h"
+#include "core/os/small_object_allocator.h"
 #include "core/register_core_types.h"
 #include "core/string/translation.h"
 #include "core/version.h"
@@ -173,6 +175,7 @@ static int fixed_fps = -1;
 static bool print_fps = false;
 
 bool profile_gpu = false;
+static bool prewarm_shader_cache = false;
 
 /* Helper methods */
 
@@ -360,6 +363,7 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("Standalone tools:\n");
 	OS::get_singleton()->print("  -s, --script <script>                        Run a script.\n");
 	OS::get_singleton()->print("  --check-only                                 Only parse for errors and quit (use with --script).\n");
+	OS::get_singleton()->print("  --prewarm-shader-cache                       Compile the renderer shaders and those drawn in the first frame into the shader cache, then quit. Implies --quit.\n");
 #ifdef TOOLS_ENABLED
 	OS::get_singleton()->print("  --export <preset> <path>                     Export the project using the given preset and matching release template. The preset name should match one defined in export_presets.cfg.\n");
 	OS::get_singleton()->print("                                               <path> should be absolute or relative to the project directory, and include the filename for the binary (e.g. 'builds/game.exe'). The target directory should exist.\n");
@@ -430,6 +434,7 @@ Error Main::test_setup() {
 	register_driver_types();
 
 	ClassDB::set_current_api(ClassDB::API_NONE);
+	ClassDB::build_lookup_tables();
 
 	_start_success = true;
 
@@ -910,6 +915,9 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			upwards = true;
 		} else if (I->get() == "-q" || I->get() == "--quit") { // Auto quit at the end of the first main loop iteration
 			auto_quit = true;
+		} else if (I->get() == "--prewarm-shader-cache") { // fill the shader cache during the first main loop iteration, then quit
+			prewarm_shader_cache = true;
+			auto_quit = true;
 		} else if (I->get().ends_with("project.godot")) {
 			String path;
 			String file = I->get();
@@ -1071,12 +1079,29 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	// Initialize user data dir.
 	OS::get_singleton()->ensure_user_data_dir();
 
+	if (prewarm_shader_cache) {
+		// Override the project, the renderer reads this when creating its shaders.
+		ProjectSettings::get_singleton()->set_setting("rendering/shader_compiler/shader_cache/enabled", true);
+	}
+
 	GLOBAL_DEF("memory/limits/multithreaded_server/rid_pool_prealloc", 60);
 	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/multithreaded_server/rid_pool_prealloc",
 			PropertyInfo(Variant::INT,
 					"memory/limits/multithreaded_server/rid_pool_prealloc",
 					PROPERTY_HINT_RANGE,
 					"0,500,1")); // No negative and limit to 500 due to crashes
+
+	GLOBAL_DEF_RST("memory/small_object_allocator/enabled", false);
+	GLOBAL_DEF_RST("memory/small_object_allocator/thread_cache_size", SmallObjectAllocator::DEFAULT_THREAD_CACHE_SIZE);
+	ProjectSettings::get_singleton()->set_custom_property_info("memory/small_object_allocator/thread_cache_size",
+			PropertyInfo(Variant::INT,
+					"memory/small_object_allocator/thread_cache_size",
+					PROPERTY_HINT_RANGE,
+					"0,1024,1,or_greater"));
+	SmallObjectAllocator::configure(GLOBAL_GET("memory/small_object_allocator/enabled"), GLOBAL_GET("memory/small_object_allocator/thread_cache_size"));
+	if (SmallObjectAllocator::is_enabled()) {
+		performance->add_small_object_allocator_monitors();
+	}
 	GLOBAL_DEF("network/limits/debugger/max_chars_per_second", 32768);
 	ProjectSettings::get_singleton()->set_custom_property_info("network/limits/debugger/max_chars_per_second",
 			PropertyInfo(Variant::INT,
@@ -1817,6 +1842,7 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 	locale = String();
 
 	ClassDB::set_current_api(ClassDB::API_NONE); //no more APIs are registered at this point
+	ClassDB::build_lookup_tables();
 
 	print_verbose("CORE API HASH: " + uitos(ClassDB::get_api_hash(ClassDB::API_CORE)));
 	print_verbose("EDITOR API HASH: " + uitos(ClassDB::get_api_hash(ClassDB::API_EDITOR)));
@@ -2552,6 +2578,9 @@ bool Main::iteration() {
 		Engine::get_singleton()->_fps = frames;
 		performance->set_process_time(USEC_TO_SEC(process_max));
 		performance->set_physics_process_time(USEC_TO_SEC(physics_process_max));
+		if (MemoryTracker::is_enabled()) {
+			performance->update_tracked_memory_monitors();
+		}
 		process_max = 0;
 		physics_process_max = 0;
 
@@ -31,7 +31,9 @@
 #include "performance.h"
 
 #include "core/object/message_queue.h"
+#include "core/os/memory_tracker.h"
 #include "core/os/os.h"
+#include "core/os/small_object_allocator.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
 #include "servers/audio_server.h"
@@ -77,6 +79,8 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
 	BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_OBJECTS);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_OBJECTS_RESERVED);
 
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
@@ -120,6 +124,8 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"physics_3d/collision_pairs",
 		"physics_3d/islands",
 		"audio/driver/output_latency",
+		"memory/small_objects",
+		"memory/small_objects_reserved",
 
 	};
 
@@ -182,6 +188,10 @@ float Performance::get_monitor(Monitor p_monitor) const {
 			return PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT);
 		case AUDIO_OUTPUT_LATENCY:
 			return AudioServer::get_singleton()->get_output_latency();
+		case MEMORY_SMALL_OBJECTS:
+			return SmallObjectAllocator::get_used_bytes();
+		case MEMORY_SMALL_OBJECTS_RESERVED:
+			return SmallObjectAllocator::get_reserved_bytes();
 
 		default: {
 		}
@@ -221,6 +231,8 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
 
 	};
 
@@ -278,10 +290,39 @@ uint64_t Performance::get_monitor_modification_time() {
 	return _monitor_modification_time;
 }
 
+uint64_t Performance::_get_small_object_size_class_used_blocks(int p_size_class) const {
+	return SmallObjectAllocator::get_size_class_used_blocks(p_size_class);
+}
+
+void Performance::add_small_object_allocator_monitors() {
+	// One monitor per size class, with the number of blocks in use.
+	for (int i = 0; i < SmallObjectAllocator::SIZE_CLASS_COUNT; i++) {
+		Vector<Variant> args;
+		args.push_back(i);
+		add_custom_monitor("small_objects/" + itos(SmallObjectAllocator::get_size_class_block_size(i)) + "_bytes", callable_mp(this, &Performance::_get_small_object_size_class_used_blocks), args);
+	}
+}
+
+uint64_t Performance::_get_tracked_memory_live_bytes(int p_category) const {
+	return MemoryTracker::get_category_live_bytes(p_category);
+}
+
+void Performance::update_tracked_memory_monitors() {
+	// One monitor per memory tracking category, with its live bytes. Categories are only ever added.
+	int count = MemoryTracker::get_category_count();
+	for (int i = _tracked_memory_monitor_count; i < count; i++) {
+		Vector<Variant> args;
+		args.push_back(i);
+		add_custom_monitor("tracked_memory/" + String(MemoryTracker::get_category_name(i)).replace("/", "_"), callable_mp(this, &Performance::_get_tracked_memory_live_bytes), args);
+	}
+	_tracked_memory_monitor_count = count;
+}
+
 Performance::Performance() {
 	_process_time = 0;
 	_physics_process_time = 0;
 	_monitor_modification_time = 0;
+	_tracked_memory_monitor_count = 0;
 	singleton = this;
 }
 
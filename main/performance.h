@@ -44,6 +44,8 @@ class Performance : public Object {
 	static void _bind_methods();
 
 	float _get_node_count() const;
+	uint64_t _get_small_object_size_class_used_blocks(int p_size_class) const;
+	uint64_t _get_tracked_memory_live_bytes(int p_category) const;
 
 	float _process_time;
 	float _physics_process_time;
@@ -60,6 +62,7 @@ class Performance : public Object {
 
 	OrderedHashMap<StringName, MonitorCall> _monitor_map;
 	uint64_t _monitor_modification_time;
+	int _tracked_memory_monitor_count;
 
 public:
 	enum Monitor {
@@ -91,6 +94,8 @@ public:
 		PHYSICS_3D_ISLAND_COUNT,
 		//physics
 		AUDIO_OUTPUT_LATENCY,
+		MEMORY_SMALL_OBJECTS,
+		MEMORY_SMALL_OBJECTS_RESERVED,
 		MONITOR_MAX
 	};
 
@@ -116,6 +121,9 @@ public:
 
 	uint64_t get_monitor_modification_time();
 
+	void add_small_object_allocator_monitors();
+	void update_tracked_memory_monitors();
+
 	static Performance *get_singleton() { return singleton; }
 
 	Performance();
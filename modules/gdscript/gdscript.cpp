@@ -40,8 +40,10 @@
 #include "core/os/file_access.h"
 #include "core/os/os.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
+#include "gdscript_line_profiler.h"
 #include "gdscript_parser.h"
 #include "gdscript_warning.h"
 
@@ -809,8 +811,26 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 
 	valid = false;
-	GDScriptParser parser;
-	Error err = parser.parse(source, path, false);
+
+	if (!p_keep_state && member_functions.is_empty() && GDScriptBytecodeCache::is_load_enabled(this)) {
+		if (GDScriptBytecodeCache::load(this) == OK) {
+			valid = true;
+
+			for (Map<StringName, Ref<GDScript>>::Element *E = subclasses.front(); E; E = E->next()) {
+				_set_subclass_path(E->get(), path);
+			}
+
+			_init_rpc_methods_properties();
+
+			return OK;
+		}
+	}
+
+	// Use the tree parsed ahead of time during project load, if there is one.
+	Ref<GDScriptParserRef> preparsed = GDScriptCache::take_preparsed(path, source);
+	GDScriptParser own_parser;
+	GDScriptParser &parser = preparsed.is_valid() ? *preparsed->get_parser() : own_parser;
+	Error err = preparsed.is_valid() ? OK : parser.parse(source, path, false);
 	if (err) {
 		if (EngineDebugger::is_active()) {
 			GDScriptLanguage::get_singleton()->debug_break_parse(get_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
@@ -874,6 +894,11 @@ Error GDScript::reload(bool p_keep_state) {
 
 	_init_rpc_methods_properties();
 
+	if (GDScriptBytecodeCache::is_save_enabled(this)) {
+		// Only an optimization, scripts that can't be cached are simply compiled again next time.
+		GDScriptBytecodeCache::save(this);
+	}
+
 	return OK;
 }
 
@@ -1771,6 +1796,41 @@ void GDScriptLanguage::init() {
 		_add_global(E->get().name, E->get().ptr);
 	}
 
+#ifdef DEBUG_ENABLED
+	GDScriptLineProfiler::register_profiler();
+#endif
+
+	if (!Engine::get_singleton()->is_editor_hint() && GLOBAL_GET("gdscript/parallel_parsing/enabled")) {
+		// Named classes and autoloads are what most other scripts depend on. Parse them
+		// all at once on worker threads instead of one by one as they get loaded.
+		Vector<String> paths;
+
+		List<StringName> global_classes;
+		ScriptServer::get_global_class_list(&global_classes);
+		for (List<StringName>::Element *E = global_classes.front(); E; E = E->next()) {
+			if (ScriptServer::get_global_class_language(E->get()) == get_name()) {
+				paths.push_back(ScriptServer::get_global_class_path(E->get()));
+			}
+		}
+
+		List<PropertyInfo> props;
+		ProjectSettings::get_singleton()->get_property_list(&props);
+		for (List<PropertyInfo>::Element *E = props.front(); E; E = E->next()) {
+			if (!E->get().name.begins_with("autoload/")) {
+				continue;
+			}
+			String autoload_path = ProjectSettings::get_singleton()->get(E->get().name);
+			if (autoload_path.begins_with("*")) {
+				autoload_path = autoload_path.substr(1, autoload_path.length());
+			}
+			if (autoload_path.get_extension() == "gd") {
+				paths.push_back(autoload_path);
+			}
+		}
+
+		GDScriptCache::preparse(paths);
+	}
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -1790,6 +1850,10 @@ Error GDScriptLanguage::execute_file(const String &p_path) {
 }
 
 void GDScriptLanguage::finish() {
+	GDScriptBytecodeCache::clear();
+#ifdef DEBUG_ENABLED
+	GDScriptLineProfiler::unregister_profiler();
+#endif
 }
 
 void GDScriptLanguage::profiling_start() {
@@ -1807,6 +1871,8 @@ void GDScriptLanguage::profiling_start() {
 		elem->self()->profile.last_frame_call_count = 0;
 		elem->self()->profile.last_frame_self_time = 0;
 		elem->self()->profile.last_frame_total_time = 0;
+		elem->self()->profile.inline_cache_hits = 0;
+		elem->self()->profile.inline_cache_misses = 0;
 		elem = elem->next();
 	}
 
@@ -2045,6 +2111,9 @@ void GDScriptLanguage::reload_tool_script(const Ref<Script> &p_script, bool p_so
 void GDScriptLanguage::frame() {
 	calls = 0;
 
+	// Whatever wasn't loaded by the first frame is unlikely to be needed soon.
+	GDScriptCache::release_preparsed();
+
 #ifdef DEBUG_ENABLED
 	if (profiling) {
 		MutexLock lock(this->lock);
@@ -2279,6 +2348,9 @@ GDScriptLanguage::GDScriptLanguage() {
 		_call_stack = nullptr;
 	}
 
+	GLOBAL_DEF("gdscript/bytecode_cache/enabled", true);
+	GLOBAL_DEF("gdscript/parallel_parsing/enabled", true);
+
 #ifdef DEBUG_ENABLED
 	GLOBAL_DEF("debug/gdscript/warnings/enable", true);
 	GLOBAL_DEF("debug/gdscript/warnings/treat_warnings_as_errors", false);
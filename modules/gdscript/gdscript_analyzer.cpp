@@ -1071,8 +1071,65 @@ void GDScriptAnalyzer::resolve_for(GDScriptParser::ForNode *p_for) {
 		resolve_node(p_for->list);
 	}
 
-	// TODO: If list is a typed array, the variable should be an element.
-	// Also applicable for constant range() (so variable is int or float).
+	// Packed arrays and typed arrays of the common math types yield elements of a known type,
+	// so the iterator can be hard typed and the loop can use the specialized iterate opcodes.
+	// TODO: Also applicable for other typed arrays and constant range() (so variable is int or float).
+	if (p_for->variable && p_for->list) {
+		GDScriptParser::DataType list_type = p_for->list->get_datatype();
+		Variant::Type element_type = Variant::NIL;
+		if (list_type.is_hard_type() && list_type.kind == GDScriptParser::DataType::BUILTIN) {
+			switch (list_type.builtin_type) {
+				case Variant::PACKED_BYTE_ARRAY:
+				case Variant::PACKED_INT32_ARRAY:
+				case Variant::PACKED_INT64_ARRAY:
+					element_type = Variant::INT;
+					break;
+				case Variant::PACKED_FLOAT32_ARRAY:
+				case Variant::PACKED_FLOAT64_ARRAY:
+					element_type = Variant::FLOAT;
+					break;
+				case Variant::PACKED_STRING_ARRAY:
+					element_type = Variant::STRING;
+					break;
+				case Variant::PACKED_VECTOR2_ARRAY:
+					element_type = Variant::VECTOR2;
+					break;
+				case Variant::PACKED_VECTOR3_ARRAY:
+					element_type = Variant::VECTOR3;
+					break;
+				case Variant::PACKED_COLOR_ARRAY:
+					element_type = Variant::COLOR;
+					break;
+				case Variant::ARRAY:
+					if (list_type.has_container_element_type()) {
+						GDScriptParser::DataType list_element_type = list_type.get_container_element_type();
+						if (list_element_type.kind == GDScriptParser::DataType::BUILTIN) {
+							switch (list_element_type.builtin_type) {
+								case Variant::INT:
+								case Variant::FLOAT:
+								case Variant::VECTOR2:
+								case Variant::VECTOR3:
+									element_type = list_element_type.builtin_type;
+									break;
+								default:
+									break;
+							}
+						}
+					}
+					break;
+				default:
+					break;
+			}
+		}
+
+		if (element_type != Variant::NIL) {
+			GDScriptParser::DataType variable_type;
+			variable_type.type_source = GDScriptParser::DataType::ANNOTATED_INFERRED;
+			variable_type.kind = GDScriptParser::DataType::BUILTIN;
+			variable_type.builtin_type = element_type;
+			p_for->variable->set_datatype(variable_type);
+		}
+	}
 
 	resolve_suite(p_for->loop);
 	p_for->set_datatype(p_for->loop->get_datatype());
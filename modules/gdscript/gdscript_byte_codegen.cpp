@@ -399,6 +399,7 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 	function->_stack_size = RESERVED_STACK + max_locals + temporaries.size();
 	function->_instruction_args_size = instr_args_max;
 	function->_ptrcall_args_size = ptrcall_max;
+	function->_allocate_inline_caches(inline_cache_count);
 
 	ended = true;
 	return function;
@@ -420,6 +421,26 @@ void GDScriptByteCodeGenerator::set_initial_line(int p_line) {
 #define IS_BUILTIN_TYPE(m_var, m_type) \
 	(m_var.type.has_type && m_var.type.kind == GDScriptDataType::BUILTIN && m_var.type.builtin_type == m_type)
 
+// Element type of a typed array when it has specialized opcodes, NIL otherwise.
+static Variant::Type _get_typed_array_element_type(const GDScriptDataType &p_type) {
+	if (!p_type.has_type || p_type.kind != GDScriptDataType::BUILTIN || p_type.builtin_type != Variant::ARRAY || !p_type.has_container_element_type()) {
+		return Variant::NIL;
+	}
+	GDScriptDataType element_type = p_type.get_container_element_type();
+	if (!element_type.has_type || element_type.kind != GDScriptDataType::BUILTIN) {
+		return Variant::NIL;
+	}
+	switch (element_type.builtin_type) {
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR3:
+			return element_type.builtin_type;
+		default:
+			return Variant::NIL;
+	}
+}
+
 void GDScriptByteCodeGenerator::write_type_adjust(const Address &p_target, Variant::Type p_new_type) {
 	switch (p_new_type) {
 		case Variant::BOOL:
@@ -683,6 +704,31 @@ void GDScriptByteCodeGenerator::write_end_ternary() {
 }
 
 void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address &p_index, const Address &p_source) {
+	Variant::Type element_type = _get_typed_array_element_type(p_target.type);
+	if (element_type != Variant::NIL && IS_BUILTIN_TYPE(p_index, Variant::INT) && IS_BUILTIN_TYPE(p_source, element_type)) {
+		// Write the element in place.
+		switch (element_type) {
+			case Variant::INT:
+				append(GDScriptFunction::OPCODE_SET_INDEXED_TYPED_ARRAY_INT, 3);
+				break;
+			case Variant::FLOAT:
+				append(GDScriptFunction::OPCODE_SET_INDEXED_TYPED_ARRAY_FLOAT, 3);
+				break;
+			case Variant::VECTOR2:
+				append(GDScriptFunction::OPCODE_SET_INDEXED_TYPED_ARRAY_VECTOR2, 3);
+				break;
+			case Variant::VECTOR3:
+				append(GDScriptFunction::OPCODE_SET_INDEXED_TYPED_ARRAY_VECTOR3, 3);
+				break;
+			default:
+				break;
+		}
+		append(p_target);
+		append(p_index);
+		append(p_source);
+		return;
+	}
+
 	if (HAS_BUILTIN_TYPE(p_target)) {
 		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_setter(p_target.type.builtin_type)) {
 			// Use indexed setter instead.
@@ -711,6 +757,31 @@ void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address
 }
 
 void GDScriptByteCodeGenerator::write_get(const Address &p_target, const Address &p_index, const Address &p_source) {
+	Variant::Type element_type = _get_typed_array_element_type(p_source.type);
+	if (element_type != Variant::NIL && IS_BUILTIN_TYPE(p_index, Variant::INT)) {
+		// Read the element without going through the generic indexed getter.
+		switch (element_type) {
+			case Variant::INT:
+				append(GDScriptFunction::OPCODE_GET_INDEXED_TYPED_ARRAY_INT, 3);
+				break;
+			case Variant::FLOAT:
+				append(GDScriptFunction::OPCODE_GET_INDEXED_TYPED_ARRAY_FLOAT, 3);
+				break;
+			case Variant::VECTOR2:
+				append(GDScriptFunction::OPCODE_GET_INDEXED_TYPED_ARRAY_VECTOR2, 3);
+				break;
+			case Variant::VECTOR3:
+				append(GDScriptFunction::OPCODE_GET_INDEXED_TYPED_ARRAY_VECTOR3, 3);
+				break;
+			default:
+				break;
+		}
+		append(p_source);
+		append(p_index);
+		append(p_target);
+		return;
+	}
+
 	if (HAS_BUILTIN_TYPE(p_source)) {
 		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_getter(p_source.type.builtin_type)) {
 			// Use indexed getter instead.
@@ -750,6 +821,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -765,6 +837,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -904,6 +977,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(p_target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_super_call(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) {
@@ -925,6 +999,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(p_target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_call_gdscript_utility(const Address &p_target, GDScriptUtilityFunctions::FunctionPtr p_function, const Vector<Address> &p_arguments) {
@@ -973,6 +1048,10 @@ void GDScriptByteCodeGenerator::write_call_utility(const Address &p_target, cons
 }
 
 void GDScriptByteCodeGenerator::write_call_builtin_type(const Address &p_target, const Address &p_base, Variant::Type p_type, const StringName &p_method, const Vector<Address> &p_arguments) {
+	if (p_arguments.size() == 1 && (p_method == "append" || p_method == "push_back") && write_append(p_target, p_base, p_type, p_arguments[0])) {
+		return;
+	}
+
 	bool is_validated = false;
 
 	// Check if all types are correct.
@@ -1015,6 +1094,64 @@ void GDScriptByteCodeGenerator::write_call_builtin_type(const Address &p_target,
 	append(Variant::get_validated_builtin_method(p_type, p_method));
 }
 
+bool GDScriptByteCodeGenerator::write_append(const Address &p_target, const Address &p_base, Variant::Type p_type, const Address &p_value) {
+	if (p_type == Variant::ARRAY) {
+		// Array returns nothing, so the target is left alone.
+		append(GDScriptFunction::OPCODE_APPEND_ARRAY, 2);
+		append(p_base);
+		append(p_value);
+		return true;
+	}
+
+	GDScriptFunction::Opcode code;
+	switch (p_type) {
+		case Variant::PACKED_BYTE_ARRAY:
+			code = GDScriptFunction::OPCODE_APPEND_PACKED_BYTE_ARRAY;
+			break;
+		case Variant::PACKED_INT32_ARRAY:
+			code = GDScriptFunction::OPCODE_APPEND_PACKED_INT32_ARRAY;
+			break;
+		case Variant::PACKED_INT64_ARRAY:
+			code = GDScriptFunction::OPCODE_APPEND_PACKED_INT64_ARRAY;
+			break;
+		case Variant::PACKED_FLOAT32_ARRAY:
+			code = GDScriptFunction::OPCODE_APPEND_PACKED_FLOAT32_ARRAY;
+			break;
+		case Variant::PACKED_FLOAT64_ARRAY:
+			code = GDScriptFunction::OPCODE_APPEND_PACKED_FLOAT64_ARRAY;
+			break;
+		case Variant::PACKED_STRING_ARRAY:
+			code = GDScriptFunction::OPCODE_APPEND_PACKED_STRING_ARRAY;
+			break;
+		case Variant::PACKED_VECTOR2_ARRAY:
+			code = GDScriptFunction::OPCODE_APPEND_PACKED_VECTOR2_ARRAY;
+			break;
+		case Variant::PACKED_VECTOR3_ARRAY:
+			code = GDScriptFunction::OPCODE_APPEND_PACKED_VECTOR3_ARRAY;
+			break;
+		case Variant::PACKED_COLOR_ARRAY:
+			code = GDScriptFunction::OPCODE_APPEND_PACKED_COLOR_ARRAY;
+			break;
+		default:
+			return false;
+	}
+
+	// The value is stored natively, so it must have the exact element type.
+	if (!IS_BUILTIN_TYPE(p_value, Variant::get_builtin_method_argument_type(p_type, "append", 0))) {
+		return false;
+	}
+
+	if (p_target.mode == Address::TEMPORARY && temporaries[p_target.address].type != Variant::BOOL) {
+		write_type_adjust(p_target, Variant::BOOL);
+	}
+
+	append(code, 3);
+	append(p_base);
+	append(p_value);
+	append(p_target);
+	return true;
+}
+
 void GDScriptByteCodeGenerator::write_call_builtin_type_static(const Address &p_target, Variant::Type p_type, const StringName &p_method, const Vector<Address> &p_arguments) {
 	bool is_validated = false;
 
@@ -1154,6 +1291,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(p_target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) {
@@ -1165,6 +1303,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(p_target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) {
@@ -1176,6 +1315,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(p_target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_lambda(const Address &p_target, GDScriptFunction *p_function, const Vector<Address> &p_captures) {
@@ -1306,7 +1446,8 @@ void GDScriptByteCodeGenerator::write_endif() {
 }
 
 void GDScriptByteCodeGenerator::start_for(const GDScriptDataType &p_iterator_type, const GDScriptDataType &p_list_type) {
-	Address counter(Address::LOCAL_VARIABLE, add_local("@counter_pos", p_iterator_type), p_iterator_type);
+	// The counter holds iteration state whose type depends on the container, not the iterator.
+	Address counter(Address::LOCAL_VARIABLE, add_local("@counter_pos", GDScriptDataType()), GDScriptDataType());
 	Address container(Address::LOCAL_VARIABLE, add_local("@container_pos", p_list_type), p_list_type);
 
 	// Store state.
@@ -1371,8 +1512,28 @@ void GDScriptByteCodeGenerator::write_for() {
 					iterate_opcode = GDScriptFunction::OPCODE_ITERATE_DICTIONARY;
 					break;
 				case Variant::ARRAY:
-					begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_ARRAY;
-					iterate_opcode = GDScriptFunction::OPCODE_ITERATE_ARRAY;
+					switch (_get_typed_array_element_type(container.type)) {
+						case Variant::INT:
+							begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_TYPED_ARRAY_INT;
+							iterate_opcode = GDScriptFunction::OPCODE_ITERATE_TYPED_ARRAY_INT;
+							break;
+						case Variant::FLOAT:
+							begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_TYPED_ARRAY_FLOAT;
+							iterate_opcode = GDScriptFunction::OPCODE_ITERATE_TYPED_ARRAY_FLOAT;
+							break;
+						case Variant::VECTOR2:
+							begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR2;
+							iterate_opcode = GDScriptFunction::OPCODE_ITERATE_TYPED_ARRAY_VECTOR2;
+							break;
+						case Variant::VECTOR3:
+							begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR3;
+							iterate_opcode = GDScriptFunction::OPCODE_ITERATE_TYPED_ARRAY_VECTOR3;
+							break;
+						default:
+							begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_ARRAY;
+							iterate_opcode = GDScriptFunction::OPCODE_ITERATE_ARRAY;
+							break;
+					}
 					break;
 				case Variant::PACKED_BYTE_ARRAY:
 					begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_PACKED_BYTE_ARRAY;
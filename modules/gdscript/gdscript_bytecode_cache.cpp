@@ -0,0 +1,1361 @@
+/*************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/io/marshalls.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/version.h"
+#include "gdscript_cache.h"
+
+GDScriptBytecodeCache::LookupTables *GDScriptBytecodeCache::lookup_tables = nullptr;
+HashMap<String, GDScriptBytecodeCache::FileHash> GDScriptBytecodeCache::file_hashes;
+Mutex GDScriptBytecodeCache::mutex;
+
+static const char *cache_magic = "GDBC";
+
+void GDScriptBytecodeCache::Writer::put_u8(uint8_t p_value) {
+	buffer.push_back(p_value);
+}
+
+void GDScriptBytecodeCache::Writer::put_u32(uint32_t p_value) {
+	int ofs = buffer.size();
+	buffer.resize(ofs + 4);
+	encode_uint32(p_value, buffer.ptrw() + ofs);
+}
+
+void GDScriptBytecodeCache::Writer::put_string(const String &p_value) {
+	CharString utf8 = p_value.utf8();
+	put_u32(utf8.length());
+	int ofs = buffer.size();
+	buffer.resize(ofs + utf8.length());
+	memcpy(buffer.ptrw() + ofs, utf8.get_data(), utf8.length());
+}
+
+void GDScriptBytecodeCache::Writer::put_variant(const Variant &p_value) {
+	int len = 0;
+	Error err = encode_variant(p_value, nullptr, len, false);
+	if (err != OK) {
+		fail("Can't encode constant of type '" + Variant::get_type_name(p_value.get_type()) + "'.");
+		return;
+	}
+	put_u32(len);
+	int ofs = buffer.size();
+	buffer.resize(ofs + len);
+	encode_variant(p_value, buffer.ptrw() + ofs, len, false);
+}
+
+void GDScriptBytecodeCache::Writer::fail(const String &p_error) {
+	if (error.is_empty()) {
+		error = p_error;
+	}
+}
+
+uint8_t GDScriptBytecodeCache::Reader::get_u8() {
+	if (failed()) {
+		return 0;
+	}
+	if (pos + 1 > size) {
+		corrupt = true;
+		return 0;
+	}
+	return data[pos++];
+}
+
+uint32_t GDScriptBytecodeCache::Reader::get_u32() {
+	if (failed()) {
+		return 0;
+	}
+	if (pos + 4 > size) {
+		corrupt = true;
+		return 0;
+	}
+	uint32_t value = decode_uint32(data + pos);
+	pos += 4;
+	return value;
+}
+
+uint32_t GDScriptBytecodeCache::Reader::get_count() {
+	uint32_t count = get_u32();
+	if (failed()) {
+		return 0;
+	}
+	// Every element takes at least one byte, anything larger can only come from bad data.
+	if (count > uint32_t(size - pos)) {
+		corrupt = true;
+		return 0;
+	}
+	return count;
+}
+
+Variant::Type GDScriptBytecodeCache::Reader::get_type() {
+	uint32_t type = get_u32();
+	if (!failed() && type >= Variant::VARIANT_MAX) {
+		corrupt = true;
+		return Variant::NIL;
+	}
+	return Variant::Type(type);
+}
+
+String GDScriptBytecodeCache::Reader::get_string() {
+	uint32_t len = get_count();
+	if (failed()) {
+		return String();
+	}
+	String value;
+	value.parse_utf8((const char *)data + pos, len);
+	pos += len;
+	return value;
+}
+
+Variant GDScriptBytecodeCache::Reader::get_variant() {
+	uint32_t len = get_count();
+	if (failed()) {
+		return Variant();
+	}
+	Variant value;
+	Error err = decode_variant(value, data + pos, len, nullptr, false);
+	if (err != OK) {
+		corrupt = true;
+		return Variant();
+	}
+	pos += len;
+	return value;
+}
+
+void GDScriptBytecodeCache::Reader::fail(const String &p_error) {
+	if (error.is_empty()) {
+		error = p_error;
+	}
+}
+
+const GDScriptBytecodeCache::LookupTables *GDScriptBytecodeCache::_get_lookup_tables() {
+	MutexLock lock(mutex);
+
+	if (lookup_tables) {
+		return lookup_tables;
+	}
+
+	LookupTables *tables = memnew(LookupTables);
+
+	for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+		Variant::Type type = Variant::Type(i);
+
+		for (int op = 0; op < Variant::OP_MAX; op++) {
+			for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+				Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op), type, Variant::Type(j));
+				if (evaluator && !tables->operators.has(evaluator)) {
+					OperatorKey key;
+					key.op = Variant::Operator(op);
+					key.type_a = type;
+					key.type_b = Variant::Type(j);
+					tables->operators[evaluator] = key;
+				}
+			}
+		}
+
+		List<StringName> members;
+		Variant::get_member_list(type, &members);
+		for (const List<StringName>::Element *E = members.front(); E; E = E->next()) {
+			MemberKey key;
+			key.type = type;
+			key.name = E->get();
+			Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, E->get());
+			if (setter && !tables->setters.has(setter)) {
+				tables->setters[setter] = key;
+			}
+			Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, E->get());
+			if (getter && !tables->getters.has(getter)) {
+				tables->getters[getter] = key;
+			}
+		}
+
+		Variant::ValidatedKeyedSetter keyed_setter = Variant::get_member_validated_keyed_setter(type);
+		if (keyed_setter && !tables->keyed_setters.has(keyed_setter)) {
+			tables->keyed_setters[keyed_setter] = type;
+		}
+		Variant::ValidatedKeyedGetter keyed_getter = Variant::get_member_validated_keyed_getter(type);
+		if (keyed_getter && !tables->keyed_getters.has(keyed_getter)) {
+			tables->keyed_getters[keyed_getter] = type;
+		}
+		Variant::ValidatedIndexedSetter indexed_setter = Variant::get_member_validated_indexed_setter(type);
+		if (indexed_setter && !tables->indexed_setters.has(indexed_setter)) {
+			tables->indexed_setters[indexed_setter] = type;
+		}
+		Variant::ValidatedIndexedGetter indexed_getter = Variant::get_member_validated_indexed_getter(type);
+		if (indexed_getter && !tables->indexed_getters.has(indexed_getter)) {
+			tables->indexed_getters[indexed_getter] = type;
+		}
+
+		List<StringName> methods;
+		Variant::get_builtin_method_list(type, &methods);
+		for (const List<StringName>::Element *E = methods.front(); E; E = E->next()) {
+			Variant::ValidatedBuiltInMethod method = Variant::get_validated_builtin_method(type, E->get());
+			if (method && !tables->builtin_methods.has(method)) {
+				MemberKey key;
+				key.type = type;
+				key.name = E->get();
+				tables->builtin_methods[method] = key;
+			}
+		}
+
+		for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+			Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, j);
+			if (constructor && !tables->constructors.has(constructor)) {
+				ConstructorKey key;
+				key.type = type;
+				key.index = j;
+				tables->constructors[constructor] = key;
+			}
+		}
+	}
+
+	List<StringName> functions;
+	Variant::get_utility_function_list(&functions);
+	for (const List<StringName>::Element *E = functions.front(); E; E = E->next()) {
+		Variant::ValidatedUtilityFunction function = Variant::get_validated_utility_function(E->get());
+		if (function && !tables->utilities.has(function)) {
+			tables->utilities[function] = E->get();
+		}
+	}
+
+	functions.clear();
+	GDScriptUtilityFunctions::get_function_list(&functions);
+	for (const List<StringName>::Element *E = functions.front(); E; E = E->next()) {
+		GDScriptUtilityFunctions::FunctionPtr function = GDScriptUtilityFunctions::get_function(E->get());
+		if (function && !tables->gds_utilities.has(function)) {
+			tables->gds_utilities[function] = E->get();
+		}
+	}
+
+	lookup_tables = tables;
+	return lookup_tables;
+}
+
+String GDScriptBytecodeCache::_get_file_md5(const String &p_path) {
+	uint64_t modified_time = FileAccess::get_modified_time(p_path);
+
+	MutexLock lock(mutex);
+
+	const FileHash *hash = file_hashes.getptr(p_path);
+	if (hash && hash->modified_time == modified_time && modified_time != 0) {
+		return hash->md5;
+	}
+
+	FileHash new_hash;
+	new_hash.modified_time = modified_time;
+	new_hash.md5 = FileAccess::get_md5(p_path);
+	file_hashes[p_path] = new_hash;
+	return new_hash.md5;
+}
+
+bool GDScriptBytecodeCache::_is_plain_variant(const Variant &p_value) {
+	switch (p_value.get_type()) {
+		case Variant::OBJECT:
+		case Variant::RID:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL:
+			return false;
+		case Variant::ARRAY: {
+			const Array array = p_value;
+			if (array.is_typed()) {
+				return false;
+			}
+			for (int i = 0; i < array.size(); i++) {
+				if (!_is_plain_variant(array[i])) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case Variant::DICTIONARY: {
+			const Dictionary dict = p_value;
+			List<Variant> keys;
+			dict.get_key_list(&keys);
+			for (const List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+				if (!_is_plain_variant(E->get()) || !_is_plain_variant(dict[E->get()])) {
+					return false;
+				}
+			}
+			return true;
+		}
+		default:
+			return true;
+	}
+}
+
+String GDScriptBytecodeCache::_get_script_path(const GDScript *p_script) {
+	if (!p_script->path.is_empty()) {
+		return p_script->path;
+	}
+	return p_script->get_path();
+}
+
+// Scripts are referenced by the path of the file that contains them and the
+// names of the inner classes leading to them. An empty path stands for the
+// script being serialized.
+void GDScriptBytecodeCache::_write_script_ref(Writer &w, const GDScript *p_script) {
+	Vector<StringName> names;
+	const GDScript *top = p_script;
+	while (top->_owner) {
+		const GDScript *owner = top->_owner;
+		const Map<StringName, Ref<GDScript>>::Element *E = owner->subclasses.front();
+		while (E && E->get().ptr() != top) {
+			E = E->next();
+		}
+		if (!E) {
+			w.fail("Inner class '" + top->fully_qualified_name + "' is not reachable from its owner.");
+			return;
+		}
+		names.push_back(E->key());
+		top = owner;
+	}
+
+	if (top == w.root) {
+		w.put_string(String());
+	} else {
+		String path = _get_script_path(top);
+		if (!path.is_resource_file()) {
+			w.fail("Script '" + path + "' is not saved to a file.");
+			return;
+		}
+		w.put_string(path);
+		w.script_paths.insert(path);
+	}
+
+	w.put_u32(names.size());
+	for (int i = names.size() - 1; i >= 0; i--) {
+		w.put_string(names[i]);
+	}
+}
+
+Ref<GDScript> GDScriptBytecodeCache::_read_script_ref(Reader &r, bool p_full) {
+	String path = r.get_string();
+	uint32_t depth = r.get_count();
+	if (r.failed()) {
+		return Ref<GDScript>();
+	}
+
+	Ref<GDScript> script;
+	if (path.is_empty()) {
+		script = Ref<GDScript>(r.root);
+	} else if (p_full || depth > 0) {
+		// Inner classes only exist once their file is compiled.
+		Error err = OK;
+		script = GDScriptCache::get_full_script(path, err, r.owner_path);
+		if (err != OK || script.is_null() || !script->is_valid()) {
+			r.fail("Can't load script '" + path + "'.");
+			return Ref<GDScript>();
+		}
+	} else {
+		// Same as the compiler, other scripts are completed in GDScriptCache::finish_compiling().
+		script = GDScriptCache::get_shallow_script(path, r.owner_path);
+	}
+
+	for (uint32_t i = 0; i < depth; i++) {
+		StringName name = r.get_string();
+		if (r.failed()) {
+			return Ref<GDScript>();
+		}
+		if (!script->subclasses.has(name)) {
+			r.fail("Inner class '" + String(name) + "' not found in '" + script->fully_qualified_name + "'.");
+			return Ref<GDScript>();
+		}
+		script = script->subclasses[name];
+	}
+
+	return script;
+}
+
+void GDScriptBytecodeCache::_write_value(Writer &w, const Variant &p_value) {
+	if (p_value.get_type() != Variant::OBJECT) {
+		if (!_is_plain_variant(p_value)) {
+			w.fail("Constant of type '" + Variant::get_type_name(p_value.get_type()) + "' can't be stored.");
+			return;
+		}
+		w.put_u8(VALUE_VARIANT);
+		w.put_variant(p_value);
+		return;
+	}
+
+	Object *obj = p_value.get_validated_object();
+	if (!obj) {
+		w.put_u8(VALUE_NULL_OBJECT);
+		return;
+	}
+
+	GDScript *script = Object::cast_to<GDScript>(obj);
+	if (script) {
+		w.put_u8(VALUE_SCRIPT);
+		_write_script_ref(w, script);
+		return;
+	}
+
+	// Native classes, engine singletons and autoloads.
+	const Map<const Object *, StringName>::Element *E = w.globals.find(obj);
+	if (E) {
+		w.put_u8(VALUE_GLOBAL);
+		w.put_string(E->get());
+		return;
+	}
+
+	Resource *resource = Object::cast_to<Resource>(obj);
+	if (resource && resource->get_path().is_resource_file()) {
+		w.put_u8(VALUE_RESOURCE);
+		w.put_string(resource->get_path());
+		return;
+	}
+
+	w.fail("Constant object of class '" + obj->get_class() + "' can't be stored.");
+}
+
+Variant GDScriptBytecodeCache::_read_value(Reader &r) {
+	switch (r.get_u8()) {
+		case VALUE_VARIANT:
+			return r.get_variant();
+		case VALUE_NULL_OBJECT:
+			return Variant((Object *)nullptr);
+		case VALUE_SCRIPT:
+			return _read_script_ref(r, false);
+		case VALUE_RESOURCE: {
+			String path = r.get_string();
+			if (r.failed()) {
+				return Variant();
+			}
+			RES resource = ResourceLoader::load(path);
+			if (resource.is_null()) {
+				r.fail("Can't load resource '" + path + "'.");
+			}
+			return resource;
+		}
+		case VALUE_GLOBAL: {
+			StringName name = r.get_string();
+			if (r.failed()) {
+				return Variant();
+			}
+			const Map<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+			if (!global_map.has(name)) {
+				r.fail("Global '" + String(name) + "' doesn't exist.");
+				return Variant();
+			}
+			return GDScriptLanguage::get_singleton()->get_global_array()[global_map[name]];
+		}
+		default:
+			r.corrupt = true;
+			return Variant();
+	}
+}
+
+void GDScriptBytecodeCache::_write_data_type(Writer &w, const GDScriptDataType &p_type) {
+	w.put_u8(p_type.has_type);
+	w.put_u8(p_type.kind);
+	w.put_u32(p_type.builtin_type);
+	w.put_string(p_type.native_type);
+	w.put_u8(p_type.script_type != nullptr);
+	if (p_type.script_type) {
+		// Types pointing to their own script don't hold a reference, see GDScriptCompiler::_gdtype_from_datatype().
+		w.put_u8(p_type.script_type_ref.is_valid());
+		_write_value(w, p_type.script_type);
+	}
+	w.put_u8(p_type.has_container_element_type());
+	if (p_type.has_container_element_type()) {
+		_write_data_type(w, p_type.get_container_element_type());
+	}
+}
+
+GDScriptDataType GDScriptBytecodeCache::_read_data_type(Reader &r) {
+	GDScriptDataType type;
+	type.has_type = r.get_u8();
+	uint8_t kind = r.get_u8();
+	if (kind > GDScriptDataType::GDSCRIPT) {
+		r.corrupt = true;
+		return type;
+	}
+	type.kind = GDScriptDataType::Kind(kind);
+	type.builtin_type = r.get_type();
+	type.native_type = r.get_string();
+	if (r.get_u8()) {
+		bool holds_ref = r.get_u8();
+		Variant value = _read_value(r);
+		Script *script = Object::cast_to<Script>(value.get_validated_object());
+		if (!script) {
+			r.fail("Type refers to a missing script.");
+			return type;
+		}
+		type.script_type = script;
+		if (holds_ref) {
+			type.script_type_ref = Ref<Script>(script);
+		}
+	}
+	if (r.get_u8()) {
+		type.set_container_element_type(_read_data_type(r));
+	}
+	return type;
+}
+
+template <class T, class K>
+static const K *_find_key(const Map<T, K> &p_map, T p_function) {
+	const typename Map<T, K>::Element *E = p_map.find(p_function);
+	return E ? &E->get() : nullptr;
+}
+
+void GDScriptBytecodeCache::_write_function(Writer &w, const GDScriptFunction *p_function) {
+	const LookupTables *tables = w.tables;
+
+	w.put_string(p_function->name);
+	w.put_u8(p_function->_static);
+	w.put_u32(p_function->rpc_mode);
+	_write_data_type(w, p_function->return_type);
+
+	w.put_u32(p_function->_argument_count);
+	w.put_u32(p_function->argument_types.size());
+	for (int i = 0; i < p_function->argument_types.size(); i++) {
+		_write_data_type(w, p_function->argument_types[i]);
+	}
+#ifdef TOOLS_ENABLED
+	w.put_u32(p_function->arg_names.size());
+	for (int i = 0; i < p_function->arg_names.size(); i++) {
+		w.put_string(p_function->arg_names[i]);
+	}
+#else
+	w.put_u32(0);
+#endif
+	w.put_u32(p_function->default_arguments.size());
+	for (int i = 0; i < p_function->default_arguments.size(); i++) {
+		w.put_u32(p_function->default_arguments[i]);
+	}
+
+	w.put_u32(p_function->_initial_line);
+	w.put_u32(p_function->_stack_size);
+	w.put_u32(p_function->_instruction_args_size);
+	w.put_u32(p_function->_ptrcall_args_size);
+	w.put_u32(p_function->_inline_caches_count);
+
+	w.put_u32(p_function->code.size());
+	for (int i = 0; i < p_function->code.size(); i++) {
+		w.put_u32(p_function->code[i]);
+	}
+
+	w.put_u32(p_function->constants.size());
+	for (int i = 0; i < p_function->constants.size(); i++) {
+		_write_value(w, p_function->constants[i]);
+	}
+
+	w.put_u32(p_function->global_names.size());
+	for (int i = 0; i < p_function->global_names.size(); i++) {
+		w.put_string(p_function->global_names[i]);
+	}
+
+	w.put_u32(p_function->operator_funcs.size());
+	for (int i = 0; i < p_function->operator_funcs.size(); i++) {
+		const OperatorKey *key = _find_key(tables->operators, p_function->operator_funcs[i]);
+		if (!key) {
+			w.fail("Unknown operator evaluator.");
+			return;
+		}
+		w.put_u32(key->op);
+		w.put_u32(key->type_a);
+		w.put_u32(key->type_b);
+	}
+
+	w.put_u32(p_function->setters.size());
+	for (int i = 0; i < p_function->setters.size(); i++) {
+		const MemberKey *key = _find_key(tables->setters, p_function->setters[i]);
+		if (!key) {
+			w.fail("Unknown member setter.");
+			return;
+		}
+		w.put_u32(key->type);
+		w.put_string(key->name);
+	}
+
+	w.put_u32(p_function->getters.size());
+	for (int i = 0; i < p_function->getters.size(); i++) {
+		const MemberKey *key = _find_key(tables->getters, p_function->getters[i]);
+		if (!key) {
+			w.fail("Unknown member getter.");
+			return;
+		}
+		w.put_u32(key->type);
+		w.put_string(key->name);
+	}
+
+	w.put_u32(p_function->keyed_setters.size());
+	for (int i = 0; i < p_function->keyed_setters.size(); i++) {
+		const Variant::Type *type = _find_key(tables->keyed_setters, p_function->keyed_setters[i]);
+		if (!type) {
+			w.fail("Unknown keyed setter.");
+			return;
+		}
+		w.put_u32(*type);
+	}
+
+	w.put_u32(p_function->keyed_getters.size());
+	for (int i = 0; i < p_function->keyed_getters.size(); i++) {
+		const Variant::Type *type = _find_key(tables->keyed_getters, p_function->keyed_getters[i]);
+		if (!type) {
+			w.fail("Unknown keyed getter.");
+			return;
+		}
+		w.put_u32(*type);
+	}
+
+	w.put_u32(p_function->indexed_setters.size());
+	for (int i = 0; i < p_function->indexed_setters.size(); i++) {
+		const Variant::Type *type = _find_key(tables->indexed_setters, p_function->indexed_setters[i]);
+		if (!type) {
+			w.fail("Unknown indexed setter.");
+			return;
+		}
+		w.put_u32(*type);
+	}
+
+	w.put_u32(p_function->indexed_getters.size());
+	for (int i = 0; i < p_function->indexed_getters.size(); i++) {
+		const Variant::Type *type = _find_key(tables->indexed_getters, p_function->indexed_getters[i]);
+		if (!type) {
+			w.fail("Unknown indexed getter.");
+			return;
+		}
+		w.put_u32(*type);
+	}
+
+	w.put_u32(p_function->builtin_methods.size());
+	for (int i = 0; i < p_function->builtin_methods.size(); i++) {
+		const MemberKey *key = _find_key(tables->builtin_methods, p_function->builtin_methods[i]);
+		if (!key) {
+			w.fail("Unknown built-in method.");
+			return;
+		}
+		w.put_u32(key->type);
+		w.put_string(key->name);
+	}
+
+	w.put_u32(p_function->constructors.size());
+	for (int i = 0; i < p_function->constructors.size(); i++) {
+		const ConstructorKey *key = _find_key(tables->constructors, p_function->constructors[i]);
+		if (!key) {
+			w.fail("Unknown constructor.");
+			return;
+		}
+		w.put_u32(key->type);
+		w.put_u32(key->index);
+	}
+
+	w.put_u32(p_function->utilities.size());
+	for (int i = 0; i < p_function->utilities.size(); i++) {
+		const StringName *name = _find_key(tables->utilities, p_function->utilities[i]);
+		if (!name) {
+			w.fail("Unknown utility function.");
+			return;
+		}
+		w.put_string(*name);
+	}
+
+	w.put_u32(p_function->gds_utilities.size());
+	for (int i = 0; i < p_function->gds_utilities.size(); i++) {
+		const StringName *name = _find_key(tables->gds_utilities, p_function->gds_utilities[i]);
+		if (!name) {
+			w.fail("Unknown GDScript utility function.");
+			return;
+		}
+		w.put_string(*name);
+	}
+
+	w.put_u32(p_function->methods.size());
+	for (int i = 0; i < p_function->methods.size(); i++) {
+		w.put_string(p_function->methods[i]->get_instance_class());
+		w.put_string(p_function->methods[i]->get_name());
+	}
+
+	w.put_u32(p_function->lambdas.size());
+	for (int i = 0; i < p_function->lambdas.size(); i++) {
+		_write_function(w, p_function->lambdas[i]);
+	}
+
+	w.put_u32(p_function->temporary_slots.size());
+	for (const Map<int, Variant::Type>::Element *E = p_function->temporary_slots.front(); E; E = E->next()) {
+		w.put_u32(E->key());
+		w.put_u32(E->get());
+	}
+}
+
+GDScriptFunction *GDScriptBytecodeCache::_read_function(Reader &r, GDScript *p_script) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_script;
+	function->source = p_script->get_path();
+
+	function->name = r.get_string();
+	function->_static = r.get_u8();
+	function->rpc_mode = MultiplayerAPI::RPCMode(r.get_u32());
+	function->return_type = _read_data_type(r);
+
+	function->_argument_count = r.get_u32();
+	uint32_t count = r.get_count();
+	function->argument_types.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		function->argument_types.write[i] = _read_data_type(r);
+	}
+	count = r.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		StringName arg_name = r.get_string();
+#ifdef TOOLS_ENABLED
+		function->arg_names.push_back(arg_name);
+#endif
+	}
+	count = r.get_count();
+	function->default_arguments.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		function->default_arguments.write[i] = r.get_u32();
+	}
+
+	function->_initial_line = r.get_u32();
+	function->_stack_size = r.get_u32();
+	function->_instruction_args_size = r.get_u32();
+	function->_ptrcall_args_size = r.get_u32();
+	int inline_caches_count = r.get_count();
+
+	count = r.get_count();
+	function->code.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		function->code.write[i] = r.get_u32();
+	}
+
+	count = r.get_count();
+	function->constants.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		function->constants.write[i] = _read_value(r);
+	}
+
+	count = r.get_count();
+	function->global_names.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		function->global_names.write[i] = r.get_string();
+	}
+
+	count = r.get_count();
+	function->operator_funcs.resize(count);
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		uint32_t op = r.get_u32();
+		Variant::Type type_a = r.get_type();
+		Variant::Type type_b = r.get_type();
+		if (op >= Variant::OP_MAX) {
+			r.corrupt = true;
+			break;
+		}
+		function->operator_funcs.write[i] = Variant::get_validated_operator_evaluator(Variant::Operator(op), type_a, type_b);
+		if (!function->operator_funcs[i]) {
+			r.fail("Operator '" + Variant::get_operator_name(Variant::Operator(op)) + "' is not available for '" + Variant::get_type_name(type_a) + "' and '" + Variant::get_type_name(type_b) + "'.");
+		}
+	}
+
+	count = r.get_count();
+	function->setters.resize(count);
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		Variant::Type type = r.get_type();
+		StringName member = r.get_string();
+		function->setters.write[i] = Variant::get_member_validated_setter(type, member);
+		if (!function->setters[i]) {
+			r.fail("Member '" + String(member) + "' can't be set on '" + Variant::get_type_name(type) + "'.");
+		}
+	}
+
+	count = r.get_count();
+	function->getters.resize(count);
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		Variant::Type type = r.get_type();
+		StringName member = r.get_string();
+		function->getters.write[i] = Variant::get_member_validated_getter(type, member);
+		if (!function->getters[i]) {
+			r.fail("Member '" + String(member) + "' can't be read from '" + Variant::get_type_name(type) + "'.");
+		}
+	}
+
+	count = r.get_count();
+	function->keyed_setters.resize(count);
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		function->keyed_setters.write[i] = Variant::get_member_validated_keyed_setter(r.get_type());
+		if (!function->keyed_setters[i]) {
+			r.fail("Keyed setter not available.");
+		}
+	}
+
+	count = r.get_count();
+	function->keyed_getters.resize(count);
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		function->keyed_getters.write[i] = Variant::get_member_validated_keyed_getter(r.get_type());
+		if (!function->keyed_getters[i]) {
+			r.fail("Keyed getter not available.");
+		}
+	}
+
+	count = r.get_count();
+	function->indexed_setters.resize(count);
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		function->indexed_setters.write[i] = Variant::get_member_validated_indexed_setter(r.get_type());
+		if (!function->indexed_setters[i]) {
+			r.fail("Indexed setter not available.");
+		}
+	}
+
+	count = r.get_count();
+	function->indexed_getters.resize(count);
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		function->indexed_getters.write[i] = Variant::get_member_validated_indexed_getter(r.get_type());
+		if (!function->indexed_getters[i]) {
+			r.fail("Indexed getter not available.");
+		}
+	}
+
+	count = r.get_count();
+	function->builtin_methods.resize(count);
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		Variant::Type type = r.get_type();
+		StringName method = r.get_string();
+		function->builtin_methods.write[i] = Variant::get_validated_builtin_method(type, method);
+		if (!function->builtin_methods[i]) {
+			r.fail("Method '" + String(method) + "' not found in '" + Variant::get_type_name(type) + "'.");
+		}
+	}
+
+	count = r.get_count();
+	function->constructors.resize(count);
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		Variant::Type type = r.get_type();
+		uint32_t index = r.get_u32();
+		if (r.failed() || int(index) >= Variant::get_constructor_count(type)) {
+			r.fail("Constructor not found for '" + Variant::get_type_name(type) + "'.");
+			break;
+		}
+		function->constructors.write[i] = Variant::get_validated_constructor(type, index);
+	}
+
+	count = r.get_count();
+	function->utilities.resize(count);
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		StringName utility = r.get_string();
+		function->utilities.write[i] = Variant::get_validated_utility_function(utility);
+		if (!function->utilities[i]) {
+			r.fail("Utility function '" + String(utility) + "' not found.");
+		}
+	}
+
+	count = r.get_count();
+	function->gds_utilities.resize(count);
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		StringName utility = r.get_string();
+		function->gds_utilities.write[i] = GDScriptUtilityFunctions::get_function(utility);
+		if (!function->gds_utilities[i]) {
+			r.fail("GDScript utility function '" + String(utility) + "' not found.");
+		}
+	}
+
+	count = r.get_count();
+	function->methods.resize(count);
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		StringName class_name = r.get_string();
+		StringName method = r.get_string();
+		function->methods.write[i] = ClassDB::get_method(class_name, method);
+		if (!function->methods[i]) {
+			r.fail("Method '" + String(method) + "' not found in class '" + String(class_name) + "'.");
+		}
+	}
+
+	count = r.get_count();
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		// Pushed right away, so the function owns the lambda even if reading fails.
+		function->lambdas.push_back(_read_function(r, p_script));
+	}
+
+	count = r.get_count();
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		int slot = r.get_u32();
+		function->temporary_slots[slot] = r.get_type();
+	}
+
+	if (r.failed()) {
+		return function;
+	}
+
+	// Same as GDScriptByteCodeGenerator::write_end().
+	function->_constant_count = function->constants.size();
+	function->_constants_ptr = function->constants.size() ? function->constants.ptrw() : nullptr;
+	function->_global_names_count = function->global_names.size();
+	function->_global_names_ptr = function->global_names.size() ? function->global_names.ptr() : nullptr;
+	function->_code_size = function->code.size();
+	function->_code_ptr = function->code.size() ? function->code.ptr() : nullptr;
+	function->_default_arg_count = function->default_arguments.size() ? function->default_arguments.size() - 1 : 0;
+	function->_default_arg_ptr = function->default_arguments.size() ? function->default_arguments.ptr() : nullptr;
+	function->_operator_funcs_count = function->operator_funcs.size();
+	function->_operator_funcs_ptr = function->operator_funcs.size() ? function->operator_funcs.ptr() : nullptr;
+	function->_setters_count = function->setters.size();
+	function->_setters_ptr = function->setters.size() ? function->setters.ptr() : nullptr;
+	function->_getters_count = function->getters.size();
+	function->_getters_ptr = function->getters.size() ? function->getters.ptr() : nullptr;
+	function->_keyed_setters_count = function->keyed_setters.size();
+	function->_keyed_setters_ptr = function->keyed_setters.size() ? function->keyed_setters.ptr() : nullptr;
+	function->_keyed_getters_count = function->keyed_getters.size();
+	function->_keyed_getters_ptr = function->keyed_getters.size() ? function->keyed_getters.ptr() : nullptr;
+	function->_indexed_setters_count = function->indexed_setters.size();
+	function->_indexed_setters_ptr = function->indexed_setters.size() ? function->indexed_setters.ptr() : nullptr;
+	function->_indexed_getters_count = function->indexed_getters.size();
+	function->_indexed_getters_ptr = function->indexed_getters.size() ? function->indexed_getters.ptr() : nullptr;
+	function->_builtin_methods_count = function->builtin_methods.size();
+	function->_builtin_methods_ptr = function->builtin_methods.size() ? function->builtin_methods.ptr() : nullptr;
+	function->_constructors_count = function->constructors.size();
+	function->_constructors_ptr = function->constructors.size() ? function->constructors.ptr() : nullptr;
+	function->_utilities_count = function->utilities.size();
+	function->_utilities_ptr = function->utilities.size() ? function->utilities.ptr() : nullptr;
+	function->_gds_utilities_count = function->gds_utilities.size();
+	function->_gds_utilities_ptr = function->gds_utilities.size() ? function->gds_utilities.ptr() : nullptr;
+	function->_methods_count = function->methods.size();
+	function->_methods_ptr = function->methods.size() ? function->methods.ptrw() : nullptr;
+	function->_lambdas_count = function->lambdas.size();
+	function->_lambdas_ptr = function->lambdas.size() ? function->lambdas.ptrw() : nullptr;
+	function->_allocate_inline_caches(inline_caches_count);
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	return function;
+}
+
+void GDScriptBytecodeCache::_write_class_tree(Writer &w, const GDScript *p_script) {
+	w.put_u32(p_script->subclasses.size());
+	for (const Map<StringName, Ref<GDScript>>::Element *E = p_script->subclasses.front(); E; E = E->next()) {
+		w.put_string(E->key());
+		_write_class_tree(w, E->get().ptr());
+	}
+}
+
+void GDScriptBytecodeCache::_read_class_tree(Reader &r, GDScript *p_script) {
+	// Same as GDScriptCompiler::_make_scripts(), so classes can refer to each other before they are read.
+	p_script->subclasses.clear();
+
+	uint32_t count = r.get_count();
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		StringName name = r.get_string();
+		String fully_qualified_name = p_script->fully_qualified_name + "::" + name;
+
+		Ref<GDScript> subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(fully_qualified_name);
+		if (subclass.is_null()) {
+			subclass.instance();
+		}
+		subclass->_owner = p_script;
+		subclass->fully_qualified_name = fully_qualified_name;
+		p_script->subclasses.insert(name, subclass);
+
+		_read_class_tree(r, subclass.ptr());
+	}
+}
+
+void GDScriptBytecodeCache::_write_class(Writer &w, const GDScript *p_script) {
+	w.put_u8(p_script->tool);
+	w.put_string(p_script->name);
+	w.put_string(p_script->native.is_valid() ? String(p_script->native->get_name()) : String());
+	w.put_u8(p_script->base.is_valid());
+	if (p_script->base.is_valid()) {
+		_write_script_ref(w, p_script->base.ptr());
+	}
+
+	w.put_u32(p_script->member_indices.size());
+	for (const Map<StringName, GDScript::MemberInfo>::Element *E = p_script->member_indices.front(); E; E = E->next()) {
+		w.put_string(E->key());
+		w.put_u32(E->get().index);
+		w.put_string(E->get().setter);
+		w.put_string(E->get().getter);
+		w.put_u32(E->get().rpc_mode);
+		_write_data_type(w, E->get().data_type);
+	}
+
+	w.put_u32(p_script->members.size());
+	for (const Set<StringName>::Element *E = p_script->members.front(); E; E = E->next()) {
+		w.put_string(E->get());
+	}
+
+	w.put_u32(p_script->member_info.size());
+	for (const Map<StringName, PropertyInfo>::Element *E = p_script->member_info.front(); E; E = E->next()) {
+		const PropertyInfo &info = E->get();
+		w.put_string(E->key());
+		w.put_u32(info.type);
+		w.put_string(info.name);
+		w.put_string(info.class_name);
+		w.put_u32(info.hint);
+		w.put_string(info.hint_string);
+		w.put_u32(info.usage);
+	}
+
+	w.put_u32(p_script->constants.size());
+	for (const Map<StringName, Variant>::Element *E = p_script->constants.front(); E; E = E->next()) {
+		w.put_string(E->key());
+		_write_value(w, E->get());
+	}
+
+	w.put_u32(p_script->_signals.size());
+	for (const Map<StringName, Vector<StringName>>::Element *E = p_script->_signals.front(); E; E = E->next()) {
+		w.put_string(E->key());
+		w.put_u32(E->get().size());
+		for (int i = 0; i < E->get().size(); i++) {
+			w.put_string(E->get()[i]);
+		}
+	}
+
+	w.put_u32(p_script->member_functions.size());
+	for (const Map<StringName, GDScriptFunction *>::Element *E = p_script->member_functions.front(); E; E = E->next()) {
+		w.put_string(E->key());
+		_write_function(w, E->get());
+	}
+
+	for (const Map<StringName, Ref<GDScript>>::Element *E = p_script->subclasses.front(); E; E = E->next()) {
+		_write_class(w, E->get().ptr());
+	}
+}
+
+void GDScriptBytecodeCache::_read_class(Reader &r, GDScript *p_script) {
+	p_script->tool = r.get_u8();
+	p_script->name = r.get_string();
+
+	StringName native_name = r.get_string();
+	p_script->native = Ref<GDScriptNativeClass>();
+	if (native_name != StringName()) {
+		const Map<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+		if (global_map.has(native_name)) {
+			p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[global_map[native_name]];
+		}
+		if (p_script->native.is_null()) {
+			r.fail("Native class '" + String(native_name) + "' not found.");
+			return;
+		}
+	}
+
+	p_script->base = Ref<GDScript>();
+	p_script->_base = nullptr;
+	if (r.get_u8()) {
+		p_script->base = _read_script_ref(r, true);
+		p_script->_base = p_script->base.ptr();
+		if (p_script->base.is_null()) {
+			return;
+		}
+	}
+
+	p_script->member_indices.clear();
+	uint32_t count = r.get_count();
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		StringName name = r.get_string();
+		GDScript::MemberInfo minfo;
+		minfo.index = r.get_u32();
+		minfo.setter = r.get_string();
+		minfo.getter = r.get_string();
+		minfo.rpc_mode = MultiplayerAPI::RPCMode(r.get_u32());
+		minfo.data_type = _read_data_type(r);
+		p_script->member_indices[name] = minfo;
+	}
+
+	p_script->members.clear();
+	count = r.get_count();
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		p_script->members.insert(r.get_string());
+	}
+
+	p_script->member_info.clear();
+	count = r.get_count();
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		StringName name = r.get_string();
+		PropertyInfo info;
+		info.type = r.get_type();
+		info.name = r.get_string();
+		info.class_name = r.get_string();
+		info.hint = PropertyHint(r.get_u32());
+		info.hint_string = r.get_string();
+		info.usage = r.get_u32();
+		p_script->member_info[name] = info;
+	}
+
+	p_script->constants.clear();
+	count = r.get_count();
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		StringName name = r.get_string();
+		p_script->constants[name] = _read_value(r);
+	}
+
+	p_script->_signals.clear();
+	count = r.get_count();
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		StringName name = r.get_string();
+		Vector<StringName> parameters;
+		parameters.resize(r.get_count());
+		for (int j = 0; j < parameters.size(); j++) {
+			parameters.write[j] = r.get_string();
+		}
+		p_script->_signals[name] = parameters;
+	}
+
+	for (Map<StringName, GDScriptFunction *>::Element *E = p_script->member_functions.front(); E; E = E->next()) {
+		memdelete(E->get());
+	}
+	p_script->member_functions.clear();
+	p_script->initializer = nullptr;
+	p_script->implicit_initializer = nullptr;
+
+	count = r.get_count();
+	for (uint32_t i = 0; i < count && !r.failed(); i++) {
+		StringName name = r.get_string();
+		if (r.failed()) {
+			break;
+		}
+		// Stored before checking for errors, so a failed read is cleaned up by the next compilation.
+		p_script->member_functions[name] = _read_function(r, p_script);
+	}
+	if (r.failed()) {
+		return;
+	}
+
+	if (p_script->member_functions.has(GDScriptLanguage::get_singleton()->strings._init)) {
+		p_script->initializer = p_script->member_functions[GDScriptLanguage::get_singleton()->strings._init];
+	}
+	if (p_script->member_functions.has("@implicit_new")) {
+		p_script->implicit_initializer = p_script->member_functions["@implicit_new"];
+	}
+
+	for (Map<StringName, Ref<GDScript>>::Element *E = p_script->subclasses.front(); E && !r.failed(); E = E->next()) {
+		_read_class(r, E->get().ptr());
+	}
+
+	p_script->valid = !r.failed();
+}
+
+String GDScriptBytecodeCache::get_cache_path(const String &p_script_path) {
+	return ProjectSettings::IMPORTED_FILES_PATH.get_base_dir().plus_file("gdscript_cache").plus_file(p_script_path.md5_text() + ".gdc");
+}
+
+bool GDScriptBytecodeCache::is_load_enabled(const String &p_script_path) {
+	if (!p_script_path.is_resource_file() || !GLOBAL_GET("gdscript/bytecode_cache/enabled")) {
+		return false;
+	}
+	// The editor needs the parser for documentation and the debugger needs the stack info it emits.
+	return !Engine::get_singleton()->is_editor_hint() && !EngineDebugger::is_active();
+}
+
+bool GDScriptBytecodeCache::is_load_enabled(const GDScript *p_script) {
+	return is_load_enabled(_get_script_path(p_script));
+}
+
+bool GDScriptBytecodeCache::is_save_enabled(const GDScript *p_script) {
+#ifdef TOOLS_ENABLED
+	// The editor reloads scripts as they are edited, only projects run from it write the cache.
+	if (Engine::get_singleton()->is_editor_hint()) {
+		return false;
+	}
+	return _get_script_path(p_script).is_resource_file() && GLOBAL_GET("gdscript/bytecode_cache/enabled");
+#else
+	// Exported projects can't write to res://, their cache is added on export.
+	return false;
+#endif
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::serialize(const GDScript *p_script, Error &r_error) {
+	r_error = ERR_UNAVAILABLE;
+	ERR_FAIL_NULL_V(p_script, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(!p_script->valid, Vector<uint8_t>(), "Only compiled scripts can be serialized.");
+
+	const String script_path = _get_script_path(p_script);
+
+	Writer w;
+	w.root = p_script;
+	w.tables = _get_lookup_tables();
+
+	const Map<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+	const Variant *global_array = GDScriptLanguage::get_singleton()->get_global_array();
+	for (const Map<StringName, int>::Element *E = global_map.front(); E; E = E->next()) {
+		const Variant &global = global_array[E->get()];
+		if (global.get_type() == Variant::OBJECT && global.get_validated_object()) {
+			w.globals[global.get_validated_object()] = E->key();
+		}
+	}
+
+	_write_class_tree(w, p_script);
+	_write_class(w, p_script);
+	if (w.failed()) {
+		print_verbose("GDScript: Can't cache '" + script_path + "': " + w.error);
+		return Vector<uint8_t>();
+	}
+
+	// The compiled code depends on the interface of every script it was compiled against, and on what those were compiled against.
+	Set<String> dependencies;
+	if (!script_path.is_empty()) {
+		GDScriptCache::get_dependencies(script_path, dependencies);
+	}
+	for (const Set<String>::Element *E = w.script_paths.front(); E; E = E->next()) {
+		dependencies.insert(E->get());
+		GDScriptCache::get_dependencies(E->get(), dependencies);
+	}
+	dependencies.erase(script_path);
+
+	Writer payload;
+	payload.put_string(p_script->source.md5_text());
+	payload.put_u32(dependencies.size());
+	for (const Set<String>::Element *E = dependencies.front(); E; E = E->next()) {
+		String md5 = _get_file_md5(E->get());
+		if (md5.is_empty()) {
+			print_verbose("GDScript: Can't cache '" + script_path + "': Dependency '" + E->get() + "' can't be read.");
+			return Vector<uint8_t>();
+		}
+		payload.put_string(E->get());
+		payload.put_string(md5);
+	}
+	payload.buffer.append_array(w.buffer);
+
+	Writer out;
+	out.buffer.resize(4);
+	memcpy(out.buffer.ptrw(), cache_magic, 4);
+	out.put_u32(FORMAT_VERSION);
+	out.put_u32(VERSION_HEX);
+	out.put_u32(GDScriptFunction::OPCODE_END);
+	out.put_u32(Variant::VARIANT_MAX);
+	out.put_u32(payload.buffer.size());
+	out.put_u32(hash_djb2_buffer(payload.buffer.ptr(), payload.buffer.size()));
+	out.buffer.append_array(payload.buffer);
+
+	r_error = OK;
+	return out.buffer;
+}
+
+Error GDScriptBytecodeCache::deserialize(GDScript *p_script, const Vector<uint8_t> &p_data) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+
+	Reader r;
+	r.data = p_data.ptr();
+	r.size = p_data.size();
+
+	if (r.size < 4 || memcmp(r.data, cache_magic, 4) != 0) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	r.pos = 4;
+
+	// Written by another engine build, nothing in it can be trusted.
+	if (r.get_u32() != FORMAT_VERSION || r.get_u32() != VERSION_HEX || r.get_u32() != GDScriptFunction::OPCODE_END || r.get_u32() != Variant::VARIANT_MAX) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	uint32_t payload_size = r.get_u32();
+	uint32_t checksum = r.get_u32();
+	if (r.failed() || payload_size != uint32_t(r.size - r.pos) || hash_djb2_buffer(r.data + r.pos, payload_size) != checksum) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	// Stale caches are expected, so they are rejected silently.
+	if (r.get_string() != p_script->source.md5_text()) {
+		return ERR_INVALID_DATA;
+	}
+	Set<String> dependencies;
+	uint32_t dependency_count = r.get_count();
+	for (uint32_t i = 0; i < dependency_count && !r.failed(); i++) {
+		String path = r.get_string();
+		String md5 = r.get_string();
+		if (!r.failed() && _get_file_md5(path) != md5) {
+			return ERR_INVALID_DATA;
+		}
+		dependencies.insert(path);
+	}
+	ERR_FAIL_COND_V_MSG(r.failed(), ERR_FILE_CORRUPT, "Malformed GDScript bytecode cache.");
+
+	r.root = p_script;
+	r.owner_path = _get_script_path(p_script);
+
+	p_script->fully_qualified_name = r.owner_path;
+	p_script->_owner = nullptr;
+
+	_read_class_tree(r, p_script);
+	_read_class(r, p_script);
+
+	ERR_FAIL_COND_V_MSG(r.corrupt, ERR_FILE_CORRUPT, "Malformed GDScript bytecode cache for '" + r.owner_path + "'.");
+	if (!r.error.is_empty()) {
+		print_verbose("GDScript: Can't use cache for '" + r.owner_path + "': " + r.error);
+		return ERR_CANT_RESOLVE;
+	}
+
+	if (r.owner_path.is_empty()) {
+		return OK;
+	}
+	Error err = GDScriptCache::finish_compiling(r.owner_path);
+	// Keep the whole dependency list, not only the scripts referenced by the compiled code, so caches of scripts
+	// depending on this one are still invalidated by changes to the scripts this one was compiled against.
+	GDScriptCache::add_dependencies(r.owner_path, dependencies);
+	return err;
+}
+
+Error GDScriptBytecodeCache::load(GDScript *p_script) {
+	String cache_path = get_cache_path(_get_script_path(p_script));
+	if (!FileAccess::exists(cache_path)) {
+		return ERR_FILE_NOT_FOUND;
+	}
+
+	Error err = OK;
+	Vector<uint8_t> data = FileAccess::get_file_as_array(cache_path, &err);
+	if (err != OK) {
+		return err;
+	}
+	return deserialize(p_script, data);
+}
+
+Error GDScriptBytecodeCache::save(const GDScript *p_script) {
+	Error err = OK;
+	Vector<uint8_t> data = serialize(p_script, err);
+	if (err != OK) {
+		return err;
+	}
+
+	String cache_path = get_cache_path(_get_script_path(p_script));
+
+	DirAccessRef da = DirAccess::create(DirAccess::ACCESS_RESOURCES);
+	if (!da->dir_exists(cache_path.get_base_dir())) {
+		err = da->make_dir_recursive(cache_path.get_base_dir());
+		ERR_FAIL_COND_V_MSG(err != OK, err, "Can't create GDScript cache directory '" + cache_path.get_base_dir() + "'.");
+	}
+
+	FileAccessRef f = FileAccess::open(cache_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(!f, err, "Can't write GDScript cache file '" + cache_path + "'.");
+	f->store_buffer(data.ptr(), data.size());
+	return OK;
+}
+
+void GDScriptBytecodeCache::clear() {
+	MutexLock lock(mutex);
+
+	if (lookup_tables) {
+		memdelete(lookup_tables);
+		lookup_tables = nullptr;
+	}
+	file_hashes.clear();
+}
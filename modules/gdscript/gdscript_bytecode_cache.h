@@ -0,0 +1,170 @@
+/*************************************************************************/
+/*  gdscript_bytecode_cache.h                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_CACHE_H
+#define GDSCRIPT_BYTECODE_CACHE_H
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/map.h"
+#include "core/templates/set.h"
+#include "gdscript.h"
+
+// Stores compiled GDScript classes (bytecode, constants, global names and type
+// info) in a versioned binary format, so scripts whose source and dependencies
+// did not change can be loaded without running the parser and analyzer.
+//
+// Function pointers used by validated opcodes are stored by name or type and
+// resolved again on load, so a cache is only valid for the engine version that
+// wrote it.
+class GDScriptBytecodeCache {
+	enum {
+		FORMAT_VERSION = 2,
+	};
+
+	enum ValueKind {
+		VALUE_VARIANT,
+		VALUE_NULL_OBJECT,
+		VALUE_SCRIPT,
+		VALUE_RESOURCE,
+		VALUE_GLOBAL,
+	};
+
+	struct OperatorKey {
+		Variant::Operator op = Variant::OP_MAX;
+		Variant::Type type_a = Variant::NIL;
+		Variant::Type type_b = Variant::NIL;
+	};
+
+	struct MemberKey {
+		Variant::Type type = Variant::NIL;
+		StringName name;
+	};
+
+	struct ConstructorKey {
+		Variant::Type type = Variant::NIL;
+		int index = 0;
+	};
+
+	// Reverse lookups from the function pointers stored in a compiled function
+	// to something that can be written to disk. Built once, on first save.
+	struct LookupTables {
+		Map<Variant::ValidatedOperatorEvaluator, OperatorKey> operators;
+		Map<Variant::ValidatedSetter, MemberKey> setters;
+		Map<Variant::ValidatedGetter, MemberKey> getters;
+		Map<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+		Map<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+		Map<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+		Map<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+		Map<Variant::ValidatedBuiltInMethod, MemberKey> builtin_methods;
+		Map<Variant::ValidatedConstructor, ConstructorKey> constructors;
+		Map<Variant::ValidatedUtilityFunction, StringName> utilities;
+		Map<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+	};
+
+	struct Writer {
+		Vector<uint8_t> buffer;
+		const GDScript *root = nullptr;
+		const LookupTables *tables = nullptr;
+		Map<const Object *, StringName> globals;
+		Set<String> script_paths;
+		String error;
+
+		void put_u8(uint8_t p_value);
+		void put_u32(uint32_t p_value);
+		void put_string(const String &p_value);
+		void put_variant(const Variant &p_value);
+		void fail(const String &p_error);
+		bool failed() const { return !error.is_empty(); }
+	};
+
+	struct Reader {
+		const uint8_t *data = nullptr;
+		int size = 0;
+		int pos = 0;
+		GDScript *root = nullptr;
+		String owner_path;
+		bool corrupt = false;
+		String error;
+
+		uint8_t get_u8();
+		uint32_t get_u32();
+		uint32_t get_count();
+		Variant::Type get_type();
+		String get_string();
+		Variant get_variant();
+		void fail(const String &p_error);
+		bool failed() const { return corrupt || !error.is_empty(); }
+	};
+
+	struct FileHash {
+		uint64_t modified_time = 0;
+		String md5;
+	};
+
+	static LookupTables *lookup_tables;
+	static HashMap<String, FileHash> file_hashes;
+	static Mutex mutex;
+
+	static const LookupTables *_get_lookup_tables();
+	static String _get_file_md5(const String &p_path);
+	static bool _is_plain_variant(const Variant &p_value);
+	static String _get_script_path(const GDScript *p_script);
+
+	static void _write_script_ref(Writer &w, const GDScript *p_script);
+	static void _write_value(Writer &w, const Variant &p_value);
+	static void _write_data_type(Writer &w, const GDScriptDataType &p_type);
+	static void _write_function(Writer &w, const GDScriptFunction *p_function);
+	static void _write_class_tree(Writer &w, const GDScript *p_script);
+	static void _write_class(Writer &w, const GDScript *p_script);
+
+	static Ref<GDScript> _read_script_ref(Reader &r, bool p_full);
+	static Variant _read_value(Reader &r);
+	static GDScriptDataType _read_data_type(Reader &r);
+	static GDScriptFunction *_read_function(Reader &r, GDScript *p_script);
+	static void _read_class_tree(Reader &r, GDScript *p_script);
+	static void _read_class(Reader &r, GDScript *p_script);
+
+public:
+	static String get_cache_path(const String &p_script_path);
+	static bool is_load_enabled(const String &p_script_path);
+	static bool is_load_enabled(const GDScript *p_script);
+	static bool is_save_enabled(const GDScript *p_script);
+
+	static Vector<uint8_t> serialize(const GDScript *p_script, Error &r_error);
+	static Error deserialize(GDScript *p_script, const Vector<uint8_t> &p_data);
+
+	static Error load(GDScript *p_script);
+	static Error save(const GDScript *p_script);
+
+	static void clear();
+};
+
+#endif // GDSCRIPT_BYTECODE_CACHE_H
@@ -31,9 +31,12 @@
 #include "gdscript_cache.h"
 
 #include "core/os/file_access.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/thread_work_pool.h"
 #include "core/templates/vector.h"
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_parser.h"
 
 bool GDScriptParserRef::is_valid() const {
@@ -109,7 +112,11 @@ GDScriptParserRef::~GDScriptParserRef() {
 		memdelete(analyzer);
 	}
 	MutexLock lock(GDScriptCache::singleton->lock);
-	GDScriptCache::singleton->parser_map.erase(path);
+	// A tree handed over by take_preparsed() may have been replaced in the map since.
+	GDScriptParserRef **ref = GDScriptCache::singleton->parser_map.getptr(path);
+	if (ref && *ref == this) {
+		GDScriptCache::singleton->parser_map.erase(path);
+	}
 }
 
 GDScriptCache *GDScriptCache::singleton = nullptr;
@@ -118,6 +125,7 @@ void GDScriptCache::remove_script(const String &p_path) {
 	MutexLock lock(singleton->lock);
 	singleton->shallow_gdscript_cache.erase(p_path);
 	singleton->full_gdscript_cache.erase(p_path);
+	singleton->compiled_dependencies.erase(p_path);
 }
 
 Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptParserRef::Status p_status, Error &r_error, const String &p_owner) {
@@ -226,6 +234,10 @@ Error GDScriptCache::finish_compiling(const String &p_owner) {
 	singleton->shallow_gdscript_cache.erase(p_owner);
 
 	Set<String> depends = singleton->dependencies[p_owner];
+	{
+		MutexLock lock(singleton->lock);
+		singleton->compiled_dependencies[p_owner] = depends;
+	}
 
 	Error err = OK;
 	for (const Set<String>::Element *E = depends.front(); E != nullptr; E = E->next()) {
@@ -243,13 +255,174 @@ Error GDScriptCache::finish_compiling(const String &p_owner) {
 	return err;
 }
 
+void GDScriptCache::get_dependencies(const String &p_path, Set<String> &r_dependencies) {
+	MutexLock lock(singleton->lock);
+
+	List<String> pending;
+	pending.push_back(p_path);
+	while (!pending.is_empty()) {
+		const Set<String> *depends = singleton->compiled_dependencies.getptr(pending.front()->get());
+		pending.pop_front();
+		if (!depends) {
+			continue;
+		}
+		for (const Set<String>::Element *E = depends->front(); E; E = E->next()) {
+			if (E->get() != p_path && !r_dependencies.has(E->get())) {
+				r_dependencies.insert(E->get());
+				pending.push_back(E->get());
+			}
+		}
+	}
+}
+
+void GDScriptCache::add_dependencies(const String &p_path, const Set<String> &p_dependencies) {
+	MutexLock lock(singleton->lock);
+	Set<String> &depends = singleton->compiled_dependencies[p_path];
+	for (const Set<String>::Element *E = p_dependencies.front(); E; E = E->next()) {
+		depends.insert(E->get());
+	}
+}
+
+void GDScriptCache::_preparse_script(uint32_t p_index, PreparseItem *p_items) {
+	PreparseItem &item = p_items[p_index];
+	item.source = get_source_code(item.path);
+	if (item.source.is_empty()) {
+		return;
+	}
+	item.parser = memnew(GDScriptParser);
+	if (item.parser->parse(item.source, item.path, false) != OK) {
+		// Errors are reported when the script is parsed again by whoever loads it.
+		memdelete(item.parser);
+		item.parser = nullptr;
+	}
+}
+
+void GDScriptCache::preparse(const Vector<String> &p_paths) {
+	// The parser fills these lookup tables on first use, do it before going wide.
+	GDScriptParser::get_builtin_type(StringName());
+	GDScriptParser::get_real_class_name(StringName());
+
+	ThreadWorkPool work_pool;
+	work_pool.init();
+
+	Set<String> visited;
+	Vector<String> wave = p_paths;
+
+	while (!wave.is_empty()) {
+		LocalVector<PreparseItem> items;
+		for (int i = 0; i < wave.size(); i++) {
+			const String &path = wave[i];
+			if (visited.has(path)) {
+				continue;
+			}
+			visited.insert(path);
+			{
+				MutexLock lock(singleton->lock);
+				if (singleton->parser_map.has(path) || singleton->full_gdscript_cache.has(path)) {
+					continue;
+				}
+			}
+			if (!FileAccess::exists(path)) {
+				continue;
+			}
+			if (GDScriptBytecodeCache::is_load_enabled(path) && FileAccess::exists(GDScriptBytecodeCache::get_cache_path(path))) {
+				// Most likely loaded from the bytecode cache without being parsed at all.
+				continue;
+			}
+			PreparseItem item;
+			item.path = path;
+			items.push_back(item);
+		}
+		wave.clear();
+
+		if (items.is_empty()) {
+			break;
+		}
+
+		work_pool.do_work(items.size(), singleton, &GDScriptCache::_preparse_script, items.ptr());
+
+		MutexLock lock(singleton->lock);
+		for (uint32_t i = 0; i < items.size(); i++) {
+			PreparseItem &item = items[i];
+			if (item.parser == nullptr) {
+				continue;
+			}
+			if (singleton->parser_map.has(item.path)) {
+				memdelete(item.parser);
+				continue;
+			}
+
+			Ref<GDScriptParserRef> ref;
+			ref.instance();
+			ref->parser = item.parser;
+			ref->path = item.path;
+			ref->source = item.source;
+			ref->status = GDScriptParserRef::PARSED;
+			singleton->parser_map[item.path] = ref.ptr();
+			singleton->preparsed[item.path] = ref;
+
+			// Base scripts are needed first, parse them in the next wave.
+			String extends_path = item.parser->get_tree()->extends_path;
+			if (!extends_path.is_empty()) {
+				if (extends_path.is_rel_path()) {
+					extends_path = item.path.get_base_dir().plus_file(extends_path);
+				}
+				wave.push_back(extends_path.simplify_path());
+			}
+			const Set<String> *depends = singleton->dependencies.getptr(item.path);
+			if (depends) {
+				for (const Set<String>::Element *E = depends->front(); E; E = E->next()) {
+					wave.push_back(E->get());
+				}
+			}
+		}
+	}
+
+	work_pool.finish();
+}
+
+Ref<GDScriptParserRef> GDScriptCache::take_preparsed(const String &p_path, const String &p_source) {
+	MutexLock lock(singleton->lock);
+
+	Ref<GDScriptParserRef> ref;
+	if (p_path.is_empty() || !singleton->preparsed.has(p_path)) {
+		return ref;
+	}
+	ref = singleton->preparsed[p_path];
+	singleton->preparsed.erase(p_path);
+
+	// Only a tree nobody started analyzing can be handed over, and only if the source didn't change since.
+	if (ref->status != GDScriptParserRef::PARSED || ref->reference_get_count() > 1 || ref->source != p_source) {
+		return Ref<GDScriptParserRef>();
+	}
+	singleton->parser_map.erase(p_path);
+	ref->source = String();
+	return ref;
+}
+
+void GDScriptCache::release_preparsed() {
+	HashMap<String, Ref<GDScriptParserRef>> released;
+	{
+		MutexLock lock(singleton->lock);
+		if (singleton->preparsed.is_empty()) {
+			return;
+		}
+		released = singleton->preparsed;
+		singleton->preparsed.clear();
+	}
+	// Freed outside of the lock, the parser references erase themselves from the cache.
+	released.clear();
+}
+
 GDScriptCache::GDScriptCache() {
 	singleton = this;
 }
 
 GDScriptCache::~GDScriptCache() {
+	preparsed.clear();
 	parser_map.clear();
 	shallow_gdscript_cache.clear();
 	full_gdscript_cache.clear();
+	compiled_dependencies.clear();
 	singleton = nullptr;
 }
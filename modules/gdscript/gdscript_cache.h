@@ -55,6 +55,7 @@ private:
 	GDScriptAnalyzer *analyzer = nullptr;
 	Status status = EMPTY;
 	String path;
+	String source; // Only kept for scripts parsed ahead of time.
 
 	friend class GDScriptCache;
 
@@ -74,6 +75,10 @@ class GDScriptCache {
 	HashMap<String, GDScript *> shallow_gdscript_cache;
 	HashMap<String, GDScript *> full_gdscript_cache;
 	HashMap<String, Set<String>> dependencies;
+	HashMap<String, Set<String>> compiled_dependencies;
+	// Scripts parsed ahead of time on worker threads, kept until GDScript::reload()
+	// claims them or they are released.
+	HashMap<String, Ref<GDScriptParserRef>> preparsed;
 
 	friend class GDScript;
 	friend class GDScriptParserRef;
@@ -83,12 +88,25 @@ class GDScriptCache {
 	Mutex lock;
 	static void remove_script(const String &p_path);
 
+	struct PreparseItem {
+		String path;
+		String source;
+		GDScriptParser *parser = nullptr;
+	};
+	void _preparse_script(uint32_t p_index, PreparseItem *p_items);
+
 public:
 	static Ref<GDScriptParserRef> get_parser(const String &p_path, GDScriptParserRef::Status status, Error &r_error, const String &p_owner = String());
 	static String get_source_code(const String &p_path);
 	static Ref<GDScript> get_shallow_script(const String &p_path, const String &p_owner = String());
 	static Ref<GDScript> get_full_script(const String &p_path, Error &r_error, const String &p_owner = String());
 	static Error finish_compiling(const String &p_owner);
+	static void get_dependencies(const String &p_path, Set<String> &r_dependencies);
+	static void add_dependencies(const String &p_path, const Set<String> &p_dependencies);
+
+	static void preparse(const Vector<String> &p_paths);
+	static Ref<GDScriptParserRef> take_preparsed(const String &p_path, const String &p_source);
+	static void release_preparsed();
 
 	GDScriptCache();
 	~GDScriptCache();
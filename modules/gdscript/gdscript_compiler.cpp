@@ -188,20 +188,105 @@ static bool _is_exact_type(const PropertyInfo &p_par_type, const GDScriptDataTyp
 	}
 }
 
-static bool _have_exact_arguments(const MethodBind *p_method, const Vector<GDScriptCodeGenerator::Address> &p_arguments) {
-	if (p_method->get_argument_count() != p_arguments.size()) {
-		// ptrcall won't work with default arguments.
-		return false;
+// Implicit conversions accepted by the analyzer for native arguments that can be
+// resolved before the call, so the value reaches ptrcall in the exact type.
+static bool _is_ptrcall_convertible(Variant::Type p_from, Variant::Type p_to) {
+	switch (p_to) {
+		case Variant::INT:
+			return p_from == Variant::FLOAT;
+		case Variant::FLOAT:
+			return p_from == Variant::INT;
+		case Variant::STRING:
+			return p_from == Variant::STRING_NAME;
+		case Variant::STRING_NAME:
+		case Variant::NODE_PATH:
+			return p_from == Variant::STRING;
+		default:
+			return false;
+	}
+}
+
+static bool _convert_ptrcall_constant(const Variant &p_value, Variant::Type p_type, Variant &r_converted) {
+	if (p_value.get_type() == p_type) {
+		r_converted = p_value;
+		return true;
 	}
+	const Variant *argptr = &p_value;
+	Callable::CallError err;
+	Variant::construct(p_type, r_converted, &argptr, 1, err);
+	return err.error == Callable::CallError::CALL_OK;
+}
+
+void GDScriptCompiler::_write_method_bind_call(CodeGen &codegen, const GDScriptCodeGenerator::Address &p_target, const GDScriptCodeGenerator::Address &p_base, MethodBind *p_method, const Vector<GDScriptCodeGenerator::Address> &p_arguments, const Vector<GDScriptParser::ExpressionNode *> &p_argument_nodes) {
+	GDScriptCodeGenerator *gen = codegen.generator;
+	const int argc = p_method->get_argument_count();
+
+	// ptrcall takes exactly the bound arguments, so omitted ones are filled with the bound defaults.
+	bool use_ptrcall = !p_method->is_vararg() && p_arguments.size() <= argc && p_arguments.size() >= argc - p_method->get_default_argument_count();
+
 	MethodInfo info;
-	ClassDB::get_method_info(p_method->get_instance_class(), p_method->get_name(), &info);
-	for (int i = 0; i < p_arguments.size(); i++) {
-		const PropertyInfo &prop = info.arguments[i];
-		if (!_is_exact_type(prop, p_arguments[i].type)) {
-			return false;
+	if (use_ptrcall) {
+		ClassDB::get_method_info(p_method->get_instance_class(), p_method->get_name(), &info);
+		use_ptrcall = info.arguments.size() == argc;
+	}
+
+	Vector<GDScriptCodeGenerator::Address> arguments;
+	Vector<Variant::Type> conversions;
+	for (int i = 0; use_ptrcall && i < argc; i++) {
+		const PropertyInfo &par = info.arguments[i];
+		Variant::Type conversion = Variant::VARIANT_MAX;
+
+		if (i >= p_arguments.size()) {
+			// Object and Variant parameters can't be passed as constants through ptrcall.
+			Variant value;
+			use_ptrcall = par.type != Variant::NIL && par.type != Variant::OBJECT && _convert_ptrcall_constant(p_method->get_default_argument(i), par.type, value);
+			if (use_ptrcall) {
+				arguments.push_back(codegen.add_constant(value));
+			}
+		} else if (_is_exact_type(par, p_arguments[i].type)) {
+			arguments.push_back(p_arguments[i]);
+		} else if (p_arguments[i].type.has_type && p_arguments[i].type.kind == GDScriptDataType::BUILTIN && _is_ptrcall_convertible(p_arguments[i].type.builtin_type, par.type)) {
+			Variant value;
+			if (i < p_argument_nodes.size() && p_argument_nodes[i]->is_constant && _convert_ptrcall_constant(p_argument_nodes[i]->reduced_value, par.type, value)) {
+				arguments.push_back(codegen.add_constant(value));
+			} else {
+				// Converted into a typed temporary right before the call.
+				arguments.push_back(p_arguments[i]);
+				conversion = par.type;
+			}
+		} else {
+			use_ptrcall = false;
+		}
+		conversions.push_back(conversion);
+	}
+
+	if (!use_ptrcall) {
+		// Not exact arguments, but still can use method bind call.
+		gen->write_call_method_bind(p_target, p_base, p_method, p_arguments);
+		return;
+	}
+
+	int temporaries = 0;
+	for (int i = 0; i < arguments.size(); i++) {
+		if (conversions[i] == Variant::VARIANT_MAX) {
+			continue;
 		}
+		GDScriptDataType type;
+		type.has_type = true;
+		type.kind = GDScriptDataType::BUILTIN;
+		type.builtin_type = conversions[i];
+
+		GDScriptCodeGenerator::Address converted = codegen.add_temporary(type);
+		gen->write_assign(converted, arguments[i]);
+		arguments.write[i] = converted;
+		temporaries++;
+	}
+
+	gen->write_call_ptrcall(p_target, p_base, p_method, arguments);
+
+	for (int i = 0; i < temporaries; i++) {
+		gen->pop_temporary();
 	}
-	return true;
 }
 
 GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &codegen, Error &r_error, const GDScriptParser::ExpressionNode *p_expression, bool p_root, bool p_initializer, const GDScriptCodeGenerator::Address &p_index_addr) {
@@ -510,14 +595,7 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 							GDScriptCodeGenerator::Address self;
 							self.mode = GDScriptCodeGenerator::Address::SELF;
 							MethodBind *method = ClassDB::get_method(codegen.script->native->get_name(), call->function_name);
-
-							if (_have_exact_arguments(method, arguments)) {
-								// Exact arguments, use ptrcall.
-								gen->write_call_ptrcall(result, self, method, arguments);
-							} else {
-								// Not exact arguments, but still can use method bind call.
-								gen->write_call_method_bind(result, self, method, arguments);
-							}
+							_write_method_bind_call(codegen, result, self, method, arguments, call->arguments);
 						} else if ((codegen.function_node && codegen.function_node->is_static) || call->function_name == "new") {
 							GDScriptCodeGenerator::Address self;
 							self.mode = GDScriptCodeGenerator::Address::CLASS;
@@ -557,13 +635,7 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 									}
 									if (ClassDB::class_exists(class_name) && ClassDB::has_method(class_name, call->function_name)) {
 										MethodBind *method = ClassDB::get_method(class_name, call->function_name);
-										if (_have_exact_arguments(method, arguments)) {
-											// Exact arguments, use ptrcall.
-											gen->write_call_ptrcall(result, base, method, arguments);
-										} else {
-											// Not exact arguments, but still can use method bind call.
-											gen->write_call_method_bind(result, base, method, arguments);
-										}
+										_write_method_bind_call(codegen, result, base, method, arguments, call->arguments);
 									} else {
 										gen->write_call(result, base, call->function_name, arguments);
 									}
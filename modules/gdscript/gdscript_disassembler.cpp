@@ -184,6 +184,19 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_SET_INDEXED_TYPED_ARRAY_INT:
+			case OPCODE_SET_INDEXED_TYPED_ARRAY_FLOAT:
+			case OPCODE_SET_INDEXED_TYPED_ARRAY_VECTOR2:
+			case OPCODE_SET_INDEXED_TYPED_ARRAY_VECTOR3: {
+				text += "set indexed typed array ";
+				text += DADDR(1);
+				text += "[";
+				text += DADDR(2);
+				text += "] = ";
+				text += DADDR(3);
+
+				incr += 4;
+			} break;
 			case OPCODE_GET_KEYED: {
 				text += "get keyed ";
 				text += DADDR(3);
@@ -217,6 +230,20 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_GET_INDEXED_TYPED_ARRAY_INT:
+			case OPCODE_GET_INDEXED_TYPED_ARRAY_FLOAT:
+			case OPCODE_GET_INDEXED_TYPED_ARRAY_VECTOR2:
+			case OPCODE_GET_INDEXED_TYPED_ARRAY_VECTOR3: {
+				text += "get indexed typed array ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += "[";
+				text += DADDR(2);
+				text += "]";
+
+				incr += 4;
+			} break;
 			case OPCODE_SET_NAMED: {
 				text += "set_named ";
 				text += DADDR(1);
@@ -225,7 +252,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
@@ -246,7 +273,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -509,7 +536,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
@@ -641,6 +668,37 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				DISASSEMBLE_PTRCALL(PACKED_VECTOR3_ARRAY);
 				DISASSEMBLE_PTRCALL(PACKED_COLOR_ARRAY);
 
+			case OPCODE_APPEND_ARRAY: {
+				text += "append ";
+				text += DADDR(1);
+				text += ".append(";
+				text += DADDR(2);
+				text += ")";
+
+				incr += 3;
+			} break;
+
+#define DISASSEMBLE_APPEND_PACKED(m_type)         \
+	case OPCODE_APPEND_PACKED_##m_type##_ARRAY: { \
+		text += "append (packed ";                \
+		text += #m_type;                          \
+		text += ") ";                             \
+		text += DADDR(3) + " = ";                 \
+		text += DADDR(1) + ".append(";            \
+		text += DADDR(2) + ")";                   \
+		incr += 4;                                \
+	} break
+
+				DISASSEMBLE_APPEND_PACKED(BYTE);
+				DISASSEMBLE_APPEND_PACKED(INT32);
+				DISASSEMBLE_APPEND_PACKED(INT64);
+				DISASSEMBLE_APPEND_PACKED(FLOAT32);
+				DISASSEMBLE_APPEND_PACKED(FLOAT64);
+				DISASSEMBLE_APPEND_PACKED(STRING);
+				DISASSEMBLE_APPEND_PACKED(VECTOR2);
+				DISASSEMBLE_APPEND_PACKED(VECTOR3);
+				DISASSEMBLE_APPEND_PACKED(COLOR);
+
 			case OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
 				int argc = _code_ptr[ip + 1 + instr_var_args];
 
@@ -877,6 +935,10 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 	m_macro(STRING);                       \
 	m_macro(DICTIONARY);                   \
 	m_macro(ARRAY);                        \
+	m_macro(TYPED_ARRAY_INT);              \
+	m_macro(TYPED_ARRAY_FLOAT);            \
+	m_macro(TYPED_ARRAY_VECTOR2);          \
+	m_macro(TYPED_ARRAY_VECTOR3);          \
 	m_macro(PACKED_BYTE_ARRAY);            \
 	m_macro(PACKED_INT32_ARRAY);           \
 	m_macro(PACKED_INT64_ARRAY);           \
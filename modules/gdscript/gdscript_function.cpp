@@ -30,8 +30,51 @@
 
 #include "gdscript_function.h"
 
+#include "core/config/engine.h"
+#include "core/core_string_names.h"
 #include "gdscript.h"
 
+MethodBind *GDScriptInlineCache::_resolve(const Object *p_base, const StringName &p_name, Kind p_kind, int &r_index) {
+	if (used.get() >= MAX_ENTRIES) {
+		return nullptr; // Megamorphic, stay on the generic path.
+	}
+
+	const StringName &class_name = p_base->get_class_name();
+	MethodBind *method = nullptr;
+	int index = -1;
+	switch (p_kind) {
+		case KIND_GET: {
+			method = ClassDB::get_property_getter_method(class_name, p_name, &index);
+		} break;
+		case KIND_SET: {
+#ifdef TOOLS_ENABLED
+			// Object::set() also flags the object as edited, which the editor relies on.
+			if (Engine::get_singleton()->is_editor_hint()) {
+				break;
+			}
+#endif
+			method = ClassDB::get_property_setter_method(class_name, p_name, &index);
+		} break;
+		case KIND_CALL: {
+			// Scripts override call() to run their static functions, and free() is not a bound method.
+			if (!Object::cast_to<Script>(p_base) && p_name != CoreStringNames::get_singleton()->_free) {
+				method = ClassDB::get_method(class_name, p_name);
+			}
+		} break;
+	}
+
+	// Members that can't be cached are recorded too, so the site doesn't resolve them again.
+	uint32_t slot = used.postincrement();
+	if (slot < MAX_ENTRIES) {
+		entries[slot].method = method;
+		entries[slot].index = index;
+		entries[slot].key.set((uintptr_t)class_name.data_unique_pointer());
+	}
+
+	r_index = index;
+	return method;
+}
+
 const int *GDScriptFunction::get_code() const {
 	return _code_ptr;
 }
@@ -149,11 +192,21 @@ GDScriptFunction::GDScriptFunction() {
 #endif
 }
 
+void GDScriptFunction::_allocate_inline_caches(int p_count) {
+	ERR_FAIL_COND(_inline_caches_ptr);
+	_inline_caches_count = p_count;
+	_inline_caches_ptr = p_count ? memnew_arr(GDScriptInlineCache, p_count) : nullptr;
+}
+
 GDScriptFunction::~GDScriptFunction() {
 	for (int i = 0; i < lambdas.size(); i++) {
 		memdelete(lambdas[i]);
 	}
 
+	if (_inline_caches_ptr) {
+		memdelete_arr(_inline_caches_ptr);
+	}
+
 #ifdef DEBUG_ENABLED
 
 	MutexLock lock(GDScriptLanguage::get_singleton()->lock);
@@ -36,6 +36,7 @@
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
 #include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 #include "gdscript_utility_functions.h"
@@ -219,6 +220,56 @@ public:
 	}
 };
 
+// Inline cache of a named get, set or call site. Records the native method the
+// member resolved to for each class of object seen at the site, so later runs on
+// the same class skip the lookup. Entries are only ever added and the key is
+// published after the payload, so hits need no lock when several threads run the
+// same function.
+class GDScriptInlineCache {
+public:
+	enum Kind {
+		KIND_GET,
+		KIND_SET,
+		KIND_CALL,
+	};
+
+	enum {
+		MAX_ENTRIES = 4, // Sites that see more classes than this stay on the generic path.
+	};
+
+private:
+	struct Entry {
+		SafeNumeric<uintptr_t> key; // Unique pointer of the class name, 0 while unpublished.
+		MethodBind *method = nullptr; // nullptr when the member has to go through the generic path.
+		int index = -1; // Index of indexed properties, passed before the value.
+	};
+
+	Entry entries[MAX_ENTRIES];
+	SafeNumeric<uint32_t> used;
+
+	MethodBind *_resolve(const Object *p_base, const StringName &p_name, Kind p_kind, int &r_index);
+
+public:
+	// Returns the method to dispatch to on p_base, or nullptr if the generic path must be used.
+	// r_hit is only set when a cached entry provided the method, filling an entry counts as a miss.
+	_FORCE_INLINE_ MethodBind *lookup(const Object *p_base, const StringName &p_name, Kind p_kind, int &r_index, bool &r_hit) {
+		uintptr_t key = (uintptr_t)p_base->get_class_name().data_unique_pointer();
+		for (int i = 0; i < MAX_ENTRIES; i++) {
+			uintptr_t entry_key = entries[i].key.get();
+			if (entry_key == key) {
+				r_index = entries[i].index;
+				r_hit = entries[i].method != nullptr;
+				return entries[i].method;
+			}
+			if (entry_key == 0) {
+				break;
+			}
+		}
+		r_hit = false;
+		return _resolve(p_base, p_name, p_kind, r_index);
+	}
+};
+
 class GDScriptFunction {
 public:
 	enum Opcode {
@@ -229,9 +280,17 @@ public:
 		OPCODE_SET_KEYED,
 		OPCODE_SET_KEYED_VALIDATED,
 		OPCODE_SET_INDEXED_VALIDATED,
+		OPCODE_SET_INDEXED_TYPED_ARRAY_INT,
+		OPCODE_SET_INDEXED_TYPED_ARRAY_FLOAT,
+		OPCODE_SET_INDEXED_TYPED_ARRAY_VECTOR2,
+		OPCODE_SET_INDEXED_TYPED_ARRAY_VECTOR3,
 		OPCODE_GET_KEYED,
 		OPCODE_GET_KEYED_VALIDATED,
 		OPCODE_GET_INDEXED_VALIDATED,
+		OPCODE_GET_INDEXED_TYPED_ARRAY_INT,
+		OPCODE_GET_INDEXED_TYPED_ARRAY_FLOAT,
+		OPCODE_GET_INDEXED_TYPED_ARRAY_VECTOR2,
+		OPCODE_GET_INDEXED_TYPED_ARRAY_VECTOR3,
 		OPCODE_SET_NAMED,
 		OPCODE_SET_NAMED_VALIDATED,
 		OPCODE_GET_NAMED,
@@ -300,6 +359,16 @@ public:
 		OPCODE_CALL_PTRCALL_PACKED_VECTOR2_ARRAY,
 		OPCODE_CALL_PTRCALL_PACKED_VECTOR3_ARRAY,
 		OPCODE_CALL_PTRCALL_PACKED_COLOR_ARRAY,
+		OPCODE_APPEND_ARRAY,
+		OPCODE_APPEND_PACKED_BYTE_ARRAY,
+		OPCODE_APPEND_PACKED_INT32_ARRAY,
+		OPCODE_APPEND_PACKED_INT64_ARRAY,
+		OPCODE_APPEND_PACKED_FLOAT32_ARRAY,
+		OPCODE_APPEND_PACKED_FLOAT64_ARRAY,
+		OPCODE_APPEND_PACKED_STRING_ARRAY,
+		OPCODE_APPEND_PACKED_VECTOR2_ARRAY,
+		OPCODE_APPEND_PACKED_VECTOR3_ARRAY,
+		OPCODE_APPEND_PACKED_COLOR_ARRAY,
 		OPCODE_AWAIT,
 		OPCODE_AWAIT_RESUME,
 		OPCODE_CREATE_LAMBDA,
@@ -322,6 +391,10 @@ public:
 		OPCODE_ITERATE_BEGIN_STRING,
 		OPCODE_ITERATE_BEGIN_DICTIONARY,
 		OPCODE_ITERATE_BEGIN_ARRAY,
+		OPCODE_ITERATE_BEGIN_TYPED_ARRAY_INT,
+		OPCODE_ITERATE_BEGIN_TYPED_ARRAY_FLOAT,
+		OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR2,
+		OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR3,
 		OPCODE_ITERATE_BEGIN_PACKED_BYTE_ARRAY,
 		OPCODE_ITERATE_BEGIN_PACKED_INT32_ARRAY,
 		OPCODE_ITERATE_BEGIN_PACKED_INT64_ARRAY,
@@ -342,6 +415,10 @@ public:
 		OPCODE_ITERATE_STRING,
 		OPCODE_ITERATE_DICTIONARY,
 		OPCODE_ITERATE_ARRAY,
+		OPCODE_ITERATE_TYPED_ARRAY_INT,
+		OPCODE_ITERATE_TYPED_ARRAY_FLOAT,
+		OPCODE_ITERATE_TYPED_ARRAY_VECTOR2,
+		OPCODE_ITERATE_TYPED_ARRAY_VECTOR3,
 		OPCODE_ITERATE_PACKED_BYTE_ARRAY,
 		OPCODE_ITERATE_PACKED_INT32_ARRAY,
 		OPCODE_ITERATE_PACKED_INT64_ARRAY,
@@ -427,6 +504,8 @@ public:
 private:
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
+	friend class GDScriptBytecodeCache;
+	friend class GDScriptLineProfiler;
 
 	StringName source;
 
@@ -463,6 +542,8 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	int _lambdas_count = 0;
 	GDScriptFunction **_lambdas_ptr = nullptr;
+	int _inline_caches_count = 0;
+	GDScriptInlineCache *_inline_caches_ptr = nullptr;
 	const int *_code_ptr = nullptr;
 	int _code_size = 0;
 	int _argument_count = 0;
@@ -506,6 +587,8 @@ private:
 
 	List<StackDebug> stack_debug;
 
+	void _allocate_inline_caches(int p_count);
+
 	_FORCE_INLINE_ Variant *_get_variant(int p_address, GDScriptInstance *p_instance, Variant *p_stack, String &r_error) const;
 	_FORCE_INLINE_ String _get_call_error(const Callable::CallError &p_err, const String &p_where, const Variant **argptrs) const;
 
@@ -527,6 +610,8 @@ private:
 		uint64_t last_frame_call_count = 0;
 		uint64_t last_frame_self_time = 0;
 		uint64_t last_frame_total_time = 0;
+		uint64_t inline_cache_hits = 0;
+		uint64_t inline_cache_misses = 0;
 	} profile;
 
 #endif
@@ -590,6 +675,10 @@ public:
 
 #ifdef DEBUG_ENABLED
 	void disassemble(const Vector<String> &p_code_lines) const;
+
+	// Named accesses and calls on native objects, counted while the profiler runs.
+	uint64_t get_inline_cache_hits() const { return profile.inline_cache_hits; }
+	uint64_t get_inline_cache_misses() const { return profile.inline_cache_misses; }
 #endif
 
 	_FORCE_INLINE_ MultiplayerAPI::RPCMode get_rpc_mode() const { return rpc_mode; }
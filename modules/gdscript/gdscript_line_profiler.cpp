@@ -0,0 +1,397 @@
+/*************************************************************************/
+/*  gdscript_line_profiler.cpp                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "gdscript_line_profiler.h"
+
+#ifdef DEBUG_ENABLED
+
+#include "core/debugger/engine_debugger.h"
+#include "core/object/method_bind.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "gdscript_function.h"
+
+bool GDScriptLineProfiler::active = false;
+uint32_t GDScriptLineProfiler::session = 0;
+uint64_t GDScriptLineProfiler::last_ticks = 0;
+GDScriptLineProfiler::Node *GDScriptLineProfiler::root = nullptr;
+LocalVector<GDScriptLineProfiler::Frame> GDScriptLineProfiler::stack;
+LocalVector<GDScriptLineProfiler::Node *> GDScriptLineProfiler::dirty_nodes;
+
+GDScriptLineProfiler::Node::~Node() {
+	for (Map<ChildKey, Node *>::Element *E = children.front(); E; E = E->next()) {
+		memdelete(E->get());
+	}
+}
+
+void GDScriptLineProfiler::_reset() {
+	// Calls still on the stack belong to the previous session and are ignored from now on.
+	session++;
+	if (session == 0) {
+		session = 1;
+	}
+
+	stack.clear();
+	dirty_nodes.clear();
+	if (root) {
+		memdelete(root);
+	}
+	root = memnew(Node);
+}
+
+GDScriptLineProfiler::LineCost &GDScriptLineProfiler::_get_line_cost(Node *p_node, int p_line) {
+	uint32_t index = MAX(p_line - p_node->first_line, 0);
+	if (index >= p_node->lines.size()) {
+		p_node->lines.resize(index + 1);
+	}
+	if (!p_node->dirty) {
+		p_node->dirty = true;
+		dirty_nodes.push_back(p_node);
+	}
+	return p_node->lines[index];
+}
+
+void GDScriptLineProfiler::_charge(uint64_t p_now) {
+	if (stack.size() > 0) {
+		const Frame &frame = stack[stack.size() - 1];
+		_get_line_cost(frame.node, frame.line).time += p_now - last_ticks;
+	}
+	last_ticks = p_now;
+}
+
+// New nodes have no label yet, callers set it so labels are only built once per call site.
+GDScriptLineProfiler::Node *GDScriptLineProfiler::_get_child(const ChildKey &p_key, int p_first_line, bool p_native) {
+	Node *parent = root;
+	ChildKey key = p_key;
+	if (stack.size() > 0) {
+		const Frame &frame = stack[stack.size() - 1];
+		parent = frame.node;
+		key.line = frame.line;
+	}
+
+	Map<ChildKey, Node *>::Element *E = parent->children.find(key);
+	if (E) {
+		return E->get();
+	}
+
+	Node *node = memnew(Node);
+	node->first_line = p_first_line;
+	node->native = p_native;
+	if (parent != root) {
+		node->prefix = parent->prefix + parent->label + ":" + itos(key.line) + ";";
+	}
+	parent->children.insert(key, node);
+	return node;
+}
+
+uint32_t GDScriptLineProfiler::enter_function(const GDScriptFunction *p_function) {
+	if (!active || Thread::get_caller_id() != Thread::get_main_id()) {
+		return 0;
+	}
+
+	_charge(OS::get_singleton()->get_ticks_usec());
+
+	// Signatures are only generated while the debugger is active, fall back to the function name.
+	const StringName &signature = p_function->profile.signature != StringName() ? p_function->profile.signature : p_function->get_name();
+	ChildKey key;
+	key.id = signature.data_unique_pointer();
+	Node *node = _get_child(key, p_function->_initial_line, false);
+	if (node->label.is_empty()) {
+		node->label = signature;
+	}
+
+	Frame frame;
+	frame.node = node;
+	frame.line = p_function->_initial_line;
+	stack.push_back(frame);
+	_get_line_cost(node, frame.line).hits++;
+	return session;
+}
+
+void GDScriptLineProfiler::line(uint32_t p_session, int p_line) {
+	if (p_session != session || stack.is_empty()) {
+		return;
+	}
+
+	_charge(OS::get_singleton()->get_ticks_usec());
+
+	Frame &frame = stack[stack.size() - 1];
+	frame.line = p_line;
+	_get_line_cost(frame.node, p_line).hits++;
+}
+
+void GDScriptLineProfiler::exit_function(uint32_t p_session) {
+	if (p_session != session || stack.is_empty()) {
+		return;
+	}
+
+	_charge(OS::get_singleton()->get_ticks_usec());
+	// A native call left open by an error in the function is closed with it.
+	while (stack.size() > 1 && stack[stack.size() - 1].node->native) {
+		stack.resize(stack.size() - 1);
+	}
+	stack.resize(stack.size() - 1);
+}
+
+GDScriptLineProfiler::Node *GDScriptLineProfiler::_enter_native(const ChildKey &p_key) {
+	_charge(OS::get_singleton()->get_ticks_usec());
+
+	Node *node = _get_child(p_key, 0, true);
+	Frame frame;
+	frame.node = node;
+	stack.push_back(frame);
+	_get_line_cost(node, 0).hits++;
+	return node;
+}
+
+void GDScriptLineProfiler::enter_native(uint32_t p_session, const MethodBind *p_method) {
+	if (p_session != session || stack.is_empty()) {
+		return;
+	}
+
+	ChildKey key;
+	key.id = p_method;
+	Node *node = _enter_native(key);
+	if (node->label.is_empty()) {
+		node->label = String(p_method->get_instance_class()) + "::" + String(p_method->get_name());
+	}
+}
+
+void GDScriptLineProfiler::enter_method(uint32_t p_session, const Variant *p_base, const StringName &p_method) {
+	if (p_session != session || stack.is_empty()) {
+		return;
+	}
+
+	ChildKey key;
+	key.id = p_method.data_unique_pointer();
+	if (p_base->get_type() == Variant::OBJECT) {
+		// Script functions record themselves, calls that fail have nothing to attribute.
+		Object *obj = p_base->get_validated_object();
+		if (!obj || obj->get_script_instance()) {
+			return;
+		}
+		key.owner = obj->get_class_name().data_unique_pointer();
+	} else {
+		key.owner = (const void *)(uintptr_t)(p_base->get_type() + 1);
+	}
+
+	Node *node = _enter_native(key);
+	if (node->label.is_empty()) {
+		String type = p_base->get_type() == Variant::OBJECT ? String(p_base->get_validated_object()->get_class_name()) : Variant::get_type_name(p_base->get_type());
+		node->label = type + "::" + String(p_method);
+	}
+}
+
+void GDScriptLineProfiler::enter_builtin_method(uint32_t p_session, Variant::Type p_type, Variant::ValidatedBuiltInMethod p_method) {
+	if (p_session != session || stack.is_empty()) {
+		return;
+	}
+
+	ChildKey key;
+	key.id = (const void *)p_method;
+	Node *node = _enter_native(key);
+	if (node->label.is_empty()) {
+		// Validated calls only keep the function pointer, look its name up once.
+		List<StringName> methods;
+		Variant::get_builtin_method_list(p_type, &methods);
+		for (List<StringName>::Element *E = methods.front(); E; E = E->next()) {
+			if (Variant::get_validated_builtin_method(p_type, E->get()) == p_method) {
+				node->label = Variant::get_type_name(p_type) + "::" + String(E->get());
+				break;
+			}
+		}
+		if (node->label.is_empty()) {
+			node->label = Variant::get_type_name(p_type) + "::<unknown>";
+		}
+	}
+}
+
+void GDScriptLineProfiler::enter_builtin_static(uint32_t p_session, Variant::Type p_type, const StringName &p_method) {
+	if (p_session != session || stack.is_empty()) {
+		return;
+	}
+
+	ChildKey key;
+	key.id = p_method.data_unique_pointer();
+	key.owner = (const void *)(uintptr_t)(p_type + 1);
+	Node *node = _enter_native(key);
+	if (node->label.is_empty()) {
+		node->label = Variant::get_type_name(p_type) + "::" + String(p_method);
+	}
+}
+
+void GDScriptLineProfiler::enter_append(uint32_t p_session, Variant::Type p_type) {
+	if (p_session != session || stack.is_empty()) {
+		return;
+	}
+
+	static const char append_id = 0;
+	ChildKey key;
+	key.id = &append_id;
+	key.owner = (const void *)(uintptr_t)(p_type + 1);
+	Node *node = _enter_native(key);
+	if (node->label.is_empty()) {
+		node->label = Variant::get_type_name(p_type) + "::append";
+	}
+}
+
+void GDScriptLineProfiler::enter_utility(uint32_t p_session, const StringName &p_function) {
+	if (p_session != session || stack.is_empty()) {
+		return;
+	}
+
+	ChildKey key;
+	key.id = p_function.data_unique_pointer();
+	Node *node = _enter_native(key);
+	if (node->label.is_empty()) {
+		node->label = "@GlobalScope::" + String(p_function);
+	}
+}
+
+void GDScriptLineProfiler::enter_utility(uint32_t p_session, Variant::ValidatedUtilityFunction p_function) {
+	if (p_session != session || stack.is_empty()) {
+		return;
+	}
+
+	ChildKey key;
+	key.id = (const void *)p_function;
+	Node *node = _enter_native(key);
+	if (node->label.is_empty()) {
+		List<StringName> functions;
+		Variant::get_utility_function_list(&functions);
+		for (List<StringName>::Element *E = functions.front(); E; E = E->next()) {
+			if (Variant::get_validated_utility_function(E->get()) == p_function) {
+				node->label = "@GlobalScope::" + String(E->get());
+				break;
+			}
+		}
+		if (node->label.is_empty()) {
+			node->label = "@GlobalScope::<unknown>";
+		}
+	}
+}
+
+void GDScriptLineProfiler::enter_gdscript_utility(uint32_t p_session, GDScriptUtilityFunctions::FunctionPtr p_function) {
+	if (p_session != session || stack.is_empty()) {
+		return;
+	}
+
+	ChildKey key;
+	key.id = (const void *)p_function;
+	Node *node = _enter_native(key);
+	if (node->label.is_empty()) {
+		List<StringName> functions;
+		GDScriptUtilityFunctions::get_function_list(&functions);
+		for (List<StringName>::Element *E = functions.front(); E; E = E->next()) {
+			if (GDScriptUtilityFunctions::get_function(E->get()) == p_function) {
+				node->label = "@GDScript::" + String(E->get());
+				break;
+			}
+		}
+		if (node->label.is_empty()) {
+			node->label = "@GDScript::<unknown>";
+		}
+	}
+}
+
+void GDScriptLineProfiler::exit_native(uint32_t p_session) {
+	if (p_session != session || stack.is_empty() || !stack[stack.size() - 1].node->native) {
+		return;
+	}
+
+	_charge(OS::get_singleton()->get_ticks_usec());
+	stack.resize(stack.size() - 1);
+}
+
+void GDScriptLineProfiler::set_active(bool p_active) {
+	_reset();
+	active = p_active;
+	last_ticks = OS::get_singleton()->get_ticks_usec();
+}
+
+void GDScriptLineProfiler::_toggle(void *p_user, bool p_enable, const Array &p_opts) {
+	set_active(p_enable);
+}
+
+Array GDScriptLineProfiler::take_frame_data() {
+	// Flat list of (folded stack, self time in microseconds, hits) for every line that ran this frame.
+	Array data;
+	for (uint32_t i = 0; i < dirty_nodes.size(); i++) {
+		Node *node = dirty_nodes[i];
+		for (uint32_t j = 0; j < node->lines.size(); j++) {
+			LineCost &cost = node->lines[j];
+			if (cost.hits == 0 && cost.time == 0) {
+				continue;
+			}
+			if (node->native) {
+				data.push_back(node->prefix + node->label);
+			} else {
+				data.push_back(node->prefix + node->label + ":" + itos(node->first_line + j));
+			}
+			data.push_back(cost.time);
+			data.push_back(cost.hits);
+			cost = LineCost();
+		}
+		node->dirty = false;
+	}
+	dirty_nodes.clear();
+	return data;
+}
+
+void GDScriptLineProfiler::_tick(void *p_user, float p_frame_time, float p_process_time, float p_physics_time, float p_physics_frame_time) {
+	if (dirty_nodes.is_empty()) {
+		return;
+	}
+
+	Array data = take_frame_data();
+	if (EngineDebugger::get_singleton()) {
+		EngineDebugger::get_singleton()->send_message("gdscript_lines:profile_frame", data);
+	}
+}
+
+void GDScriptLineProfiler::register_profiler() {
+	EngineDebugger::register_profiler("gdscript_lines", EngineDebugger::Profiler(nullptr, &_toggle, nullptr, &_tick));
+}
+
+void GDScriptLineProfiler::unregister_profiler() {
+	// The debugger may have dropped its profilers already when shutting down.
+	if (EngineDebugger::has_profiler("gdscript_lines")) {
+		EngineDebugger::unregister_profiler("gdscript_lines");
+	}
+	active = false;
+	stack.clear();
+	dirty_nodes.clear();
+	if (root) {
+		memdelete(root);
+		root = nullptr;
+	}
+}
+
+#endif // DEBUG_ENABLED
@@ -0,0 +1,138 @@
+/*************************************************************************/
+/*  gdscript_line_profiler.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GDSCRIPT_LINE_PROFILER_H
+#define GDSCRIPT_LINE_PROFILER_H
+
+#ifdef DEBUG_ENABLED
+
+#include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/map.h"
+#include "core/variant/array.h"
+#include "core/variant/variant.h"
+#include "gdscript_utility_functions.h"
+
+class GDScriptFunction;
+class MethodBind;
+
+// Opt-in per-line profiler, exposed to the debugger as the "gdscript_lines"
+// profiler. Each OPCODE_LINE charges the time elapsed since the previous one to
+// the line that was running. Calls to script functions, native and built-in
+// methods and utility functions become children in a call tree, keyed by the
+// calling line. Operators and constructors stay part of the line's self time.
+//
+// Every frame the lines that ran are streamed as folded stacks
+// ("caller:line;callee:line"), ready for flame graph tools. Only the main thread
+// is profiled.
+class GDScriptLineProfiler {
+	struct LineCost {
+		uint64_t time = 0;
+		uint64_t hits = 0;
+	};
+
+	struct ChildKey {
+		const void *id = nullptr;
+		const void *owner = nullptr; // Tells apart methods of different types called by name.
+		int line = 0;
+
+		bool operator<(const ChildKey &p_other) const {
+			if (id != p_other.id) {
+				return id < p_other.id;
+			}
+			return owner == p_other.owner ? line < p_other.line : owner < p_other.owner;
+		}
+	};
+
+	struct Node {
+		String label; // Function signature, or "Class::method" for native methods.
+		String prefix; // Folded stack of the callers, including the trailing separator.
+		int first_line = 0;
+		bool native = false;
+		bool dirty = false;
+		LocalVector<LineCost> lines; // Indexed by line - first_line.
+		Map<ChildKey, Node *> children;
+
+		~Node();
+	};
+
+	struct Frame {
+		Node *node = nullptr;
+		int line = 0;
+	};
+
+	static bool active;
+	static uint32_t session;
+	static uint64_t last_ticks;
+	static Node *root;
+	static LocalVector<Frame> stack;
+	static LocalVector<Node *> dirty_nodes;
+
+	static void _reset();
+	static LineCost &_get_line_cost(Node *p_node, int p_line);
+	static void _charge(uint64_t p_now);
+	static Node *_get_child(const ChildKey &p_key, int p_first_line, bool p_native);
+	static Node *_enter_native(const ChildKey &p_key);
+
+	static void _toggle(void *p_user, bool p_enable, const Array &p_opts);
+	static void _tick(void *p_user, float p_frame_time, float p_process_time, float p_physics_time, float p_physics_frame_time);
+
+public:
+	_FORCE_INLINE_ static bool is_active() { return active; }
+	// Starts a new session when enabled. The debugger toggles it through the registered profiler.
+	static void set_active(bool p_active);
+
+	// Returns the session the call belongs to, or 0 when the call is not profiled.
+	static uint32_t enter_function(const GDScriptFunction *p_function);
+	static void line(uint32_t p_session, int p_line);
+	static void exit_function(uint32_t p_session);
+
+	// Every enter_* call for a native callee must be paired with exit_native().
+	static void enter_native(uint32_t p_session, const MethodBind *p_method);
+	static void enter_method(uint32_t p_session, const Variant *p_base, const StringName &p_method);
+	static void enter_builtin_method(uint32_t p_session, Variant::Type p_type, Variant::ValidatedBuiltInMethod p_method);
+	static void enter_builtin_static(uint32_t p_session, Variant::Type p_type, const StringName &p_method);
+	// For the append opcodes, which no longer know which method they replaced.
+	static void enter_append(uint32_t p_session, Variant::Type p_type);
+	static void enter_utility(uint32_t p_session, const StringName &p_function);
+	static void enter_utility(uint32_t p_session, Variant::ValidatedUtilityFunction p_function);
+	static void enter_gdscript_utility(uint32_t p_session, GDScriptUtilityFunctions::FunctionPtr p_function);
+	static void exit_native(uint32_t p_session);
+
+	// Collects the lines that ran since the last call, as sent in each "gdscript_lines:profile_frame" message.
+	static Array take_frame_data();
+
+	static void register_profiler();
+	static void unregister_profiler();
+};
+
+#endif // DEBUG_ENABLED
+
+#endif // GDSCRIPT_LINE_PROFILER_H
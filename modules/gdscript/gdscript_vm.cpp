@@ -34,6 +34,7 @@
 #include "core/os/os.h"
 #include "gdscript.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_line_profiler.h"
 
 Variant *GDScriptFunction::_get_variant(int p_address, GDScriptInstance *p_instance, Variant *p_stack, String &r_error) const {
 	int address = p_address & ADDR_MASK;
@@ -123,6 +124,18 @@ static String _get_var_type(const Variant *p_var) {
 }
 #endif // DEBUG_ENABLED
 
+// Inline caches only dispatch on native objects, a script instance may handle the member itself.
+static _FORCE_INLINE_ Object *_get_inline_cache_base(const Variant *p_base) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		return nullptr;
+	}
+	Object *obj = p_base->get_validated_object();
+	if (!obj || obj->get_script_instance()) {
+		return nullptr;
+	}
+	return obj;
+}
+
 String GDScriptFunction::_get_call_error(const Callable::CallError &p_err, const String &p_where, const Variant **argptrs) const {
 	String err_text;
 
@@ -200,9 +213,17 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_SET_KEYED,                          \
 		&&OPCODE_SET_KEYED_VALIDATED,                \
 		&&OPCODE_SET_INDEXED_VALIDATED,              \
+		&&OPCODE_SET_INDEXED_TYPED_ARRAY_INT,        \
+		&&OPCODE_SET_INDEXED_TYPED_ARRAY_FLOAT,      \
+		&&OPCODE_SET_INDEXED_TYPED_ARRAY_VECTOR2,    \
+		&&OPCODE_SET_INDEXED_TYPED_ARRAY_VECTOR3,    \
 		&&OPCODE_GET_KEYED,                          \
 		&&OPCODE_GET_KEYED_VALIDATED,                \
 		&&OPCODE_GET_INDEXED_VALIDATED,              \
+		&&OPCODE_GET_INDEXED_TYPED_ARRAY_INT,        \
+		&&OPCODE_GET_INDEXED_TYPED_ARRAY_FLOAT,      \
+		&&OPCODE_GET_INDEXED_TYPED_ARRAY_VECTOR2,    \
+		&&OPCODE_GET_INDEXED_TYPED_ARRAY_VECTOR3,    \
 		&&OPCODE_SET_NAMED,                          \
 		&&OPCODE_SET_NAMED_VALIDATED,                \
 		&&OPCODE_GET_NAMED,                          \
@@ -270,6 +291,16 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_CALL_PTRCALL_PACKED_VECTOR2_ARRAY,  \
 		&&OPCODE_CALL_PTRCALL_PACKED_VECTOR3_ARRAY,  \
 		&&OPCODE_CALL_PTRCALL_PACKED_COLOR_ARRAY,    \
+		&&OPCODE_APPEND_ARRAY,                       \
+		&&OPCODE_APPEND_PACKED_BYTE_ARRAY,           \
+		&&OPCODE_APPEND_PACKED_INT32_ARRAY,          \
+		&&OPCODE_APPEND_PACKED_INT64_ARRAY,          \
+		&&OPCODE_APPEND_PACKED_FLOAT32_ARRAY,        \
+		&&OPCODE_APPEND_PACKED_FLOAT64_ARRAY,        \
+		&&OPCODE_APPEND_PACKED_STRING_ARRAY,         \
+		&&OPCODE_APPEND_PACKED_VECTOR2_ARRAY,        \
+		&&OPCODE_APPEND_PACKED_VECTOR3_ARRAY,        \
+		&&OPCODE_APPEND_PACKED_COLOR_ARRAY,          \
 		&&OPCODE_AWAIT,                              \
 		&&OPCODE_AWAIT_RESUME,                       \
 		&&OPCODE_CREATE_LAMBDA,                      \
@@ -292,6 +323,10 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_ITERATE_BEGIN_STRING,               \
 		&&OPCODE_ITERATE_BEGIN_DICTIONARY,           \
 		&&OPCODE_ITERATE_BEGIN_ARRAY,                \
+		&&OPCODE_ITERATE_BEGIN_TYPED_ARRAY_INT,      \
+		&&OPCODE_ITERATE_BEGIN_TYPED_ARRAY_FLOAT,    \
+		&&OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR2,  \
+		&&OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR3,  \
 		&&OPCODE_ITERATE_BEGIN_PACKED_BYTE_ARRAY,    \
 		&&OPCODE_ITERATE_BEGIN_PACKED_INT32_ARRAY,   \
 		&&OPCODE_ITERATE_BEGIN_PACKED_INT64_ARRAY,   \
@@ -312,6 +347,10 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_ITERATE_STRING,                     \
 		&&OPCODE_ITERATE_DICTIONARY,                 \
 		&&OPCODE_ITERATE_ARRAY,                      \
+		&&OPCODE_ITERATE_TYPED_ARRAY_INT,            \
+		&&OPCODE_ITERATE_TYPED_ARRAY_FLOAT,          \
+		&&OPCODE_ITERATE_TYPED_ARRAY_VECTOR2,        \
+		&&OPCODE_ITERATE_TYPED_ARRAY_VECTOR3,        \
 		&&OPCODE_ITERATE_PACKED_BYTE_ARRAY,          \
 		&&OPCODE_ITERATE_PACKED_INT32_ARRAY,         \
 		&&OPCODE_ITERATE_PACKED_INT64_ARRAY,         \
@@ -571,6 +610,23 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #define GET_INSTRUCTION_ARG(m_v, m_idx) \
 	Variant *m_v = instruction_args[m_idx]
 
+#define GET_INLINE_CACHE(m_v, m_code_ofs)                                                               \
+	GD_ERR_BREAK(_code_ptr[ip + m_code_ofs] < 0 || _code_ptr[ip + m_code_ofs] >= _inline_caches_count); \
+	GDScriptInlineCache *m_v = &_inline_caches_ptr[_code_ptr[ip + m_code_ofs]]
+
+#ifdef DEBUG_ENABLED
+#define COUNT_INLINE_CACHE(m_hit)                       \
+	if (GDScriptLanguage::get_singleton()->profiling) { \
+		if (m_hit) {                                    \
+			profile.inline_cache_hits++;                \
+		} else {                                        \
+			profile.inline_cache_misses++;              \
+		}                                               \
+	}
+#else
+#define COUNT_INLINE_CACHE(m_hit)
+#endif
+
 #ifdef DEBUG_ENABLED
 
 	uint64_t function_start_time = 0;
@@ -582,6 +638,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		profile.call_count++;
 		profile.frame_call_count++;
 	}
+
+	// Session of the per-line profiler this call is recorded in, 0 when it is not profiled.
+	uint32_t line_profile_session = 0;
+	if (unlikely(GDScriptLineProfiler::is_active())) {
+		line_profile_session = GDScriptLineProfiler::enter_function(this);
+	}
 	bool exit_ok = false;
 	bool awaited = false;
 #endif
@@ -829,6 +891,47 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#ifdef DEBUG_ENABLED
+#define TYPED_ARRAY_INDEX_ERROR(m_text) \
+	err_text = m_text;                  \
+	OPCODE_BREAK
+#else
+#define TYPED_ARRAY_INDEX_ERROR(m_text) ((void)0)
+#endif
+
+// Elements of typed arrays are read and written in place. Holes left by `resize()` are replaced with the zero value.
+#define OPCODE_SET_INDEXED_TYPED_ARRAY(m_type, m_get_func)                                                                                 \
+	OPCODE(OPCODE_SET_INDEXED_TYPED_ARRAY_##m_type) {                                                                                      \
+		CHECK_SPACE(3);                                                                                                                    \
+		GET_INSTRUCTION_ARG(dst, 0);                                                                                                       \
+		GET_INSTRUCTION_ARG(index, 1);                                                                                                     \
+		GET_INSTRUCTION_ARG(value, 2);                                                                                                     \
+		Array *array = VariantInternal::get_array(dst);                                                                                    \
+		int64_t int_index = *VariantInternal::get_int(index);                                                                              \
+		int64_t size = array->size();                                                                                                      \
+		if (int_index < 0) {                                                                                                               \
+			int_index += size;                                                                                                             \
+		}                                                                                                                                  \
+		if (unlikely(int_index < 0 || int_index >= size)) {                                                                                \
+			TYPED_ARRAY_INDEX_ERROR("Out of bounds set index '" + index->operator String() + "' (on base: '" + _get_var_type(dst) + "')"); \
+		} else if (likely(array->get_typed_builtin() == Variant::m_type)) {                                                                \
+			Variant *elem = &(*array)[int_index];                                                                                          \
+			if (elem->get_type() != Variant::m_type) {                                                                                     \
+				VariantInternal::initialize(elem, Variant::m_type);                                                                        \
+			}                                                                                                                              \
+			*VariantInternal::m_get_func(elem) = *VariantInternal::m_get_func(value);                                                      \
+		} else {                                                                                                                           \
+			array->set(int_index, *value);                                                                                                 \
+		}                                                                                                                                  \
+		ip += 4;                                                                                                                           \
+	}                                                                                                                                      \
+	DISPATCH_OPCODE
+
+			OPCODE_SET_INDEXED_TYPED_ARRAY(INT, get_int);
+			OPCODE_SET_INDEXED_TYPED_ARRAY(FLOAT, get_float);
+			OPCODE_SET_INDEXED_TYPED_ARRAY(VECTOR2, get_vector2);
+			OPCODE_SET_INDEXED_TYPED_ARRAY(VECTOR3, get_vector3);
+
 			OPCODE(OPCODE_GET_KEYED) {
 				CHECK_SPACE(3);
 
@@ -929,8 +1032,44 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_GET_INDEXED_TYPED_ARRAY(m_type, m_value_type, m_get_func)                                                                   \
+	OPCODE(OPCODE_GET_INDEXED_TYPED_ARRAY_##m_type) {                                                                                      \
+		CHECK_SPACE(3);                                                                                                                    \
+		GET_INSTRUCTION_ARG(src, 0);                                                                                                       \
+		GET_INSTRUCTION_ARG(index, 1);                                                                                                     \
+		GET_INSTRUCTION_ARG(dst, 2);                                                                                                       \
+		const Array *array = VariantInternal::get_array((const Variant *)src);                                                             \
+		int64_t int_index = *VariantInternal::get_int(index);                                                                              \
+		int64_t size = array->size();                                                                                                      \
+		if (int_index < 0) {                                                                                                               \
+			int_index += size;                                                                                                             \
+		}                                                                                                                                  \
+		if (unlikely(int_index < 0 || int_index >= size)) {                                                                                \
+			TYPED_ARRAY_INDEX_ERROR("Out of bounds get index '" + index->operator String() + "' (on base: '" + _get_var_type(src) + "')"); \
+		} else if (likely(array->get_typed_builtin() == Variant::m_type)) {                                                                \
+			const Variant *elem = &(*array)[int_index];                                                                                    \
+			m_value_type elem_value = elem->get_type() == Variant::m_type ? *VariantInternal::m_get_func(elem) : m_value_type();           \
+			if (dst->get_type() != Variant::m_type) {                                                                                      \
+				VariantInternal::initialize(dst, Variant::m_type);                                                                         \
+			}                                                                                                                              \
+			*VariantInternal::m_get_func(dst) = elem_value;                                                                                \
+		} else {                                                                                                                           \
+			/* Not typed as the compiler expected (e.g. filled from C++), use the generic get. */                                          \
+			bool valid;                                                                                                                    \
+			Variant ret = src->get(*index, &valid);                                                                                        \
+			*dst = ret;                                                                                                                    \
+		}                                                                                                                                  \
+		ip += 4;                                                                                                                           \
+	}                                                                                                                                      \
+	DISPATCH_OPCODE
+
+			OPCODE_GET_INDEXED_TYPED_ARRAY(INT, int64_t, get_int);
+			OPCODE_GET_INDEXED_TYPED_ARRAY(FLOAT, double, get_float);
+			OPCODE_GET_INDEXED_TYPED_ARRAY(VECTOR2, Vector2, get_vector2);
+			OPCODE_GET_INDEXED_TYPED_ARRAY(VECTOR3, Vector3, get_vector3);
+
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(5);
 
 				GET_INSTRUCTION_ARG(dst, 0);
 				GET_INSTRUCTION_ARG(value, 1);
@@ -940,8 +1079,32 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				GET_INLINE_CACHE(cache, 4);
+
+				MethodBind *setter = nullptr;
+				int setter_index = -1;
+				Object *obj = _get_inline_cache_base(dst);
+				if (obj) {
+					bool cache_hit;
+					setter = cache->lookup(obj, *index, GDScriptInlineCache::KIND_SET, setter_index, cache_hit);
+					COUNT_INLINE_CACHE(cache_hit);
+				}
+
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				if (setter) {
+					Callable::CallError ce;
+					if (setter_index >= 0) {
+						Variant setter_arg = setter_index;
+						const Variant *args[2] = { &setter_arg, value };
+						setter->call(obj, args, 2, ce);
+					} else {
+						const Variant *args[1] = { value };
+						setter->call(obj, args, 1, ce);
+					}
+					valid = ce.error == Callable::CallError::CALL_OK;
+				} else {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -950,7 +1113,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -970,7 +1133,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_INSTRUCTION_ARG(src, 0);
 				GET_INSTRUCTION_ARG(dst, 1);
@@ -980,6 +1143,35 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				GET_INLINE_CACHE(cache, 4);
+
+				MethodBind *getter = nullptr;
+				int getter_index = -1;
+				Object *obj = _get_inline_cache_base(src);
+				if (obj) {
+					bool cache_hit;
+					getter = cache->lookup(obj, *index, GDScriptInlineCache::KIND_GET, getter_index, cache_hit);
+					COUNT_INLINE_CACHE(cache_hit);
+				}
+
+				if (getter) {
+					Callable::CallError ce;
+					Variant value;
+					if (getter_index >= 0) {
+						Variant getter_arg = getter_index;
+						const Variant *args[1] = { &getter_arg };
+						value = getter->call(obj, args, 1, ce);
+					} else {
+						value = getter->call(obj, nullptr, 0, ce);
+					}
+					// On error, let the generic path get the value and report the failure.
+					if (ce.error == Callable::CallError::CALL_OK) {
+						*dst = value;
+						ip += 5;
+						DISPATCH_OPCODE;
+					}
+				}
+
 				bool valid;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
@@ -999,7 +1191,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1439,7 +1631,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_CALL_ASYNC)
 			OPCODE(OPCODE_CALL_RETURN)
 			OPCODE(OPCODE_CALL) {
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 				bool call_ret = (_code_ptr[ip] & INSTR_MASK) != OPCODE_CALL;
 #ifdef DEBUG_ENABLED
 				bool call_async = (_code_ptr[ip] & INSTR_MASK) == OPCODE_CALL_ASYNC;
@@ -1454,21 +1646,43 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				GET_INLINE_CACHE(cache, 3);
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
+				MethodBind *method = nullptr;
+				Object *obj = _get_inline_cache_base(base);
+				if (obj) {
+					int unused_index;
+					bool cache_hit;
+					method = cache->lookup(obj, *methodname, GDScriptInlineCache::KIND_CALL, unused_index, cache_hit);
+					COUNT_INLINE_CACHE(cache_hit);
+				}
+
 #ifdef DEBUG_ENABLED
 				uint64_t call_time = 0;
 
 				if (GDScriptLanguage::get_singleton()->profiling) {
 					call_time = OS::get_singleton()->get_ticks_usec();
 				}
+				if (unlikely(line_profile_session)) {
+					if (method) {
+						GDScriptLineProfiler::enter_native(line_profile_session, method);
+					} else {
+						GDScriptLineProfiler::enter_method(line_profile_session, base, *methodname);
+					}
+				}
 
 #endif
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->call(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					if (method) {
+						*ret = method->call(obj, (const Variant **)argptrs, argc, err);
+					} else {
+						base->call(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					}
 #ifdef DEBUG_ENABLED
 					if (!call_async && ret->get_type() == Variant::OBJECT) {
 						// Check if getting a function state without await.
@@ -1485,6 +1699,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						}
 					}
 #endif
+				} else if (method) {
+					method->call(obj, (const Variant **)argptrs, argc, err);
 				} else {
 					Variant ret;
 					base->call(*methodname, (const Variant **)argptrs, argc, ret, err);
@@ -1493,6 +1709,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				if (GDScriptLanguage::get_singleton()->profiling) {
 					function_call_time += OS::get_singleton()->get_ticks_usec() - call_time;
 				}
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::exit_native(line_profile_session);
+				}
 
 				if (err.error != Callable::CallError::CALL_OK) {
 					String methodstr = *methodname;
@@ -1532,7 +1751,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -1571,6 +1790,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				if (GDScriptLanguage::get_singleton()->profiling) {
 					call_time = OS::get_singleton()->get_ticks_usec();
 				}
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::enter_native(line_profile_session, method);
+				}
 #endif
 
 				Callable::CallError err;
@@ -1585,6 +1807,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				if (GDScriptLanguage::get_singleton()->profiling) {
 					function_call_time += OS::get_singleton()->get_ticks_usec() - call_time;
 				}
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::exit_native(line_profile_session);
+				}
 
 				if (err.error != Callable::CallError::CALL_OK) {
 					String methodstr = method->get_name();
@@ -1641,6 +1866,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				if (GDScriptLanguage::get_singleton()->profiling) {
 					call_time = OS::get_singleton()->get_ticks_usec();
 				}
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::enter_builtin_static(line_profile_session, builtin_type, *methodname);
+				}
 #endif
 
 				Callable::CallError err;
@@ -1650,6 +1878,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				if (GDScriptLanguage::get_singleton()->profiling) {
 					function_call_time += OS::get_singleton()->get_ticks_usec() - call_time;
 				}
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::exit_native(line_profile_session);
+				}
 
 				if (err.error != Callable::CallError::CALL_OK) {
 					err_text = _get_call_error(err, "static function '" + methodname->operator String() + "' in type '" + Variant::get_type_name(builtin_type) + "'", argptrs);
@@ -1689,6 +1920,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		if (GDScriptLanguage::get_singleton()->profiling) {                          \
 			call_time = OS::get_singleton()->get_ticks_usec();                       \
 		}                                                                            \
+		if (unlikely(line_profile_session)) {                                        \
+			GDScriptLineProfiler::enter_native(line_profile_session, method);        \
+		}                                                                            \
 		GET_INSTRUCTION_ARG(ret, argc + 1);                                          \
 		VariantInternal::initialize(ret, Variant::m_type);                           \
 		void *ret_opaque = VariantInternal::OP_GET_##m_type(ret);                    \
@@ -1696,6 +1930,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		if (GDScriptLanguage::get_singleton()->profiling) {                          \
 			function_call_time += OS::get_singleton()->get_ticks_usec() - call_time; \
 		}                                                                            \
+		if (unlikely(line_profile_session)) {                                        \
+			GDScriptLineProfiler::exit_native(line_profile_session);                 \
+		}                                                                            \
 		ip += 3;                                                                     \
 	}                                                                                \
 	DISPATCH_OPCODE
@@ -1792,6 +2029,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				if (GDScriptLanguage::get_singleton()->profiling) {
 					call_time = OS::get_singleton()->get_ticks_usec();
 				}
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::enter_native(line_profile_session, method);
+				}
 #endif
 
 				GET_INSTRUCTION_ARG(ret, argc + 1);
@@ -1804,6 +2044,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				if (GDScriptLanguage::get_singleton()->profiling) {
 					function_call_time += OS::get_singleton()->get_ticks_usec() - call_time;
 				}
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::exit_native(line_profile_session);
+				}
 #endif
 				ip += 3;
 			}
@@ -1845,6 +2088,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				if (GDScriptLanguage::get_singleton()->profiling) {
 					call_time = OS::get_singleton()->get_ticks_usec();
 				}
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::enter_native(line_profile_session, method);
+				}
 #endif
 
 				GET_INSTRUCTION_ARG(ret, argc + 1);
@@ -1855,6 +2101,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				if (GDScriptLanguage::get_singleton()->profiling) {
 					function_call_time += OS::get_singleton()->get_ticks_usec() - call_time;
 				}
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::exit_native(line_profile_session);
+				}
 #endif
 				ip += 3;
 			}
@@ -1879,6 +2128,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				if (GDScriptLanguage::get_singleton()->profiling) {
 					call_time = OS::get_singleton()->get_ticks_usec();
 				}
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::enter_builtin_method(line_profile_session, base->get_type(), method);
+				}
 #endif
 
 				GET_INSTRUCTION_ARG(ret, argc + 1);
@@ -1888,6 +2140,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				if (GDScriptLanguage::get_singleton()->profiling) {
 					function_call_time += OS::get_singleton()->get_ticks_usec() - call_time;
 				}
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::exit_native(line_profile_session);
+				}
 #endif
 
 				ip += 3;
@@ -1909,10 +2164,20 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				GET_INSTRUCTION_ARG(dst, argc);
 
+#ifdef DEBUG_ENABLED
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::enter_utility(line_profile_session, function);
+				}
+#endif
+
 				Callable::CallError err;
 				Variant::call_utility_function(function, dst, (const Variant **)argptrs, argc, err);
 
 #ifdef DEBUG_ENABLED
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::exit_native(line_profile_session);
+				}
+
 				if (err.error != Callable::CallError::CALL_OK) {
 					String methodstr = function;
 					if (dst->get_type() == Variant::STRING) {
@@ -1943,8 +2208,19 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				GET_INSTRUCTION_ARG(dst, argc);
 
+#ifdef DEBUG_ENABLED
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::enter_utility(line_profile_session, function);
+				}
+#endif
+
 				function(dst, (const Variant **)argptrs, argc);
 
+#ifdef DEBUG_ENABLED
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::exit_native(line_profile_session);
+				}
+#endif
 				ip += 3;
 			}
 			DISPATCH_OPCODE;
@@ -1964,10 +2240,20 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				GET_INSTRUCTION_ARG(dst, argc);
 
+#ifdef DEBUG_ENABLED
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::enter_gdscript_utility(line_profile_session, function);
+				}
+#endif
+
 				Callable::CallError err;
 				function(dst, (const Variant **)argptrs, argc, err);
 
 #ifdef DEBUG_ENABLED
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::exit_native(line_profile_session);
+				}
+
 				if (err.error != Callable::CallError::CALL_OK) {
 					// TODO: Add this information in debug.
 					String methodstr = "<unknown function>";
@@ -2050,6 +2336,79 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_APPEND_ARRAY) {
+				CHECK_SPACE(2);
+
+				GET_INSTRUCTION_ARG(base, 0);
+				GET_INSTRUCTION_ARG(value, 1);
+
+#ifdef DEBUG_ENABLED
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::enter_append(line_profile_session, Variant::ARRAY);
+				}
+#endif
+
+				// Typed arrays validate the value themselves.
+				VariantInternal::get_array(base)->push_back(*value);
+
+#ifdef DEBUG_ENABLED
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::exit_native(line_profile_session);
+				}
+#endif
+
+				ip += 3;
+			}
+			DISPATCH_OPCODE;
+
+#ifdef DEBUG_ENABLED
+#define OPCODE_APPEND_PACKED_ARRAY(m_var_type, m_get_func, m_value_get_func)                                   \
+	OPCODE(OPCODE_APPEND_PACKED_##m_var_type##_ARRAY) {                                                        \
+		CHECK_SPACE(3);                                                                                        \
+		GET_INSTRUCTION_ARG(base, 0);                                                                          \
+		GET_INSTRUCTION_ARG(value, 1);                                                                         \
+		GET_INSTRUCTION_ARG(ret, 2);                                                                           \
+		if (unlikely(line_profile_session)) {                                                                  \
+			GDScriptLineProfiler::enter_append(line_profile_session, Variant::PACKED_##m_var_type##_ARRAY);    \
+		}                                                                                                      \
+		bool failed = VariantInternal::m_get_func(base)->push_back(*VariantInternal::m_value_get_func(value)); \
+		if (unlikely(line_profile_session)) {                                                                  \
+			GDScriptLineProfiler::exit_native(line_profile_session);                                           \
+		}                                                                                                      \
+		if (ret->get_type() != Variant::BOOL) {                                                                \
+			VariantInternal::initialize(ret, Variant::BOOL);                                                   \
+		}                                                                                                      \
+		*VariantInternal::get_bool(ret) = failed;                                                              \
+		ip += 4;                                                                                               \
+	}                                                                                                          \
+	DISPATCH_OPCODE
+#else
+#define OPCODE_APPEND_PACKED_ARRAY(m_var_type, m_get_func, m_value_get_func)                                   \
+	OPCODE(OPCODE_APPEND_PACKED_##m_var_type##_ARRAY) {                                                        \
+		CHECK_SPACE(3);                                                                                        \
+		GET_INSTRUCTION_ARG(base, 0);                                                                          \
+		GET_INSTRUCTION_ARG(value, 1);                                                                         \
+		GET_INSTRUCTION_ARG(ret, 2);                                                                           \
+		bool failed = VariantInternal::m_get_func(base)->push_back(*VariantInternal::m_value_get_func(value)); \
+		if (ret->get_type() != Variant::BOOL) {                                                                \
+			VariantInternal::initialize(ret, Variant::BOOL);                                                   \
+		}                                                                                                      \
+		*VariantInternal::get_bool(ret) = failed;                                                              \
+		ip += 4;                                                                                               \
+	}                                                                                                          \
+	DISPATCH_OPCODE
+#endif
+
+			OPCODE_APPEND_PACKED_ARRAY(BYTE, get_byte_array, get_int);
+			OPCODE_APPEND_PACKED_ARRAY(INT32, get_int32_array, get_int);
+			OPCODE_APPEND_PACKED_ARRAY(INT64, get_int64_array, get_int);
+			OPCODE_APPEND_PACKED_ARRAY(FLOAT32, get_float32_array, get_float);
+			OPCODE_APPEND_PACKED_ARRAY(FLOAT64, get_float64_array, get_float);
+			OPCODE_APPEND_PACKED_ARRAY(STRING, get_string_array, get_string);
+			OPCODE_APPEND_PACKED_ARRAY(VECTOR2, get_vector2_array, get_vector2);
+			OPCODE_APPEND_PACKED_ARRAY(VECTOR3, get_vector3_array, get_vector3);
+			OPCODE_APPEND_PACKED_ARRAY(COLOR, get_color_array, get_color);
+
 			OPCODE(OPCODE_AWAIT) {
 				CHECK_SPACE(2);
 
@@ -2697,6 +3056,39 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_ITERATE_BEGIN_TYPED_ARRAY(m_var_type, m_ret_type, m_ret_get_func)                                                         \
+	OPCODE(OPCODE_ITERATE_BEGIN_TYPED_ARRAY_##m_var_type) {                                                                              \
+		CHECK_SPACE(8);                                                                                                                  \
+		GET_INSTRUCTION_ARG(counter, 0);                                                                                                 \
+		GET_INSTRUCTION_ARG(container, 1);                                                                                               \
+		const Array *array = VariantInternal::get_array((const Variant *)container);                                                     \
+		VariantInternal::initialize(counter, Variant::INT);                                                                              \
+		*VariantInternal::get_int(counter) = 0;                                                                                          \
+		if (!array->is_empty()) {                                                                                                        \
+			GET_INSTRUCTION_ARG(iterator, 2);                                                                                            \
+			if (likely(array->get_typed_builtin() == Variant::m_var_type)) {                                                             \
+				const Variant *elem = &array->get(0);                                                                                    \
+				m_ret_type elem_value = elem->get_type() == Variant::m_var_type ? *VariantInternal::m_ret_get_func(elem) : m_ret_type(); \
+				VariantInternal::initialize(iterator, Variant::m_var_type);                                                              \
+				*VariantInternal::m_ret_get_func(iterator) = elem_value;                                                                 \
+			} else {                                                                                                                     \
+				/* Not typed as the compiler expected (e.g. filled from C++), copy the element as is. */                                 \
+				*iterator = array->get(0);                                                                                               \
+			}                                                                                                                            \
+			ip += 5;                                                                                                                     \
+		} else {                                                                                                                         \
+			int jumpto = _code_ptr[ip + 4];                                                                                              \
+			GD_ERR_BREAK(jumpto<0 || jumpto> _code_size);                                                                                \
+			ip = jumpto;                                                                                                                 \
+		}                                                                                                                                \
+	}                                                                                                                                    \
+	DISPATCH_OPCODE
+
+			OPCODE_ITERATE_BEGIN_TYPED_ARRAY(INT, int64_t, get_int);
+			OPCODE_ITERATE_BEGIN_TYPED_ARRAY(FLOAT, double, get_float);
+			OPCODE_ITERATE_BEGIN_TYPED_ARRAY(VECTOR2, Vector2, get_vector2);
+			OPCODE_ITERATE_BEGIN_TYPED_ARRAY(VECTOR3, Vector3, get_vector3);
+
 #define OPCODE_ITERATE_BEGIN_PACKED_ARRAY(m_var_type, m_elem_type, m_get_func, m_var_ret_type, m_ret_type, m_ret_get_func) \
 	OPCODE(OPCODE_ITERATE_BEGIN_PACKED_##m_var_type##_ARRAY) {                                                             \
 		CHECK_SPACE(8);                                                                                                    \
@@ -3030,6 +3422,41 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_ITERATE_TYPED_ARRAY(m_var_type, m_ret_type, m_ret_get_func)                                                               \
+	OPCODE(OPCODE_ITERATE_TYPED_ARRAY_##m_var_type) {                                                                                    \
+		CHECK_SPACE(4);                                                                                                                  \
+		GET_INSTRUCTION_ARG(counter, 0);                                                                                                 \
+		GET_INSTRUCTION_ARG(container, 1);                                                                                               \
+		const Array *array = VariantInternal::get_array((const Variant *)container);                                                     \
+		int64_t *idx = VariantInternal::get_int(counter);                                                                                \
+		(*idx)++;                                                                                                                        \
+		if (*idx >= array->size()) {                                                                                                     \
+			int jumpto = _code_ptr[ip + 4];                                                                                              \
+			GD_ERR_BREAK(jumpto<0 || jumpto> _code_size);                                                                                \
+			ip = jumpto;                                                                                                                 \
+		} else {                                                                                                                         \
+			GET_INSTRUCTION_ARG(iterator, 2);                                                                                            \
+			if (likely(array->get_typed_builtin() == Variant::m_var_type)) {                                                             \
+				const Variant *elem = &array->get(*idx);                                                                                 \
+				m_ret_type elem_value = elem->get_type() == Variant::m_var_type ? *VariantInternal::m_ret_get_func(elem) : m_ret_type(); \
+				if (iterator->get_type() != Variant::m_var_type) {                                                                       \
+					VariantInternal::initialize(iterator, Variant::m_var_type);                                                          \
+				}                                                                                                                        \
+				*VariantInternal::m_ret_get_func(iterator) = elem_value;                                                                 \
+			} else {                                                                                                                     \
+				/* Not typed as the compiler expected (e.g. filled from C++), copy the element as is. */                                 \
+				*iterator = array->get(*idx);                                                                                            \
+			}                                                                                                                            \
+			ip += 5;                                                                                                                     \
+		}                                                                                                                                \
+	}                                                                                                                                    \
+	DISPATCH_OPCODE
+
+			OPCODE_ITERATE_TYPED_ARRAY(INT, int64_t, get_int);
+			OPCODE_ITERATE_TYPED_ARRAY(FLOAT, double, get_float);
+			OPCODE_ITERATE_TYPED_ARRAY(VECTOR2, Vector2, get_vector2);
+			OPCODE_ITERATE_TYPED_ARRAY(VECTOR3, Vector3, get_vector3);
+
 #define OPCODE_ITERATE_PACKED_ARRAY(m_var_type, m_elem_type, m_get_func, m_ret_get_func)            \
 	OPCODE(OPCODE_ITERATE_PACKED_##m_var_type##_ARRAY) {                                            \
 		CHECK_SPACE(4);                                                                             \
@@ -3215,6 +3642,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
+#ifdef DEBUG_ENABLED
+				if (unlikely(line_profile_session)) {
+					GDScriptLineProfiler::line(line_profile_session, line);
+				}
+#endif
+
 				if (EngineDebugger::is_active()) {
 					// line
 					bool do_break = false;
@@ -3302,6 +3735,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		GDScriptLanguage::get_singleton()->script_frame_time += time_taken - function_call_time;
 	}
 
+	if (line_profile_session) {
+		GDScriptLineProfiler::exit_function(line_profile_session);
+	}
+
 	// Check if this is the last time the function is resuming from await
 	// Will be true if never awaited as well
 	// When it's the last resume it will postpone the exit from stack,
@@ -36,6 +36,7 @@
 #include "core/os/file_access.h"
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_tokenizer.h"
 #include "gdscript_utility_functions.h"
@@ -86,7 +87,17 @@ public:
 		}
 
 		// TODO: Re-add compiled GDScript on export.
-		return;
+		// The source is kept, as the bytecode cache is only used when its hash matches.
+		Ref<GDScript> script = ResourceLoader::load(p_path);
+		if (script.is_null() || !script->is_valid()) {
+			return;
+		}
+
+		Error err = OK;
+		Vector<uint8_t> bytecode = GDScriptBytecodeCache::serialize(script.ptr(), err);
+		if (err == OK) {
+			add_file(GDScriptBytecodeCache::get_cache_path(p_path), bytecode, false);
+		}
 	}
 };
 
@@ -140,6 +140,9 @@ GDScriptTestRunner::GDScriptTestRunner(const String &p_source_dir, bool p_init_l
 			String warning = GDScriptWarning::get_name_from_code((GDScriptWarning::Code)i).to_lower();
 			ProjectSettings::get_singleton()->set_setting("debug/gdscript/warnings/" + warning, true);
 		}
+
+		// The scripts are here to test the parser and compiler, don't load them from cache.
+		ProjectSettings::get_singleton()->set_setting("gdscript/bytecode_cache/enabled", false);
 	}
 
 	// Enable printing to show results
@@ -31,6 +31,8 @@
 #ifndef GDSCRIPT_TEST_RUNNER_SUITE_H
 #define GDSCRIPT_TEST_RUNNER_SUITE_H
 
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_line_profiler.h"
 #include "gdscript_test_runner.h"
 #include "tests/test_macros.h"
 
@@ -69,6 +71,100 @@ func _init():
 	CHECK_MESSAGE(int(reference->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+TEST_CASE("[Modules][GDScript] Serialize compiled bytecode and run it") {
+	const String source = R"(
+extends Reference
+
+const FACTOR = 3
+
+class Inner:
+	func twice(value: int) -> int:
+		return value * 2
+
+func _init():
+	var inner := Inner.new()
+	var total := 0
+	for i in range(4):
+		total += inner.twice(i) * FACTOR
+	set_meta("result", total)
+)";
+
+	Ref<GDScript> compiled = memnew(GDScript);
+	compiled->set_source_code(source);
+	ERR_PRINT_OFF;
+	const Error error = compiled->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	Error serialize_error = FAILED;
+	const Vector<uint8_t> bytecode = GDScriptBytecodeCache::serialize(compiled.ptr(), serialize_error);
+	REQUIRE_MESSAGE(serialize_error == OK, "The compiled script should be serializable.");
+
+	Ref<GDScript> loaded = memnew(GDScript);
+	loaded->set_source_code(source);
+	REQUIRE_MESSAGE(GDScriptBytecodeCache::deserialize(loaded.ptr(), bytecode) == OK, "The bytecode should load without parsing.");
+	CHECK(loaded->is_valid());
+	CHECK(loaded->get_subclasses().has("Inner"));
+
+	Ref<Reference> reference = memnew(Reference);
+	reference->set_script(loaded);
+	CHECK_MESSAGE(int(reference->get_meta("result")) == 36, "The loaded bytecode should run like the compiled one.");
+
+	Ref<GDScript> changed = memnew(GDScript);
+	changed->set_source_code(source + "\n# Changed.\n");
+	CHECK_MESSAGE(GDScriptBytecodeCache::deserialize(changed.ptr(), bytecode) != OK, "Bytecode for a different source should be rejected.");
+
+	Vector<uint8_t> truncated = bytecode;
+	truncated.resize(truncated.size() / 2);
+	CHECK_MESSAGE(GDScriptBytecodeCache::deserialize(changed.ptr(), truncated) == ERR_FILE_CORRUPT, "Truncated bytecode should be rejected.");
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Modules][GDScript] Profile a script per line") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends Reference
+
+func twice(value):
+	return value * 2
+
+func _init():
+	var total = 0
+	for i in 3:
+		total += twice(i)
+	var values = []
+	values.append(total)
+	set_meta("result", abs(-values[0]))
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	GDScriptLineProfiler::set_active(true);
+	Ref<Reference> reference = memnew(Reference);
+	reference->set_script(gdscript);
+	const Array data = GDScriptLineProfiler::take_frame_data();
+	GDScriptLineProfiler::set_active(false);
+	CHECK(int(reference->get_meta("result")) == 6);
+
+	// The data is a flat list of (folded stack, time, hits) triples.
+	REQUIRE(data.size() % 3 == 0);
+	Dictionary hits;
+	for (int i = 0; i < data.size(); i += 3) {
+		hits[data[i]] = int(hits.get(data[i], 0)) + int(data[i + 2]);
+	}
+
+	CHECK_MESSAGE(int(hits.get("_init:8", 0)) == 1, "Lines should be keyed by function name and line.");
+	CHECK_MESSAGE(int(hits.get("_init:10", 0)) == 3, "Every run of a line in a loop should be counted.");
+	CHECK_MESSAGE(int(hits.get("_init:10;twice:5", 0)) == 3, "Script calls should be nested under the calling line.");
+	CHECK_MESSAGE(int(hits.get("_init:12;Array::append", 0)) == 1, "Built-in method calls should be nested under the calling line.");
+	CHECK_MESSAGE(int(hits.get("_init:13;@GlobalScope::abs", 0)) == 1, "Utility function calls should be nested under the calling line.");
+	CHECK_MESSAGE(int(hits.get("_init:13;Object::set_meta", 0)) == 1, "Native method calls should be nested under the calling line.");
+	CHECK_MESSAGE(GDScriptLineProfiler::take_frame_data().is_empty(), "Taking the data should reset it.");
+}
+#endif // DEBUG_ENABLED
+
 } // namespace GDScriptTests
 
 #endif // GDSCRIPT_TEST_RUNNER_SUITE_H
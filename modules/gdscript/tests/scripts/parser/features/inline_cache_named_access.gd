@@ -0,0 +1,30 @@
+class Scripted:
+	var strength = 10
+
+	func get_strength():
+		return strength * 2
+
+
+func test():
+	# Indexed properties.
+	var boxes = []
+	for i in 3:
+		var box = StyleBoxFlat.new()
+		box.content_margin_left = i
+		boxes.push_back(box)
+	var total = 0
+	for box in boxes:
+		total += int(box.content_margin_left)
+	print(total)
+
+	# More classes at the same sites than a cache holds.
+	var resources = [Image.new(), Translation.new(), InputEventKey.new(), InputEventAction.new(), StyleBoxFlat.new(), StyleBoxEmpty.new()]
+	for resource in resources:
+		resource.resource_name = "Named"
+		print(resource.get_class(), " ", resource.resource_name)
+
+	# Script instances resolve their own members before the native ones.
+	var action = InputEventAction.new()
+	action.strength = 0.5
+	for item in [action, Scripted.new(), action]:
+		print(item.strength, " ", item.get_strength())
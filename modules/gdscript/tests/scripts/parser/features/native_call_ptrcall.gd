@@ -0,0 +1,17 @@
+func test():
+	var rng := RandomNumberGenerator.new()
+	# Integers passed to float parameters are converted before the call.
+	print(rng.randf_range(2, 2))
+	var bound: int = 3
+	print(rng.randf_range(bound, bound))
+
+	# Strings passed to StringName parameters.
+	print(rng.has_method("randf_range"))
+	var method_name: String = "randi"
+	print(rng.has_method(method_name))
+	print(rng.has_method("not_a_method"))
+
+	# Omitted arguments are filled from the bound defaults.
+	var expression := Expression.new()
+	print(expression.parse("1 + 2"))
+	print(expression.execute())
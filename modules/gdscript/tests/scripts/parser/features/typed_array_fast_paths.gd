@@ -0,0 +1,27 @@
+func test():
+	var ints: Array[int] = [1, 2, 3]
+	ints.resize(4)
+	var sum := 0
+	for i in ints:
+		sum += i
+	print(sum)
+
+	ints[3] = 4
+	ints[-1] += 1
+	print(ints[3])
+	ints.append(6)
+	print(ints)
+
+	var packed := PackedInt32Array()
+	for n in 3:
+		packed.append(n * 2)
+	var total := 0
+	for value in packed:
+		total += value
+	print(packed, " ", total)
+
+	var points: Array[Vector2] = [Vector2(1, 2), Vector2(3, 4)]
+	var acc := Vector2()
+	for point in points:
+		acc += point
+	print(acc)
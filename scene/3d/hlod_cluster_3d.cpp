@@ -0,0 +1,210 @@
+/*************************************************************************/
+/*  hlod_cluster_3d.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "hlod_cluster_3d.h"
+
+#include "scene/resources/surface_tool.h"
+
+void HLODCluster3D::_find_meshes(Node *p_node, List<MeshInstance3D *> &r_meshes) {
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		Node *child = p_node->get_child(i);
+		if (!child->get_owner()) {
+			continue; //maybe a helper
+		}
+
+		MeshInstance3D *mi = Object::cast_to<MeshInstance3D>(child);
+		if (mi && mi->is_visible_in_tree() && mi->get_mesh().is_valid() && mi->get_skin().is_null()) {
+			r_meshes.push_back(mi);
+		}
+
+		if (Object::cast_to<HLODCluster3D>(child)) {
+			continue; //nested clusters manage their own children
+		}
+
+		_find_meshes(child, r_meshes);
+	}
+}
+
+void HLODCluster3D::_clear_lod_children() {
+	for (int i = 0; i < lod_children.size(); i++) {
+		GeometryInstance3D *child = Object::cast_to<GeometryInstance3D>(ObjectDB::get_instance(lod_children[i]));
+		if (child) {
+			RS::get_singleton()->instance_geometry_set_as_instance_lod(child->get_instance(), RID());
+		}
+	}
+	lod_children.clear();
+}
+
+void HLODCluster3D::_update_lod_children() {
+	_clear_lod_children();
+
+	if (get_mesh().is_null()) {
+		return; //nothing baked yet, children are drawn as usual
+	}
+
+	List<MeshInstance3D *> meshes;
+	_find_meshes(this, meshes);
+
+	for (List<MeshInstance3D *>::Element *E = meshes.front(); E; E = E->next()) {
+		RS::get_singleton()->instance_geometry_set_as_instance_lod(E->get()->get_instance(), get_instance());
+		lod_children.push_back(E->get()->get_instance_id());
+	}
+}
+
+void HLODCluster3D::_notification(int p_what) {
+	switch (p_what) {
+		case NOTIFICATION_READY: {
+			_update_lod_children();
+		} break;
+		case NOTIFICATION_EXIT_TREE: {
+			_clear_lod_children();
+			request_ready(); //link the children again if the cluster is added back
+		} break;
+	}
+}
+
+void HLODCluster3D::set_bake_triangle_ratio(float p_ratio) {
+	bake_triangle_ratio = CLAMP(p_ratio, 0.0, 1.0);
+}
+
+float HLODCluster3D::get_bake_triangle_ratio() const {
+	return bake_triangle_ratio;
+}
+
+void HLODCluster3D::set_bake_max_error(float p_error) {
+	bake_max_error = MAX(p_error, 0.0);
+}
+
+float HLODCluster3D::get_bake_max_error() const {
+	return bake_max_error;
+}
+
+HLODCluster3D::BakeError HLODCluster3D::bake() {
+	ERR_FAIL_COND_V(!is_inside_tree(), BAKE_ERROR_NO_MESHES);
+
+	if (SurfaceTool::simplify_func == nullptr) {
+		return BAKE_ERROR_NO_SIMPLIFIER;
+	}
+
+	List<MeshInstance3D *> meshes;
+	_find_meshes(this, meshes);
+
+	//merge all surfaces that share a material, so the proxy costs one draw call per material
+	Map<Ref<Material>, Ref<SurfaceTool>> merged;
+	Vector<Ref<Material>> material_order;
+
+	Transform global_to_local = get_global_transform().affine_inverse();
+
+	for (List<MeshInstance3D *>::Element *E = meshes.front(); E; E = E->next()) {
+		MeshInstance3D *mi = E->get();
+		Ref<Mesh> mesh = mi->get_mesh();
+		Transform xform = global_to_local * mi->get_global_transform();
+
+		for (int i = 0; i < mesh->get_surface_count(); i++) {
+			if (mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
+				continue;
+			}
+
+			Ref<Material> material = mi->get_active_material(i);
+
+			Ref<Mesh> source = mesh;
+			int source_surface = i;
+			if (!(mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX)) {
+				//the simplifier works on indexed geometry
+				Ref<SurfaceTool> st;
+				st.instance();
+				st->create_from(mesh, i);
+				st->index();
+				source = st->commit();
+				source_surface = 0;
+			}
+
+			if (!merged.has(material)) {
+				Ref<SurfaceTool> st;
+				st.instance();
+				st->begin(Mesh::PRIMITIVE_TRIANGLES);
+				merged[material] = st;
+				material_order.push_back(material);
+			}
+
+			merged[material]->append_from(source, source_surface, xform);
+		}
+	}
+
+	if (material_order.is_empty()) {
+		return BAKE_ERROR_NO_MESHES;
+	}
+
+	Ref<ArrayMesh> proxy;
+	proxy.instance();
+
+	for (int i = 0; i < material_order.size(); i++) {
+		Ref<SurfaceTool> st = merged[material_order[i]];
+		Array arrays = st->commit_to_arrays();
+
+		Vector<int> indices = arrays[Mesh::ARRAY_INDEX];
+		int target_index_count = MAX(3, int(indices.size() * bake_triangle_ratio) / 3 * 3);
+		if (target_index_count < indices.size()) {
+			Vector<int> lod = st->generate_lod(bake_max_error, target_index_count);
+			if (lod.size()) {
+				arrays[Mesh::ARRAY_INDEX] = lod;
+			}
+		}
+
+		proxy->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays);
+		proxy->surface_set_material(proxy->get_surface_count() - 1, material_order[i]);
+	}
+
+	set_mesh(proxy);
+	_update_lod_children();
+
+	return BAKE_ERROR_OK;
+}
+
+void HLODCluster3D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_bake_triangle_ratio", "ratio"), &HLODCluster3D::set_bake_triangle_ratio);
+	ClassDB::bind_method(D_METHOD("get_bake_triangle_ratio"), &HLODCluster3D::get_bake_triangle_ratio);
+	ClassDB::bind_method(D_METHOD("set_bake_max_error", "error"), &HLODCluster3D::set_bake_max_error);
+	ClassDB::bind_method(D_METHOD("get_bake_max_error"), &HLODCluster3D::get_bake_max_error);
+
+	ClassDB::bind_method(D_METHOD("bake"), &HLODCluster3D::bake);
+
+	ADD_GROUP("Bake", "bake_");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "bake_triangle_ratio", PROPERTY_HINT_RANGE, "0.01,1,0.01"), "set_bake_triangle_ratio", "get_bake_triangle_ratio");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "bake_max_error", PROPERTY_HINT_RANGE, "0,1,0.001"), "set_bake_max_error", "get_bake_max_error");
+
+	BIND_ENUM_CONSTANT(BAKE_ERROR_OK);
+	BIND_ENUM_CONSTANT(BAKE_ERROR_NO_MESHES);
+	BIND_ENUM_CONSTANT(BAKE_ERROR_NO_SIMPLIFIER);
+}
+
+HLODCluster3D::HLODCluster3D() {
+	set_lod_min_distance(100.0);
+}
@@ -0,0 +1,74 @@
+/*************************************************************************/
+/*  hlod_cluster_3d.h                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef HLOD_CLUSTER_3D_H
+#define HLOD_CLUSTER_3D_H
+
+#include "scene/3d/mesh_instance_3d.h"
+
+class SurfaceTool;
+
+class HLODCluster3D : public MeshInstance3D {
+	GDCLASS(HLODCluster3D, MeshInstance3D);
+
+	float bake_triangle_ratio = 0.25;
+	float bake_max_error = 0.05;
+
+	Vector<ObjectID> lod_children;
+
+	void _find_meshes(Node *p_node, List<MeshInstance3D *> &r_meshes);
+	void _update_lod_children();
+	void _clear_lod_children();
+
+protected:
+	void _notification(int p_what);
+	static void _bind_methods();
+
+public:
+	enum BakeError {
+		BAKE_ERROR_OK,
+		BAKE_ERROR_NO_MESHES,
+		BAKE_ERROR_NO_SIMPLIFIER,
+	};
+
+	void set_bake_triangle_ratio(float p_ratio);
+	float get_bake_triangle_ratio() const;
+
+	void set_bake_max_error(float p_error);
+	float get_bake_max_error() const;
+
+	BakeError bake();
+
+	HLODCluster3D();
+};
+
+VARIANT_ENUM_CAST(HLODCluster3D::BakeError);
+
+#endif // HLOD_CLUSTER_3D_H
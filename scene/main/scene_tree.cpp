@@ -38,6 +38,7 @@
 #include "core/object/message_queue.h"
 #include "core/os/dir_access.h"
 #include "core/os/keyboard.h"
+#include "core/os/memory_tracker.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 #include "node.h"
@@ -396,6 +397,8 @@ void SceneTree::initialize() {
 }
 
 bool SceneTree::physics_process(float p_time) {
+	MEMORY_TRACKING_SCOPE("scene_tree");
+
 	root_lock++;
 
 	current_frame++;
@@ -423,6 +426,8 @@ bool SceneTree::physics_process(float p_time) {
 }
 
 bool SceneTree::process(float p_time) {
+	MEMORY_TRACKING_SCOPE("scene_tree");
+
 	root_lock++;
 
 	MainLoop::process(p_time);
@@ -35,6 +35,8 @@
 #include "constraint_2d_sw.h"
 
 class BodyPair2DSW : public Constraint2DSW {
+	friend class ContactSolverSIMD2DSW;
+
 	enum {
 		MAX_CONTACTS = 2
 	};
@@ -91,6 +93,8 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual bool is_body_pair() const override { return true; }
+
 	BodyPair2DSW(Body2DSW *p_A, int p_shape_A, Body2DSW *p_B, int p_shape_B);
 	~BodyPair2DSW();
 };
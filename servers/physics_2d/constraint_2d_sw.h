@@ -37,6 +37,7 @@ class Constraint2DSW {
 	Body2DSW **_body_ptr;
 	int _body_count;
 	uint64_t island_step;
+	uint32_t solver_color;
 	bool disabled_collisions_between_bodies;
 
 	RID self;
@@ -46,6 +47,7 @@ protected:
 		_body_ptr = p_body_ptr;
 		_body_count = p_body_count;
 		island_step = 0;
+		solver_color = 0;
 		disabled_collisions_between_bodies = true;
 	}
 
@@ -56,6 +58,12 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
+	_FORCE_INLINE_ uint32_t get_solver_color() const { return solver_color; }
+	_FORCE_INLINE_ void set_solver_color(uint32_t p_color) { solver_color = p_color; }
+
+	// Body pairs can be solved in batches, see ContactSolverSIMD2DSW.
+	virtual bool is_body_pair() const { return false; }
+
 	_FORCE_INLINE_ Body2DSW **get_body_ptr() const { return _body_ptr; }
 	_FORCE_INLINE_ int get_body_count() const { return _body_count; }
 
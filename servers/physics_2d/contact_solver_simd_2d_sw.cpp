@@ -0,0 +1,294 @@
+/*************************************************************************/
+/*  contact_solver_simd_2d_sw.cpp                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "contact_solver_simd_2d_sw.h"
+
+#include "body_pair_2d_sw.h"
+
+#define LANE_COUNT ContactSolverSIMD2DSW::LANE_COUNT
+#define FOR_LANES for (int l = 0; l < LANE_COUNT; l++)
+
+struct LaneReal2DSW {
+	real_t v[LANE_COUNT];
+
+	_FORCE_INLINE_ static LaneReal2DSW splat(real_t p_value) {
+		LaneReal2DSW r;
+		FOR_LANES { r.v[l] = p_value; }
+		return r;
+	}
+
+	_FORCE_INLINE_ LaneReal2DSW operator+(const LaneReal2DSW &p_b) const {
+		LaneReal2DSW r;
+		FOR_LANES { r.v[l] = v[l] + p_b.v[l]; }
+		return r;
+	}
+
+	_FORCE_INLINE_ LaneReal2DSW operator-(const LaneReal2DSW &p_b) const {
+		LaneReal2DSW r;
+		FOR_LANES { r.v[l] = v[l] - p_b.v[l]; }
+		return r;
+	}
+
+	_FORCE_INLINE_ LaneReal2DSW operator*(const LaneReal2DSW &p_b) const {
+		LaneReal2DSW r;
+		FOR_LANES { r.v[l] = v[l] * p_b.v[l]; }
+		return r;
+	}
+
+	_FORCE_INLINE_ LaneReal2DSW operator-() const {
+		LaneReal2DSW r;
+		FOR_LANES { r.v[l] = -v[l]; }
+		return r;
+	}
+
+	_FORCE_INLINE_ LaneReal2DSW max(const LaneReal2DSW &p_b) const {
+		LaneReal2DSW r;
+		FOR_LANES { r.v[l] = MAX(v[l], p_b.v[l]); }
+		return r;
+	}
+
+	_FORCE_INLINE_ LaneReal2DSW clamp(const LaneReal2DSW &p_min, const LaneReal2DSW &p_max) const {
+		LaneReal2DSW r;
+		FOR_LANES { r.v[l] = CLAMP(v[l], p_min.v[l], p_max.v[l]); }
+		return r;
+	}
+
+	_FORCE_INLINE_ static LaneReal2DSW select(const bool *p_mask, const LaneReal2DSW &p_a, const LaneReal2DSW &p_b) {
+		LaneReal2DSW r;
+		FOR_LANES { r.v[l] = p_mask[l] ? p_a.v[l] : p_b.v[l]; }
+		return r;
+	}
+};
+
+struct LaneVector2DSW {
+	LaneReal2DSW x, y;
+
+	_FORCE_INLINE_ LaneVector2DSW operator+(const LaneVector2DSW &p_b) const { return { x + p_b.x, y + p_b.y }; }
+	_FORCE_INLINE_ LaneVector2DSW operator-(const LaneVector2DSW &p_b) const { return { x - p_b.x, y - p_b.y }; }
+	_FORCE_INLINE_ LaneVector2DSW operator-() const { return { -x, -y }; }
+	_FORCE_INLINE_ LaneVector2DSW operator*(const LaneReal2DSW &p_scalar) const { return { x * p_scalar, y * p_scalar }; }
+
+	_FORCE_INLINE_ LaneReal2DSW dot(const LaneVector2DSW &p_b) const {
+		return x * p_b.x + y * p_b.y;
+	}
+
+	_FORCE_INLINE_ LaneReal2DSW cross(const LaneVector2DSW &p_b) const {
+		return x * p_b.y - y * p_b.x;
+	}
+
+	_FORCE_INLINE_ LaneVector2DSW orthogonal() const {
+		return { y, -x };
+	}
+
+	_FORCE_INLINE_ static LaneVector2DSW select(const bool *p_mask, const LaneVector2DSW &p_a, const LaneVector2DSW &p_b) {
+		return { LaneReal2DSW::select(p_mask, p_a.x, p_b.x), LaneReal2DSW::select(p_mask, p_a.y, p_b.y) };
+	}
+
+	_FORCE_INLINE_ void set_lane(int p_lane, const Vector2 &p_value) {
+		x.v[p_lane] = p_value.x;
+		y.v[p_lane] = p_value.y;
+	}
+
+	_FORCE_INLINE_ Vector2 get_lane(int p_lane) const {
+		return Vector2(x.v[p_lane], y.v[p_lane]);
+	}
+};
+
+// Mirrors the Body2DSW state the contact solver reads and writes.
+struct LaneBody2DSW {
+	LaneVector2DSW linear_velocity;
+	LaneReal2DSW angular_velocity;
+	LaneVector2DSW biased_linear_velocity;
+	LaneReal2DSW biased_angular_velocity;
+	LaneReal2DSW inv_mass;
+	LaneReal2DSW inv_inertia;
+	bool dynamic[LANE_COUNT];
+
+	void gather(int p_lane, const Body2DSW *p_body, bool p_dynamic) {
+		linear_velocity.set_lane(p_lane, p_body->get_linear_velocity());
+		angular_velocity.v[p_lane] = p_body->get_angular_velocity();
+		biased_linear_velocity.set_lane(p_lane, p_body->get_biased_linear_velocity());
+		biased_angular_velocity.v[p_lane] = p_body->get_biased_angular_velocity();
+		inv_mass.v[p_lane] = p_body->get_inv_mass();
+		inv_inertia.v[p_lane] = p_body->get_inv_inertia();
+		dynamic[p_lane] = p_dynamic;
+	}
+
+	void scatter(int p_lane, Body2DSW *p_body) const {
+		p_body->set_linear_velocity(linear_velocity.get_lane(p_lane));
+		p_body->set_angular_velocity(angular_velocity.v[p_lane]);
+		p_body->set_biased_linear_velocity(biased_linear_velocity.get_lane(p_lane));
+		p_body->set_biased_angular_velocity(biased_angular_velocity.v[p_lane]);
+	}
+
+	// Same as Body2DSW::apply_impulse, for the dynamic lanes.
+	_FORCE_INLINE_ void apply_impulse(const LaneVector2DSW &p_impulse, const LaneVector2DSW &p_position) {
+		linear_velocity = LaneVector2DSW::select(dynamic, linear_velocity + p_impulse * inv_mass, linear_velocity);
+		angular_velocity = LaneReal2DSW::select(dynamic, angular_velocity + inv_inertia * p_position.cross(p_impulse), angular_velocity);
+	}
+
+	// Same as Body2DSW::apply_bias_impulse, for the dynamic lanes.
+	_FORCE_INLINE_ void apply_bias_impulse(const LaneVector2DSW &p_impulse, const LaneVector2DSW &p_position) {
+		biased_linear_velocity = LaneVector2DSW::select(dynamic, biased_linear_velocity + p_impulse * inv_mass, biased_linear_velocity);
+		biased_angular_velocity = LaneReal2DSW::select(dynamic, biased_angular_velocity + inv_inertia * p_position.cross(p_impulse), biased_angular_velocity);
+	}
+};
+
+void ContactSolverSIMD2DSW::solve(BodyPair2DSW *const *p_pairs, uint32_t p_count) {
+	const LaneReal2DSW zero = LaneReal2DSW::splat(0.0);
+
+	for (uint32_t from = 0; from < p_count; from += LANE_COUNT) {
+		BodyPair2DSW *pairs[LANE_COUNT];
+		LaneBody2DSW A;
+		LaneBody2DSW B;
+		LaneReal2DSW friction;
+		int max_contact_count = 0;
+
+		FOR_LANES {
+			BodyPair2DSW *pair = from + l < p_count ? p_pairs[from + l] : nullptr;
+			pairs[l] = (pair && pair->collided && !pair->oneway_disabled) ? pair : nullptr;
+			if (!pairs[l]) {
+				// Harmless values for unused lanes, their results are never written back.
+				A.gather(l, p_pairs[from]->A, false);
+				B.gather(l, p_pairs[from]->B, false);
+				friction.v[l] = 0;
+				continue;
+			}
+			A.gather(l, pair->A, pair->dynamic_A);
+			B.gather(l, pair->B, pair->dynamic_B);
+			friction.v[l] = ABS(MIN(pair->A->get_friction(), pair->B->get_friction()));
+			max_contact_count = MAX(max_contact_count, pair->contact_count);
+		}
+
+		// Contacts of one pair act on the same bodies, so they are solved one after another.
+		for (int i = 0; i < max_contact_count; i++) {
+			bool active[LANE_COUNT];
+			LaneVector2DSW normal;
+			LaneVector2DSW rA;
+			LaneVector2DSW rB;
+			LaneReal2DSW acc_normal_impulse;
+			LaneReal2DSW acc_tangent_impulse;
+			LaneReal2DSW acc_bias_impulse;
+			LaneReal2DSW mass_normal;
+			LaneReal2DSW mass_tangent;
+			LaneReal2DSW bias;
+			LaneReal2DSW bounce;
+
+			// Inactive lanes get zero impulses, which leaves their bodies untouched.
+			FOR_LANES {
+				active[l] = pairs[l] && i < pairs[l]->contact_count && pairs[l]->contacts[i].active;
+				if (!active[l]) {
+					normal.set_lane(l, Vector2());
+					rA.set_lane(l, Vector2());
+					rB.set_lane(l, Vector2());
+					acc_normal_impulse.v[l] = 0;
+					acc_tangent_impulse.v[l] = 0;
+					acc_bias_impulse.v[l] = 0;
+					mass_normal.v[l] = 0;
+					mass_tangent.v[l] = 0;
+					bias.v[l] = 0;
+					bounce.v[l] = 0;
+					continue;
+				}
+				const BodyPair2DSW::Contact &c = pairs[l]->contacts[i];
+				normal.set_lane(l, c.normal);
+				rA.set_lane(l, c.rA);
+				rB.set_lane(l, c.rB);
+				acc_normal_impulse.v[l] = c.acc_normal_impulse;
+				acc_tangent_impulse.v[l] = c.acc_tangent_impulse;
+				acc_bias_impulse.v[l] = c.acc_bias_impulse;
+				mass_normal.v[l] = c.mass_normal;
+				mass_tangent.v[l] = c.mass_tangent;
+				bias.v[l] = c.bias;
+				bounce.v[l] = c.bounce;
+			}
+
+			// Relative velocity at contact.
+
+			LaneVector2DSW crA = { -A.angular_velocity * rA.y, A.angular_velocity * rA.x };
+			LaneVector2DSW crB = { -B.angular_velocity * rB.y, B.angular_velocity * rB.x };
+			LaneVector2DSW dv = B.linear_velocity + crB - A.linear_velocity - crA;
+
+			LaneVector2DSW crbA = { -A.biased_angular_velocity * rA.y, A.biased_angular_velocity * rA.x };
+			LaneVector2DSW crbB = { -B.biased_angular_velocity * rB.y, B.biased_angular_velocity * rB.x };
+			LaneVector2DSW dbv = B.biased_linear_velocity + crbB - A.biased_linear_velocity - crbA;
+
+			LaneReal2DSW vn = dv.dot(normal);
+			LaneReal2DSW vbn = dbv.dot(normal);
+			LaneVector2DSW tangent = normal.orthogonal();
+			LaneReal2DSW vt = dv.dot(tangent);
+
+			LaneReal2DSW jbn = (bias - vbn) * mass_normal;
+			LaneReal2DSW jbnOld = acc_bias_impulse;
+			acc_bias_impulse = (jbnOld + jbn).max(zero);
+
+			LaneVector2DSW jb = normal * (acc_bias_impulse - jbnOld);
+
+			A.apply_bias_impulse(-jb, rA);
+			B.apply_bias_impulse(jb, rB);
+
+			LaneReal2DSW jn = -(bounce + vn) * mass_normal;
+			LaneReal2DSW jnOld = acc_normal_impulse;
+			acc_normal_impulse = (jnOld + jn).max(zero);
+
+			LaneReal2DSW jtMax = friction * acc_normal_impulse;
+			LaneReal2DSW jt = -vt * mass_tangent;
+			LaneReal2DSW jtOld = acc_tangent_impulse;
+			acc_tangent_impulse = (jtOld + jt).clamp(-jtMax, jtMax);
+
+			LaneVector2DSW j = normal * (acc_normal_impulse - jnOld) + tangent * (acc_tangent_impulse - jtOld);
+
+			A.apply_impulse(-j, rA);
+			B.apply_impulse(j, rB);
+
+			FOR_LANES {
+				if (!active[l]) {
+					continue;
+				}
+				BodyPair2DSW::Contact &c = pairs[l]->contacts[i];
+				c.acc_normal_impulse = acc_normal_impulse.v[l];
+				c.acc_tangent_impulse = acc_tangent_impulse.v[l];
+				c.acc_bias_impulse = acc_bias_impulse.v[l];
+			}
+		}
+
+		FOR_LANES {
+			if (!pairs[l]) {
+				continue;
+			}
+			if (pairs[l]->dynamic_A) {
+				A.scatter(l, pairs[l]->A);
+			}
+			if (pairs[l]->dynamic_B) {
+				B.scatter(l, pairs[l]->B);
+			}
+		}
+	}
+}
@@ -0,0 +1,55 @@
+/*************************************************************************/
+/*  contact_solver_simd_2d_sw.h                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef CONTACT_SOLVER_SIMD_2D_SW_H
+#define CONTACT_SOLVER_SIMD_2D_SW_H
+
+#include "core/math/math_defs.h"
+#include "core/typedefs.h"
+
+class BodyPair2DSW;
+
+// Solves the contacts of several body pairs side by side. Body state and contacts
+// are gathered into structure-of-arrays lanes, solved with branch-free lane math
+// the compiler turns into SSE/AVX/NEON, and scattered back.
+//
+// The pairs given in one call must not share any dynamic body (e.g. constraints of
+// the same color). The math follows BodyPair2DSW::solve operation by operation, so
+// both paths give the same results within floating point tolerance.
+class ContactSolverSIMD2DSW {
+public:
+	enum {
+		LANE_COUNT = 4
+	};
+
+	static void solve(BodyPair2DSW *const *p_pairs, uint32_t p_count);
+};
+
+#endif // CONTACT_SOLVER_SIMD_2D_SW_H
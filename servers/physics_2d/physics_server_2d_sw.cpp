@@ -34,6 +34,7 @@
 #include "collision_solver_2d_sw.h"
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/os/memory_tracker.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -1250,6 +1251,8 @@ void PhysicsServer2DSW::init() {
 };
 
 void PhysicsServer2DSW::step(real_t p_step) {
+	MEMORY_TRACKING_SCOPE("physics_2d");
+
 	if (!active) {
 		return;
 	}
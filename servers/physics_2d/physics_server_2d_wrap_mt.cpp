@@ -116,7 +116,7 @@ void PhysicsServer2DWrapMT::finish() {
 }
 
 PhysicsServer2DWrapMT::PhysicsServer2DWrapMT(PhysicsServer2D *p_contained, bool p_create_thread) :
-		command_queue(p_create_thread) {
+		command_queue(p_create_thread, SERVER_WRAP_MT_COMMAND_QUEUE_MODE) {
 	physics_2d_server = p_contained;
 	create_thread = p_create_thread;
 	step_pending = 0;
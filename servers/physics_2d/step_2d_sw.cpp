@@ -29,6 +29,8 @@
 /*************************************************************************/
 
 #include "step_2d_sw.h"
+#include "body_pair_2d_sw.h"
+#include "contact_solver_simd_2d_sw.h"
 
 #include "core/os/os.h"
 
@@ -38,6 +40,13 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+// Islands with at least this many constraints get their constraints solved in parallel.
+#define ISLAND_COLORING_MIN_CONSTRAINTS 256
+// With the SIMD contact solver, islands with at least this many constraints get colored to fill the lanes.
+#define ISLAND_COLORING_MIN_CONSTRAINTS_SIMD (2 * ContactSolverSIMD2DSW::LANE_COUNT)
+#define SOLVER_COLOR_COUNT 64
+#define CONSTRAINT_BATCH_CHUNK_SIZE 32
+
 void Step2DSW::_populate_island(Body2DSW *p_body, LocalVector<Body2DSW *> &p_body_island, LocalVector<Constraint2DSW *> &p_constraint_island) {
 	p_body->set_island_step(_step);
 
@@ -89,9 +98,148 @@ void Step2DSW::_pre_solve_island(LocalVector<Constraint2DSW *> &p_constraint_isl
 	p_constraint_island.resize(valid_constraint_count);
 }
 
-void Step2DSW::_solve_island(uint32_t p_island_index, void *p_userdata) const {
+void Step2DSW::_color_island(const LocalVector<Constraint2DSW *> &p_constraint_island, ColoredIsland &r_colored_island) const {
+	uint32_t constraint_count = p_constraint_island.size();
+
+	// Dynamic bodies only belong to one island, so other islands being colored at the same time never touch them.
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		Constraint2DSW *constraint = p_constraint_island[constraint_index];
+		for (int i = 0; i < constraint->get_body_count(); i++) {
+			Body2DSW *body = constraint->get_body_ptr()[i];
+			if (body->get_mode() > PhysicsServer2D::BODY_MODE_KINEMATIC) {
+				body->set_solver_color_mask(0);
+			}
+		}
+	}
+
+	// Greedy coloring: each constraint takes the first color none of its dynamic bodies uses yet.
+	// Static and kinematic bodies are never written by the solver, so they can be shared within a color.
+	// Constraints running out of colors go to the last color.
+	uint32_t color_counts[SOLVER_COLOR_COUNT + 1] = {};
+
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		Constraint2DSW *constraint = p_constraint_island[constraint_index];
+
+		uint64_t used_colors = 0;
+		for (int i = 0; i < constraint->get_body_count(); i++) {
+			Body2DSW *body = constraint->get_body_ptr()[i];
+			if (body->get_mode() > PhysicsServer2D::BODY_MODE_KINEMATIC) {
+				used_colors |= body->get_solver_color_mask();
+			}
+		}
+
+		uint32_t color = SOLVER_COLOR_COUNT;
+		if (used_colors != UINT64_MAX) {
+			color = 0;
+			while (used_colors & (uint64_t(1) << color)) {
+				++color;
+			}
+
+			for (int i = 0; i < constraint->get_body_count(); i++) {
+				Body2DSW *body = constraint->get_body_ptr()[i];
+				if (body->get_mode() > PhysicsServer2D::BODY_MODE_KINEMATIC) {
+					body->set_solver_color_mask(body->get_solver_color_mask() | (uint64_t(1) << color));
+				}
+			}
+		}
+
+		constraint->set_solver_color(color);
+		++color_counts[color];
+	}
+
+	// Group constraints by color, keeping their relative order.
+	r_colored_island.color_offsets.resize(SOLVER_COLOR_COUNT + 2);
+	uint32_t write_offsets[SOLVER_COLOR_COUNT + 1];
+	uint32_t offset = 0;
+	for (uint32_t color = 0; color <= SOLVER_COLOR_COUNT; ++color) {
+		r_colored_island.color_offsets[color] = offset;
+		write_offsets[color] = offset;
+		offset += color_counts[color];
+	}
+	r_colored_island.color_offsets[SOLVER_COLOR_COUNT + 1] = offset;
+
+	r_colored_island.constraints.resize(constraint_count);
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		Constraint2DSW *constraint = p_constraint_island[constraint_index];
+		r_colored_island.constraints[write_offsets[constraint->get_solver_color()]++] = constraint;
+	}
+}
+
+void Step2DSW::_solve_constraint_batch(uint32_t p_chunk_index, const ConstraintBatch *p_batch) {
+	uint32_t from = p_chunk_index * CONSTRAINT_BATCH_CHUNK_SIZE;
+	uint32_t to = MIN(from + CONSTRAINT_BATCH_CHUNK_SIZE, p_batch->count);
+
+	if (!simd_contact_solver) {
+		for (uint32_t constraint_index = from; constraint_index < to; ++constraint_index) {
+			p_batch->constraints[constraint_index]->solve(delta);
+		}
+		return;
+	}
+
+	// Constraints of a batch are independent, so the order doesn't matter and body pairs can be solved side by side.
+	BodyPair2DSW *body_pairs[CONSTRAINT_BATCH_CHUNK_SIZE];
+	uint32_t body_pair_count = 0;
+	for (uint32_t constraint_index = from; constraint_index < to; ++constraint_index) {
+		Constraint2DSW *constraint = p_batch->constraints[constraint_index];
+		if (constraint->is_body_pair()) {
+			body_pairs[body_pair_count++] = static_cast<BodyPair2DSW *>(constraint);
+		} else {
+			constraint->solve(delta);
+		}
+	}
+	ContactSolverSIMD2DSW::solve(body_pairs, body_pair_count);
+}
+
+void Step2DSW::_solve_island_colored(uint32_t p_island_index) {
+	ColoredIsland &colored_island = colored_islands[p_island_index];
+	_color_island(constraint_islands[p_island_index], colored_island);
+
+	const LocalVector<Constraint2DSW *> &constraints = colored_island.constraints;
+	const LocalVector<uint32_t> &color_offsets = colored_island.color_offsets;
+
+	if (!colored_island.batch_pool) {
+		colored_island.batch_pool = memnew(ThreadWorkPool);
+		colored_island.batch_pool->init();
+	}
+	ThreadWorkPool &batch_pool = *colored_island.batch_pool;
+
+	for (int i = 0; i < iterations; i++) {
+		// Go through all iterations, colors are solved one after another.
+		for (uint32_t color = 0; color < SOLVER_COLOR_COUNT; ++color) {
+			ConstraintBatch batch;
+			batch.constraints = constraints.ptr() + color_offsets[color];
+			batch.count = color_offsets[color + 1] - color_offsets[color];
+
+			uint32_t chunk_count = (batch.count + CONSTRAINT_BATCH_CHUNK_SIZE - 1) / CONSTRAINT_BATCH_CHUNK_SIZE;
+			if (chunk_count > 1) {
+				batch_pool.do_work(chunk_count, this, &Step2DSW::_solve_constraint_batch, &batch);
+			} else if (chunk_count > 0) {
+				_solve_constraint_batch(0, &batch);
+			}
+		}
+
+		// Last color can't be solved in parallel.
+		for (uint32_t constraint_index = color_offsets[SOLVER_COLOR_COUNT]; constraint_index < color_offsets[SOLVER_COLOR_COUNT + 1]; ++constraint_index) {
+			constraints[constraint_index]->solve(delta);
+		}
+	}
+}
+
+void Step2DSW::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	const LocalVector<Constraint2DSW *> &constraint_island = constraint_islands[p_island_index];
 
+	if (constraint_island.size() >= ISLAND_COLORING_MIN_CONSTRAINTS && work_pool.get_thread_count() > 1) {
+		// Big island, one thread isn't enough for it.
+		_solve_island_colored(p_island_index);
+		return;
+	}
+
+	if (simd_contact_solver && constraint_island.size() >= ISLAND_COLORING_MIN_CONSTRAINTS_SIMD) {
+		// Colors are needed to find contacts that can share lanes.
+		_solve_island_colored(p_island_index);
+		return;
+	}
+
 	for (int i = 0; i < iterations; i++) {
 		uint32_t constraint_count = constraint_island.size();
 		for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
@@ -131,6 +279,7 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 	iterations = p_iterations;
 	delta = p_delta;
+	simd_contact_solver = p_space->is_using_simd_contact_solver();
 
 	const SelfList<Body2DSW>::List *body_list = &p_space->get_active_body_list();
 
@@ -251,6 +400,10 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
+	if (colored_islands.size() < island_count) {
+		colored_islands.resize(island_count);
+	}
+
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
 	if (island_count > 1) {
@@ -304,5 +457,10 @@ Step2DSW::Step2DSW() {
 }
 
 Step2DSW::~Step2DSW() {
+	for (uint32_t i = 0; i < colored_islands.size(); i++) {
+		if (colored_islands[i].batch_pool) {
+			memdelete(colored_islands[i].batch_pool);
+		}
+	}
 	work_pool.finish();
 }
@@ -38,6 +38,10 @@
 
 class BodyContact3DSW : public Constraint3DSW {
 protected:
+	// Shared with ContactSolverSIMD3DSW, so both solvers give the same results.
+	static constexpr real_t MIN_VELOCITY = 0.0001;
+	static constexpr real_t MAX_BIAS_ROTATION = Math_PI / 8;
+
 	struct Contact {
 		Vector3 position;
 		Vector3 normal;
@@ -67,6 +71,8 @@ protected:
 };
 
 class BodyPair3DSW : public BodyContact3DSW {
+	friend class ContactSolverSIMD3DSW;
+
 	enum {
 		MAX_CONTACTS = 4
 	};
@@ -105,6 +111,15 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual bool is_body_pair() const override { return true; }
+
+	_FORCE_INLINE_ int get_contact_count() const { return contact_count; }
+	// Impulse accumulated on a contact while solving, normal and tangent.
+	_FORCE_INLINE_ Vector3 get_contact_impulse(int p_index) const {
+		ERR_FAIL_INDEX_V(p_index, contact_count, Vector3());
+		return contacts[p_index].normal * contacts[p_index].acc_normal_impulse + contacts[p_index].acc_tangent_impulse;
+	}
+
 	BodyPair3DSW(Body3DSW *p_A, int p_shape_A, Body3DSW *p_B, int p_shape_B);
 	~BodyPair3DSW();
 };
@@ -38,6 +38,7 @@ class Constraint3DSW {
 	Body3DSW **_body_ptr;
 	int _body_count;
 	uint64_t island_step;
+	uint32_t solver_color;
 	int priority;
 	bool disabled_collisions_between_bodies;
 
@@ -48,6 +49,7 @@ protected:
 		_body_ptr = p_body_ptr;
 		_body_count = p_body_count;
 		island_step = 0;
+		solver_color = 0;
 		priority = 1;
 		disabled_collisions_between_bodies = true;
 	}
@@ -59,9 +61,15 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
+	_FORCE_INLINE_ uint32_t get_solver_color() const { return solver_color; }
+	_FORCE_INLINE_ void set_solver_color(uint32_t p_color) { solver_color = p_color; }
+
 	_FORCE_INLINE_ Body3DSW **get_body_ptr() const { return _body_ptr; }
 	_FORCE_INLINE_ int get_body_count() const { return _body_count; }
 
+	// Body pairs can be solved in batches, see ContactSolverSIMD3DSW.
+	virtual bool is_body_pair() const { return false; }
+
 	virtual SoftBody3DSW *get_soft_body_ptr(int p_index) const { return nullptr; }
 	virtual int get_soft_body_count() const { return 0; }
 
@@ -0,0 +1,416 @@
+/*************************************************************************/
+/*  contact_solver_simd_3d_sw.cpp                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "contact_solver_simd_3d_sw.h"
+
+#include "body_pair_3d_sw.h"
+
+#define LANE_COUNT ContactSolverSIMD3DSW::LANE_COUNT
+#define FOR_LANES for (int l = 0; l < LANE_COUNT; l++)
+
+struct LaneMask3DSW {
+	bool m[LANE_COUNT];
+
+	_FORCE_INLINE_ LaneMask3DSW operator&&(const LaneMask3DSW &p_b) const {
+		LaneMask3DSW r;
+		FOR_LANES { r.m[l] = m[l] && p_b.m[l]; }
+		return r;
+	}
+
+	_FORCE_INLINE_ LaneMask3DSW operator||(const LaneMask3DSW &p_b) const {
+		LaneMask3DSW r;
+		FOR_LANES { r.m[l] = m[l] || p_b.m[l]; }
+		return r;
+	}
+};
+
+struct LaneReal3DSW {
+	real_t v[LANE_COUNT];
+
+	_FORCE_INLINE_ static LaneReal3DSW splat(real_t p_value) {
+		LaneReal3DSW r;
+		FOR_LANES { r.v[l] = p_value; }
+		return r;
+	}
+
+	_FORCE_INLINE_ LaneReal3DSW operator+(const LaneReal3DSW &p_b) const {
+		LaneReal3DSW r;
+		FOR_LANES { r.v[l] = v[l] + p_b.v[l]; }
+		return r;
+	}
+
+	_FORCE_INLINE_ LaneReal3DSW operator-(const LaneReal3DSW &p_b) const {
+		LaneReal3DSW r;
+		FOR_LANES { r.v[l] = v[l] - p_b.v[l]; }
+		return r;
+	}
+
+	_FORCE_INLINE_ LaneReal3DSW operator*(const LaneReal3DSW &p_b) const {
+		LaneReal3DSW r;
+		FOR_LANES { r.v[l] = v[l] * p_b.v[l]; }
+		return r;
+	}
+
+	_FORCE_INLINE_ LaneReal3DSW operator/(const LaneReal3DSW &p_b) const {
+		LaneReal3DSW r;
+		FOR_LANES { r.v[l] = v[l] / p_b.v[l]; }
+		return r;
+	}
+
+	_FORCE_INLINE_ LaneReal3DSW operator-() const {
+		LaneReal3DSW r;
+		FOR_LANES { r.v[l] = -v[l]; }
+		return r;
+	}
+
+	_FORCE_INLINE_ LaneMask3DSW operator>(const LaneReal3DSW &p_b) const {
+		LaneMask3DSW r;
+		FOR_LANES { r.m[l] = v[l] > p_b.v[l]; }
+		return r;
+	}
+
+	_FORCE_INLINE_ LaneReal3DSW abs() const {
+		LaneReal3DSW r;
+		FOR_LANES { r.v[l] = Math::abs(v[l]); }
+		return r;
+	}
+
+	_FORCE_INLINE_ LaneReal3DSW sqrt() const {
+		LaneReal3DSW r;
+		FOR_LANES { r.v[l] = Math::sqrt(v[l]); }
+		return r;
+	}
+
+	_FORCE_INLINE_ LaneReal3DSW max(const LaneReal3DSW &p_b) const {
+		LaneReal3DSW r;
+		FOR_LANES { r.v[l] = MAX(v[l], p_b.v[l]); }
+		return r;
+	}
+
+	_FORCE_INLINE_ static LaneReal3DSW select(const LaneMask3DSW &p_mask, const LaneReal3DSW &p_a, const LaneReal3DSW &p_b) {
+		LaneReal3DSW r;
+		FOR_LANES { r.v[l] = p_mask.m[l] ? p_a.v[l] : p_b.v[l]; }
+		return r;
+	}
+};
+
+struct LaneVector3DSW {
+	LaneReal3DSW x, y, z;
+
+	_FORCE_INLINE_ LaneVector3DSW operator+(const LaneVector3DSW &p_b) const { return { x + p_b.x, y + p_b.y, z + p_b.z }; }
+	_FORCE_INLINE_ LaneVector3DSW operator-(const LaneVector3DSW &p_b) const { return { x - p_b.x, y - p_b.y, z - p_b.z }; }
+	_FORCE_INLINE_ LaneVector3DSW operator-() const { return { -x, -y, -z }; }
+	_FORCE_INLINE_ LaneVector3DSW operator*(const LaneReal3DSW &p_scalar) const { return { x * p_scalar, y * p_scalar, z * p_scalar }; }
+	_FORCE_INLINE_ LaneVector3DSW operator/(const LaneReal3DSW &p_scalar) const { return { x / p_scalar, y / p_scalar, z / p_scalar }; }
+
+	_FORCE_INLINE_ LaneReal3DSW dot(const LaneVector3DSW &p_b) const {
+		return x * p_b.x + y * p_b.y + z * p_b.z;
+	}
+
+	_FORCE_INLINE_ LaneVector3DSW cross(const LaneVector3DSW &p_b) const {
+		return { (y * p_b.z) - (z * p_b.y), (z * p_b.x) - (x * p_b.z), (x * p_b.y) - (y * p_b.x) };
+	}
+
+	_FORCE_INLINE_ LaneReal3DSW length() const {
+		LaneReal3DSW x2 = x * x;
+		LaneReal3DSW y2 = y * y;
+		LaneReal3DSW z2 = z * z;
+		return (x2 + y2 + z2).sqrt();
+	}
+
+	_FORCE_INLINE_ static LaneVector3DSW select(const LaneMask3DSW &p_mask, const LaneVector3DSW &p_a, const LaneVector3DSW &p_b) {
+		return { LaneReal3DSW::select(p_mask, p_a.x, p_b.x), LaneReal3DSW::select(p_mask, p_a.y, p_b.y), LaneReal3DSW::select(p_mask, p_a.z, p_b.z) };
+	}
+
+	_FORCE_INLINE_ void set_lane(int p_lane, const Vector3 &p_value) {
+		x.v[p_lane] = p_value.x;
+		y.v[p_lane] = p_value.y;
+		z.v[p_lane] = p_value.z;
+	}
+
+	_FORCE_INLINE_ Vector3 get_lane(int p_lane) const {
+		return Vector3(x.v[p_lane], y.v[p_lane], z.v[p_lane]);
+	}
+};
+
+struct LaneBasis3DSW {
+	LaneVector3DSW rows[3];
+
+	_FORCE_INLINE_ LaneVector3DSW xform(const LaneVector3DSW &p_vector) const {
+		return { rows[0].dot(p_vector), rows[1].dot(p_vector), rows[2].dot(p_vector) };
+	}
+
+	_FORCE_INLINE_ void set_lane(int p_lane, const Basis &p_value) {
+		for (int i = 0; i < 3; i++) {
+			rows[i].set_lane(p_lane, p_value.elements[i]);
+		}
+	}
+};
+
+// Mirrors the Body3DSW state the contact solver reads and writes.
+struct LaneBody3DSW {
+	LaneVector3DSW linear_velocity;
+	LaneVector3DSW angular_velocity;
+	LaneVector3DSW biased_linear_velocity;
+	LaneVector3DSW biased_angular_velocity;
+	LaneVector3DSW center_of_mass;
+	LaneBasis3DSW inv_inertia_tensor;
+	LaneReal3DSW inv_mass;
+	LaneMask3DSW dynamic;
+
+	void gather(int p_lane, const Body3DSW *p_body, bool p_dynamic) {
+		linear_velocity.set_lane(p_lane, p_body->get_linear_velocity());
+		angular_velocity.set_lane(p_lane, p_body->get_angular_velocity());
+		biased_linear_velocity.set_lane(p_lane, p_body->get_biased_linear_velocity());
+		biased_angular_velocity.set_lane(p_lane, p_body->get_biased_angular_velocity());
+		center_of_mass.set_lane(p_lane, p_body->get_center_of_mass());
+		inv_inertia_tensor.set_lane(p_lane, p_body->get_inv_inertia_tensor());
+		inv_mass.v[p_lane] = p_body->get_inv_mass();
+		dynamic.m[p_lane] = p_dynamic;
+	}
+
+	void scatter(int p_lane, Body3DSW *p_body) const {
+		p_body->set_linear_velocity(linear_velocity.get_lane(p_lane));
+		p_body->set_angular_velocity(angular_velocity.get_lane(p_lane));
+		p_body->set_biased_linear_velocity(biased_linear_velocity.get_lane(p_lane));
+		p_body->set_biased_angular_velocity(biased_angular_velocity.get_lane(p_lane));
+	}
+
+	// Same as Body3DSW::apply_impulse, for the lanes in p_mask.
+	_FORCE_INLINE_ void apply_impulse(const LaneMask3DSW &p_mask, const LaneVector3DSW &p_impulse, const LaneVector3DSW &p_position) {
+		LaneMask3DSW mask = p_mask && dynamic;
+		linear_velocity = LaneVector3DSW::select(mask, linear_velocity + p_impulse * inv_mass, linear_velocity);
+		angular_velocity = LaneVector3DSW::select(mask, angular_velocity + inv_inertia_tensor.xform((p_position - center_of_mass).cross(p_impulse)), angular_velocity);
+	}
+
+	// Same as Body3DSW::apply_bias_impulse, for the lanes in p_mask.
+	_FORCE_INLINE_ void apply_bias_impulse(const LaneMask3DSW &p_mask, const LaneVector3DSW &p_impulse, const LaneVector3DSW &p_position, real_t p_max_delta_av) {
+		LaneMask3DSW mask = p_mask && dynamic;
+		biased_linear_velocity = LaneVector3DSW::select(mask, biased_linear_velocity + p_impulse * inv_mass, biased_linear_velocity);
+		if (p_max_delta_av != 0.0) {
+			LaneVector3DSW delta_av = inv_inertia_tensor.xform((p_position - center_of_mass).cross(p_impulse));
+			if (p_max_delta_av > 0) {
+				LaneReal3DSW max_delta_av = LaneReal3DSW::splat(p_max_delta_av);
+				LaneReal3DSW delta_av_length = delta_av.length();
+				// Lanes that don't clamp may divide by zero here, their result is discarded.
+				delta_av = LaneVector3DSW::select(delta_av_length > max_delta_av, (delta_av / delta_av_length) * max_delta_av, delta_av);
+			}
+			biased_angular_velocity = LaneVector3DSW::select(mask, biased_angular_velocity + delta_av, biased_angular_velocity);
+		}
+	}
+};
+
+void ContactSolverSIMD3DSW::solve(BodyPair3DSW *const *p_pairs, uint32_t p_count, real_t p_step) {
+	const real_t max_bias_av = BodyPair3DSW::MAX_BIAS_ROTATION / p_step;
+	const LaneReal3DSW min_velocity = LaneReal3DSW::splat(BodyPair3DSW::MIN_VELOCITY);
+	const LaneReal3DSW cmp_epsilon = LaneReal3DSW::splat(CMP_EPSILON);
+	const LaneReal3DSW zero = LaneReal3DSW::splat(0.0);
+
+	for (uint32_t from = 0; from < p_count; from += LANE_COUNT) {
+		BodyPair3DSW *pairs[LANE_COUNT];
+		LaneBody3DSW A;
+		LaneBody3DSW B;
+		LaneReal3DSW friction;
+		int max_contact_count = 0;
+
+		FOR_LANES {
+			pairs[l] = (from + l < p_count && p_pairs[from + l]->collided) ? p_pairs[from + l] : nullptr;
+			if (!pairs[l]) {
+				// Harmless values for unused lanes, their results are never written back.
+				A.gather(l, p_pairs[from]->A, false);
+				B.gather(l, p_pairs[from]->B, false);
+				friction.v[l] = 0;
+				continue;
+			}
+			BodyPair3DSW *pair = pairs[l];
+			A.gather(l, pair->A, pair->dynamic_A);
+			B.gather(l, pair->B, pair->dynamic_B);
+			friction.v[l] = ABS(MIN(pair->A->get_friction(), pair->B->get_friction()));
+			max_contact_count = MAX(max_contact_count, pair->contact_count);
+		}
+
+		// Contacts of one pair act on the same bodies, so they are solved one after another.
+		for (int i = 0; i < max_contact_count; i++) {
+			LaneMask3DSW active;
+			LaneVector3DSW normal;
+			LaneVector3DSW rA;
+			LaneVector3DSW rB;
+			LaneVector3DSW acc_tangent_impulse;
+			LaneReal3DSW acc_normal_impulse;
+			LaneReal3DSW acc_bias_impulse;
+			LaneReal3DSW acc_bias_impulse_center_of_mass;
+			LaneReal3DSW mass_normal;
+			LaneReal3DSW bias;
+			LaneReal3DSW bounce;
+
+			FOR_LANES {
+				active.m[l] = pairs[l] && i < pairs[l]->contact_count && pairs[l]->contacts[i].active;
+				const BodyPair3DSW::Contact &c = active.m[l] ? pairs[l]->contacts[i] : p_pairs[from]->contacts[0];
+				normal.set_lane(l, c.normal);
+				rA.set_lane(l, c.rA);
+				rB.set_lane(l, c.rB);
+				acc_tangent_impulse.set_lane(l, c.acc_tangent_impulse);
+				acc_normal_impulse.v[l] = c.acc_normal_impulse;
+				acc_bias_impulse.v[l] = c.acc_bias_impulse;
+				acc_bias_impulse_center_of_mass.v[l] = c.acc_bias_impulse_center_of_mass;
+				mass_normal.v[l] = c.mass_normal;
+				bias.v[l] = c.bias;
+				bounce.v[l] = c.bounce;
+			}
+
+			// Positions as BodyPair3DSW passes them to the bodies.
+			LaneVector3DSW position_A = rA + A.center_of_mass;
+			LaneVector3DSW position_B = rB + B.center_of_mass;
+
+			// Bias impulse.
+
+			LaneVector3DSW crbA = A.biased_angular_velocity.cross(rA);
+			LaneVector3DSW crbB = B.biased_angular_velocity.cross(rB);
+			LaneVector3DSW dbv = B.biased_linear_velocity + crbB - A.biased_linear_velocity - crbA;
+
+			LaneReal3DSW vbn = dbv.dot(normal);
+
+			LaneMask3DSW bias_mask = active && ((-vbn + bias).abs() > min_velocity);
+			{
+				LaneReal3DSW jbn = (-vbn + bias) * mass_normal;
+				LaneReal3DSW jbnOld = acc_bias_impulse;
+				acc_bias_impulse = LaneReal3DSW::select(bias_mask, (jbnOld + jbn).max(zero), acc_bias_impulse);
+
+				LaneVector3DSW jb = normal * (acc_bias_impulse - jbnOld);
+
+				A.apply_bias_impulse(bias_mask, -jb, position_A, max_bias_av);
+				B.apply_bias_impulse(bias_mask, jb, position_B, max_bias_av);
+
+				crbA = A.biased_angular_velocity.cross(rA);
+				crbB = B.biased_angular_velocity.cross(rB);
+				dbv = B.biased_linear_velocity + crbB - A.biased_linear_velocity - crbA;
+
+				vbn = dbv.dot(normal);
+
+				LaneMask3DSW com_mask = bias_mask && ((-vbn + bias).abs() > min_velocity);
+
+				LaneReal3DSW jbn_com = (-vbn + bias) / (A.inv_mass + B.inv_mass);
+				LaneReal3DSW jbnOld_com = acc_bias_impulse_center_of_mass;
+				acc_bias_impulse_center_of_mass = LaneReal3DSW::select(com_mask, (jbnOld_com + jbn_com).max(zero), acc_bias_impulse_center_of_mass);
+
+				LaneVector3DSW jb_com = normal * (acc_bias_impulse_center_of_mass - jbnOld_com);
+
+				A.apply_bias_impulse(com_mask, -jb_com, A.center_of_mass, 0.0);
+				B.apply_bias_impulse(com_mask, jb_com, B.center_of_mass, 0.0);
+			}
+
+			// Normal impulse.
+
+			LaneVector3DSW crA = A.angular_velocity.cross(rA);
+			LaneVector3DSW crB = B.angular_velocity.cross(rB);
+			LaneVector3DSW dv = B.linear_velocity + crB - A.linear_velocity - crA;
+
+			LaneReal3DSW vn = dv.dot(normal);
+
+			LaneMask3DSW normal_mask = active && (vn.abs() > min_velocity);
+			{
+				LaneReal3DSW jn = -(bounce + vn) * mass_normal;
+				LaneReal3DSW jnOld = acc_normal_impulse;
+				acc_normal_impulse = LaneReal3DSW::select(normal_mask, (jnOld + jn).max(zero), acc_normal_impulse);
+
+				LaneVector3DSW j = normal * (acc_normal_impulse - jnOld);
+
+				A.apply_impulse(normal_mask, -j, position_A);
+				B.apply_impulse(normal_mask, j, position_B);
+			}
+
+			// Friction impulse.
+
+			LaneVector3DSW lvA = A.linear_velocity + A.angular_velocity.cross(rA);
+			LaneVector3DSW lvB = B.linear_velocity + B.angular_velocity.cross(rB);
+
+			LaneVector3DSW dtv = lvB - lvA;
+			LaneReal3DSW tn = normal.dot(dtv);
+
+			// Tangential velocity.
+			LaneVector3DSW tv = dtv - normal * tn;
+			LaneReal3DSW tvl = tv.length();
+
+			LaneMask3DSW friction_mask = active && (tvl > min_velocity);
+			{
+				tv = tv / tvl;
+
+				LaneVector3DSW temp1 = A.inv_inertia_tensor.xform(rA.cross(tv));
+				LaneVector3DSW temp2 = B.inv_inertia_tensor.xform(rB.cross(tv));
+
+				LaneReal3DSW t = -tvl / (A.inv_mass + B.inv_mass + tv.dot(temp1.cross(rA) + temp2.cross(rB)));
+
+				LaneVector3DSW jt = tv * t;
+
+				LaneVector3DSW jtOld = acc_tangent_impulse;
+				LaneVector3DSW acc = jtOld + jt;
+
+				LaneReal3DSW fi_len = acc.length();
+				LaneReal3DSW jtMax = acc_normal_impulse * friction;
+
+				LaneMask3DSW clamp_mask = (fi_len > cmp_epsilon) && (fi_len > jtMax);
+				acc = LaneVector3DSW::select(clamp_mask, acc * (jtMax / fi_len), acc);
+				acc_tangent_impulse = LaneVector3DSW::select(friction_mask, acc, acc_tangent_impulse);
+
+				jt = acc_tangent_impulse - jtOld;
+
+				A.apply_impulse(friction_mask, -jt, position_A);
+				B.apply_impulse(friction_mask, jt, position_B);
+			}
+
+			LaneMask3DSW still_active = bias_mask || normal_mask || friction_mask;
+
+			FOR_LANES {
+				if (!active.m[l]) {
+					continue;
+				}
+				BodyPair3DSW::Contact &c = pairs[l]->contacts[i];
+				c.acc_tangent_impulse = acc_tangent_impulse.get_lane(l);
+				c.acc_normal_impulse = acc_normal_impulse.v[l];
+				c.acc_bias_impulse = acc_bias_impulse.v[l];
+				c.acc_bias_impulse_center_of_mass = acc_bias_impulse_center_of_mass.v[l];
+				// Will activate itself if still needed, same as the scalar path.
+				c.active = still_active.m[l];
+			}
+		}
+
+		FOR_LANES {
+			if (!pairs[l]) {
+				continue;
+			}
+			if (pairs[l]->dynamic_A) {
+				A.scatter(l, pairs[l]->A);
+			}
+			if (pairs[l]->dynamic_B) {
+				B.scatter(l, pairs[l]->B);
+			}
+		}
+	}
+}
@@ -32,6 +32,7 @@
 
 #include "broad_phase_3d_bvh.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/os/memory_tracker.h"
 #include "core/os/os.h"
 #include "joints/cone_twist_joint_3d_sw.h"
 #include "joints/generic_6dof_joint_3d_sw.h"
@@ -1606,6 +1607,8 @@ void PhysicsServer3DSW::init() {
 };
 
 void PhysicsServer3DSW::step(real_t p_step) {
+	MEMORY_TRACKING_SCOPE("physics_3d");
+
 #ifndef _3D_DISABLED
 
 	if (!active) {
@@ -110,6 +110,8 @@ private:
 	real_t body_time_to_sleep;
 	real_t body_angular_velocity_damp_ratio;
 
+	bool simd_contact_solver;
+
 	bool locked;
 
 	int island_count;
@@ -165,6 +167,7 @@ public:
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
 	_FORCE_INLINE_ real_t get_body_angular_velocity_damp_ratio() const { return body_angular_velocity_damp_ratio; }
+	_FORCE_INLINE_ bool is_using_simd_contact_solver() const { return simd_contact_solver; }
 
 	void update();
 	void setup();
@@ -29,6 +29,8 @@
 /*************************************************************************/
 
 #include "step_3d_sw.h"
+#include "body_pair_3d_sw.h"
+#include "contact_solver_simd_3d_sw.h"
 #include "joints_3d_sw.h"
 
 #include "core/os/os.h"
@@ -39,6 +41,13 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+// Islands with at least this many constraints get their constraints solved in parallel.
+#define ISLAND_COLORING_MIN_CONSTRAINTS 256
+// With the SIMD contact solver, islands with at least this many constraints get colored to fill the lanes.
+#define ISLAND_COLORING_MIN_CONSTRAINTS_SIMD (2 * ContactSolverSIMD3DSW::LANE_COUNT)
+#define SOLVER_COLOR_COUNT 64
+#define CONSTRAINT_BATCH_CHUNK_SIZE 32
+
 void Step3DSW::_populate_island(Body3DSW *p_body, LocalVector<Body3DSW *> &p_body_island, LocalVector<Constraint3DSW *> &p_constraint_island) {
 	p_body->set_island_step(_step);
 
@@ -128,9 +137,173 @@ void Step3DSW::_pre_solve_island(LocalVector<Constraint3DSW *> &p_constraint_isl
 	p_constraint_island.resize(valid_constraint_count);
 }
 
+void Step3DSW::_color_island(const LocalVector<Constraint3DSW *> &p_constraint_island, ColoredIsland &r_colored_island) const {
+	uint32_t constraint_count = p_constraint_island.size();
+
+	// Dynamic bodies only belong to one island, so other islands being colored at the same time never touch them.
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		Constraint3DSW *constraint = p_constraint_island[constraint_index];
+		for (int i = 0; i < constraint->get_body_count(); i++) {
+			Body3DSW *body = constraint->get_body_ptr()[i];
+			if (body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+				body->set_solver_color_mask(0);
+			}
+		}
+	}
+
+	// Greedy coloring: each constraint takes the first color none of its dynamic bodies uses yet.
+	// Static and kinematic bodies are never written by the solver, so they can be shared within a color.
+	// Constraints involving soft bodies, or running out of colors, go to the last color.
+	uint32_t color_counts[SOLVER_COLOR_COUNT + 1] = {};
+
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		Constraint3DSW *constraint = p_constraint_island[constraint_index];
+
+		uint32_t color = SOLVER_COLOR_COUNT;
+		if (constraint->get_soft_body_count() == 0) {
+			uint64_t used_colors = 0;
+			for (int i = 0; i < constraint->get_body_count(); i++) {
+				Body3DSW *body = constraint->get_body_ptr()[i];
+				if (body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+					used_colors |= body->get_solver_color_mask();
+				}
+			}
+
+			if (used_colors != UINT64_MAX) {
+				color = 0;
+				while (used_colors & (uint64_t(1) << color)) {
+					++color;
+				}
+
+				for (int i = 0; i < constraint->get_body_count(); i++) {
+					Body3DSW *body = constraint->get_body_ptr()[i];
+					if (body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+						body->set_solver_color_mask(body->get_solver_color_mask() | (uint64_t(1) << color));
+					}
+				}
+			}
+		}
+
+		constraint->set_solver_color(color);
+		++color_counts[color];
+	}
+
+	// Group constraints by color, keeping their relative order.
+	r_colored_island.color_offsets.resize(SOLVER_COLOR_COUNT + 2);
+	uint32_t write_offsets[SOLVER_COLOR_COUNT + 1];
+	uint32_t offset = 0;
+	for (uint32_t color = 0; color <= SOLVER_COLOR_COUNT; ++color) {
+		r_colored_island.color_offsets[color] = offset;
+		write_offsets[color] = offset;
+		offset += color_counts[color];
+	}
+	r_colored_island.color_offsets[SOLVER_COLOR_COUNT + 1] = offset;
+
+	r_colored_island.constraints.resize(constraint_count);
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		Constraint3DSW *constraint = p_constraint_island[constraint_index];
+		r_colored_island.constraints[write_offsets[constraint->get_solver_color()]++] = constraint;
+	}
+}
+
+void Step3DSW::_solve_constraint_batch(uint32_t p_chunk_index, const ConstraintBatch *p_batch) {
+	uint32_t from = p_chunk_index * CONSTRAINT_BATCH_CHUNK_SIZE;
+	uint32_t to = MIN(from + CONSTRAINT_BATCH_CHUNK_SIZE, p_batch->count);
+
+	if (!simd_contact_solver) {
+		for (uint32_t constraint_index = from; constraint_index < to; ++constraint_index) {
+			p_batch->constraints[constraint_index]->solve(delta);
+		}
+		return;
+	}
+
+	// Constraints of a batch are independent, so the order doesn't matter and body pairs can be solved side by side.
+	BodyPair3DSW *body_pairs[CONSTRAINT_BATCH_CHUNK_SIZE];
+	uint32_t body_pair_count = 0;
+	for (uint32_t constraint_index = from; constraint_index < to; ++constraint_index) {
+		Constraint3DSW *constraint = p_batch->constraints[constraint_index];
+		if (constraint->is_body_pair()) {
+			body_pairs[body_pair_count++] = static_cast<BodyPair3DSW *>(constraint);
+		} else {
+			constraint->solve(delta);
+		}
+	}
+	ContactSolverSIMD3DSW::solve(body_pairs, body_pair_count, delta);
+}
+
+void Step3DSW::_solve_island_colored(uint32_t p_island_index) {
+	ColoredIsland &colored_island = colored_islands[p_island_index];
+	_color_island(constraint_islands[p_island_index], colored_island);
+
+	LocalVector<Constraint3DSW *> &constraints = colored_island.constraints;
+	LocalVector<uint32_t> &color_offsets = colored_island.color_offsets;
+
+	if (!colored_island.batch_pool) {
+		colored_island.batch_pool = memnew(ThreadWorkPool);
+		colored_island.batch_pool->init();
+	}
+	ThreadWorkPool &batch_pool = *colored_island.batch_pool;
+
+	int current_priority = 1;
+
+	while (color_offsets[SOLVER_COLOR_COUNT + 1] > 0) {
+		for (int i = 0; i < iterations; i++) {
+			// Go through all iterations, colors are solved one after another.
+			for (uint32_t color = 0; color < SOLVER_COLOR_COUNT; ++color) {
+				ConstraintBatch batch;
+				batch.constraints = constraints.ptr() + color_offsets[color];
+				batch.count = color_offsets[color + 1] - color_offsets[color];
+
+				uint32_t chunk_count = (batch.count + CONSTRAINT_BATCH_CHUNK_SIZE - 1) / CONSTRAINT_BATCH_CHUNK_SIZE;
+				if (chunk_count > 1) {
+					batch_pool.do_work(chunk_count, this, &Step3DSW::_solve_constraint_batch, &batch);
+				} else if (chunk_count > 0) {
+					_solve_constraint_batch(0, &batch);
+				}
+			}
+
+			// Last color can't be solved in parallel.
+			for (uint32_t constraint_index = color_offsets[SOLVER_COLOR_COUNT]; constraint_index < color_offsets[SOLVER_COLOR_COUNT + 1]; ++constraint_index) {
+				constraints[constraint_index]->solve(delta);
+			}
+		}
+
+		// Check priority to keep only higher priority constraints.
+		// Any subset of a color is still independent, so colors don't need to be recomputed.
+		uint32_t priority_constraint_count = 0;
+		++current_priority;
+		uint32_t color_begin = 0;
+		for (uint32_t color = 0; color <= SOLVER_COLOR_COUNT; ++color) {
+			uint32_t color_end = color_offsets[color + 1];
+			color_offsets[color] = priority_constraint_count;
+			for (uint32_t constraint_index = color_begin; constraint_index < color_end; ++constraint_index) {
+				Constraint3DSW *constraint = constraints[constraint_index];
+				if (constraint->get_priority() >= current_priority) {
+					// Keep this constraint for the next iteration.
+					constraints[priority_constraint_count++] = constraint;
+				}
+			}
+			color_begin = color_end;
+		}
+		color_offsets[SOLVER_COLOR_COUNT + 1] = priority_constraint_count;
+	}
+}
+
 void Step3DSW::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	LocalVector<Constraint3DSW *> &constraint_island = constraint_islands[p_island_index];
 
+	if (constraint_island.size() >= ISLAND_COLORING_MIN_CONSTRAINTS && work_pool.get_thread_count() > 1) {
+		// Big island, one thread isn't enough for it.
+		_solve_island_colored(p_island_index);
+		return;
+	}
+
+	if (simd_contact_solver && constraint_island.size() >= ISLAND_COLORING_MIN_CONSTRAINTS_SIMD) {
+		// Colors are needed to find contacts that can share lanes.
+		_solve_island_colored(p_island_index);
+		return;
+	}
+
 	int current_priority = 1;
 
 	uint32_t constraint_count = constraint_island.size();
@@ -187,6 +360,7 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 
 	iterations = p_iterations;
 	delta = p_delta;
+	simd_contact_solver = p_space->is_using_simd_contact_solver();
 
 	const SelfList<Body3DSW>::List *body_list = &p_space->get_active_body_list();
 
@@ -354,6 +528,10 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
+	if (colored_islands.size() < island_count) {
+		colored_islands.resize(island_count);
+	}
+
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
 	if (island_count > 1) {
@@ -415,5 +593,10 @@ Step3DSW::Step3DSW() {
 }
 
 Step3DSW::~Step3DSW() {
+	for (uint32_t i = 0; i < colored_islands.size(); i++) {
+		if (colored_islands[i].batch_pool) {
+			memdelete(colored_islands[i].batch_pool);
+		}
+	}
 	work_pool.finish();
 }
@@ -41,17 +41,36 @@ class Step3DSW {
 
 	int iterations = 0;
 	real_t delta = 0.0;
+	bool simd_contact_solver = false;
 
 	ThreadWorkPool work_pool;
 
+	struct ColoredIsland {
+		// Constraints grouped by color, constraints of the same color don't share any dynamic body.
+		LocalVector<Constraint3DSW *> constraints;
+		// Color i spans [color_offsets[i], color_offsets[i + 1]), the last color is solved serially.
+		LocalVector<uint32_t> color_offsets;
+		// Several islands can be solved at the same time, each one needs its own pool. Created on first use.
+		ThreadWorkPool *batch_pool = nullptr;
+	};
+
+	struct ConstraintBatch {
+		Constraint3DSW *const *constraints = nullptr;
+		uint32_t count = 0;
+	};
+
 	LocalVector<LocalVector<Body3DSW *>> body_islands;
 	LocalVector<LocalVector<Constraint3DSW *>> constraint_islands;
+	LocalVector<ColoredIsland> colored_islands;
 	LocalVector<Constraint3DSW *> all_constraints;
 
 	void _populate_island(Body3DSW *p_body, LocalVector<Body3DSW *> &p_body_island, LocalVector<Constraint3DSW *> &p_constraint_island);
 	void _populate_island_soft_body(SoftBody3DSW *p_soft_body, LocalVector<Body3DSW *> &p_body_island, LocalVector<Constraint3DSW *> &p_constraint_island);
 	void _setup_contraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<Constraint3DSW *> &p_constraint_island) const;
+	void _color_island(const LocalVector<Constraint3DSW *> &p_constraint_island, ColoredIsland &r_colored_island) const;
+	void _solve_constraint_batch(uint32_t p_chunk_index, const ConstraintBatch *p_batch);
+	void _solve_island_colored(uint32_t p_island_index);
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
 	void _check_suspend(const LocalVector<Body3DSW *> &p_body_island) const;
 
@@ -97,6 +97,16 @@ void _collect_ysort_children(RendererCanvasCull::Item *p_canvas_item, Transform2
 	}
 }
 
+// Polygon commands are retained across redraws when they are built again from the same data,
+// these keep the different ways of building them apart.
+enum PolygonSource {
+	POLYGON_SOURCE_POLYLINE,
+	POLYGON_SOURCE_MULTILINE,
+	POLYGON_SOURCE_CIRCLE,
+	POLYGON_SOURCE_POLYGON,
+	POLYGON_SOURCE_TRIANGLE_ARRAY,
+};
+
 void _mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner, RID_PtrOwner<RendererCanvasCull::Item, true> &canvas_item_owner) {
 	do {
 		ysort_owner->ysort_children_count = -1;
@@ -107,6 +117,8 @@ void _mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner, RID_PtrOwner<Rende
 void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **z_list, RendererCanvasRender::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner) {
 	Item *ci = p_canvas_item;
 
+	ci->end_rebuild();
+
 	if (!ci->visible) {
 		return;
 	}
@@ -524,8 +536,9 @@ void RendererCanvasCull::canvas_item_add_line(RID p_item, const Point2 &p_from,
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandPrimitive *line = canvas_item->alloc_command<Item::CommandPrimitive>();
+	Item::CommandPrimitive *line = canvas_item->record_command<Item::CommandPrimitive>(Item::Command::TYPE_PRIMITIVE);
 	ERR_FAIL_COND(!line);
+	canvas_item->hash_command(Item::Command::TYPE_PRIMITIVE, p_from, p_to, p_color, p_width);
 	if (p_width > 1.001) {
 		Vector2 t = (p_from - p_to).orthogonal().normalized() * p_width * 0.5;
 		line->points[0] = p_from + t;
@@ -548,6 +561,12 @@ void RendererCanvasCull::canvas_item_add_polyline(RID p_item, const Vector<Point
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
+	canvas_item->hash_command(Item::Command::TYPE_POLYGON, POLYGON_SOURCE_POLYLINE, p_points, p_colors, p_width, p_antialiased);
+	if (canvas_item->reuse_polygons(p_antialiased ? 3 : 1, POLYGON_SOURCE_POLYLINE, p_points, p_colors, p_width, p_antialiased)) {
+		return;
+	}
+	Vector<uint8_t> source = Item::make_source(POLYGON_SOURCE_POLYLINE, p_points, p_colors, p_width, p_antialiased);
+
 	Color color = Color(1, 1, 1, 1);
 
 	Vector<int> indices;
@@ -557,7 +576,7 @@ void RendererCanvasCull::canvas_item_add_polyline(RID p_item, const Vector<Point
 	Vector2 prev_t;
 	int j2;
 
-	Item::CommandPolygon *pline = canvas_item->alloc_command<Item::CommandPolygon>();
+	Item::CommandPolygon *pline = canvas_item->record_command<Item::CommandPolygon>(Item::Command::TYPE_POLYGON);
 	ERR_FAIL_COND(!pline);
 
 	PackedColorArray colors;
@@ -584,10 +603,10 @@ void RendererCanvasCull::canvas_item_add_polyline(RID p_item, const Vector<Point
 		colors_bottom.resize(pc2);
 		points_bottom.resize(pc2);
 
-		Item::CommandPolygon *pline_top = canvas_item->alloc_command<Item::CommandPolygon>();
+		Item::CommandPolygon *pline_top = canvas_item->record_command<Item::CommandPolygon>(Item::Command::TYPE_POLYGON);
 		ERR_FAIL_COND(!pline_top);
 
-		Item::CommandPolygon *pline_bottom = canvas_item->alloc_command<Item::CommandPolygon>();
+		Item::CommandPolygon *pline_bottom = canvas_item->record_command<Item::CommandPolygon>(Item::Command::TYPE_POLYGON);
 		ERR_FAIL_COND(!pline_bottom);
 
 		//make three trianglestrip's for drawing the antialiased line...
@@ -642,9 +661,11 @@ void RendererCanvasCull::canvas_item_add_polyline(RID p_item, const Vector<Point
 
 		pline_top->primitive = RS::PRIMITIVE_TRIANGLE_STRIP;
 		pline_top->polygon.create(indices, points_top, colors_top);
+		pline_top->polygon.source = source;
 
 		pline_bottom->primitive = RS::PRIMITIVE_TRIANGLE_STRIP;
 		pline_bottom->polygon.create(indices, points_bottom, colors_bottom);
+		pline_bottom->polygon.source = source;
 	} else {
 		//make a trianglestrip for drawing the line...
 
@@ -680,6 +701,7 @@ void RendererCanvasCull::canvas_item_add_polyline(RID p_item, const Vector<Point
 
 	pline->primitive = RS::PRIMITIVE_TRIANGLE_STRIP;
 	pline->polygon.create(indices, points, colors);
+	pline->polygon.source = source;
 }
 
 void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, float p_width) {
@@ -687,7 +709,13 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandPolygon *pline = canvas_item->alloc_command<Item::CommandPolygon>();
+	canvas_item->hash_command(Item::Command::TYPE_POLYGON, POLYGON_SOURCE_MULTILINE, p_points, p_colors, p_width);
+	if (canvas_item->reuse_polygons(1, POLYGON_SOURCE_MULTILINE, p_points, p_colors, p_width)) {
+		return;
+	}
+	Vector<uint8_t> source = Item::make_source(POLYGON_SOURCE_MULTILINE, p_points, p_colors, p_width);
+
+	Item::CommandPolygon *pline = canvas_item->record_command<Item::CommandPolygon>(Item::Command::TYPE_POLYGON);
 	ERR_FAIL_COND(!pline);
 
 	if (true || p_width <= 1) {
@@ -695,6 +723,7 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 
 		pline->primitive = RS::PRIMITIVE_LINES;
 		pline->polygon.create(Vector<int>(), p_points, p_colors);
+		pline->polygon.source = source;
 	} else {
 	}
 }
@@ -703,8 +732,9 @@ void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, c
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
+	Item::CommandRect *rect = canvas_item->record_command<Item::CommandRect>(Item::Command::TYPE_RECT);
 	ERR_FAIL_COND(!rect);
+	canvas_item->hash_command(Item::Command::TYPE_RECT, p_rect, p_color);
 	rect->modulate = p_color;
 	rect->rect = p_rect;
 }
@@ -713,7 +743,13 @@ void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos,
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandPolygon *circle = canvas_item->alloc_command<Item::CommandPolygon>();
+	canvas_item->hash_command(Item::Command::TYPE_POLYGON, POLYGON_SOURCE_CIRCLE, p_pos, p_radius, p_color);
+	if (canvas_item->reuse_polygons(1, POLYGON_SOURCE_CIRCLE, p_pos, p_radius, p_color)) {
+		return;
+	}
+	Vector<uint8_t> source = Item::make_source(POLYGON_SOURCE_CIRCLE, p_pos, p_radius, p_color);
+
+	Item::CommandPolygon *circle = canvas_item->record_command<Item::CommandPolygon>(Item::Command::TYPE_POLYGON);
 	ERR_FAIL_COND(!circle);
 
 	circle->primitive = RS::PRIMITIVE_TRIANGLES;
@@ -743,14 +779,16 @@ void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos,
 	Vector<Color> color;
 	color.push_back(p_color);
 	circle->polygon.create(indices, points, color);
+	circle->polygon.source = source;
 }
 
 void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
+	Item::CommandRect *rect = canvas_item->record_command<Item::CommandRect>(Item::Command::TYPE_RECT);
 	ERR_FAIL_COND(!rect);
+	canvas_item->hash_command(Item::Command::TYPE_RECT, p_rect, p_texture, p_tile, p_modulate, p_transpose);
 	rect->modulate = p_modulate;
 	rect->rect = p_rect;
 	rect->flags = 0;
@@ -780,8 +818,9 @@ void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const R
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
+	Item::CommandRect *rect = canvas_item->record_command<Item::CommandRect>(Item::Command::TYPE_RECT);
 	ERR_FAIL_COND(!rect);
+	canvas_item->hash_command(Item::Command::TYPE_RECT, p_rect, p_texture, p_src_rect, p_modulate, p_transpose, p_clip_uv);
 	rect->modulate = p_modulate;
 	rect->rect = p_rect;
 
@@ -821,8 +860,9 @@ void RendererCanvasCull::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_r
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandNinePatch *style = canvas_item->alloc_command<Item::CommandNinePatch>();
+	Item::CommandNinePatch *style = canvas_item->record_command<Item::CommandNinePatch>(Item::Command::TYPE_NINEPATCH);
 	ERR_FAIL_COND(!style);
+	canvas_item->hash_command(Item::Command::TYPE_NINEPATCH, p_rect, p_source, p_texture, p_topleft, p_bottomright, p_x_axis_mode, p_y_axis_mode, p_draw_center, p_modulate);
 
 	style->texture = p_texture;
 
@@ -845,8 +885,9 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandPrimitive *prim = canvas_item->alloc_command<Item::CommandPrimitive>();
+	Item::CommandPrimitive *prim = canvas_item->record_command<Item::CommandPrimitive>(Item::Command::TYPE_PRIMITIVE);
 	ERR_FAIL_COND(!prim);
+	canvas_item->hash_command(Item::Command::TYPE_PRIMITIVE, p_points, p_colors, p_uvs, p_texture, p_width);
 
 	for (int i = 0; i < p_points.size(); i++) {
 		prim->points[i] = p_points[i];
@@ -878,14 +919,21 @@ void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2
 	ERR_FAIL_COND(color_size != 0 && color_size != 1 && color_size != pointcount);
 	ERR_FAIL_COND(uv_size != 0 && (uv_size != pointcount));
 #endif
+	if (canvas_item->reuse_polygons(1, POLYGON_SOURCE_POLYGON, p_points, p_colors, p_uvs, p_texture)) {
+		canvas_item->hash_command(Item::Command::TYPE_POLYGON, POLYGON_SOURCE_POLYGON, p_points, p_colors, p_uvs, p_texture);
+		return;
+	}
+
 	Vector<int> indices = Geometry2D::triangulate_polygon(p_points);
 	ERR_FAIL_COND_MSG(indices.is_empty(), "Invalid polygon data, triangulation failed.");
 
-	Item::CommandPolygon *polygon = canvas_item->alloc_command<Item::CommandPolygon>();
+	Item::CommandPolygon *polygon = canvas_item->record_command<Item::CommandPolygon>(Item::Command::TYPE_POLYGON);
 	ERR_FAIL_COND(!polygon);
+	canvas_item->hash_command(Item::Command::TYPE_POLYGON, POLYGON_SOURCE_POLYGON, p_points, p_colors, p_uvs, p_texture);
 	polygon->primitive = RS::PRIMITIVE_TRIANGLES;
 	polygon->texture = p_texture;
 	polygon->polygon.create(indices, p_points, p_colors, p_uvs);
+	polygon->polygon.source = Item::make_source(POLYGON_SOURCE_POLYGON, p_points, p_colors, p_uvs, p_texture);
 }
 
 void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector<int> &p_indices, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, const Vector<int> &p_bones, const Vector<float> &p_weights, RID p_texture, int p_count) {
@@ -899,14 +947,21 @@ void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector
 	ERR_FAIL_COND(!p_bones.is_empty() && p_bones.size() != vertex_count * 4);
 	ERR_FAIL_COND(!p_weights.is_empty() && p_weights.size() != vertex_count * 4);
 
+	canvas_item->hash_command(Item::Command::TYPE_POLYGON, POLYGON_SOURCE_TRIANGLE_ARRAY, p_indices, p_points, p_colors, p_uvs, p_bones, p_weights, p_texture, p_count);
+	if (canvas_item->reuse_polygons(1, POLYGON_SOURCE_TRIANGLE_ARRAY, p_indices, p_points, p_colors, p_uvs, p_bones, p_weights, p_texture, p_count)) {
+		return;
+	}
+	Vector<uint8_t> source = Item::make_source(POLYGON_SOURCE_TRIANGLE_ARRAY, p_indices, p_points, p_colors, p_uvs, p_bones, p_weights, p_texture, p_count);
+
 	Vector<int> indices = p_indices;
 
-	Item::CommandPolygon *polygon = canvas_item->alloc_command<Item::CommandPolygon>();
+	Item::CommandPolygon *polygon = canvas_item->record_command<Item::CommandPolygon>(Item::Command::TYPE_POLYGON);
 	ERR_FAIL_COND(!polygon);
 
 	polygon->texture = p_texture;
 
 	polygon->polygon.create(indices, p_points, p_colors, p_uvs, p_bones, p_weights);
+	polygon->polygon.source = source;
 
 	polygon->primitive = RS::PRIMITIVE_TRIANGLES;
 }
@@ -915,8 +970,9 @@ void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transfo
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandTransform *tr = canvas_item->alloc_command<Item::CommandTransform>();
+	Item::CommandTransform *tr = canvas_item->record_command<Item::CommandTransform>(Item::Command::TYPE_TRANSFORM);
 	ERR_FAIL_COND(!tr);
+	canvas_item->hash_command(Item::Command::TYPE_TRANSFORM, p_transform);
 	tr->xform = p_transform;
 }
 
@@ -925,10 +981,21 @@ void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, con
 	ERR_FAIL_COND(!canvas_item);
 	ERR_FAIL_COND(!p_mesh.is_valid());
 
-	Item::CommandMesh *m = canvas_item->alloc_command<Item::CommandMesh>();
-	ERR_FAIL_COND(!m);
+	// Reused as is, so a skinned mesh keeps its mesh instance across redraws.
+	Item::CommandMesh *m = canvas_item->reuse_command<Item::CommandMesh>(Item::Command::TYPE_MESH);
+	if (!m) {
+		m = canvas_item->alloc_command<Item::CommandMesh>();
+		ERR_FAIL_COND(!m);
+	} else if (m->mesh_instance.is_valid() && (m->mesh != p_mesh || !canvas_item->skeleton.is_valid())) {
+		RSG::storage->free(m->mesh_instance);
+		m->mesh_instance = RID();
+	}
+	canvas_item->hash_command(Item::Command::TYPE_MESH, p_mesh, p_transform, p_modulate, p_texture);
+	//the bounds come from the mesh, which may have changed
+	canvas_item->rect_dirty = true;
+
 	m->mesh = p_mesh;
-	if (canvas_item->skeleton.is_valid()) {
+	if (canvas_item->skeleton.is_valid() && !m->mesh_instance.is_valid()) {
 		m->mesh_instance = RSG::storage->mesh_instance_create(p_mesh);
 		RSG::storage->mesh_instance_set_skeleton(m->mesh_instance, canvas_item->skeleton);
 	}
@@ -943,8 +1010,10 @@ void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles,
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandParticles *part = canvas_item->alloc_command<Item::CommandParticles>();
+	Item::CommandParticles *part = canvas_item->record_command<Item::CommandParticles>(Item::Command::TYPE_PARTICLES);
 	ERR_FAIL_COND(!part);
+	canvas_item->hash_command(Item::Command::TYPE_PARTICLES, p_particles, p_texture);
+	canvas_item->rect_dirty = true;
 	part->particles = p_particles;
 
 	part->texture = p_texture;
@@ -957,8 +1026,10 @@ void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandMultiMesh *mm = canvas_item->alloc_command<Item::CommandMultiMesh>();
+	Item::CommandMultiMesh *mm = canvas_item->record_command<Item::CommandMultiMesh>(Item::Command::TYPE_MULTIMESH);
 	ERR_FAIL_COND(!mm);
+	canvas_item->hash_command(Item::Command::TYPE_MULTIMESH, p_mesh, p_texture);
+	canvas_item->rect_dirty = true;
 	mm->multimesh = p_mesh;
 
 	mm->texture = p_texture;
@@ -968,8 +1039,9 @@ void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore)
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandClipIgnore *ci = canvas_item->alloc_command<Item::CommandClipIgnore>();
+	Item::CommandClipIgnore *ci = canvas_item->record_command<Item::CommandClipIgnore>(Item::Command::TYPE_CLIP_IGNORE);
 	ERR_FAIL_COND(!ci);
+	canvas_item->hash_command(Item::Command::TYPE_CLIP_IGNORE, p_ignore);
 	ci->ignore = p_ignore;
 }
 
@@ -1048,7 +1120,7 @@ void RendererCanvasCull::canvas_item_clear(RID p_item) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	canvas_item->clear();
+	canvas_item->begin_rebuild();
 }
 
 void RendererCanvasCull::canvas_item_set_draw_index(RID p_item, int p_index) {
@@ -132,6 +132,7 @@ public:
 	struct Polygon {
 		PolygonID polygon_id;
 		Rect2 rect_cache;
+		Vector<uint8_t> source; //copy of the data the polygon was built from, so retained rebuilds can keep it
 
 		_FORCE_INLINE_ void create(const Vector<int> &p_indices, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs = Vector<Point2>(), const Vector<int> &p_bones = Vector<int>(), const Vector<float> &p_weights = Vector<float>()) {
 			ERR_FAIL_COND(polygon_id != 0);
@@ -441,6 +442,225 @@ public:
 		Vector<CommandBlock> blocks;
 		uint32_t current_block;
 
+		// Retained rebuilds: begin_rebuild() keeps the previous commands, and the ones
+		// recorded afterwards are matched in order against them and updated in place.
+		// A hash of everything recorded tells whether the list changed, so the rect is
+		// only computed again when needed.
+		static constexpr uint64_t COMMANDS_HASH_SEED = 14695981039346656037ULL;
+
+		Command *rebuild_cursor;
+		Command *rebuild_last;
+		bool rebuilding;
+		uint64_t commands_hash;
+		uint64_t rebuild_hash;
+
+		// 64-bit FNV-1a, small changes to float coordinates don't cancel out like with djb2.
+		static _FORCE_INLINE_ uint64_t hash_bytes(const void *p_data, uint32_t p_size, uint64_t p_hash) {
+			const uint8_t *data = (const uint8_t *)p_data;
+			for (uint32_t i = 0; i < p_size; i++) {
+				p_hash = (p_hash ^ data[i]) * 1099511628211ULL;
+			}
+			return p_hash;
+		}
+
+		template <class T>
+		static _FORCE_INLINE_ uint64_t hash_arg(const T &p_arg, uint64_t p_hash) {
+			return hash_bytes(&p_arg, sizeof(T), p_hash);
+		}
+
+		template <class T>
+		static _FORCE_INLINE_ uint64_t hash_arg(const Vector<T> &p_arg, uint64_t p_hash) {
+			uint32_t size = p_arg.size();
+			p_hash = hash_bytes(&size, sizeof(uint32_t), p_hash);
+			return hash_bytes(p_arg.ptr(), size * sizeof(T), p_hash);
+		}
+
+		static _FORCE_INLINE_ uint64_t hash_args(uint64_t p_hash) {
+			return p_hash;
+		}
+
+		template <class T, class... P>
+		static _FORCE_INLINE_ uint64_t hash_args(uint64_t p_hash, const T &p_arg, const P &...p_args) {
+			return hash_args(hash_arg(p_arg, p_hash), p_args...);
+		}
+
+		template <class... P>
+		_FORCE_INLINE_ void hash_command(Command::Type p_type, const P &...p_args) {
+			rebuild_hash = hash_args(hash_arg(p_type, rebuild_hash), p_args...);
+		}
+
+		// Polygons keep a copy of the data they were built from (Polygon::source), and are
+		// only kept when it is the same, byte for byte.
+		template <class T>
+		static _FORCE_INLINE_ uint32_t source_size(const T &p_arg) {
+			return sizeof(T);
+		}
+
+		template <class T>
+		static _FORCE_INLINE_ uint32_t source_size(const Vector<T> &p_arg) {
+			return sizeof(uint32_t) + p_arg.size() * sizeof(T);
+		}
+
+		template <class T>
+		static _FORCE_INLINE_ uint8_t *write_source(const T &p_arg, uint8_t *p_dst) {
+			memcpy(p_dst, &p_arg, sizeof(T));
+			return p_dst + sizeof(T);
+		}
+
+		template <class T>
+		static _FORCE_INLINE_ uint8_t *write_source(const Vector<T> &p_arg, uint8_t *p_dst) {
+			uint32_t size = p_arg.size();
+			memcpy(p_dst, &size, sizeof(uint32_t));
+			memcpy(p_dst + sizeof(uint32_t), p_arg.ptr(), size * sizeof(T));
+			return p_dst + sizeof(uint32_t) + size * sizeof(T);
+		}
+
+		template <class T>
+		static _FORCE_INLINE_ bool match_source(const T &p_arg, const uint8_t *&r_src, const uint8_t *p_end) {
+			if (uint32_t(p_end - r_src) < sizeof(T) || memcmp(r_src, &p_arg, sizeof(T)) != 0) {
+				return false;
+			}
+			r_src += sizeof(T);
+			return true;
+		}
+
+		template <class T>
+		static _FORCE_INLINE_ bool match_source(const Vector<T> &p_arg, const uint8_t *&r_src, const uint8_t *p_end) {
+			uint32_t size = p_arg.size();
+			if (!match_source(size, r_src, p_end) || uint32_t(p_end - r_src) < size * sizeof(T) || memcmp(r_src, p_arg.ptr(), size * sizeof(T)) != 0) {
+				return false;
+			}
+			r_src += size * sizeof(T);
+			return true;
+		}
+
+		template <class... P>
+		static Vector<uint8_t> make_source(const P &...p_args) {
+			uint32_t size = 0;
+			for (uint32_t arg_size : { source_size(p_args)... }) {
+				size += arg_size;
+			}
+			Vector<uint8_t> source;
+			source.resize(size);
+			uint8_t *dst = source.ptrw();
+			for (uint8_t *end : { (dst = write_source(p_args, dst))... }) {
+				(void)end;
+			}
+			return source;
+		}
+
+		template <class... P>
+		static bool is_same_source(const Vector<uint8_t> &p_source, const P &...p_args) {
+			const uint8_t *src = p_source.ptr();
+			const uint8_t *end = src + p_source.size();
+			for (bool matched : { match_source(p_args, src, end)... }) {
+				if (!matched) {
+					return false;
+				}
+			}
+			return src == end;
+		}
+
+		void begin_rebuild() {
+			if (rebuilding) {
+				end_rebuild();
+			}
+
+			rebuilding = true;
+			rebuild_cursor = commands;
+			rebuild_last = nullptr;
+			rebuild_hash = COMMANDS_HASH_SEED;
+
+			clip = false;
+			final_clip_owner = nullptr;
+			material_owner = nullptr;
+			light_masked = false;
+		}
+
+		void end_rebuild() {
+			if (rebuilding) {
+				if (rebuild_cursor) {
+					//fewer commands than last time, drop the rest
+					_free_commands_after(rebuild_last);
+				}
+				rebuilding = false;
+				rebuild_cursor = nullptr;
+				rebuild_last = nullptr;
+			}
+
+			if (rebuild_hash != commands_hash) {
+				commands_hash = rebuild_hash;
+				rect_dirty = true;
+			}
+		}
+
+		// Returns the next command of the previous list as is, if it has the requested type.
+		// Otherwise the lists diverged, so what is left of the previous one is dropped.
+		template <class T>
+		T *reuse_command(Command::Type p_type) {
+			if (!rebuild_cursor) {
+				return nullptr;
+			}
+
+			if (rebuild_cursor->type != p_type) {
+				_free_commands_after(rebuild_last);
+				rebuild_cursor = nullptr;
+				return nullptr;
+			}
+
+			T *command = static_cast<T *>(rebuild_cursor);
+			rebuild_last = rebuild_cursor;
+			rebuild_cursor = rebuild_cursor->next;
+			return command;
+		}
+
+		// Like alloc_command(), but reuses the memory of the matching previous command.
+		template <class T>
+		T *record_command(Command::Type p_type) {
+			T *command = reuse_command<T>(p_type);
+			if (!command) {
+				return alloc_command<T>();
+			}
+
+			Command *next = command->next;
+			command->~T();
+			memnew_placement(command, T);
+			command->next = next;
+			return command;
+		}
+
+		// Keeps the next p_count polygons of the previous list if they were built from the same data.
+		// Polygons built together share one source buffer, so only the first one is compared.
+		template <class... P>
+		bool reuse_polygons(int p_count, const P &...p_args) {
+			Command *c = rebuild_cursor;
+			const uint8_t *source = nullptr;
+			for (int i = 0; i < p_count; i++) {
+				if (!c || c->type != Command::TYPE_POLYGON) {
+					return false;
+				}
+				const Polygon &polygon = static_cast<CommandPolygon *>(c)->polygon;
+				if (!polygon.polygon_id || polygon.source.is_empty()) {
+					return false;
+				}
+				if (i == 0) {
+					if (!is_same_source(polygon.source, p_args...)) {
+						return false;
+					}
+					source = polygon.source.ptr();
+				} else if (polygon.source.ptr() != source) {
+					return false;
+				}
+				c = c->next;
+			}
+
+			for (int i = 0; i < p_count; i++) {
+				rebuild_last = rebuild_cursor;
+				rebuild_cursor = rebuild_cursor->next;
+			}
+			return true;
+		}
+
 		template <class T>
 		T *alloc_command() {
 			T *command;
@@ -488,31 +708,77 @@ public:
 			return command;
 		}
 
-		void clear() {
-			// The first one is always allocated on heap
-			// the rest go in the blocks
-			Command *c = commands;
+		void _free_commands_after(Command *p_last) {
+			if (!p_last) {
+				// The first one is always allocated on heap
+				// the rest go in the blocks
+				Command *c = commands;
+				while (c) {
+					Command *n = c->next;
+					if (c == commands) {
+						memdelete(commands);
+						commands = nullptr;
+					} else {
+						c->~Command();
+					}
+					c = n;
+				}
+				{
+					uint32_t cbc = MIN((current_block + 1), (uint32_t)blocks.size());
+					CommandBlock *blockptr = blocks.ptrw();
+					for (uint32_t i = 0; i < cbc; i++) {
+						blockptr[i].usage = 0;
+					}
+				}
+
+				last_command = nullptr;
+				commands = nullptr;
+				current_block = 0;
+				rect_dirty = true;
+				return;
+			}
+
+			Command *from = p_last->next;
+			if (!from) {
+				return;
+			}
+
+			// Commands after the first one are laid out in the blocks in list order,
+			// so the block holding the first dropped command becomes the current one.
+			Command *c = from;
 			while (c) {
 				Command *n = c->next;
-				if (c == commands) {
-					memdelete(commands);
-					commands = nullptr;
-				} else {
-					c->~Command();
-				}
+				c->~Command();
 				c = n;
 			}
-			{
-				uint32_t cbc = MIN((current_block + 1), (uint32_t)blocks.size());
-				CommandBlock *blockptr = blocks.ptrw();
-				for (uint32_t i = 0; i < cbc; i++) {
-					blockptr[i].usage = 0;
+
+			uint8_t *memory = (uint8_t *)from;
+			uint32_t cbc = MIN((current_block + 1), (uint32_t)blocks.size());
+			CommandBlock *blockptr = blocks.ptrw();
+			for (uint32_t i = 0; i < cbc; i++) {
+				if (memory >= blockptr[i].memory && memory < blockptr[i].memory + CommandBlock::MAX_SIZE) {
+					blockptr[i].usage = memory - blockptr[i].memory;
+					for (uint32_t j = i + 1; j < cbc; j++) {
+						blockptr[j].usage = 0;
+					}
+					current_block = i;
+					break;
 				}
 			}
 
-			last_command = nullptr;
-			commands = nullptr;
-			current_block = 0;
+			p_last->next = nullptr;
+			last_command = p_last;
+			rect_dirty = true;
+		}
+
+		void clear() {
+			_free_commands_after(nullptr);
+
+			rebuilding = false;
+			rebuild_cursor = nullptr;
+			rebuild_last = nullptr;
+			commands_hash = COMMANDS_HASH_SEED;
+			rebuild_hash = COMMANDS_HASH_SEED;
 			clip = false;
 			rect_dirty = true;
 			final_clip_owner = nullptr;
@@ -527,6 +793,11 @@ public:
 			commands = nullptr;
 			last_command = nullptr;
 			current_block = 0;
+			rebuild_cursor = nullptr;
+			rebuild_last = nullptr;
+			rebuilding = false;
+			commands_hash = COMMANDS_HASH_SEED;
+			rebuild_hash = COMMANDS_HASH_SEED;
 			light_mask = 1;
 			vp_render = nullptr;
 			next = nullptr;
@@ -602,6 +873,8 @@ public:
 	virtual bool free(RID p_rid) = 0;
 	virtual void update() = 0;
 
+	virtual uint64_t get_render_info(RS::RenderInfo p_info) = 0;
+
 	RendererCanvasRender() { singleton = this; }
 	virtual ~RendererCanvasRender() {}
 };
@@ -312,6 +312,44 @@ RendererCanvasRender::PolygonID RendererCanvasRenderRD::request_polygon(const Ve
 
 	pb.vertex_format_id = vertex_id;
 
+	if (vertex_count <= BATCH_POLYGON_MAX_VERTICES && (uint32_t)p_weights.size() != vertex_count * 4) {
+		//small polygons without skinning keep a CPU copy, so they can be merged into batches
+		pb.batch_vertices.resize(vertex_count);
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			BatchVertex &v = pb.batch_vertices[i];
+			v.vertex[0] = p_points[i].x;
+			v.vertex[1] = p_points[i].y;
+
+			Color color = (uint32_t)p_colors.size() == vertex_count ? p_colors[i] : (p_colors.size() == 1 ? p_colors[0] : Color(1, 1, 1, 1));
+			v.color[0] = color.r;
+			v.color[1] = color.g;
+			v.color[2] = color.b;
+			v.color[3] = color.a;
+
+			Vector2 uv = (uint32_t)p_uvs.size() == vertex_count ? p_uvs[i] : Vector2();
+			v.uv[0] = uv.x;
+			v.uv[1] = uv.y;
+		}
+
+		if (p_indices.size()) {
+			pb.batch_indices.resize(p_indices.size());
+			for (int i = 0; i < p_indices.size(); i++) {
+				if ((uint32_t)p_indices[i] >= vertex_count) {
+					//invalid indices, leave this polygon out of batching
+					pb.batch_vertices.clear();
+					pb.batch_indices.clear();
+					break;
+				}
+				pb.batch_indices[i] = p_indices[i];
+			}
+		} else {
+			pb.batch_indices.resize(vertex_count - vertex_count % 3);
+			for (uint32_t i = 0; i < pb.batch_indices.size(); i++) {
+				pb.batch_indices[i] = i;
+			}
+		}
+	}
+
 	PolygonID id = polygon_buffers.last_id++;
 
 	polygon_buffers.polygons[id] = pb;
@@ -464,6 +502,25 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 
 	const Item::Command *c = p_item->commands;
 	while (c) {
+		if (batching.current_batch < batching.batches.size() && c->type != Item::Command::TYPE_TRANSFORM) {
+			//commands merged into a batch are drawn once, when the batch starts, and skipped afterwards (batches may span several items)
+			const Batch &batch = batching.batches[batching.current_batch];
+			if (batching.skipping || c == batch.first_command) {
+				if (!batching.skipping) {
+					_render_batch(p_draw_list, batch, p_framebuffer_format);
+					last_texture = RID(); //batch bound its own texture
+				}
+
+				batching.skipping = c != batch.last_command;
+				if (!batching.skipping) {
+					batching.current_batch++;
+				}
+
+				c = c->next;
+				continue;
+			}
+		}
+
 		push_constant.flags = base_flags | (push_constant.flags & (FLAGS_DEFAULT_NORMAL_MAP_USED | FLAGS_DEFAULT_SPECULAR_MAP_USED)); //reset on each command for sanity, keep canvastexture binding config
 
 		switch (c->type) {
@@ -545,6 +602,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 				RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 				RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
 				RD::get_singleton()->draw_list_draw(p_draw_list, true);
+				info.draw_calls++;
 
 			} break;
 
@@ -609,6 +667,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 				RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 				RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
 				RD::get_singleton()->draw_list_draw(p_draw_list, true);
+				info.draw_calls++;
 
 				//restore if overrided
 				push_constant.color_texture_pixel_size[0] = texpixel_size.x;
@@ -654,6 +713,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 					RD::get_singleton()->draw_list_bind_index_array(p_draw_list, pb->indices);
 				}
 				RD::get_singleton()->draw_list_draw(p_draw_list, pb->indices.is_valid());
+				info.draw_calls++;
 
 			} break;
 			case Item::Command::TYPE_PRIMITIVE: {
@@ -684,6 +744,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 				}
 				RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 				RD::get_singleton()->draw_list_draw(p_draw_list, true);
+				info.draw_calls++;
 
 				if (primitive->point_count == 4) {
 					for (uint32_t j = 1; j < 3; j++) {
@@ -699,6 +760,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 
 					RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 					RD::get_singleton()->draw_list_draw(p_draw_list, true);
+					info.draw_calls++;
 				}
 
 			} break;
@@ -820,6 +882,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 					RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 
 					RD::get_singleton()->draw_list_draw(p_draw_list, index_array.is_valid(), instance_count);
+					info.draw_calls++;
 				}
 
 				for (int j = 0; j < 6; j++) {
@@ -858,6 +921,370 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 	}
 }
 
+bool RendererCanvasRenderRD::_item_is_lit(const Item *p_item, Light *p_lights) const {
+	if (using_directional_lights) {
+		return true;
+	}
+
+	Light *light = p_lights;
+	while (light) {
+		if (light->render_index_cache >= 0 && p_item->light_mask & light->item_mask && p_item->z_final >= light->z_min && p_item->z_final <= light->z_max && p_item->global_rect_cache.intersects_transformed(light->xform_cache, light->rect_cache)) {
+			return true;
+		}
+		light = light->next_ptr;
+	}
+
+	return false;
+}
+
+bool RendererCanvasRenderRD::_get_command_batch_texture(const Item::Command *p_command, RID &r_texture) const {
+	switch (p_command->type) {
+		case Item::Command::TYPE_RECT: {
+			const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(p_command);
+			if (rect->flags & CANVAS_RECT_CLIP_UV) {
+				return false; //clamping needs the source rect in the shader
+			}
+			r_texture = rect->texture;
+			return true;
+		}
+		case Item::Command::TYPE_NINEPATCH: {
+			const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(p_command);
+			if (np->axis_x != RS::NINE_PATCH_STRETCH || np->axis_y != RS::NINE_PATCH_STRETCH) {
+				return false; //tiling is resolved per pixel in the shader
+			}
+			Size2 size = np->rect.size.abs();
+			if (np->margin[SIDE_LEFT] + np->margin[SIDE_RIGHT] > size.width || np->margin[SIDE_TOP] + np->margin[SIDE_BOTTOM] > size.height) {
+				return false; //overlapping margins can't be split into nine rects
+			}
+			r_texture = np->texture;
+			return true;
+		}
+		case Item::Command::TYPE_POLYGON: {
+			const Item::CommandPolygon *polygon = static_cast<const Item::CommandPolygon *>(p_command);
+			if (polygon->primitive != RS::PRIMITIVE_TRIANGLES) {
+				return false;
+			}
+			const PolygonBuffers *pb = polygon_buffers.polygons.getptr(polygon->polygon.polygon_id);
+			if (!pb || pb->batch_indices.is_empty()) {
+				return false;
+			}
+			r_texture = polygon->texture;
+			return true;
+		}
+		default: {
+			return false;
+		}
+	}
+}
+
+void RendererCanvasRenderRD::_batch_command(const Item::Command *p_command, const Transform2D &p_xform, const Color &p_modulate, const Size2 &p_texpixel_size) {
+	LocalVector<BatchVertex> &vertices = batching.vertices;
+	LocalVector<uint32_t> &indices = batching.indices;
+
+	auto add_vertex = [&](const Vector2 &p_vertex, const Color &p_color, const Vector2 &p_uv) {
+		BatchVertex v;
+		Vector2 vertex = p_xform.xform(p_vertex);
+		v.vertex[0] = vertex.x;
+		v.vertex[1] = vertex.y;
+		v.color[0] = p_color.r;
+		v.color[1] = p_color.g;
+		v.color[2] = p_color.b;
+		v.color[3] = p_color.a;
+		v.uv[0] = p_uv.x;
+		v.uv[1] = p_uv.y;
+		vertices.push_back(v);
+	};
+
+	auto add_quad_indices = [&](uint32_t p_base) {
+		indices.push_back(p_base + 0);
+		indices.push_back(p_base + 1);
+		indices.push_back(p_base + 2);
+		indices.push_back(p_base + 0);
+		indices.push_back(p_base + 2);
+		indices.push_back(p_base + 3);
+	};
+
+	switch (p_command->type) {
+		case Item::Command::TYPE_RECT: {
+			const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(p_command);
+
+			//same vertex and uv layout as the quad shader variant
+			Rect2 src_rect(0, 0, 1, 1);
+			Rect2 dst_rect = rect->rect.abs();
+			bool transpose = false;
+
+			if (rect->texture != RID()) {
+				if (rect->flags & CANVAS_RECT_REGION) {
+					src_rect = Rect2(rect->source.position * p_texpixel_size, rect->source.size * p_texpixel_size);
+				}
+				if (rect->flags & CANVAS_RECT_FLIP_H) {
+					src_rect.size.x *= -1;
+				}
+				if (rect->flags & CANVAS_RECT_FLIP_V) {
+					src_rect.size.y *= -1;
+				}
+				transpose = rect->flags & CANVAS_RECT_TRANSPOSE;
+			}
+
+			Color color = rect->modulate * p_modulate;
+			static const Vector2 corners[4] = { Vector2(0, 0), Vector2(0, 1), Vector2(1, 1), Vector2(1, 0) };
+
+			uint32_t base = vertices.size();
+			for (int i = 0; i < 4; i++) {
+				const Vector2 &corner = corners[i];
+				Vector2 flipped(src_rect.size.x < 0 ? 1.0 - corner.x : corner.x, src_rect.size.y < 0 ? 1.0 - corner.y : corner.y);
+				Vector2 uv_corner = transpose ? Vector2(corner.y, corner.x) : corner;
+				add_vertex(dst_rect.position + dst_rect.size * flipped, color, src_rect.position + src_rect.size.abs() * uv_corner);
+			}
+			add_quad_indices(base);
+
+		} break;
+		case Item::Command::TYPE_NINEPATCH: {
+			const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(p_command);
+
+			//split into (up to) nine rects, each stretching linearly like the ninepatch shader variant does
+			Rect2 src_rect(0, 0, 1, 1);
+			Size2 pixel_size = p_texpixel_size;
+
+			if (np->texture != RID() && np->source != Rect2()) {
+				src_rect = Rect2(np->source.position * p_texpixel_size, np->source.size * p_texpixel_size);
+				pixel_size = Size2(1.0 / np->source.size.width, 1.0 / np->source.size.height);
+			}
+
+			Size2 size = np->rect.size.abs();
+			const float xs[4] = { 0, np->margin[SIDE_LEFT], size.width - np->margin[SIDE_RIGHT], size.width };
+			const float ys[4] = { 0, np->margin[SIDE_TOP], size.height - np->margin[SIDE_BOTTOM], size.height };
+			const float us[4] = { 0, np->margin[SIDE_LEFT] * pixel_size.width, 1.0f - np->margin[SIDE_RIGHT] * pixel_size.width, 1 };
+			const float vs[4] = { 0, np->margin[SIDE_TOP] * pixel_size.height, 1.0f - np->margin[SIDE_BOTTOM] * pixel_size.height, 1 };
+
+			Color color = np->color * p_modulate;
+
+			for (int y = 0; y < 3; y++) {
+				for (int x = 0; x < 3; x++) {
+					if (x == 1 && y == 1 && !np->draw_center) {
+						continue;
+					}
+
+					uint32_t base = vertices.size();
+					add_vertex(np->rect.position + Vector2(xs[x], ys[y]), color, src_rect.position + Vector2(us[x], vs[y]) * src_rect.size);
+					add_vertex(np->rect.position + Vector2(xs[x], ys[y + 1]), color, src_rect.position + Vector2(us[x], vs[y + 1]) * src_rect.size);
+					add_vertex(np->rect.position + Vector2(xs[x + 1], ys[y + 1]), color, src_rect.position + Vector2(us[x + 1], vs[y + 1]) * src_rect.size);
+					add_vertex(np->rect.position + Vector2(xs[x + 1], ys[y]), color, src_rect.position + Vector2(us[x + 1], vs[y]) * src_rect.size);
+					add_quad_indices(base);
+				}
+			}
+
+		} break;
+		case Item::Command::TYPE_POLYGON: {
+			const Item::CommandPolygon *polygon = static_cast<const Item::CommandPolygon *>(p_command);
+			const PolygonBuffers *pb = polygon_buffers.polygons.getptr(polygon->polygon.polygon_id);
+			ERR_FAIL_COND(!pb);
+
+			//vertex colors are used as they are, like in the unbatched attribute pipeline
+			uint32_t base = vertices.size();
+			for (uint32_t i = 0; i < pb->batch_vertices.size(); i++) {
+				BatchVertex v = pb->batch_vertices[i];
+				Vector2 vertex = p_xform.xform(Vector2(v.vertex[0], v.vertex[1]));
+				v.vertex[0] = vertex.x;
+				v.vertex[1] = vertex.y;
+				vertices.push_back(v);
+			}
+			for (uint32_t i = 0; i < pb->batch_indices.size(); i++) {
+				indices.push_back(base + pb->batch_indices[i]);
+			}
+
+		} break;
+		default: {
+		}
+	}
+}
+
+void RendererCanvasRenderRD::_flush_batch(Batch &r_batch, uint32_t &r_command_count, uint32_t p_vertex_start) {
+	if (r_command_count > 1) {
+		r_batch.index_count = batching.indices.size() - r_batch.index_offset;
+		batching.batches.push_back(r_batch);
+	} else if (r_command_count == 1) {
+		//a single command is drawn as usual, drop its geometry
+		batching.vertices.resize(p_vertex_start);
+		batching.indices.resize(r_batch.index_offset);
+	}
+
+	r_command_count = 0;
+}
+
+void RendererCanvasRenderRD::_prepare_batches(int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights) {
+	batching.vertices.clear();
+	batching.indices.clear();
+	batching.batches.clear();
+	batching.current_batch = 0;
+	batching.skipping = false;
+
+	if (!batching.enabled) {
+		return;
+	}
+
+	Batch batch;
+	uint32_t batch_commands = 0;
+	uint32_t batch_vertex_start = 0;
+	RID batch_texture;
+	const Item *batch_clip = nullptr;
+	RS::CanvasItemTextureFilter batch_filter = default_filter;
+	RS::CanvasItemTextureRepeat batch_repeat = default_repeat;
+
+	for (int i = 0; i < p_item_count; i++) {
+		const Item *ci = items[i];
+
+		RS::CanvasItemTextureFilter filter = ci->texture_filter != RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT ? ci->texture_filter : default_filter;
+		RS::CanvasItemTextureRepeat repeat = ci->texture_repeat != RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT ? ci->texture_repeat : default_repeat;
+
+		//only the default unlit pipeline is batched, as custom shaders and normal maps may depend on per item state
+		bool batchable = ci->material.is_null() && ci->canvas_group == nullptr && !_item_is_lit(ci, p_lights);
+
+		if (!batchable || ci->final_clip_owner != batch_clip || filter != batch_filter || repeat != batch_repeat) {
+			_flush_batch(batch, batch_commands, batch_vertex_start);
+		}
+
+		if (!batchable) {
+			continue;
+		}
+
+		Transform2D base_transform = p_canvas_transform_inverse * ci->final_transform;
+		Transform2D xform = base_transform;
+		bool clip_ignored = false;
+
+		for (const Item::Command *c = ci->commands; c; c = c->next) {
+			if (c->type == Item::Command::TYPE_TRANSFORM) {
+				xform = base_transform * static_cast<const Item::CommandTransform *>(c)->xform;
+				continue;
+			}
+
+			if (c->type == Item::Command::TYPE_CLIP_IGNORE) {
+				clip_ignored = static_cast<const Item::CommandClipIgnore *>(c)->ignore;
+			}
+
+			RID texture;
+			if (!_get_command_batch_texture(c, texture)) {
+				_flush_batch(batch, batch_commands, batch_vertex_start);
+				continue;
+			}
+
+			if (texture.is_null()) {
+				texture = default_canvas_texture;
+			}
+
+			if (texture != batch_texture) {
+				_flush_batch(batch, batch_commands, batch_vertex_start);
+			}
+
+			if (batch_commands == 0) {
+				Size2i size;
+				Color specular_shininess;
+				bool use_normal;
+				bool use_specular;
+				if (!storage->canvas_texture_get_uniform_set(texture, filter, repeat, shader.default_version_rd_shader, CANVAS_TEXTURE_UNIFORM_SET, batch.uniform_set, size, specular_shininess, use_normal, use_specular)) {
+					batch_texture = RID();
+					continue;
+				}
+
+				batch.first_command = c;
+				batch.texpixel_size = Size2(1.0 / float(size.x), 1.0 / float(size.y));
+				batch.index_offset = batching.indices.size();
+				batch_vertex_start = batching.vertices.size();
+				batch_texture = texture;
+				batch_clip = ci->final_clip_owner;
+				batch_filter = filter;
+				batch_repeat = repeat;
+			}
+
+			_batch_command(c, xform, ci->final_modulate, batch.texpixel_size);
+			batch.last_command = c;
+			batch_commands++;
+		}
+
+		//the batch is drawn with this item's scissor state, so it can't carry unclipped commands into the next item
+		if (clip_ignored) {
+			_flush_batch(batch, batch_commands, batch_vertex_start);
+		}
+	}
+
+	_flush_batch(batch, batch_commands, batch_vertex_start);
+}
+
+void RendererCanvasRenderRD::_upload_batches() {
+	if (batching.batches.is_empty()) {
+		return;
+	}
+
+	uint32_t vertex_count = batching.vertices.size();
+	uint32_t index_count = batching.indices.size();
+
+	if (vertex_count > batching.vertex_capacity || index_count > batching.index_capacity) {
+		if (batching.vertex_buffer.is_valid()) {
+			RD::get_singleton()->free(batching.vertex_array);
+			RD::get_singleton()->free(batching.vertex_buffer);
+			RD::get_singleton()->free(batching.index_buffer);
+		}
+
+		batching.vertex_capacity = MAX(MAX(batching.vertex_capacity, (uint32_t)BATCH_DEFAULT_VERTEX_CAPACITY), next_power_of_2(vertex_count));
+		batching.index_capacity = MAX(MAX(batching.index_capacity, batching.vertex_capacity * 3 / 2), next_power_of_2(index_count));
+
+		batching.vertex_buffer = RD::get_singleton()->vertex_buffer_create(batching.vertex_capacity * sizeof(BatchVertex));
+		// Debug builds validate draws against the highest index of the initial data, and treat
+		// a buffer created without data as referencing every vertex. Start from zeros.
+		Vector<uint8_t> index_data;
+		index_data.resize(batching.index_capacity * sizeof(uint32_t));
+		memset(index_data.ptrw(), 0, index_data.size());
+		batching.index_buffer = RD::get_singleton()->index_buffer_create(batching.index_capacity, RD::INDEX_BUFFER_FORMAT_UINT32, index_data);
+
+		Vector<RID> buffers;
+		buffers.push_back(batching.vertex_buffer);
+		buffers.push_back(batching.vertex_buffer);
+		buffers.push_back(batching.vertex_buffer);
+		buffers.push_back(storage->mesh_get_default_rd_buffer(RendererStorageRD::DEFAULT_RD_BUFFER_BONES));
+		buffers.push_back(storage->mesh_get_default_rd_buffer(RendererStorageRD::DEFAULT_RD_BUFFER_BONES));
+
+		batching.vertex_array = RD::get_singleton()->vertex_array_create(batching.vertex_capacity, batching.vertex_format, buffers);
+	}
+
+	RD::get_singleton()->buffer_update(batching.vertex_buffer, 0, vertex_count * sizeof(BatchVertex), batching.vertices.ptr());
+	RD::get_singleton()->buffer_update(batching.index_buffer, 0, index_count * sizeof(uint32_t), batching.indices.ptr());
+}
+
+void RendererCanvasRenderRD::_render_batch(RD::DrawListID p_draw_list, const Batch &p_batch, RD::FramebufferFormatID p_framebuffer_format) {
+	RID pipeline = shader.pipeline_variants.variants[PIPELINE_LIGHT_MODE_DISABLED][PIPELINE_VARIANT_ATTRIBUTE_TRIANGLES].get_render_pipeline(batching.vertex_format, p_framebuffer_format);
+	RD::get_singleton()->draw_list_bind_render_pipeline(p_draw_list, pipeline);
+	RD::get_singleton()->draw_list_bind_uniform_set(p_draw_list, p_batch.uniform_set, CANVAS_TEXTURE_UNIFORM_SET);
+
+	//vertices are already in canvas space, with modulation baked in
+	PushConstant push_constant;
+	_update_transform_2d_to_mat2x3(Transform2D(), push_constant.world);
+	push_constant.flags = 0;
+	push_constant.specular_shininess = 0;
+
+	for (int i = 0; i < 4; i++) {
+		push_constant.modulation[i] = 1;
+		push_constant.ninepatch_margins[i] = 0;
+		push_constant.src_rect[i] = 0;
+		push_constant.dst_rect[i] = 0;
+		push_constant.lights[i] = 0;
+	}
+	push_constant.pad[0] = 0;
+	push_constant.pad[1] = 0;
+	push_constant.color_texture_pixel_size[0] = p_batch.texpixel_size.x;
+	push_constant.color_texture_pixel_size[1] = p_batch.texpixel_size.y;
+
+	RID index_array = RD::get_singleton()->index_array_create(batching.index_buffer, p_batch.index_offset, p_batch.index_count);
+	batching.index_arrays.push_back(index_array);
+
+	RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
+	RD::get_singleton()->draw_list_bind_vertex_array(p_draw_list, batching.vertex_array);
+	RD::get_singleton()->draw_list_bind_index_array(p_draw_list, index_array);
+	RD::get_singleton()->draw_list_draw(p_draw_list, true);
+
+	info.batches++;
+	info.draw_calls++;
+}
+
 RID RendererCanvasRenderRD::_create_base_uniform_set(RID p_to_render_target, bool p_backbuffer) {
 	//re create canvas state
 	Vector<RD::Uniform> uniforms;
@@ -1002,6 +1429,10 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 
 	RD::FramebufferFormatID fb_format = RD::get_singleton()->framebuffer_get_format(framebuffer);
 
+	//buffers can't be updated while a draw list is open, so batch geometry is built up front
+	_prepare_batches(p_item_count, canvas_transform_inverse, p_lights);
+	_upload_batches();
+
 	RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(framebuffer, clear ? RD::INITIAL_ACTION_CLEAR : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_DISCARD, clear_colors);
 
 	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, fb_uniform_set, BASE_UNIFORM_SET);
@@ -1058,12 +1489,23 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 	}
 
 	RD::get_singleton()->draw_list_end();
+
+	for (uint32_t i = 0; i < batching.index_arrays.size(); i++) {
+		RD::get_singleton()->free(batching.index_arrays[i]);
+	}
+	batching.index_arrays.clear();
 }
 
 void RendererCanvasRenderRD::canvas_render_items(RID p_to_render_target, Item *p_item_list, const Color &p_modulate, Light *p_light_list, Light *p_directional_light_list, const Transform2D &p_canvas_transform, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, bool &r_sdf_used) {
 	r_sdf_used = false;
 	int item_count = 0;
 
+	if (info_frame != RendererCompositorRD::singleton->get_frame_number()) {
+		info_frame = RendererCompositorRD::singleton->get_frame_number();
+		last_frame_info = info;
+		info = Info();
+	}
+
 	//setup canvas state uniforms if needed
 
 	Transform2D canvas_transform_inverse = p_canvas_transform.affine_inverse();
@@ -2248,6 +2690,20 @@ void RendererCanvasRenderRD::set_time(double p_time) {
 void RendererCanvasRenderRD::update() {
 }
 
+uint64_t RendererCanvasRenderRD::get_render_info(RS::RenderInfo p_info) {
+	switch (p_info) {
+		case RS::INFO_2D_BATCHES_IN_FRAME: {
+			return last_frame_info.batches;
+		}
+		case RS::INFO_2D_DRAW_CALLS_IN_FRAME: {
+			return last_frame_info.draw_calls;
+		}
+		default: {
+			return 0;
+		}
+	}
+}
+
 RendererCanvasRenderRD::RendererCanvasRenderRD(RendererStorageRD *p_storage) {
 	storage = p_storage;
 
@@ -2531,6 +2987,39 @@ RendererCanvasRenderRD::RendererCanvasRenderRD(RendererStorageRD *p_storage) {
 		shader.quad_index_array = RD::get_singleton()->index_array_create(shader.quad_index_buffer, 0, 6);
 	}
 
+	{ //batching, same attribute layout as polygons
+		Vector<RD::VertexAttribute> attributes;
+
+		RD::VertexAttribute vd;
+		vd.format = RD::DATA_FORMAT_R32G32_SFLOAT;
+		vd.offset = offsetof(BatchVertex, vertex);
+		vd.location = RS::ARRAY_VERTEX;
+		vd.stride = sizeof(BatchVertex);
+		attributes.push_back(vd);
+
+		vd.format = RD::DATA_FORMAT_R32G32B32A32_SFLOAT;
+		vd.offset = offsetof(BatchVertex, color);
+		vd.location = RS::ARRAY_COLOR;
+		attributes.push_back(vd);
+
+		vd.format = RD::DATA_FORMAT_R32G32_SFLOAT;
+		vd.offset = offsetof(BatchVertex, uv);
+		vd.location = RS::ARRAY_TEX_UV;
+		attributes.push_back(vd);
+
+		vd.format = RD::DATA_FORMAT_R32G32B32A32_UINT;
+		vd.offset = 0;
+		vd.location = RS::ARRAY_BONES;
+		vd.stride = 0;
+		attributes.push_back(vd);
+
+		vd.format = RD::DATA_FORMAT_R32G32B32A32_SFLOAT;
+		vd.location = RS::ARRAY_WEIGHTS;
+		attributes.push_back(vd);
+
+		batching.vertex_format = RD::get_singleton()->vertex_format_create(attributes);
+	}
+
 	{ //primitive
 		primitive_arrays.index_array[0] = shader.quad_index_array = RD::get_singleton()->index_array_create(shader.quad_index_buffer, 0, 1);
 		primitive_arrays.index_array[1] = shader.quad_index_array = RD::get_singleton()->index_array_create(shader.quad_index_buffer, 0, 2);
@@ -2578,6 +3067,7 @@ RendererCanvasRenderRD::RendererCanvasRenderRD(RendererStorageRD *p_storage) {
 	storage->canvas_texture_initialize(default_canvas_texture);
 
 	state.shadow_texture_size = GLOBAL_GET("rendering/2d/shadow_atlas/size");
+	batching.enabled = GLOBAL_GET("rendering/2d/batching/enabled");
 
 	//create functions for shader and material
 	storage->shader_set_data_request_function(RendererStorageRD::SHADER_TYPE_2D, _create_shader_funcs);
@@ -2677,6 +3167,12 @@ RendererCanvasRenderRD::~RendererCanvasRenderRD() {
 		//primitives are erase by dependency
 	}
 
+	if (batching.vertex_buffer.is_valid()) {
+		RD::get_singleton()->free(batching.vertex_array);
+		RD::get_singleton()->free(batching.vertex_buffer);
+		RD::get_singleton()->free(batching.index_buffer);
+	}
+
 	if (state.shadow_fb.is_valid()) {
 		RD::get_singleton()->free(state.shadow_depth_texture);
 	}
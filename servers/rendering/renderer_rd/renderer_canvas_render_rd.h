@@ -105,7 +105,9 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 		MAX_RENDER_ITEMS = 256 * 1024,
 		MAX_LIGHT_TEXTURES = 1024,
 		MAX_LIGHTS_PER_ITEM = 16,
-		DEFAULT_MAX_LIGHTS_PER_RENDER = 256
+		DEFAULT_MAX_LIGHTS_PER_RENDER = 256,
+		BATCH_POLYGON_MAX_VERTICES = 128,
+		BATCH_DEFAULT_VERTEX_CAPACITY = 16384
 	};
 
 	/****************/
@@ -229,12 +231,22 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 	/**** POLYGONS ****/
 	/******************/
 
+	struct BatchVertex {
+		float vertex[2];
+		float color[4];
+		float uv[2];
+	};
+
 	struct PolygonBuffers {
 		RD::VertexFormatID vertex_format_id;
 		RID vertex_buffer;
 		RID vertex_array;
 		RID index_buffer;
 		RID indices;
+
+		//CPU copy of small unskinned polygons, so they can be merged into batches
+		LocalVector<BatchVertex> batch_vertices;
+		LocalVector<uint32_t> batch_indices;
 	};
 
 	struct {
@@ -382,6 +394,49 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 
 	} state;
 
+	/******************/
+	/**** BATCHING ****/
+	/******************/
+
+	//consecutive rects, nine-patches and polygons sharing texture, clip and default material
+	//are transformed on the CPU and drawn from a streamed vertex buffer with a single draw call
+	struct Batch {
+		const Item::Command *first_command = nullptr;
+		const Item::Command *last_command = nullptr;
+		RID uniform_set;
+		Size2 texpixel_size;
+		uint32_t index_offset = 0;
+		uint32_t index_count = 0;
+	};
+
+	struct {
+		bool enabled = true;
+
+		RD::VertexFormatID vertex_format = RD::INVALID_ID;
+		RID vertex_buffer;
+		RID vertex_array;
+		RID index_buffer;
+		uint32_t vertex_capacity = 0;
+		uint32_t index_capacity = 0;
+
+		LocalVector<BatchVertex> vertices;
+		LocalVector<uint32_t> indices;
+		LocalVector<Batch> batches;
+		LocalVector<RID> index_arrays;
+
+		uint32_t current_batch = 0;
+		bool skipping = false;
+	} batching;
+
+	struct Info {
+		uint64_t batches = 0;
+		uint64_t draw_calls = 0;
+	};
+
+	Info info;
+	Info last_frame_info;
+	uint64_t info_frame = 0;
+
 	struct PushConstant {
 		float world[6];
 		uint32_t flags;
@@ -428,6 +483,14 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 	void _render_item(RenderingDevice::DrawListID p_draw_list, const Item *p_item, RenderingDevice::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants);
 	void _render_items(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights, bool p_to_backbuffer = false);
 
+	bool _item_is_lit(const Item *p_item, Light *p_lights) const;
+	bool _get_command_batch_texture(const Item::Command *p_command, RID &r_texture) const;
+	void _batch_command(const Item::Command *p_command, const Transform2D &p_xform, const Color &p_modulate, const Size2 &p_texpixel_size);
+	void _flush_batch(Batch &r_batch, uint32_t &r_command_count, uint32_t p_vertex_start);
+	void _prepare_batches(int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights);
+	void _upload_batches();
+	void _render_batch(RD::DrawListID p_draw_list, const Batch &p_batch, RD::FramebufferFormatID p_framebuffer_format);
+
 	_FORCE_INLINE_ void _update_transform_2d_to_mat2x4(const Transform2D &p_transform, float *p_mat2x4);
 	_FORCE_INLINE_ void _update_transform_2d_to_mat2x3(const Transform2D &p_transform, float *p_mat2x3);
 
@@ -463,6 +526,9 @@ public:
 	void set_time(double p_time);
 	void update();
 	bool free(RID p_rid);
+
+	uint64_t get_render_info(RS::RenderInfo p_info);
+
 	RendererCanvasRenderRD(RendererStorageRD *p_storage);
 	~RendererCanvasRenderRD();
 };
@@ -158,6 +158,10 @@ RendererCompositorRD::RendererCompositorRD() {
 	singleton = this;
 	time = 0;
 
+	if (GLOBAL_GET("rendering/shader_compiler/shader_cache/enabled")) {
+		ShaderRD::set_shader_cache_dir(GLOBAL_GET("rendering/shader_compiler/shader_cache/path"));
+	}
+
 	storage = memnew(RendererStorageRD);
 	canvas = memnew(RendererCanvasRenderRD(storage));
 
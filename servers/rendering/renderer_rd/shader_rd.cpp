@@ -30,9 +30,22 @@
 
 #include "shader_rd.h"
 
+#include "core/config/project_settings.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/thread.h"
+#include "core/version.h"
+#include "core/version_hash.gen.h"
 #include "renderer_compositor_rd.h"
 #include "servers/rendering/rendering_device.h"
 
+#define SHADER_CACHE_MAGIC "GDSC"
+#define SHADER_CACHE_FORMAT_VERSION 1
+#define SHADER_CACHE_KEY_LENGTH 16
+
+String ShaderRD::shader_cache_dir;
+String ShaderRD::shader_cache_key;
+
 void ShaderRD::_add_stage(const char *p_code, StageType p_stage_type) {
 	Vector<String> lines = String(p_code).split("\n");
 
@@ -178,6 +191,74 @@ void ShaderRD::_build_variant_code(StringBuilder &builder, uint32_t p_variant, c
 	}
 }
 
+String ShaderRD::_get_cache_dir() const {
+	return shader_cache_dir.plus_file(String(name).to_lower());
+}
+
+Vector<uint8_t> ShaderRD::_load_from_cache(const String &p_path) {
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	if (!f) {
+		return Vector<uint8_t>();
+	}
+
+	Vector<uint8_t> spir_v;
+	char magic[4];
+	f->get_buffer((uint8_t *)magic, 4);
+	uint32_t format_version = f->get_32();
+	uint32_t size = f->get_32();
+	//a truncated or foreign file is treated as a miss and gets overwritten
+	if (memcmp(magic, SHADER_CACHE_MAGIC, 4) == 0 && format_version == SHADER_CACHE_FORMAT_VERSION && size > 0 && f->get_len() == 12 + uint64_t(size)) {
+		spir_v.resize(size);
+		if (f->get_buffer(spir_v.ptrw(), size) != size) {
+			spir_v.clear();
+		}
+	}
+
+	memdelete(f);
+	return spir_v;
+}
+
+void ShaderRD::_save_to_cache(const String &p_path, const Vector<uint8_t> &p_spir_v) {
+	//variants are compiled in parallel, so write to a private file and move it in place once complete
+	String tmp_path = p_path + "." + itos(Thread::get_caller_id()) + ".tmp";
+	FileAccess *f = FileAccess::open(tmp_path, FileAccess::WRITE);
+	if (!f) {
+		return;
+	}
+	f->store_buffer((const uint8_t *)SHADER_CACHE_MAGIC, 4);
+	f->store_32(SHADER_CACHE_FORMAT_VERSION);
+	f->store_32(p_spir_v.size());
+	f->store_buffer(p_spir_v.ptr(), p_spir_v.size());
+	bool ok = f->get_error() == OK;
+	memdelete(f);
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	if (!ok || da->rename(tmp_path, p_path) != OK) {
+		da->remove(tmp_path);
+	}
+	memdelete(da);
+}
+
+Vector<uint8_t> ShaderRD::_compile_stage(RD::ShaderStage p_stage, const String &p_source, String *r_error) {
+	String path;
+	if (shader_cache_dir != String()) {
+		//the source already contains all general, variant and custom defines
+		String hash = (shader_cache_key + itos(p_stage) + "\n" + p_source).sha256_text();
+		path = _get_cache_dir().plus_file(hash + ".spv");
+
+		Vector<uint8_t> spir_v = _load_from_cache(path);
+		if (spir_v.size()) {
+			return spir_v;
+		}
+	}
+
+	Vector<uint8_t> spir_v = RD::get_singleton()->shader_compile_from_source(p_stage, p_source, RD::SHADER_LANGUAGE_GLSL, r_error);
+	if (spir_v.size() && path != String()) {
+		_save_to_cache(path, spir_v);
+	}
+	return spir_v;
+}
+
 void ShaderRD::_compile_variant(uint32_t p_variant, Version *p_version) {
 	if (!variants_enabled[p_variant]) {
 		return; //variant is disabled, return
@@ -198,7 +279,7 @@ void ShaderRD::_compile_variant(uint32_t p_variant, Version *p_version) {
 
 		current_source = builder.as_string();
 		RD::ShaderStageData stage;
-		stage.spir_v = RD::get_singleton()->shader_compile_from_source(RD::SHADER_STAGE_VERTEX, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
+		stage.spir_v = _compile_stage(RD::SHADER_STAGE_VERTEX, current_source, &error);
 		if (stage.spir_v.size() == 0) {
 			build_ok = false;
 		} else {
@@ -216,7 +297,7 @@ void ShaderRD::_compile_variant(uint32_t p_variant, Version *p_version) {
 
 		current_source = builder.as_string();
 		RD::ShaderStageData stage;
-		stage.spir_v = RD::get_singleton()->shader_compile_from_source(RD::SHADER_STAGE_FRAGMENT, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
+		stage.spir_v = _compile_stage(RD::SHADER_STAGE_FRAGMENT, current_source, &error);
 		if (stage.spir_v.size() == 0) {
 			build_ok = false;
 		} else {
@@ -235,7 +316,7 @@ void ShaderRD::_compile_variant(uint32_t p_variant, Version *p_version) {
 		current_source = builder.as_string();
 
 		RD::ShaderStageData stage;
-		stage.spir_v = RD::get_singleton()->shader_compile_from_source(RD::SHADER_STAGE_COMPUTE, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
+		stage.spir_v = _compile_stage(RD::SHADER_STAGE_COMPUTE, current_source, &error);
 		if (stage.spir_v.size() == 0) {
 			build_ok = false;
 		} else {
@@ -320,6 +401,13 @@ void ShaderRD::_compile_version(Version *p_version) {
 	p_version->dirty = false;
 
 	p_version->variants = memnew_arr(RID, variant_defines.size());
+
+	if (shader_cache_dir != String()) {
+		//create the directory before the variants race to do it
+		DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+		da->make_dir_recursive(_get_cache_dir());
+		memdelete(da);
+	}
 #if 1
 
 	RendererThreadPool::singleton->thread_work_pool.do_work(variant_defines.size(), this, &ShaderRD::_compile_variant, p_version);
@@ -443,6 +531,53 @@ bool ShaderRD::is_variant_enabled(int p_variant) const {
 	return variants_enabled[p_variant];
 }
 
+void ShaderRD::_remove_stale_cache_dirs(const String &p_base_dir, const String &p_current_dir) {
+	DirAccess *da = DirAccess::open(p_base_dir);
+	if (!da) {
+		return;
+	}
+
+	//only touch directories named like build keys, the path may be shared with other files
+	Vector<String> stale_dirs;
+	da->list_dir_begin();
+	String dir = da->get_next();
+	while (dir != String()) {
+		if (da->current_is_dir() && dir != p_current_dir && dir.length() == SHADER_CACHE_KEY_LENGTH && dir.is_valid_hex_number(false)) {
+			stale_dirs.push_back(dir);
+		}
+		dir = da->get_next();
+	}
+	da->list_dir_end();
+
+	for (int i = 0; i < stale_dirs.size(); i++) {
+		if (da->change_dir(p_base_dir.plus_file(stale_dirs[i])) == OK && da->erase_contents_recursive() == OK) {
+			da->change_dir(p_base_dir);
+			da->remove(stale_dirs[i]);
+		}
+	}
+	memdelete(da);
+}
+
+void ShaderRD::set_shader_cache_dir(const String &p_dir) {
+	if (p_dir == String()) {
+		shader_cache_dir = String();
+		return;
+	}
+
+	//entries are invalidated by engine (and thus glslang) upgrades as well as device or driver changes
+	shader_cache_key = String(VERSION_FULL_BUILD) + "|" + String(VERSION_HASH) + "|" + RD::get_singleton()->get_device_pipeline_cache_uuid() + "|" + itos(SHADER_CACHE_FORMAT_VERSION) + "|";
+
+	//each build key gets its own directory, so entries nothing can load anymore are dropped as a whole
+	String base_dir = ProjectSettings::get_singleton()->globalize_path(p_dir);
+	String key_dir = shader_cache_key.sha256_text().substr(0, SHADER_CACHE_KEY_LENGTH);
+	_remove_stale_cache_dirs(base_dir, key_dir);
+	shader_cache_dir = base_dir.plus_file(key_dir);
+}
+
+String ShaderRD::get_shader_cache_dir() {
+	return shader_cache_dir;
+}
+
 ShaderRD::ShaderRD() {
 	// Do not feel forced to use this, in most cases it makes little to no difference.
 	bool use_32_threads = false;
@@ -38,6 +38,7 @@
 #include "core/templates/map.h"
 #include "core/templates/rid_owner.h"
 #include "core/variant/variant.h"
+#include "servers/rendering/rendering_device.h"
 #include "servers/rendering_server.h"
 
 #include <stdio.h>
@@ -113,6 +114,16 @@ class ShaderRD {
 
 	void _add_stage(const char *p_code, StageType p_stage_type);
 
+	//on-disk SPIR-V cache, shared by all shaders
+	static String shader_cache_dir;
+	static String shader_cache_key;
+
+	String _get_cache_dir() const;
+	Vector<uint8_t> _compile_stage(RD::ShaderStage p_stage, const String &p_source, String *r_error);
+	static Vector<uint8_t> _load_from_cache(const String &p_path);
+	static void _save_to_cache(const String &p_path, const Vector<uint8_t> &p_spir_v);
+	static void _remove_stale_cache_dirs(const String &p_base_dir, const String &p_current_dir);
+
 protected:
 	ShaderRD();
 	void setup(const char *p_vertex_code, const char *p_fragment_code, const char *p_compute_code, const char *p_name);
@@ -151,6 +162,10 @@ public:
 	RS::ShaderNativeSourceCode version_get_native_source_code(RID p_version);
 
 	void initialize(const Vector<String> &p_variant_defines, const String &p_general_defines = "");
+
+	static void set_shader_cache_dir(const String &p_dir);
+	static String get_shader_cache_dir();
+
 	virtual ~ShaderRD();
 };
 
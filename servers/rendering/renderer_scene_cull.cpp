@@ -1104,9 +1104,46 @@ void RendererSceneCull::instance_geometry_set_material_override(RID p_instance,
 }
 
 void RendererSceneCull::instance_geometry_set_draw_range(RID p_instance, float p_min, float p_max, float p_min_margin, float p_max_margin) {
+	Instance *instance = instance_owner.getornull(p_instance);
+	ERR_FAIL_COND(!instance);
+	ERR_FAIL_COND(p_min < 0 || p_max < 0);
+
+	instance->lod_begin = p_min;
+	instance->lod_end = p_max;
+	instance->lod_begin_hysteresis = p_min_margin;
+	instance->lod_end_hysteresis = p_max_margin;
+
+	_instance_queue_update(instance, false, false);
 }
 
 void RendererSceneCull::instance_geometry_set_as_instance_lod(RID p_instance, RID p_as_lod_of_instance) {
+	Instance *instance = instance_owner.getornull(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	Instance *parent = nullptr;
+	if (p_as_lod_of_instance.is_valid()) {
+		parent = instance_owner.getornull(p_as_lod_of_instance);
+		ERR_FAIL_COND(!parent);
+		ERR_FAIL_COND_MSG(parent == instance, "An instance can't be its own LOD.");
+	}
+
+	if (instance->lod_parent == parent) {
+		return;
+	}
+
+	if (instance->lod_parent) {
+		instance->lod_parent->lod_children.erase(instance);
+		_instance_queue_update(instance->lod_parent, false, false);
+	}
+
+	instance->lod_parent = parent;
+
+	if (parent) {
+		parent->lod_children.insert(instance);
+		_instance_queue_update(parent, false, false);
+	}
+
+	_instance_queue_update(instance, false, false);
 }
 
 void RendererSceneCull::instance_geometry_set_lightmap(RID p_instance, RID p_lightmap, const Rect2 &p_lightmap_uv_scale, int p_slice_index) {
@@ -1210,6 +1247,21 @@ void RendererSceneCull::instance_geometry_get_shader_parameter_list(RID p_instan
 }
 
 void RendererSceneCull::_update_instance(Instance *p_instance) {
+	_update_instance_transformed_aabb(p_instance);
+	if (_update_instance_transform(p_instance)) {
+		_update_instance_indexer(p_instance);
+		_update_instance_pairs(p_instance);
+	}
+}
+
+void RendererSceneCull::_update_instance_transformed_aabb(Instance *p_instance) {
+	//only touches the instance itself, so it can run on any thread
+	if (!p_instance->aabb.has_no_surface()) {
+		p_instance->transformed_aabb = p_instance->transform.xform(p_instance->aabb);
+	}
+}
+
+bool RendererSceneCull::_update_instance_transform(Instance *p_instance) {
 	p_instance->version++;
 
 	if (p_instance->base_type == RS::INSTANCE_LIGHT) {
@@ -1274,7 +1326,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 	}
 
 	if (p_instance->aabb.has_no_surface()) {
-		return;
+		return false;
 	}
 
 	if (p_instance->base_type == RS::INSTANCE_LIGHTMAP) {
@@ -1288,10 +1340,6 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		}
 	}
 
-	AABB new_aabb;
-	new_aabb = p_instance->transform.xform(p_instance->aabb);
-	p_instance->transformed_aabb = new_aabb;
-
 	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
 		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
 		//make sure lights are updated if it casts shadow
@@ -1320,9 +1368,13 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 	// note: we had to remove is equal approx check here, it meant that det == 0.000004 won't work, which is the case for some of our scenes.
 	if (p_instance->scenario == nullptr || !p_instance->visible || p_instance->transform.basis.determinant() == 0) {
 		p_instance->prev_transformed_aabb = p_instance->transformed_aabb;
-		return;
+		return false;
 	}
 
+	return true;
+}
+
+void RendererSceneCull::_update_instance_indexer(Instance *p_instance) {
 	//quantize to improve moving object performance
 	AABB bvh_aabb = p_instance->transformed_aabb;
 
@@ -1413,6 +1465,149 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
 	}
 
+	_update_instance_visibility(p_instance);
+}
+
+void RendererSceneCull::_update_instance_visibility(Instance *p_instance) {
+	bool uses_visibility = ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) && (p_instance->lod_begin > 0 || p_instance->lod_end > 0 || p_instance->lod_parent || p_instance->lod_children.size());
+	if (!uses_visibility) {
+		_remove_instance_visibility(p_instance);
+		return;
+	}
+
+	Scenario *scenario = p_instance->scenario;
+	if (p_instance->visibility_index == -1) {
+		p_instance->visibility_index = scenario->instance_visibility.size();
+		scenario->instance_visibility.push_back(InstanceVisibilityData());
+		scenario->instance_data[p_instance->array_index].visibility_index = p_instance->visibility_index;
+	}
+
+	InstanceVisibilityData &vd = scenario->instance_visibility[p_instance->visibility_index];
+	vd.instance = p_instance;
+	vd.position = p_instance->transformed_aabb.position + p_instance->transformed_aabb.size * 0.5;
+	vd.range_begin = p_instance->lod_begin;
+	vd.range_end = p_instance->lod_end;
+	vd.range_begin_margin = p_instance->lod_begin_hysteresis;
+	vd.range_end_margin = p_instance->lod_end_hysteresis;
+}
+
+void RendererSceneCull::_remove_instance_visibility(Instance *p_instance) {
+	if (p_instance->visibility_index == -1) {
+		return;
+	}
+
+	Scenario *scenario = p_instance->scenario;
+
+	//replace this by last
+	int32_t swap_with_index = scenario->instance_visibility.size() - 1;
+	if (swap_with_index != p_instance->visibility_index) {
+		Instance *swapped = scenario->instance_visibility[swap_with_index].instance;
+		swapped->visibility_index = p_instance->visibility_index;
+		scenario->instance_data[swapped->array_index].visibility_index = p_instance->visibility_index;
+		scenario->instance_visibility[p_instance->visibility_index] = scenario->instance_visibility[swap_with_index];
+	}
+
+	scenario->instance_visibility.resize(swap_with_index);
+
+	for (uint32_t i = 0; i < scenario->viewport_visibility_states.size(); i++) {
+		LocalVector<uint8_t> &states = scenario->viewport_visibility_states[i].states;
+		if (states.size() > (uint32_t)swap_with_index) {
+			states[p_instance->visibility_index] = states[swap_with_index];
+			states.resize(swap_with_index);
+		} else if (states.size() > (uint32_t)p_instance->visibility_index) {
+			//the swapped in entry has no state for this viewport yet, it's added back with the default one
+			states.resize(p_instance->visibility_index);
+		}
+	}
+
+	if (p_instance->array_index != -1) {
+		scenario->instance_data[p_instance->array_index].visibility_index = -1;
+	}
+	p_instance->visibility_index = -1;
+}
+
+void RendererSceneCull::_scenario_update_visibility(Scenario *p_scenario, const Vector3 &p_camera_position, RID p_viewport) {
+	InstanceVisibilityData *visibility = p_scenario->instance_visibility.ptr();
+	uint32_t visibility_count = p_scenario->instance_visibility.size();
+
+	//the hysteresis margins depend on the previous state for the same viewport, passes without one (reflection probes) don't use them
+	uint8_t *states = nullptr;
+	if (p_viewport.is_valid()) {
+		uint64_t frame = RSG::rasterizer->get_frame_number();
+		LocalVector<ViewportVisibilityStates> &viewport_states = p_scenario->viewport_visibility_states;
+		for (int i = viewport_states.size() - 1; i >= 0; i--) {
+			if (viewport_states[i].viewport != p_viewport && viewport_states[i].last_frame + VIEWPORT_VISIBILITY_STATES_MAX_AGE < frame) {
+				//viewport no longer renders this scenario (or was freed)
+				viewport_states.remove_unordered(i);
+			}
+		}
+		ViewportVisibilityStates *vs = nullptr;
+		for (uint32_t i = 0; i < viewport_states.size(); i++) {
+			if (viewport_states[i].viewport == p_viewport) {
+				vs = &viewport_states[i];
+				break;
+			}
+		}
+		if (!vs) {
+			viewport_states.push_back(ViewportVisibilityStates());
+			vs = &viewport_states[viewport_states.size() - 1];
+			vs->viewport = p_viewport;
+		}
+		vs->last_frame = frame;
+
+		uint32_t known = vs->states.size();
+		if (known < visibility_count) {
+			vs->states.resize(visibility_count);
+			for (uint32_t i = known; i < visibility_count; i++) {
+				vs->states[i] = InstanceVisibilityData::STATE_IN_RANGE;
+			}
+		}
+		states = vs->states.ptr();
+	}
+
+	for (uint32_t i = 0; i < visibility_count; i++) {
+		InstanceVisibilityData &vd = visibility[i];
+
+		if (vd.range_begin <= 0 && vd.range_end <= 0) {
+			//no range of its own (cluster children only follow their parent), skip the distance test
+			vd.state = InstanceVisibilityData::STATE_IN_RANGE;
+			continue;
+		}
+
+		float range_begin = vd.range_begin;
+		float range_end = vd.range_end;
+		if (states && states[i] == InstanceVisibilityData::STATE_IN_RANGE) {
+			//widen the range while inside it, so instances don't pop back and forth on the boundary
+			range_begin -= vd.range_begin_margin;
+			range_end += vd.range_end_margin;
+		}
+
+		float distance = vd.position.distance_to(p_camera_position);
+		if (range_begin > 0 && distance < range_begin) {
+			vd.state = InstanceVisibilityData::STATE_TOO_CLOSE;
+		} else if (vd.range_end > 0 && distance > range_end) {
+			vd.state = InstanceVisibilityData::STATE_TOO_FAR;
+		} else {
+			vd.state = InstanceVisibilityData::STATE_IN_RANGE;
+		}
+		if (states) {
+			states[i] = vd.state;
+		}
+	}
+
+	for (uint32_t i = 0; i < visibility_count; i++) {
+		InstanceVisibilityData &vd = visibility[i];
+		vd.culled = vd.state != InstanceVisibilityData::STATE_IN_RANGE;
+
+		const Instance *parent = vd.instance->lod_parent;
+		if (!vd.culled && parent && parent->scenario == p_scenario && parent->visibility_index != -1) {
+			//children are only drawn while the camera is too close for their parent
+			vd.culled = visibility[parent->visibility_index].state != InstanceVisibilityData::STATE_TOO_CLOSE;
+		}
+	}
+}
+
+void RendererSceneCull::_update_instance_pairs(Instance *p_instance) {
 	//move instance and repair
 	pair_pass++;
 
@@ -1483,6 +1678,8 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 
 	p_instance->indexer_id = DynamicBVH::ID();
 
+	_remove_instance_visibility(p_instance);
+
 	//replace this by last
 	int32_t swap_with_index = p_instance->scenario->instance_data.size() - 1;
 	if (swap_with_index != p_instance->array_index) {
@@ -1961,14 +2158,24 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 	}
 }
 
-bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_screen_lod_threshold) {
+void RendererSceneCull::_shadow_cull_pass_add(Instance *p_instance, const Vector<Plane> &p_planes, uint32_t p_pass) {
+	ShadowCullPass &pass = shadow_cull_passes[max_shadows_used];
+	pass.light = p_instance;
+	pass.planes = p_planes;
+	pass.points = Geometry3D::compute_convex_mesh_points(&p_planes[0], p_planes.size());
+	pass.animated_material_found = false;
+
+	RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
+	shadow_data.light = static_cast<InstanceLightData *>(p_instance->base_data)->instance;
+	shadow_data.pass = p_pass;
+}
+
+bool RendererSceneCull::_light_instance_setup_shadow_passes(Instance *p_instance) {
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
 	Transform light_transform = p_instance->transform;
 	light_transform.orthonormalize(); //scale does not count on lights
 
-	bool animated_material_found = false;
-
 	switch (RSG::storage->light_get_type(p_instance->base)) {
 		case RS::LIGHT_DIRECTIONAL: {
 		} break;
@@ -1977,14 +2184,12 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 			if (shadow_mode == RS::LIGHT_OMNI_SHADOW_DUAL_PARABOLOID || !scene_render->light_instances_can_render_shadow_cube()) {
 				if (max_shadows_used + 2 > MAX_UPDATE_SHADOWS) {
-					return true;
+					return false;
 				}
-				for (int i = 0; i < 2; i++) {
-					//using this one ensures that raster deferred will have it
-					RENDER_TIMESTAMP("Culling Shadow Paraboloid" + itos(i));
 
-					real_t radius = RSG::storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
+				real_t radius = RSG::storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
 
+				for (int i = 0; i < 2; i++) {
 					real_t z = i == 0 ? -1 : 1;
 					Vector<Plane> planes;
 					planes.resize(6);
@@ -1995,55 +2200,13 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
 					planes.write[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
 
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-					Plane near_plane(light_transform.origin, light_transform.basis.get_axis(2) * z);
-
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-
-							if (instance->mesh_instance.is_valid()) {
-								RSG::storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
-
-					RSG::storage->update_mesh_instances();
-
+					_shadow_cull_pass_add(p_instance, planes, i);
 					scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, i, 0);
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
 				}
 			} else { //shadow cube
 
 				if (max_shadows_used + 6 > MAX_UPDATE_SHADOWS) {
-					return true;
+					return false;
 				}
 
 				real_t radius = RSG::storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
@@ -2051,9 +2214,6 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 				cm.set_perspective(90, 1, 0.01, radius);
 
 				for (int i = 0; i < 6; i++) {
-					RENDER_TIMESTAMP("Culling Shadow Cube side" + itos(i));
-					//using this one ensures that raster deferred will have it
-
 					static const Vector3 view_normals[6] = {
 						Vector3(+1, 0, 0),
 						Vector3(-1, 0, 0),
@@ -2073,49 +2233,8 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 					Transform xform = light_transform * Transform().looking_at(view_normals[i], view_up[i]);
 
-					Vector<Plane> planes = cm.get_projection_planes(xform);
-
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-							if (instance->mesh_instance.is_valid()) {
-								RSG::storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
-
-					RSG::storage->update_mesh_instances();
+					_shadow_cull_pass_add(p_instance, cm.get_projection_planes(xform), i);
 					scene_render->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i, 0);
-
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
 				}
 
 				//restore the regular DP matrix
@@ -2124,10 +2243,8 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 		} break;
 		case RS::LIGHT_SPOT: {
-			RENDER_TIMESTAMP("Culling Spot Light");
-
 			if (max_shadows_used + 1 > MAX_UPDATE_SHADOWS) {
-				return true;
+				return false;
 			}
 
 			real_t radius = RSG::storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
@@ -2136,54 +2253,96 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 			CameraMatrix cm;
 			cm.set_perspective(angle * 2.0, 1.0, 0.01, radius);
 
-			Vector<Plane> planes = cm.get_projection_planes(light_transform);
+			_shadow_cull_pass_add(p_instance, cm.get_projection_planes(light_transform), 0);
+			scene_render->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0, 0);
 
-			instance_shadow_cull_result.clear();
+		} break;
+	}
 
-			Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
+	return true;
+}
 
-			struct CullConvex {
-				PagedArray<Instance *> *result;
-				_FORCE_INLINE_ bool operator()(void *p_data) {
-					Instance *p_instance = (Instance *)p_data;
-					result->push_back(p_instance);
-					return false;
-				}
-			};
+void RendererSceneCull::_shadow_cull_pass_threaded(uint32_t p_index, ShadowCullData *p_cull_data) {
+	_shadow_cull_pass(p_cull_data->scenario, p_cull_data->first_pass + p_index);
+}
 
-			CullConvex cull_convex;
-			cull_convex.result = &instance_shadow_cull_result;
+void RendererSceneCull::_shadow_cull_pass(Scenario *p_scenario, uint32_t p_pass) {
+	ShadowCullPass &pass = shadow_cull_passes[p_pass];
 
-			p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
+	struct CullConvex {
+		PagedArray<RendererSceneRender::GeometryInstance *> *instances;
+		PagedArray<RID> *mesh_instances;
+		const InstanceVisibilityData *visibility = nullptr;
+		bool animated_material_found = false;
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			Instance *p_instance = (Instance *)p_data;
+			if (!p_instance->visible || !((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(p_instance->base_data)->can_cast_shadows) {
+				return false;
+			}
+			if (p_instance->visibility_index != -1 && visibility[p_instance->visibility_index].culled) {
+				return false;
+			}
 
-			RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
+			InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
+			if (geom->material_is_animated) {
+				animated_material_found = true;
+			}
+			if (p_instance->mesh_instance.is_valid()) {
+				mesh_instances->push_back(p_instance->mesh_instance);
+			}
+			instances->push_back(geom->geometry_instance);
+			return false;
+		}
+	};
 
-			for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-				Instance *instance = instance_shadow_cull_result[j];
-				if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-					continue;
-				} else {
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
+	CullConvex cull_convex;
+	cull_convex.instances = &render_shadow_data[p_pass].instances;
+	cull_convex.mesh_instances = &pass.mesh_instances;
+	cull_convex.visibility = p_scenario->instance_visibility.ptr();
 
-					if (instance->mesh_instance.is_valid()) {
-						RSG::storage->mesh_instance_check_for_update(instance->mesh_instance);
-					}
-				}
-				shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-			}
+	p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(pass.planes.ptr(), pass.planes.size(), pass.points.ptr(), pass.points.size(), cull_convex);
 
-			RSG::storage->update_mesh_instances();
+	pass.animated_material_found = cull_convex.animated_material_found;
+}
 
-			scene_render->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0, 0);
-			shadow_data.light = light->instance;
-			shadow_data.pass = 0;
+void RendererSceneCull::_cull_shadow_passes(Scenario *p_scenario, uint32_t p_first_pass) {
+	if (p_first_pass == max_shadows_used) {
+		return;
+	}
 
-		} break;
+	RENDER_TIMESTAMP("Culling Shadows");
+
+	uint32_t pass_count = max_shadows_used - p_first_pass;
+	if (pass_count > 1 && RendererThreadPool::singleton->thread_work_pool.get_thread_count() > 1) {
+		ShadowCullData cull_data;
+		cull_data.scenario = p_scenario;
+		cull_data.first_pass = p_first_pass;
+		RendererThreadPool::singleton->thread_work_pool.do_work(pass_count, this, &RendererSceneCull::_shadow_cull_pass_threaded, &cull_data);
+	} else {
+		for (uint32_t i = p_first_pass; i < max_shadows_used; i++) {
+			_shadow_cull_pass(p_scenario, i);
+		}
+	}
+
+	// Merge the pass results, mesh instances may be shared by passes but updating them twice is harmless.
+	bool mesh_instances_pending = false;
+	for (uint32_t i = p_first_pass; i < max_shadows_used; i++) {
+		ShadowCullPass &pass = shadow_cull_passes[i];
+		for (uint64_t j = 0; j < pass.mesh_instances.size(); j++) {
+			RSG::storage->mesh_instance_check_for_update(pass.mesh_instances[j]);
+			mesh_instances_pending = true;
+		}
+		pass.mesh_instances.clear();
+
+		if (pass.animated_material_found) {
+			static_cast<InstanceLightData *>(pass.light->base_data)->shadow_dirty = true;
+		}
+		pass.light = nullptr;
 	}
 
-	return animated_material_found;
+	if (mesh_instances_pending) {
+		RSG::storage->update_mesh_instances();
+	}
 }
 
 void RendererSceneCull::render_camera(RID p_render_buffers, RID p_camera, RID p_scenario, RID p_viewport, Size2 p_viewport_size, float p_screen_lod_threshold, RID p_shadow_atlas) {
@@ -2344,9 +2503,15 @@ void RendererSceneCull::_frustum_cull(CullData &cull_data, FrustumCullResult &cu
 	Transform inv_cam_transform = cull_data.cam_transform.inverse();
 	float z_near = cull_data.camera_matrix->get_z_near();
 
+	const InstanceVisibilityData *visibility = cull_data.scenario->instance_visibility.size() ? cull_data.scenario->instance_visibility.ptr() : nullptr;
+
 	for (uint64_t i = p_from; i < p_to; i++) {
 		bool mesh_visible = false;
 
+		if (visibility && cull_data.scenario->instance_data[i].visibility_index != -1 && visibility[cull_data.scenario->instance_data[i].visibility_index].culled) {
+			continue; //out of its draw range, or replaced by its LOD parent
+		}
+
 		if (cull_data.scenario->instance_aabbs[i].in_frustum(cull_data.cull->frustum) && (cull_data.occlusion_buffer == nullptr || cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING ||
 																								 !cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near))) {
 			InstanceData &idata = cull_data.scenario->instance_data[i];
@@ -2557,6 +2722,10 @@ void RendererSceneCull::_render_scene(const Transform &p_cam_transform, const Ca
 
 	scene_render->set_scene_pass(render_pass);
 
+	if (scenario->instance_visibility.size()) {
+		_scenario_update_visibility(scenario, p_cam_transform.origin, p_viewport);
+	}
+
 	if (p_render_buffers.is_valid()) {
 		//no rendering code here, this is only to set up what needs to be done, request regions, etc.
 		scene_render->sdfgi_update(p_render_buffers, p_environment, p_cam_transform.origin); //update conditions for SDFGI (whether its used or not)
@@ -2713,6 +2882,7 @@ void RendererSceneCull::_render_scene(const Transform &p_cam_transform, const Ca
 		}
 
 		// Positional Shadowss
+		uint32_t first_positional_shadow = max_shadows_used;
 		for (uint32_t i = 0; i < (uint32_t)frustum_cull_result.lights.size(); i++) {
 			Instance *ins = frustum_cull_result.lights[i];
 
@@ -2800,14 +2970,14 @@ void RendererSceneCull::_render_scene(const Transform &p_cam_transform, const Ca
 			bool redraw = scene_render->shadow_atlas_update_light(p_shadow_atlas, light->instance, coverage, light->last_version);
 
 			if (redraw && max_shadows_used < MAX_UPDATE_SHADOWS) {
-				//must redraw!
-				RENDER_TIMESTAMP(">Rendering Light " + itos(i));
-				light->shadow_dirty = _light_instance_update_shadow(ins, p_cam_transform, p_cam_projection, p_cam_orthogonal, p_cam_vaspect, p_shadow_atlas, scenario, p_screen_lod_threshold);
-				RENDER_TIMESTAMP("<Rendering Light " + itos(i));
+				//must redraw! passes are culled below, animated materials mark the light dirty again
+				light->shadow_dirty = !_light_instance_setup_shadow_passes(ins);
 			} else {
 				light->shadow_dirty = redraw;
 			}
 		}
+
+		_cull_shadow_passes(scenario, first_positional_shadow);
 	}
 
 	//render SDFGI
@@ -3302,228 +3472,299 @@ void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
 	}
 
 	if (p_instance->update_dependencies) {
-		p_instance->dependency_tracker.update_begin();
+		_update_instance_dependencies(p_instance);
+	}
 
-		if (p_instance->base.is_valid()) {
-			RSG::storage->base_update_dependency(p_instance->base, &p_instance->dependency_tracker);
-		}
+	_instance_update_list.remove(&p_instance->update_item);
 
-		if (p_instance->material_override.is_valid()) {
-			RSG::storage->material_update_dependency(p_instance->material_override, &p_instance->dependency_tracker);
-		}
+	_update_instance(p_instance);
 
-		if (p_instance->base_type == RS::INSTANCE_MESH) {
-			//remove materials no longer used and un-own them
+	p_instance->update_aabb = false;
+	p_instance->update_dependencies = false;
+}
 
-			int new_mat_count = RSG::storage->mesh_get_surface_count(p_instance->base);
-			p_instance->materials.resize(new_mat_count);
+void RendererSceneCull::_update_instance_dependencies(Instance *p_instance) {
+	p_instance->dependency_tracker.update_begin();
 
-			_instance_update_mesh_instance(p_instance);
-		}
+	if (p_instance->base.is_valid()) {
+		RSG::storage->base_update_dependency(p_instance->base, &p_instance->dependency_tracker);
+	}
 
-		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
-			InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
+	if (p_instance->material_override.is_valid()) {
+		RSG::storage->material_update_dependency(p_instance->material_override, &p_instance->dependency_tracker);
+	}
 
-			bool can_cast_shadows = true;
-			bool is_animated = false;
-			Map<StringName, Instance::InstanceShaderParameter> isparams;
+	if (p_instance->base_type == RS::INSTANCE_MESH) {
+		//remove materials no longer used and un-own them
 
-			if (p_instance->cast_shadows == RS::SHADOW_CASTING_SETTING_OFF) {
-				can_cast_shadows = false;
-			}
+		int new_mat_count = RSG::storage->mesh_get_surface_count(p_instance->base);
+		p_instance->materials.resize(new_mat_count);
 
-			if (p_instance->material_override.is_valid()) {
-				if (!RSG::storage->material_casts_shadows(p_instance->material_override)) {
-					can_cast_shadows = false;
-				}
-				is_animated = RSG::storage->material_is_animated(p_instance->material_override);
-				_update_instance_shader_parameters_from_material(isparams, p_instance->instance_shader_parameters, p_instance->material_override);
-			} else {
-				if (p_instance->base_type == RS::INSTANCE_MESH) {
-					RID mesh = p_instance->base;
+		_instance_update_mesh_instance(p_instance);
+	}
 
-					if (mesh.is_valid()) {
-						bool cast_shadows = false;
+	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
+		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
 
-						for (int i = 0; i < p_instance->materials.size(); i++) {
-							RID mat = p_instance->materials[i].is_valid() ? p_instance->materials[i] : RSG::storage->mesh_surface_get_material(mesh, i);
+		bool can_cast_shadows = true;
+		bool is_animated = false;
+		Map<StringName, Instance::InstanceShaderParameter> isparams;
 
-							if (!mat.is_valid()) {
-								cast_shadows = true;
-							} else {
-								if (RSG::storage->material_casts_shadows(mat)) {
-									cast_shadows = true;
-								}
+		if (p_instance->cast_shadows == RS::SHADOW_CASTING_SETTING_OFF) {
+			can_cast_shadows = false;
+		}
 
-								if (RSG::storage->material_is_animated(mat)) {
-									is_animated = true;
-								}
+		if (p_instance->material_override.is_valid()) {
+			if (!RSG::storage->material_casts_shadows(p_instance->material_override)) {
+				can_cast_shadows = false;
+			}
+			is_animated = RSG::storage->material_is_animated(p_instance->material_override);
+			_update_instance_shader_parameters_from_material(isparams, p_instance->instance_shader_parameters, p_instance->material_override);
+		} else {
+			if (p_instance->base_type == RS::INSTANCE_MESH) {
+				RID mesh = p_instance->base;
 
-								_update_instance_shader_parameters_from_material(isparams, p_instance->instance_shader_parameters, mat);
+				if (mesh.is_valid()) {
+					bool cast_shadows = false;
 
-								RSG::storage->material_update_dependency(mat, &p_instance->dependency_tracker);
+					for (int i = 0; i < p_instance->materials.size(); i++) {
+						RID mat = p_instance->materials[i].is_valid() ? p_instance->materials[i] : RSG::storage->mesh_surface_get_material(mesh, i);
+
+						if (!mat.is_valid()) {
+							cast_shadows = true;
+						} else {
+							if (RSG::storage->material_casts_shadows(mat)) {
+								cast_shadows = true;
 							}
-						}
 
-						if (!cast_shadows) {
-							can_cast_shadows = false;
+							if (RSG::storage->material_is_animated(mat)) {
+								is_animated = true;
+							}
+
+							_update_instance_shader_parameters_from_material(isparams, p_instance->instance_shader_parameters, mat);
+
+							RSG::storage->material_update_dependency(mat, &p_instance->dependency_tracker);
 						}
 					}
 
-				} else if (p_instance->base_type == RS::INSTANCE_MULTIMESH) {
-					RID mesh = RSG::storage->multimesh_get_mesh(p_instance->base);
-					if (mesh.is_valid()) {
-						bool cast_shadows = false;
-
-						int sc = RSG::storage->mesh_get_surface_count(mesh);
-						for (int i = 0; i < sc; i++) {
-							RID mat = RSG::storage->mesh_surface_get_material(mesh, i);
+					if (!cast_shadows) {
+						can_cast_shadows = false;
+					}
+				}
 
-							if (!mat.is_valid()) {
-								cast_shadows = true;
+			} else if (p_instance->base_type == RS::INSTANCE_MULTIMESH) {
+				RID mesh = RSG::storage->multimesh_get_mesh(p_instance->base);
+				if (mesh.is_valid()) {
+					bool cast_shadows = false;
 
-							} else {
-								if (RSG::storage->material_casts_shadows(mat)) {
-									cast_shadows = true;
-								}
-								if (RSG::storage->material_is_animated(mat)) {
-									is_animated = true;
-								}
+					int sc = RSG::storage->mesh_get_surface_count(mesh);
+					for (int i = 0; i < sc; i++) {
+						RID mat = RSG::storage->mesh_surface_get_material(mesh, i);
 
-								_update_instance_shader_parameters_from_material(isparams, p_instance->instance_shader_parameters, mat);
+						if (!mat.is_valid()) {
+							cast_shadows = true;
 
-								RSG::storage->material_update_dependency(mat, &p_instance->dependency_tracker);
+						} else {
+							if (RSG::storage->material_casts_shadows(mat)) {
+								cast_shadows = true;
+							}
+							if (RSG::storage->material_is_animated(mat)) {
+								is_animated = true;
 							}
-						}
 
-						if (!cast_shadows) {
-							can_cast_shadows = false;
-						}
+							_update_instance_shader_parameters_from_material(isparams, p_instance->instance_shader_parameters, mat);
 
-						RSG::storage->base_update_dependency(mesh, &p_instance->dependency_tracker);
+							RSG::storage->material_update_dependency(mat, &p_instance->dependency_tracker);
+						}
 					}
-				} else if (p_instance->base_type == RS::INSTANCE_IMMEDIATE) {
-					RID mat = RSG::storage->immediate_get_material(p_instance->base);
 
-					if (!(!mat.is_valid() || RSG::storage->material_casts_shadows(mat))) {
+					if (!cast_shadows) {
 						can_cast_shadows = false;
 					}
 
-					if (mat.is_valid() && RSG::storage->material_is_animated(mat)) {
-						is_animated = true;
-					}
+					RSG::storage->base_update_dependency(mesh, &p_instance->dependency_tracker);
+				}
+			} else if (p_instance->base_type == RS::INSTANCE_IMMEDIATE) {
+				RID mat = RSG::storage->immediate_get_material(p_instance->base);
 
-					if (mat.is_valid()) {
-						_update_instance_shader_parameters_from_material(isparams, p_instance->instance_shader_parameters, mat);
-					}
+				if (!(!mat.is_valid() || RSG::storage->material_casts_shadows(mat))) {
+					can_cast_shadows = false;
+				}
 
-					if (mat.is_valid()) {
-						RSG::storage->material_update_dependency(mat, &p_instance->dependency_tracker);
-					}
+				if (mat.is_valid() && RSG::storage->material_is_animated(mat)) {
+					is_animated = true;
+				}
 
-				} else if (p_instance->base_type == RS::INSTANCE_PARTICLES) {
-					bool cast_shadows = false;
+				if (mat.is_valid()) {
+					_update_instance_shader_parameters_from_material(isparams, p_instance->instance_shader_parameters, mat);
+				}
 
-					int dp = RSG::storage->particles_get_draw_passes(p_instance->base);
+				if (mat.is_valid()) {
+					RSG::storage->material_update_dependency(mat, &p_instance->dependency_tracker);
+				}
 
-					for (int i = 0; i < dp; i++) {
-						RID mesh = RSG::storage->particles_get_draw_pass_mesh(p_instance->base, i);
-						if (!mesh.is_valid()) {
-							continue;
-						}
+			} else if (p_instance->base_type == RS::INSTANCE_PARTICLES) {
+				bool cast_shadows = false;
 
-						int sc = RSG::storage->mesh_get_surface_count(mesh);
-						for (int j = 0; j < sc; j++) {
-							RID mat = RSG::storage->mesh_surface_get_material(mesh, j);
+				int dp = RSG::storage->particles_get_draw_passes(p_instance->base);
 
-							if (!mat.is_valid()) {
-								cast_shadows = true;
-							} else {
-								if (RSG::storage->material_casts_shadows(mat)) {
-									cast_shadows = true;
-								}
+				for (int i = 0; i < dp; i++) {
+					RID mesh = RSG::storage->particles_get_draw_pass_mesh(p_instance->base, i);
+					if (!mesh.is_valid()) {
+						continue;
+					}
 
-								if (RSG::storage->material_is_animated(mat)) {
-									is_animated = true;
-								}
+					int sc = RSG::storage->mesh_get_surface_count(mesh);
+					for (int j = 0; j < sc; j++) {
+						RID mat = RSG::storage->mesh_surface_get_material(mesh, j);
 
-								_update_instance_shader_parameters_from_material(isparams, p_instance->instance_shader_parameters, mat);
+						if (!mat.is_valid()) {
+							cast_shadows = true;
+						} else {
+							if (RSG::storage->material_casts_shadows(mat)) {
+								cast_shadows = true;
+							}
 
-								RSG::storage->material_update_dependency(mat, &p_instance->dependency_tracker);
+							if (RSG::storage->material_is_animated(mat)) {
+								is_animated = true;
 							}
-						}
-					}
 
-					if (!cast_shadows) {
-						can_cast_shadows = false;
+							_update_instance_shader_parameters_from_material(isparams, p_instance->instance_shader_parameters, mat);
+
+							RSG::storage->material_update_dependency(mat, &p_instance->dependency_tracker);
+						}
 					}
 				}
-			}
 
-			if (can_cast_shadows != geom->can_cast_shadows) {
-				//ability to cast shadows change, let lights now
-				for (Set<Instance *>::Element *E = geom->lights.front(); E; E = E->next()) {
-					InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
-					light->shadow_dirty = true;
+				if (!cast_shadows) {
+					can_cast_shadows = false;
 				}
+			}
+		}
 
-				geom->can_cast_shadows = can_cast_shadows;
+		if (can_cast_shadows != geom->can_cast_shadows) {
+			//ability to cast shadows change, let lights now
+			for (Set<Instance *>::Element *E = geom->lights.front(); E; E = E->next()) {
+				InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
+				light->shadow_dirty = true;
 			}
 
-			geom->material_is_animated = is_animated;
-			p_instance->instance_shader_parameters = isparams;
+			geom->can_cast_shadows = can_cast_shadows;
+		}
 
-			if (p_instance->instance_allocated_shader_parameters != (p_instance->instance_shader_parameters.size() > 0)) {
-				p_instance->instance_allocated_shader_parameters = (p_instance->instance_shader_parameters.size() > 0);
-				if (p_instance->instance_allocated_shader_parameters) {
-					p_instance->instance_allocated_shader_parameters_offset = RSG::storage->global_variables_instance_allocate(p_instance->self);
-					scene_render->geometry_instance_set_instance_shader_parameters_offset(geom->geometry_instance, p_instance->instance_allocated_shader_parameters_offset);
+		geom->material_is_animated = is_animated;
+		p_instance->instance_shader_parameters = isparams;
 
-					for (Map<StringName, Instance::InstanceShaderParameter>::Element *E = p_instance->instance_shader_parameters.front(); E; E = E->next()) {
-						if (E->get().value.get_type() != Variant::NIL) {
-							RSG::storage->global_variables_instance_update(p_instance->self, E->get().index, E->get().value);
-						}
+		if (p_instance->instance_allocated_shader_parameters != (p_instance->instance_shader_parameters.size() > 0)) {
+			p_instance->instance_allocated_shader_parameters = (p_instance->instance_shader_parameters.size() > 0);
+			if (p_instance->instance_allocated_shader_parameters) {
+				p_instance->instance_allocated_shader_parameters_offset = RSG::storage->global_variables_instance_allocate(p_instance->self);
+				scene_render->geometry_instance_set_instance_shader_parameters_offset(geom->geometry_instance, p_instance->instance_allocated_shader_parameters_offset);
+
+				for (Map<StringName, Instance::InstanceShaderParameter>::Element *E = p_instance->instance_shader_parameters.front(); E; E = E->next()) {
+					if (E->get().value.get_type() != Variant::NIL) {
+						RSG::storage->global_variables_instance_update(p_instance->self, E->get().index, E->get().value);
 					}
-				} else {
-					RSG::storage->global_variables_instance_free(p_instance->self);
-					p_instance->instance_allocated_shader_parameters_offset = -1;
-					scene_render->geometry_instance_set_instance_shader_parameters_offset(geom->geometry_instance, -1);
 				}
+			} else {
+				RSG::storage->global_variables_instance_free(p_instance->self);
+				p_instance->instance_allocated_shader_parameters_offset = -1;
+				scene_render->geometry_instance_set_instance_shader_parameters_offset(geom->geometry_instance, -1);
 			}
 		}
+	}
 
-		if (p_instance->skeleton.is_valid()) {
-			RSG::storage->skeleton_update_dependency(p_instance->skeleton, &p_instance->dependency_tracker);
-		}
+	if (p_instance->skeleton.is_valid()) {
+		RSG::storage->skeleton_update_dependency(p_instance->skeleton, &p_instance->dependency_tracker);
+	}
 
-		p_instance->dependency_tracker.update_end();
+	p_instance->dependency_tracker.update_end();
 
-		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
-			InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
-			scene_render->geometry_instance_set_surface_materials(geom->geometry_instance, p_instance->materials);
-		}
+	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
+		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
+		scene_render->geometry_instance_set_surface_materials(geom->geometry_instance, p_instance->materials);
 	}
+}
 
-	_instance_update_list.remove(&p_instance->update_item);
+void RendererSceneCull::_update_dirty_instance_bounds(Instance *p_instance) {
+	if (p_instance->update_aabb) {
+		_update_instance_aabb(p_instance);
+	}
+	_update_instance_transformed_aabb(p_instance);
+}
 
-	_update_instance(p_instance);
+void RendererSceneCull::_update_dirty_instance_bounds_threaded(uint32_t p_thread, LocalVector<Instance *> *p_instances) {
+	uint32_t total = p_instances->size();
+	uint32_t total_threads = RendererThreadPool::singleton->thread_work_pool.get_thread_count();
+	uint32_t from = p_thread * total / total_threads;
+	uint32_t to = (p_thread + 1 == total_threads) ? total : ((p_thread + 1) * total / total_threads);
 
-	p_instance->update_aabb = false;
-	p_instance->update_dependencies = false;
+	for (uint32_t i = from; i < to; i++) {
+		_update_dirty_instance_bounds((*p_instances)[i]);
+	}
 }
 
 void RendererSceneCull::update_dirty_instances() {
 	RSG::storage->update_dirty_resources();
 
 	while (_instance_update_list.first()) {
-		_update_dirty_instance(_instance_update_list.first()->self());
+		//take the whole list, instances queued while it is processed (e.g. geometry captured by a moved lightmap) are done in the next round
+		dirty_instances.clear();
+		while (_instance_update_list.first()) {
+			Instance *instance = _instance_update_list.first()->self();
+			_instance_update_list.remove(&instance->update_item);
+
+			if (instance->update_dependencies) {
+				//talks to storage and its dependency tracking, so it stays serial
+				_update_instance_dependencies(instance);
+			}
+
+			dirty_instances.push_back(instance);
+		}
+
+		//base AABBs and transformed AABBs only read storage and write to the instance itself.
+		//this relies on update_dirty_resources() having run above: storage getters such as
+		//multimesh_get_aabb() recompute dirty resources on demand, which would race between threads
+		if (dirty_instances.size() > thread_cull_threshold) {
+			RendererThreadPool::singleton->thread_work_pool.do_work(RendererThreadPool::singleton->thread_work_pool.get_thread_count(), this, &RendererSceneCull::_update_dirty_instance_bounds_threaded, &dirty_instances);
+		} else {
+			for (uint32_t i = 0; i < dirty_instances.size(); i++) {
+				_update_dirty_instance_bounds(dirty_instances[i]);
+			}
+		}
+
+		for (uint32_t i = 0; i < dirty_instances.size(); i++) {
+			Instance *instance = dirty_instances[i];
+			instance->update_aabb = false;
+			instance->update_dependencies = false;
+			instance->update_needs_index = _update_instance_transform(instance);
+		}
+
+		//update the spatial indexers as one batch, so pairing below queries the final bounds of everything that moved
+		for (uint32_t i = 0; i < dirty_instances.size(); i++) {
+			if (dirty_instances[i]->update_needs_index) {
+				_update_instance_indexer(dirty_instances[i]);
+			}
+		}
+
+		for (uint32_t i = 0; i < dirty_instances.size(); i++) {
+			if (dirty_instances[i]->update_needs_index) {
+				_update_instance_pairs(dirty_instances[i]);
+			}
+		}
 	}
+
+	dirty_instances.clear();
 }
 
 void RendererSceneCull::update() {
 	//optimize bvhs
-	for (uint32_t i = 0; i < scenario_owner.get_rid_count(); i++) {
+	uint32_t scenario_count = scenario_owner.get_max_index();
+	for (uint32_t i = 0; i < scenario_count; i++) {
 		Scenario *s = scenario_owner.get_ptr_by_index(i);
+		if (!s) {
+			continue;
+		}
 		s->indexers[Scenario::INDEXER_GEOMETRY].optimize_incremental(indexer_update_iterations);
 		s->indexers[Scenario::INDEXER_VOLUMES].optimize_incremental(indexer_update_iterations);
 	}
@@ -3567,6 +3808,11 @@ bool RendererSceneCull::free(RID p_rid) {
 
 		Instance *instance = instance_owner.getornull(p_rid);
 
+		instance_geometry_set_as_instance_lod(p_rid, RID());
+		while (instance->lod_children.front()) {
+			instance_geometry_set_as_instance_lod(instance->lod_children.front()->get()->self, RID());
+		}
+
 		instance_geometry_set_lightmap(p_rid, RID(), Rect2(), 0);
 		instance_set_scenario(p_rid, RID());
 		instance_set_base(p_rid, RID());
@@ -3610,10 +3856,10 @@ RendererSceneCull::RendererSceneCull() {
 	singleton = this;
 
 	instance_cull_result.set_page_pool(&instance_cull_page_pool);
-	instance_shadow_cull_result.set_page_pool(&instance_cull_page_pool);
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.set_page_pool(&geometry_instance_cull_page_pool);
+		shadow_cull_passes[i].mesh_instances.set_page_pool(&rid_cull_page_pool);
 	}
 	for (uint32_t i = 0; i < SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE; i++) {
 		render_sdfgi_data[i].instances.set_page_pool(&geometry_instance_cull_page_pool);
@@ -3634,10 +3880,10 @@ RendererSceneCull::RendererSceneCull() {
 
 RendererSceneCull::~RendererSceneCull() {
 	instance_cull_result.reset();
-	instance_shadow_cull_result.reset();
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.reset();
+		shadow_cull_passes[i].mesh_instances.reset();
 	}
 	for (uint32_t i = 0; i < SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE; i++) {
 		render_sdfgi_data[i].instances.reset();
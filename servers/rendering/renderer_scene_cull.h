@@ -57,7 +57,8 @@ public:
 		SDFGI_MAX_CASCADES = 8,
 		SDFGI_MAX_REGIONS_PER_CASCADE = 3,
 		MAX_INSTANCE_PAIRS = 32,
-		MAX_UPDATE_SHADOWS = 512
+		MAX_UPDATE_SHADOWS = 512,
+		VIEWPORT_VISIBILITY_STATES_MAX_AGE = 60 // Frames without a cull before a viewport's draw range states are dropped.
 	};
 
 	uint64_t render_pass;
@@ -263,6 +264,7 @@ public:
 
 		uint32_t flags = 0;
 		uint32_t layer_mask = 0; //for fast layer-mask discard
+		int32_t visibility_index = -1; //into Scenario::instance_visibility, for instances with a draw range or LOD parent
 		RID base_rid;
 		union {
 			uint64_t instance_data_rid;
@@ -271,6 +273,34 @@ public:
 		Instance *instance = nullptr;
 	};
 
+	struct InstanceVisibilityData {
+		// Draw range state, evaluated once per cull for the whole scenario.
+		// Instances that are the LOD of another one (HLOD cluster children) only
+		// look up the result of their parent, so a cluster costs a single test.
+		enum State {
+			STATE_IN_RANGE,
+			STATE_TOO_CLOSE,
+			STATE_TOO_FAR,
+		};
+
+		Instance *instance = nullptr;
+		Vector3 position;
+		float range_begin = 0.0;
+		float range_end = 0.0;
+		float range_begin_margin = 0.0;
+		float range_end_margin = 0.0;
+		uint8_t state = STATE_IN_RANGE; // For the camera of the current cull only.
+		bool culled = false;
+	};
+
+	struct ViewportVisibilityStates {
+		// Draw range states of the last cull for a viewport, indexed like the scenario's instance_visibility.
+		// Kept per viewport so cameras of other viewports don't move the hysteresis margins.
+		RID viewport;
+		uint64_t last_frame = 0;
+		LocalVector<uint8_t> states;
+	};
+
 	PagedArrayPool<InstanceBounds> instance_aabb_page_pool;
 	PagedArrayPool<InstanceData> instance_data_page_pool;
 
@@ -299,6 +329,8 @@ public:
 
 		PagedArray<InstanceBounds> instance_aabbs;
 		PagedArray<InstanceData> instance_data;
+		LocalVector<InstanceVisibilityData> instance_visibility;
+		LocalVector<ViewportVisibilityStates> viewport_visibility_states;
 
 		Scenario() {
 			indexers[INDEXER_GEOMETRY].set_index(INDEXER_GEOMETRY);
@@ -405,6 +437,7 @@ public:
 		//aabb stuff
 		bool update_aabb;
 		bool update_dependencies;
+		bool update_needs_index; //set by the batched dirty update
 
 		SelfList<Instance> update_item;
 
@@ -416,7 +449,9 @@ public:
 		float lod_end;
 		float lod_begin_hysteresis;
 		float lod_end_hysteresis;
-		RID lod_instance;
+		Instance *lod_parent; //drawn instead of this one when far away
+		Set<Instance *> lod_children;
+		int32_t visibility_index;
 
 		Vector<Color> lightmap_target_sh; //target is used for incrementally changing the SH over time, this avoids pops in some corner cases and when going interior <-> exterior
 
@@ -490,6 +525,7 @@ public:
 
 			update_aabb = false;
 			update_dependencies = false;
+			update_needs_index = false;
 
 			extra_margin = 0;
 
@@ -499,6 +535,8 @@ public:
 			lod_end = 0;
 			lod_begin_hysteresis = 0;
 			lod_end_hysteresis = 0;
+			lod_parent = nullptr;
+			visibility_index = -1;
 
 			last_frame_pass = 0;
 			version = 1;
@@ -525,6 +563,7 @@ public:
 	};
 
 	SelfList<Instance>::List _instance_update_list;
+	LocalVector<Instance *> dirty_instances;
 	void _instance_queue_update(Instance *p_instance, bool p_update_aabb, bool p_update_dependencies = false);
 
 	struct InstanceGeometryData : public InstanceBaseData {
@@ -715,7 +754,6 @@ public:
 	PagedArrayPool<RID> rid_cull_page_pool;
 
 	PagedArray<Instance *> instance_cull_result;
-	PagedArray<Instance *> instance_shadow_cull_result;
 
 	struct FrustumCullResult {
 		PagedArray<RendererSceneRender::GeometryInstance *> geometry_instances;
@@ -838,6 +876,18 @@ public:
 	RendererSceneRender::RenderShadowData render_shadow_data[MAX_UPDATE_SHADOWS];
 	uint32_t max_shadows_used = 0;
 
+	// Omni and spot shadow passes are set up serially, then culled as parallel jobs.
+	// Each pass owns the render_shadow_data entry with the same index.
+	struct ShadowCullPass {
+		Instance *light = nullptr;
+		Vector<Plane> planes;
+		Vector<Vector3> points;
+		PagedArray<RID> mesh_instances; // Storage is not thread safe, updated once all passes are culled.
+		bool animated_material_found = false;
+	};
+
+	ShadowCullPass shadow_cull_passes[MAX_UPDATE_SHADOWS];
+
 	RendererSceneRender::RenderSDFGIData render_sdfgi_data[SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE];
 	RendererSceneRender::RenderSDFGIUpdateData sdfgi_update_data;
 
@@ -888,14 +938,25 @@ public:
 	virtual Variant instance_geometry_get_shader_parameter_default_value(RID p_instance, const StringName &p_parameter) const;
 
 	_FORCE_INLINE_ void _update_instance(Instance *p_instance);
+	_FORCE_INLINE_ void _update_instance_transformed_aabb(Instance *p_instance);
+	_FORCE_INLINE_ bool _update_instance_transform(Instance *p_instance);
+	_FORCE_INLINE_ void _update_instance_indexer(Instance *p_instance);
+	_FORCE_INLINE_ void _update_instance_pairs(Instance *p_instance);
 	_FORCE_INLINE_ void _update_instance_aabb(Instance *p_instance);
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance);
+	_FORCE_INLINE_ void _update_instance_dependencies(Instance *p_instance);
+	_FORCE_INLINE_ void _update_dirty_instance_bounds(Instance *p_instance);
+	void _update_dirty_instance_bounds_threaded(uint32_t p_thread, LocalVector<Instance *> *p_instances);
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance);
 	void _unpair_instance(Instance *p_instance);
+	void _update_instance_visibility(Instance *p_instance);
+	void _remove_instance_visibility(Instance *p_instance);
+	void _scenario_update_visibility(Scenario *p_scenario, const Vector3 &p_camera_position, RID p_viewport);
 
 	void _light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect);
 
-	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_scren_lod_threshold);
+	_FORCE_INLINE_ bool _light_instance_setup_shadow_passes(Instance *p_instance);
+	_FORCE_INLINE_ void _shadow_cull_pass_add(Instance *p_instance, const Vector<Plane> &p_planes, uint32_t p_pass);
 
 	RID _render_get_environment(RID p_camera, RID p_scenario);
 
@@ -951,6 +1012,15 @@ public:
 	void _frustum_cull_threaded(uint32_t p_thread, CullData *cull_data);
 	void _frustum_cull(CullData &cull_data, FrustumCullResult &cull_result, uint64_t p_from, uint64_t p_to);
 
+	struct ShadowCullData {
+		Scenario *scenario;
+		uint32_t first_pass;
+	};
+
+	void _shadow_cull_pass_threaded(uint32_t p_index, ShadowCullData *p_cull_data);
+	void _shadow_cull_pass(Scenario *p_scenario, uint32_t p_pass);
+	void _cull_shadow_passes(Scenario *p_scenario, uint32_t p_first_pass);
+
 	bool _render_reflection_probe_step(Instance *p_instance, int p_step);
 	void _render_scene(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_render_buffers, RID p_environment, RID p_force_camera_effects, uint32_t p_visible_layers, RID p_scenario, RID p_viewport, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_lod_threshold, bool p_using_shadows = true);
 	void render_empty_scene(RID p_render_buffers, RID p_scenario, RID p_shadow_atlas);
@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/marshalls.h"
+#include "core/os/memory_tracker.h"
 #include "core/os/os.h"
 #include "core/templates/sort_array.h"
 #include "renderer_canvas_cull.h"
@@ -92,6 +93,8 @@ void RenderingServerDefault::request_frame_drawn_callback(Object *p_where, const
 }
 
 void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
+	MEMORY_TRACKING_SCOPE("rendering");
+
 	//needs to be done before changes is reset to 0, to not force the editor to redraw
 	RS::get_singleton()->emit_signal("frame_pre_draw");
 
@@ -258,6 +261,9 @@ void RenderingServerDefault::finish() {
 /* STATUS INFORMATION */
 
 uint64_t RenderingServerDefault::get_render_info(RenderInfo p_info) {
+	if (p_info == INFO_2D_BATCHES_IN_FRAME || p_info == INFO_2D_DRAW_CALLS_IN_FRAME) {
+		return RSG::canvas_render->get_render_info(p_info);
+	}
 	return RSG::storage->get_render_info(p_info);
 }
 
@@ -387,7 +393,7 @@ void RenderingServerDefault::draw(bool p_swap_buffers, double frame_step) {
 }
 
 RenderingServerDefault::RenderingServerDefault(bool p_create_thread) :
-		command_queue(p_create_thread) {
+		command_queue(p_create_thread, SERVER_WRAP_MT_COMMAND_QUEUE_MODE) {
 	create_thread = p_create_thread;
 
 	if (!p_create_thread) {
@@ -268,12 +268,14 @@ public:
 				RSG::storage->mesh_add_surface(mesh, p_surfaces[i]);
 			}
 		} else {
+			command_queue.begin_batch();
 			command_queue.push(RSG::storage, &RendererStorage::mesh_initialize, mesh);
 			command_queue.push(RSG::storage, &RendererStorage::mesh_set_blend_shape_count, mesh, p_blend_shape_count);
 			for (int i = 0; i < p_surfaces.size(); i++) {
 				RSG::storage->mesh_add_surface(mesh, p_surfaces[i]);
 				command_queue.push(RSG::storage, &RendererStorage::mesh_add_surface, mesh, p_surfaces[i]);
 			}
+			command_queue.end_batch();
 		}
 
 		return mesh;
@@ -1456,6 +1456,8 @@ public:
 		INFO_VIDEO_MEM_USED,
 		INFO_TEXTURE_MEM_USED,
 		INFO_VERTEX_MEM_USED,
+		INFO_2D_BATCHES_IN_FRAME,
+		INFO_2D_DRAW_CALLS_IN_FRAME,
 	};
 
 	virtual uint64_t get_render_info(RenderInfo p_info) = 0;
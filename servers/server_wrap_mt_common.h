@@ -28,6 +28,12 @@
 /* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
 /*************************************************************************/
 
+// Mode of the command queue of the servers using these macros. Can be forced at build time
+// (e.g. to CommandQueueMT::MODE_LOCK_FREE), otherwise it follows the project settings.
+#ifndef SERVER_WRAP_MT_COMMAND_QUEUE_MODE
+#define SERVER_WRAP_MT_COMMAND_QUEUE_MODE CommandQueueMT::MODE_PROJECT_SETTING
+#endif
+
 #define FUNC0R(m_r, m_type)                                                     \
 	virtual m_r m_type() override {                                             \
 		if (Thread::get_caller_id() != server_thread) {                         \
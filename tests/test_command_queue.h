@@ -104,7 +104,7 @@ public:
 	ThreadWork reader_threadwork;
 	ThreadWork writer_threadwork;
 
-	CommandQueueMT command_queue = CommandQueueMT(true);
+	CommandQueueMT command_queue;
 
 	enum TestMsgType {
 		TEST_MSG_FUNC1_TRANSFORM,
@@ -232,6 +232,61 @@ public:
 		reader_thread.wait_to_finish();
 		writer_thread.wait_to_finish();
 	}
+
+	SharedThreadState(CommandQueueMT::Mode p_mode = CommandQueueMT::MODE_PROJECT_SETTING) :
+			command_queue(true, p_mode) {}
+};
+
+class MultiWriterState {
+public:
+	enum {
+		WRITER_COUNT = 4,
+		MESSAGES_PER_WRITER = 1000,
+		MESSAGES_PER_BATCH = 10,
+	};
+
+	struct Writer {
+		MultiWriterState *state = nullptr;
+		int index = 0;
+		Thread thread;
+	};
+
+	CommandQueueMT command_queue = CommandQueueMT(false, CommandQueueMT::MODE_LOCK_FREE);
+	Writer writers[WRITER_COUNT];
+	int received[WRITER_COUNT] = {};
+	int out_of_order = 0;
+
+	void receive(int p_writer, int p_message) {
+		if (received[p_writer] != p_message) {
+			out_of_order++;
+		}
+		received[p_writer]++;
+	}
+
+	static void writer_loop(void *p_writer) {
+		Writer *writer = static_cast<Writer *>(p_writer);
+		CommandQueueMT &command_queue = writer->state->command_queue;
+		for (int i = 0; i < MESSAGES_PER_WRITER; i++) {
+			if (i % MESSAGES_PER_BATCH == 0) {
+				command_queue.begin_batch();
+			}
+			command_queue.push(writer->state, &MultiWriterState::receive, writer->index, i);
+			if (i % MESSAGES_PER_BATCH == MESSAGES_PER_BATCH - 1) {
+				command_queue.end_batch();
+			}
+		}
+	}
+
+	void write_all() {
+		for (int i = 0; i < WRITER_COUNT; i++) {
+			writers[i].state = this;
+			writers[i].index = i;
+			writers[i].thread.start(&MultiWriterState::writer_loop, &writers[i]);
+		}
+		for (int i = 0; i < WRITER_COUNT; i++) {
+			writers[i].thread.wait_to_finish();
+		}
+	}
 };
 
 TEST_CASE("[CommandQueue] Test Queue Basics") {
@@ -429,6 +484,146 @@ TEST_CASE("[CommandQueue] Test Queue Lapping") {
 			ProjectSettings::get_singleton()->property_get_revert(COMMAND_QUEUE_SETTING));
 }
 
+TEST_CASE("[CommandQueue] Test Lock-Free Queue Basics") {
+	SharedThreadState sts(CommandQueueMT::MODE_LOCK_FREE);
+	CHECK(sts.command_queue.is_lock_free());
+	sts.init_threads();
+
+	sts.add_msg_to_write(SharedThreadState::TEST_MSG_FUNC1_TRANSFORM);
+	sts.add_msg_to_write(SharedThreadState::TEST_MSG_FUNC3_TRANSFORMx6);
+	sts.writer_threadwork.main_start_work();
+	sts.writer_threadwork.main_wait_for_done();
+	CHECK_MESSAGE(sts.func1_count == 0,
+			"Control: no messages read before reader has run.");
+	CHECK_MESSAGE(sts.command_queue.get_pending_command_count() == 2,
+			"Both messages should be pending.");
+
+	sts.message_count_to_read = 1;
+	sts.reader_threadwork.main_start_work();
+	sts.reader_threadwork.main_wait_for_done();
+	CHECK_MESSAGE(sts.func1_count == 1,
+			"Reader should have read one message");
+
+	sts.message_count_to_read = -1;
+	sts.reader_threadwork.main_start_work();
+	sts.reader_threadwork.main_wait_for_done();
+	CHECK_MESSAGE(sts.func1_count == 2,
+			"Reader should have read one additional message from flush_all");
+	CHECK_MESSAGE(sts.command_queue.get_pending_command_count() == 0,
+			"No message should be pending after flush_all.");
+	CHECK_MESSAGE(sts.command_queue.get_peak_pending_command_count() == 1,
+			"The queue was flushed with one message pending.");
+
+	sts.add_msg_to_write(SharedThreadState::TEST_MSGSYNC_FUNC2_TRANSFORM_FLOAT);
+	sts.add_msg_to_write(SharedThreadState::TEST_MSGRET_FUNC1_TRANSFORM);
+	sts.writer_threadwork.main_start_work();
+	sts.message_count_to_read = 2;
+	sts.reader_threadwork.main_start_work();
+	sts.reader_threadwork.main_wait_for_done();
+	sts.writer_threadwork.main_wait_for_done();
+	CHECK_MESSAGE(sts.func1_count == 4,
+			"Reader should have read the messages the writer waited for.");
+
+	sts.destroy_threads();
+
+	CHECK_MESSAGE(sts.func1_count == 4,
+			"Reader should have read no additional messages after join");
+}
+
+TEST_CASE("[CommandQueue] Test Lock-Free Queue Batches") {
+	MultiWriterState mws;
+
+	mws.command_queue.begin_batch();
+	mws.command_queue.push(&mws, &MultiWriterState::receive, 0, 0);
+	mws.command_queue.push(&mws, &MultiWriterState::receive, 0, 1);
+	mws.command_queue.flush_if_pending();
+	CHECK_MESSAGE(mws.received[0] == 0,
+			"Messages of an unfinished batch should not be read.");
+
+	mws.command_queue.end_batch();
+	mws.command_queue.flush_if_pending();
+	CHECK_MESSAGE(mws.received[0] == 2,
+			"Messages of a finished batch should be read.");
+	CHECK(mws.out_of_order == 0);
+}
+
+TEST_CASE("[CommandQueue] Test Lock-Free Queue with Several Writers") {
+	MultiWriterState mws;
+	mws.write_all();
+
+	const uint32_t total_messages = MultiWriterState::WRITER_COUNT * MultiWriterState::MESSAGES_PER_WRITER;
+	CHECK_MESSAGE(mws.command_queue.get_pending_command_count() == total_messages,
+			"All messages from all writers should be pending.");
+
+	mws.command_queue.flush_all();
+	for (int i = 0; i < MultiWriterState::WRITER_COUNT; i++) {
+		CHECK_MESSAGE(mws.received[i] == MultiWriterState::MESSAGES_PER_WRITER,
+				"Reader should have read all messages from each writer.");
+	}
+	CHECK_MESSAGE(mws.out_of_order == 0,
+			"Messages from a writer should be read in the order they were written.");
+	CHECK(mws.command_queue.get_pending_command_count() == 0);
+	CHECK(mws.command_queue.get_peak_pending_command_count() == total_messages);
+}
+
+TEST_CASE("[CommandQueue] Test Lock-Free Queue with more short-lived Writers than Producers") {
+	// Every round starts new threads, 64 in total, twice the number of producer slots.
+	// The slots of exited writers have to be handed to later ones.
+	MultiWriterState mws;
+	const int rounds = 16;
+	for (int round = 0; round < rounds; round++) {
+		mws.write_all();
+		mws.command_queue.flush_all();
+		for (int i = 0; i < MultiWriterState::WRITER_COUNT; i++) {
+			CHECK_MESSAGE(mws.received[i] == MultiWriterState::MESSAGES_PER_WRITER,
+					"Reader should have read all messages from each writer.");
+			mws.received[i] = 0;
+		}
+	}
+	CHECK_MESSAGE(mws.out_of_order == 0,
+			"Messages from a writer should be read in the order they were written.");
+	CHECK(mws.command_queue.get_pending_command_count() == 0);
+}
+
+struct FloodingWriter {
+	enum {
+		// More than the staging blocks a queue of the default size is allowed to hold.
+		MESSAGE_COUNT = 50000,
+	};
+
+	MultiWriterState *state = nullptr;
+	SafeFlag done;
+
+	static void write(void *p_writer) {
+		FloodingWriter *writer = static_cast<FloodingWriter *>(p_writer);
+		for (int i = 0; i < MESSAGE_COUNT; i++) {
+			writer->state->command_queue.push(writer->state, &MultiWriterState::receive, 0, i);
+		}
+		writer->done.set();
+	}
+};
+
+TEST_CASE("[CommandQueue] Test Lock-Free Queue waiting for a flush when full") {
+	MultiWriterState mws;
+	FloodingWriter writer;
+	writer.state = &mws;
+
+	Thread thread;
+	thread.start(&FloodingWriter::write, &writer);
+	while (!writer.done.is_set()) {
+		mws.command_queue.flush_all();
+		OS::get_singleton()->delay_usec(100);
+	}
+	thread.wait_to_finish();
+	mws.command_queue.flush_all();
+
+	CHECK_MESSAGE(mws.received[0] == FloodingWriter::MESSAGE_COUNT,
+			"Reader should have read all messages, including the ones pushed after waiting.");
+	CHECK(mws.out_of_order == 0);
+	CHECK_MESSAGE(mws.command_queue.get_peak_pending_command_count() < FloodingWriter::MESSAGE_COUNT,
+			"The writer should have waited for the reader instead of staging every message.");
+}
+
 TEST_CASE("[Stress][CommandQueue] Stress test command queue") {
 	const char *COMMAND_QUEUE_SETTING = "memory/limits/command_queue/multithreading_queue_size_kb";
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING, 1);
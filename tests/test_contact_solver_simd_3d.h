@@ -0,0 +1,163 @@
+/*************************************************************************/
+/*  test_contact_solver_simd_3d.h                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_CONTACT_SOLVER_SIMD_3D_H
+#define TEST_CONTACT_SOLVER_SIMD_3D_H
+
+#include "servers/physics_3d/body_pair_3d_sw.h"
+#include "servers/physics_3d/broad_phase_3d_bvh.h"
+#include "servers/physics_3d/contact_solver_simd_3d_sw.h"
+#include "servers/physics_3d/shape_3d_sw.h"
+#include "servers/physics_3d/space_3d_sw.h"
+
+#include "tests/test_macros.h"
+
+namespace TestContactSolverSIMD3D {
+
+// A static floor with boxes stacked on it. Consecutive pairs share a box, so
+// even and odd pairs are solved as two colors, like Step3DSW does.
+class BoxStack {
+public:
+	enum {
+		BOX_COUNT = 9
+	};
+
+	Space3DSW *space = nullptr;
+	BoxShape3DSW *shape = nullptr;
+	Body3DSW *bodies[BOX_COUNT + 1];
+	BodyPair3DSW *pairs[BOX_COUNT];
+
+	void solve(bool p_simd, real_t p_step, int p_iterations) {
+		for (int i = 0; i < BOX_COUNT; i++) {
+			pairs[i]->setup(p_step);
+			pairs[i]->pre_solve(p_step);
+		}
+
+		for (int iteration = 0; iteration < p_iterations; iteration++) {
+			for (int color = 0; color < 2; color++) {
+				BodyPair3DSW *batch[BOX_COUNT];
+				uint32_t batch_count = 0;
+				for (int i = color; i < BOX_COUNT; i += 2) {
+					batch[batch_count++] = pairs[i];
+				}
+
+				if (p_simd) {
+					ContactSolverSIMD3DSW::solve(batch, batch_count, p_step);
+				} else {
+					for (uint32_t i = 0; i < batch_count; i++) {
+						batch[i]->solve(p_step);
+					}
+				}
+			}
+		}
+	}
+
+	BoxStack() {
+		if (!BroadPhase3DSW::create_func) {
+			BroadPhase3DSW::create_func = BroadPhase3DBVH::_create;
+		}
+
+		space = memnew(Space3DSW);
+		shape = memnew(BoxShape3DSW);
+		shape->set_data(Vector3(0.5, 0.5, 0.5));
+
+		for (int i = 0; i <= BOX_COUNT; i++) {
+			Body3DSW *body = memnew(Body3DSW);
+			body->add_shape(shape);
+			if (i == 0) {
+				body->set_mode(PhysicsServer3D::BODY_MODE_STATIC);
+				body->set_state(PhysicsServer3D::BODY_STATE_TRANSFORM, Transform(Basis(), Vector3(0, -0.5, 0)));
+			} else {
+				// Slightly overlapping, turned and moving, so bias, friction and angular terms all take part.
+				Transform xform(Basis(Vector3(0, 1, 0), 0.05 * i), Vector3(0.02 * i, 0.49 + (i - 1) * 0.98, 0));
+				body->set_state(PhysicsServer3D::BODY_STATE_TRANSFORM, xform);
+				body->set_linear_velocity(Vector3(0.1, -1.0, 0.05 * i));
+				body->set_angular_velocity(Vector3(0.0, 0.2, 0.1));
+			}
+			body->set_space(space);
+			body->update_inertias();
+			bodies[i] = body;
+		}
+
+		for (int i = 0; i < BOX_COUNT; i++) {
+			pairs[i] = memnew(BodyPair3DSW(bodies[i], 0, bodies[i + 1], 0));
+		}
+	}
+
+	~BoxStack() {
+		for (int i = 0; i < BOX_COUNT; i++) {
+			memdelete(pairs[i]);
+		}
+		for (int i = 0; i <= BOX_COUNT; i++) {
+			bodies[i]->remove_shape(0);
+			bodies[i]->set_space(nullptr);
+			memdelete(bodies[i]);
+		}
+		memdelete(shape);
+		memdelete(space);
+	}
+};
+
+static bool is_close(const Vector3 &p_a, const Vector3 &p_b) {
+	const real_t epsilon = 1e-3;
+	return (p_a - p_b).length() <= epsilon * MAX(1.0, p_a.length());
+}
+
+TEST_CASE("[ContactSolverSIMD3DSW] Matches the scalar solver on a box stack") {
+	const real_t step = 1.0 / 60.0;
+	const int iterations = 8;
+
+	BoxStack scalar;
+	BoxStack simd;
+	scalar.solve(false, step, iterations);
+	simd.solve(true, step, iterations);
+
+	for (int i = 0; i < BoxStack::BOX_COUNT; i++) {
+		REQUIRE(scalar.pairs[i]->get_contact_count() == simd.pairs[i]->get_contact_count());
+		CHECK_MESSAGE(scalar.pairs[i]->get_contact_count() > 0, "Stacked boxes are expected to touch.");
+		for (int j = 0; j < scalar.pairs[i]->get_contact_count(); j++) {
+			CHECK_MESSAGE(is_close(scalar.pairs[i]->get_contact_impulse(j), simd.pairs[i]->get_contact_impulse(j)),
+					vformat("Contact impulse %d of pair %d differs.", j, i));
+		}
+	}
+
+	for (int i = 1; i <= BoxStack::BOX_COUNT; i++) {
+		const Body3DSW *a = scalar.bodies[i];
+		const Body3DSW *b = simd.bodies[i];
+		CHECK_MESSAGE(is_close(a->get_linear_velocity(), b->get_linear_velocity()), vformat("Linear velocity of box %d differs.", i));
+		CHECK_MESSAGE(is_close(a->get_angular_velocity(), b->get_angular_velocity()), vformat("Angular velocity of box %d differs.", i));
+		CHECK_MESSAGE(is_close(a->get_biased_linear_velocity(), b->get_biased_linear_velocity()), vformat("Biased linear velocity of box %d differs.", i));
+		CHECK_MESSAGE(is_close(a->get_biased_angular_velocity(), b->get_biased_angular_velocity()), vformat("Biased angular velocity of box %d differs.", i));
+	}
+}
+
+} // namespace TestContactSolverSIMD3D
+
+#endif // TEST_CONTACT_SOLVER_SIMD_3D_H
@@ -155,5 +155,50 @@ TEST_CASE("[Dictionary] keys() and values()") {
 	CHECK(int(keys[0]) == 1);
 	CHECK(int(values[0]) == 3);
 }
+
+TEST_CASE("[Dictionary] Insertion order is kept across erase()") {
+	Dictionary map;
+	for (int i = 0; i < 6; i++) {
+		map[i] = i * 10;
+	}
+	map.erase(1);
+	map.erase(4);
+	map[1] = 100;
+
+	Array keys = map.keys();
+	REQUIRE(keys.size() == 5);
+	CHECK(int(keys[0]) == 0);
+	CHECK(int(keys[1]) == 2);
+	CHECK(int(keys[2]) == 3);
+	CHECK(int(keys[3]) == 5);
+	CHECK(int(keys[4]) == 1);
+	CHECK(int(map.get_key_at_index(3)) == 5);
+	CHECK(int(map.get_value_at_index(4)) == 100);
+
+	int count = 0;
+	const Variant *key = nullptr;
+	while ((key = map.next(key))) {
+		CHECK(*key == keys[count]);
+		count++;
+	}
+	CHECK(count == 5);
+}
+
+TEST_CASE("[Dictionary] Insertion and erase churn") {
+	Dictionary map;
+	for (int i = 0; i < 20000; i++) {
+		map[i] = i;
+		if (i % 3 != 0) {
+			map.erase(i - 1);
+		}
+	}
+	for (int i = 0; i < 20000; i++) {
+		const bool kept = i == 19999 || (i + 1) % 3 == 0;
+		CHECK(map.has(i) == kept);
+	}
+	CHECK(map.size() == 6667);
+	CHECK(int(map.get_key_at_index(0)) == 2);
+	CHECK(int(map.get_value_at_index(map.size() - 1)) == 19999);
+}
 } // namespace TestDictionary
 #endif // TEST_DICTIONARY_H
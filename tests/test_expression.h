@@ -32,6 +32,7 @@
 #define TEST_EXPRESSION_H
 
 #include "core/math/expression.h"
+#include "core/os/thread.h"
 
 #include "tests/test_macros.h"
 
@@ -439,6 +440,91 @@ TEST_CASE("[Expression] Unusual expressions") {
 	//		int64_t(expression.execute()) == 0,
 	//		"`(-9223372036854775807 - 1) / -1` should return the expected result.");
 }
+
+TEST_CASE("[Expression] Repeated execution") {
+	Expression expression;
+	Vector<String> parameter_names;
+	parameter_names.push_back("x");
+	parameter_names.push_back("t");
+
+	CHECK_MESSAGE(
+			expression.parse("t * Vector3(x, 2 * 3, sqrt(16)) * Vector3(1, 2, 1).y", parameter_names) == OK,
+			"The expression should parse successfully.");
+	for (int i = 0; i < 4; i++) {
+		Array inputs;
+		inputs.push_back(i);
+		inputs.push_back(Transform(Basis(), Vector3(i, 0, 0)));
+		CHECK_MESSAGE(
+				Vector3(expression.execute(inputs)) == Vector3(4 * i, 12, 8),
+				"Every execution should use its own inputs.");
+	}
+
+	CHECK_MESSAGE(
+			expression.parse("[x, {x: 1}]", parameter_names) == OK,
+			"The expression should parse successfully.");
+	Array inputs;
+	inputs.push_back(1);
+	Array first = expression.execute(inputs);
+	first.push_back(2);
+	Array second = expression.execute(inputs);
+	CHECK_MESSAGE(
+			second.size() == 2,
+			"Every execution should return a new array.");
+
+	CHECK_MESSAGE(
+			expression.parse("Vector2(1, 2).x + x", parameter_names) == OK,
+			"The expression should parse successfully.");
+	ERR_PRINT_OFF;
+	expression.execute(Array());
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(
+			expression.has_execute_failed(),
+			"Inputs that weren't passed should fail the execution.");
+	CHECK_MESSAGE(
+			int(expression.execute(inputs)) == 2,
+			"The expression should run again after a failed execution.");
+}
+
+struct ConcurrentExecution {
+	Expression *expression = nullptr;
+	int64_t offset = 0;
+	int mismatches = 0;
+
+	static void execute_loop(void *p_execution) {
+		ConcurrentExecution *execution = static_cast<ConcurrentExecution *>(p_execution);
+		for (int64_t i = 0; i < 1000; i++) {
+			Array inputs;
+			inputs.push_back(execution->offset + i);
+			if (int64_t(execution->expression->execute(inputs)) != (execution->offset + i) * 3 + 1) {
+				execution->mismatches++;
+			}
+		}
+	}
+};
+
+TEST_CASE("[Expression] Concurrent execution") {
+	Expression expression;
+	Vector<String> parameter_names;
+	parameter_names.push_back("x");
+	CHECK_MESSAGE(
+			expression.parse("(x + x) + (x + 1)", parameter_names) == OK,
+			"The expression should parse successfully.");
+
+	const int thread_count = 4;
+	ConcurrentExecution executions[thread_count];
+	Thread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		executions[i].expression = &expression;
+		executions[i].offset = i * 1000000;
+		threads[i].start(&ConcurrentExecution::execute_loop, &executions[i]);
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+		CHECK_MESSAGE(
+				executions[i].mismatches == 0,
+				"Executions on other threads shouldn't change the result.");
+	}
+}
 } // namespace TestExpression
 
 #endif // TEST_EXPRESSION_H
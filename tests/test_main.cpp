@@ -40,6 +40,7 @@
 #include "test_color.h"
 #include "test_command_queue.h"
 #include "test_config_file.h"
+#include "test_contact_solver_simd_3d.h"
 #include "test_crypto.h"
 #include "test_curve.h"
 #include "test_dictionary.h"
@@ -57,6 +58,7 @@
 #include "test_lru.h"
 #include "test_marshalls.h"
 #include "test_math.h"
+#include "test_memory_tracker.h"
 #include "test_method_bind.h"
 #include "test_node_path.h"
 #include "test_oa_hash_map.h"
@@ -71,9 +73,13 @@
 #include "test_rect2.h"
 #include "test_render.h"
 #include "test_resource.h"
+#include "test_rid_owner.h"
 #include "test_shader_lang.h"
+#include "test_small_object_allocator.h"
 #include "test_string.h"
+#include "test_string_name.h"
 #include "test_text_server.h"
+#include "test_thread_work_pool.h"
 #include "test_translation.h"
 #include "test_validate_testing.h"
 #include "test_variant.h"
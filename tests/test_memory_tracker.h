@@ -0,0 +1,103 @@
+/*************************************************************************/
+/*  test_memory_tracker.h                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_MEMORY_TRACKER_H
+#define TEST_MEMORY_TRACKER_H
+
+#include "core/os/memory_tracker.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMemoryTracker {
+
+TEST_CASE("[MemoryTracker] Categories are named after the call site directory") {
+	uint32_t category = MemoryTracker::get_category("tests/memory_tracker/first.cpp");
+	CHECK(String(MemoryTracker::get_category_name(category)) == "tests/memory_tracker");
+	CHECK_MESSAGE(MemoryTracker::get_category("tests/memory_tracker/second.h") == category, "Files in the same directory should share their category.");
+	CHECK(MemoryTracker::get_category("./tests/memory_tracker/third.cpp") == category);
+
+	CHECK_MESSAGE(MemoryTracker::get_category("/home/user/godot/tests/memory_tracker/fourth.cpp") == category, "Absolute paths should be made relative to the source tree.");
+	CHECK(MemoryTracker::get_category("C:\\godot\\tests\\memory_tracker\\fifth.cpp") == category);
+
+	uint32_t named = MemoryTracker::get_category("memory_tracker_test");
+	CHECK(String(MemoryTracker::get_category_name(named)) == "memory_tracker_test");
+	CHECK(named != category);
+}
+
+TEST_CASE("[MemoryTracker] Scopes") {
+	uint32_t generic = MemoryTracker::get_category("core/templates/memory_tracker_test.h");
+	uint32_t specific = MemoryTracker::get_category("tests/memory_tracker/scopes.cpp");
+
+	{
+		MemoryTracker::Scope scope("memory_tracker_scope");
+		uint32_t scoped = MemoryTracker::get_category("core/templates/memory_tracker_test.h");
+		CHECK(String(MemoryTracker::get_category_name(scoped)) == "memory_tracker_scope");
+		CHECK_MESSAGE(MemoryTracker::get_category("tests/memory_tracker/scopes.cpp") == specific, "Scopes should only apply to generic categories.");
+
+		{
+			MemoryTracker::Scope inner_scope("memory_tracker_inner_scope");
+			CHECK(String(MemoryTracker::get_category_name(MemoryTracker::get_category("core/templates/memory_tracker_test.h"))) == "memory_tracker_inner_scope");
+		}
+		CHECK(MemoryTracker::get_category("core/templates/memory_tracker_test.h") == scoped);
+	}
+
+	CHECK(MemoryTracker::get_category("core/templates/memory_tracker_test.h") == generic);
+	CHECK(String(MemoryTracker::get_category_name(generic)) == "core/templates");
+}
+
+TEST_CASE("[MemoryTracker] Counters") {
+	uint32_t category = MemoryTracker::get_category("tests/memory_tracker_counters/counters.cpp");
+	uint64_t live_bytes = MemoryTracker::get_category_live_bytes(category);
+	uint64_t live_allocations = MemoryTracker::get_category_live_allocations(category);
+	uint64_t allocated_bytes = MemoryTracker::get_category_allocated_bytes(category);
+	uint64_t allocation_count = MemoryTracker::get_category_allocation_count(category);
+
+	MemoryTracker::track_alloc(category, 100);
+	MemoryTracker::track_alloc(category, 50);
+	CHECK(MemoryTracker::get_category_live_bytes(category) == live_bytes + 150);
+	CHECK(MemoryTracker::get_category_live_allocations(category) == live_allocations + 2);
+
+	MemoryTracker::track_realloc(category, 100, 300);
+	MemoryTracker::track_realloc(category, 50, 10);
+	CHECK(MemoryTracker::get_category_live_bytes(category) == live_bytes + 310);
+	CHECK(MemoryTracker::get_category_live_allocations(category) == live_allocations + 2);
+
+	MemoryTracker::track_free(category, 300);
+	MemoryTracker::track_free(category, 10);
+	CHECK(MemoryTracker::get_category_live_bytes(category) == live_bytes);
+	CHECK(MemoryTracker::get_category_live_allocations(category) == live_allocations);
+
+	CHECK_MESSAGE(MemoryTracker::get_category_allocated_bytes(category) == allocated_bytes + 350, "Allocated bytes should only count growth.");
+	CHECK(MemoryTracker::get_category_allocation_count(category) == allocation_count + 2);
+}
+
+} // namespace TestMemoryTracker
+
+#endif // TEST_MEMORY_TRACKER_H
@@ -33,6 +33,8 @@
 
 #include "core/core_string_names.h"
 #include "core/object/object.h"
+#include "core/os/os.h"
+#include "core/templates/thread_work_pool.h"
 
 #include "thirdparty/doctest/doctest.h"
 
@@ -300,6 +302,91 @@ TEST_CASE("[Object] Absent name getter") {
 			actual_value == Variant(),
 			"The returned value should equal nil variant.");
 }
+
+class ObjectSpawner {
+public:
+	static const int objects_per_round = 256;
+	static const int round_count = 8;
+
+	SafeNumeric<uint32_t> failures;
+
+	void spawn(uint32_t p_index, void *p_userdata) {
+		Object *objects[objects_per_round];
+		ObjectID ids[objects_per_round];
+
+		for (int round = 0; round < round_count; round++) {
+			for (int i = 0; i < objects_per_round; i++) {
+				objects[i] = memnew(Object);
+				ids[i] = objects[i]->get_instance_id();
+			}
+			for (int i = 0; i < objects_per_round; i++) {
+				if (ObjectDB::get_instance(ids[i]) != objects[i]) {
+					failures.increment();
+				}
+			}
+			for (int i = 0; i < objects_per_round; i++) {
+				memdelete(objects[i]);
+			}
+			for (int i = 0; i < objects_per_round; i++) {
+				// The slot may be reused already, but never under the same ID.
+				if (ObjectDB::get_instance(ids[i]) != nullptr) {
+					failures.increment();
+				}
+			}
+		}
+	}
+};
+
+TEST_CASE("[Object] Inherited names resolve through the ClassDB lookup tables") {
+	ClassDB::register_class<_TestDerivedObject>();
+	// Registered after the tables were built, so lookups start by walking up to Object.
+	_TestDerivedObject derived_object;
+
+	bool valid = false;
+	CHECK(derived_object.get("get_class", &valid).get_type() == Variant::CALLABLE);
+	CHECK(valid);
+	CHECK(derived_object.get("script_changed", &valid).get_type() == Variant::SIGNAL);
+	CHECK(valid);
+	CHECK(int(derived_object.get("NOTIFICATION_PREDELETE", &valid)) == Object::NOTIFICATION_PREDELETE);
+	CHECK(valid);
+	CHECK(ClassDB::get_method(derived_object.get_class_name(), "get_class") == ClassDB::get_method("Object", "get_class"));
+	CHECK(ClassDB::has_method(derived_object.get_class_name(), "set_meta"));
+	CHECK_FALSE(ClassDB::has_method(derived_object.get_class_name(), "set_meta", true));
+
+	ClassDB::build_lookup_tables();
+
+	derived_object.set("property", 42, &valid);
+	CHECK(valid);
+	CHECK(derived_object.get_property() == 42);
+	CHECK(int(derived_object.get("property", &valid)) == 42);
+	CHECK(valid);
+	CHECK(ClassDB::get_method(derived_object.get_class_name(), "get_property") != nullptr);
+	CHECK(ClassDB::get_method(derived_object.get_class_name(), "absent_name") == nullptr);
+	CHECK(ClassDB::has_property(derived_object.get_class_name(), "property"));
+	CHECK_FALSE(ClassDB::has_property(derived_object.get_class_name(), "get_property"));
+	derived_object.get("absent_name", &valid);
+	CHECK(!valid);
+}
+
+TEST_CASE("[Object] Concurrent creation and deletion") {
+	const int job_count = 64;
+
+	int object_count = ObjectDB::get_object_count();
+
+	ObjectSpawner spawner;
+	ThreadWorkPool pool;
+	pool.init();
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	pool.do_work(job_count, &spawner, &ObjectSpawner::spawn, (void *)nullptr);
+	uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("Created and deleted %d objects on %d threads in %d usec.", job_count * ObjectSpawner::objects_per_round * ObjectSpawner::round_count, pool.get_thread_count(), elapsed).utf8().get_data());
+	pool.finish();
+
+	CHECK_MESSAGE(spawner.failures.get() == 0, "Every ID should resolve to its object while alive and to nothing once deleted.");
+	CHECK_MESSAGE(ObjectDB::get_object_count() == object_count, "The object count should be back to where it started.");
+}
 } // namespace TestObject
 
 #endif // TEST_OBJECT_H
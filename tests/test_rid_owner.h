@@ -0,0 +1,197 @@
+/*************************************************************************/
+/*  test_rid_owner.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_RID_OWNER_H
+#define TEST_RID_OWNER_H
+
+#include "core/templates/rid_owner.h"
+#include "core/templates/thread_work_pool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRIDOwner {
+
+TEST_CASE("[RID_Owner] Make and free") {
+	RID_Owner<int> owner;
+
+	RID a = owner.make_rid(1);
+	RID b = owner.make_rid(2);
+	CHECK(owner.get_rid_count() == 2);
+	CHECK(*owner.getornull(a) == 1);
+	CHECK(*owner.getornull(b) == 2);
+	CHECK(owner.owns(a));
+
+	owner.free(a);
+	CHECK(owner.get_rid_count() == 1);
+	CHECK_MESSAGE(owner.getornull(a) == nullptr, "A freed RID should not resolve, even once its element is reused.");
+	CHECK(!owner.owns(a));
+
+	RID c = owner.make_rid(3);
+	CHECK(owner.getornull(a) == nullptr);
+	CHECK(*owner.getornull(c) == 3);
+
+	owner.free(b);
+	owner.free(c);
+	CHECK(owner.get_rid_count() == 0);
+}
+
+TEST_CASE("[RID_Owner] Iteration by index") {
+	RID_PtrOwner<int> owner;
+	int values[3] = { 1, 2, 3 };
+
+	RID a = owner.make_rid(&values[0]);
+	RID b = owner.make_rid(&values[1]);
+	RID c = owner.allocate_rid();
+	owner.free(a);
+
+	int found = 0;
+	for (uint32_t i = 0; i < owner.get_max_index(); i++) {
+		int *value = owner.get_ptr_by_index(i);
+		if (value) {
+			CHECK_MESSAGE(value == &values[1], "Freed and uninitialized elements should be skipped.");
+			found++;
+		}
+	}
+	CHECK(found == 1);
+
+	owner.initialize_rid(c, &values[2]);
+	found = 0;
+	for (uint32_t i = 0; i < owner.get_max_index(); i++) {
+		if (owner.get_ptr_by_index(i)) {
+			found++;
+		}
+	}
+	CHECK(found == 2);
+
+	owner.free(b);
+	owner.free(c);
+}
+
+TEST_CASE("[RID_Owner] Batch allocation") {
+	const uint32_t count = 5000;
+
+	RID_Owner<uint32_t, true> owner(64);
+	LocalVector<uint32_t> values;
+	LocalVector<RID> rids;
+	values.resize(count);
+	rids.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		values[i] = i;
+	}
+
+	owner.make_rids(values.ptr(), count, rids.ptr());
+	CHECK(owner.get_rid_count() == count);
+
+	List<RID> owned;
+	owner.get_owned_list(&owned);
+	CHECK(owned.size() == (int)count);
+
+	bool all_valid = true;
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t *value = owner.getornull(rids[i]);
+		all_valid = all_valid && value && *value == i;
+	}
+	CHECK_MESSAGE(all_valid, "Every RID of the batch should resolve to its own value.");
+
+	owner.free_rids(rids.ptr(), count);
+	CHECK(owner.get_rid_count() == 0);
+
+	bool all_freed = true;
+	for (uint32_t i = 0; i < count; i++) {
+		all_freed = all_freed && owner.getornull(rids[i]) == nullptr;
+	}
+	CHECK(all_freed);
+
+	owner.allocate_rids(count, rids.ptr());
+	for (uint32_t i = 0; i < count; i++) {
+		owner.initialize_rid(rids[i], i * 2);
+	}
+	CHECK(*owner.getornull(rids[count - 1]) == (count - 1) * 2);
+	owner.free_rids(rids.ptr(), count);
+}
+
+class RIDStreamer {
+public:
+	static const uint32_t rids_per_job = 256;
+
+	RID_Owner<uint64_t, true> owner;
+	SafeNumeric<uint32_t> failures;
+
+	void stream(uint32_t p_index, void *p_userdata) {
+		RID rids[rids_per_job];
+		uint64_t values[rids_per_job];
+
+		for (int round = 0; round < 16; round++) {
+			for (uint32_t i = 0; i < rids_per_job; i++) {
+				values[i] = (uint64_t(p_index) << 32) | i;
+			}
+
+			// Mix single and batch calls.
+			if (round % 2) {
+				owner.make_rids(values, rids_per_job, rids);
+			} else {
+				for (uint32_t i = 0; i < rids_per_job; i++) {
+					rids[i] = owner.make_rid(values[i]);
+				}
+			}
+
+			for (uint32_t i = 0; i < rids_per_job; i++) {
+				uint64_t *value = owner.getornull(rids[i]);
+				if (!value || *value != values[i]) {
+					failures.increment();
+				}
+			}
+
+			if (round % 2) {
+				for (uint32_t i = 0; i < rids_per_job; i++) {
+					owner.free(rids[i]);
+				}
+			} else {
+				owner.free_rids(rids, rids_per_job);
+			}
+		}
+	}
+};
+
+TEST_CASE("[RID_Owner] Concurrent allocation") {
+	RIDStreamer streamer;
+
+	ThreadWorkPool pool;
+	pool.init();
+	pool.do_work(64, &streamer, &RIDStreamer::stream, (void *)nullptr);
+	pool.finish();
+
+	CHECK_MESSAGE(streamer.failures.get() == 0, "Every RID should resolve to the value it was made with.");
+	CHECK(streamer.owner.get_rid_count() == 0);
+}
+
+} // namespace TestRIDOwner
+
+#endif // TEST_RID_OWNER_H
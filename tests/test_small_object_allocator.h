@@ -0,0 +1,137 @@
+/*************************************************************************/
+/*  test_small_object_allocator.h                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_SMALL_OBJECT_ALLOCATOR_H
+#define TEST_SMALL_OBJECT_ALLOCATOR_H
+
+#include "core/os/memory.h"
+#include "core/os/small_object_allocator.h"
+
+#include "tests/test_macros.h"
+
+#include <thread>
+
+namespace TestSmallObjectAllocator {
+
+TEST_CASE("[SmallObjectAllocator] Size classes") {
+	for (size_t size = 1; size <= SmallObjectAllocator::MAX_SIZE; size++) {
+		void *block = SmallObjectAllocator::alloc(size);
+		REQUIRE(block != nullptr);
+		CHECK(SmallObjectAllocator::owns(block));
+		CHECK(((uintptr_t)block & 15) == 0);
+
+		size_t block_size = SmallObjectAllocator::get_block_size(block);
+		CHECK_MESSAGE(block_size >= size, "Block must be big enough for the requested size.");
+
+		// The block should come from the smallest size class that fits.
+		for (int i = 0; i < SmallObjectAllocator::SIZE_CLASS_COUNT; i++) {
+			uint32_t class_block_size = SmallObjectAllocator::get_size_class_block_size(i);
+			if (class_block_size >= size) {
+				CHECK(block_size == class_block_size);
+				break;
+			}
+		}
+
+		SmallObjectAllocator::free(block);
+	}
+	SmallObjectAllocator::flush_thread_cache();
+}
+
+TEST_CASE("[SmallObjectAllocator] Stats") {
+	const int size_class = 2;
+	const uint32_t block_size = SmallObjectAllocator::get_size_class_block_size(size_class);
+	const int block_count = 1000;
+
+	SmallObjectAllocator::flush_thread_cache();
+	uint64_t used_before = SmallObjectAllocator::get_size_class_used_blocks(size_class);
+
+	void *blocks[block_count];
+	for (int i = 0; i < block_count; i++) {
+		blocks[i] = SmallObjectAllocator::alloc(block_size);
+		memset(blocks[i], i & 0xFF, block_size);
+	}
+
+	SmallObjectAllocator::flush_thread_cache();
+	CHECK(SmallObjectAllocator::get_size_class_used_blocks(size_class) == used_before + block_count);
+	CHECK(SmallObjectAllocator::get_size_class_reserved_blocks(size_class) >= used_before + block_count);
+
+	bool blocks_intact = true;
+	for (int i = 0; i < block_count; i++) {
+		uint8_t *bytes = (uint8_t *)blocks[i];
+		blocks_intact = blocks_intact && bytes[0] == (i & 0xFF) && bytes[block_size - 1] == (i & 0xFF);
+		SmallObjectAllocator::free(blocks[i]);
+	}
+	CHECK_MESSAGE(blocks_intact, "Blocks shouldn't overlap.");
+
+	SmallObjectAllocator::flush_thread_cache();
+	CHECK(SmallObjectAllocator::get_size_class_used_blocks(size_class) == used_before);
+}
+
+TEST_CASE("[SmallObjectAllocator] Caches of threads not started through Thread") {
+	const int size_class = 3;
+	const uint32_t block_size = SmallObjectAllocator::get_size_class_block_size(size_class);
+	const int block_count = 100;
+
+	SmallObjectAllocator::flush_thread_cache();
+	uint64_t used_before = SmallObjectAllocator::get_size_class_used_blocks(size_class);
+
+	void *blocks[block_count];
+	std::thread thread([&blocks, block_size]() {
+		for (int i = 0; i < block_count; i++) {
+			blocks[i] = SmallObjectAllocator::alloc(block_size);
+		}
+		for (int i = 0; i < block_count / 2; i++) {
+			SmallObjectAllocator::free(blocks[i]);
+		}
+	});
+	thread.join();
+
+	CHECK_MESSAGE(SmallObjectAllocator::get_size_class_used_blocks(size_class) == used_before + block_count / 2,
+			"The cache of the thread should have been flushed when it exited.");
+
+	for (int i = block_count / 2; i < block_count; i++) {
+		SmallObjectAllocator::free(blocks[i]);
+	}
+	SmallObjectAllocator::flush_thread_cache();
+	CHECK(SmallObjectAllocator::get_size_class_used_blocks(size_class) == used_before);
+}
+
+TEST_CASE("[SmallObjectAllocator] Memory from other allocators") {
+	void *big = memalloc(SmallObjectAllocator::MAX_SIZE * 2);
+	CHECK_FALSE(SmallObjectAllocator::owns(big));
+	memfree(big);
+
+	int stack_value = 0;
+	CHECK_FALSE(SmallObjectAllocator::owns(&stack_value));
+}
+
+} // namespace TestSmallObjectAllocator
+
+#endif // TEST_SMALL_OBJECT_ALLOCATOR_H
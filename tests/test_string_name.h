@@ -0,0 +1,110 @@
+/*************************************************************************/
+/*  test_string_name.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/string/string_name.h"
+#include "core/templates/thread_work_pool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	StringName from_cstring("test_string_name_interning");
+	StringName from_string(String("test_string_name_interning"));
+	StringName from_static = _scs_create("test_string_name_interning");
+
+	CHECK(from_cstring == from_string);
+	CHECK(from_cstring == from_static);
+	CHECK(from_cstring.data_unique_pointer() == from_string.data_unique_pointer());
+	CHECK(String(from_cstring) == "test_string_name_interning");
+
+	CHECK(StringName::search("test_string_name_interning") == from_cstring);
+	CHECK(StringName::search(U"test_string_name_interning") == from_cstring);
+	CHECK(StringName::search(String("test_string_name_interning")) == from_cstring);
+	CHECK(StringName::search("test_string_name_missing") == StringName());
+
+	CHECK(StringName("test_string_name_other") != from_cstring);
+	CHECK(StringName("") == StringName());
+}
+
+TEST_CASE("[StringName] Released names can be interned again") {
+	for (int i = 0; i < 5000; i++) {
+		String name = "test_string_name_released_" + itos(i);
+		{
+			StringName released(name);
+		}
+		CHECK_MESSAGE(StringName::search(name) == StringName(), "Released names shouldn't be found anymore.");
+
+		StringName again(name);
+		CHECK(String(again) == name);
+		CHECK(StringName::search(name) == again);
+	}
+}
+
+class Interner {
+public:
+	Vector<String> names;
+	StringName *results = nullptr;
+
+	void intern(uint32_t p_index, void *p_userdata) {
+		const String &name = names[p_index % names.size()];
+		StringName temporary(name);
+		results[p_index] = StringName(name);
+	}
+};
+
+TEST_CASE("[StringName] Concurrent interning") {
+	const int name_count = 100;
+	const int intern_count = 10000;
+
+	Interner interner;
+	for (int i = 0; i < name_count; i++) {
+		interner.names.push_back("test_string_name_concurrent_" + itos(i));
+	}
+	interner.results = memnew_arr(StringName, intern_count);
+
+	ThreadWorkPool pool;
+	pool.init();
+	pool.do_work(intern_count, &interner, &Interner::intern, (void *)nullptr);
+	pool.finish();
+
+	for (int i = 0; i < intern_count; i++) {
+		CHECK_MESSAGE(interner.results[i] == StringName(interner.names[i % name_count]), "Each name should be interned only once.");
+	}
+
+	memdelete_arr(interner.results);
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
@@ -0,0 +1,153 @@
+/*************************************************************************/
+/*  test_thread_work_pool.h                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_THREAD_WORK_POOL_H
+#define TEST_THREAD_WORK_POOL_H
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/thread_work_pool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestThreadWorkPool {
+
+class Summer {
+public:
+	std::atomic<uint64_t> sum;
+
+	void add_index(uint32_t p_index, void *p_userdata) {
+		sum.fetch_add(p_index, std::memory_order_relaxed);
+	}
+
+	void nested_sum(uint32_t p_index, void *p_userdata) {
+		ThreadWorkPool pool;
+		pool.init();
+		pool.do_work(100, this, &Summer::add_index, p_userdata);
+	}
+
+	Summer() {
+		sum.store(0);
+	}
+};
+
+class Ordered {
+public:
+	std::atomic<uint32_t> done;
+	std::atomic<uint32_t> early;
+	Ordered *after = nullptr;
+
+	void run(uint32_t p_index, void *p_userdata) {
+		if (after && after->done.load(std::memory_order_acquire) != 1000) {
+			early.fetch_add(1, std::memory_order_relaxed);
+		}
+		OS::get_singleton()->delay_usec(10);
+		done.fetch_add(1, std::memory_order_release);
+	}
+
+	Ordered() {
+		done.store(0);
+		early.store(0);
+	}
+};
+
+static void end_work_thread(void *p_pool) {
+	static_cast<ThreadWorkPool *>(p_pool)->end_work();
+}
+
+TEST_CASE("[ThreadWorkPool] All elements are processed once") {
+	Summer summer;
+	ThreadWorkPool pool;
+	pool.init();
+	pool.do_work(10000, &summer, &Summer::add_index, (void *)nullptr);
+	CHECK(summer.sum.load() == 49995000);
+	CHECK(!pool.is_working());
+}
+
+TEST_CASE("[ThreadWorkPool] Concurrent pools with a dependency") {
+	Summer first;
+	Summer second;
+	ThreadWorkPool pool_a;
+	ThreadWorkPool pool_b;
+	pool_a.init();
+	pool_b.init();
+
+	pool_a.begin_work(1000, &first, &Summer::add_index, (void *)nullptr);
+	pool_b.begin_work(1000, &second, &Summer::add_index, (void *)nullptr, &pool_a);
+	pool_b.end_work();
+	CHECK_MESSAGE(first.sum.load() == 499500, "Dependency must be done before the dependent work ends.");
+	pool_a.end_work();
+	CHECK(second.sum.load() == 499500);
+}
+
+TEST_CASE("[ThreadWorkPool] Dependency ended on another thread") {
+	Ordered first;
+	Ordered second;
+	second.after = &first;
+	ThreadWorkPool pool_a;
+	ThreadWorkPool pool_b;
+	pool_a.init();
+	pool_b.init();
+
+	pool_a.begin_work(1000, &first, &Ordered::run, (void *)nullptr);
+	pool_b.begin_work(1000, &second, &Ordered::run, (void *)nullptr, &pool_a);
+
+	// Whatever the thread ending pool_a runs must still hold back pool_b.
+	Thread thread;
+	thread.start(end_work_thread, &pool_a);
+	pool_b.end_work();
+	thread.wait_to_finish();
+
+	CHECK(first.done.load() == 1000);
+	CHECK(second.done.load() == 1000);
+	CHECK_MESSAGE(second.early.load() == 0, "Dependent work must not start before the dependency is done.");
+}
+
+TEST_CASE("[ThreadWorkPool] Nested dispatch") {
+	Summer summer;
+	ThreadWorkPool pool;
+	pool.init();
+	pool.do_work(64, &summer, &Summer::nested_sum, (void *)nullptr);
+	CHECK(summer.sum.load() == 64 * 4950);
+}
+
+TEST_CASE("[ThreadWorkPool] Empty work") {
+	Summer summer;
+	ThreadWorkPool pool;
+	pool.init();
+	pool.begin_work(0, &summer, &Summer::add_index, (void *)nullptr);
+	CHECK(pool.is_done_dispatching());
+	pool.end_work();
+	CHECK(summer.sum.load() == 0);
+}
+
+} // namespace TestThreadWorkPool
+
+#endif // TEST_THREAD_WORK_POOL_H
@@ -31,6 +31,7 @@
 #ifndef TEST_VARIANT_H
 #define TEST_VARIANT_H
 
+#include "core/os/os.h"
 #include "core/variant/variant.h"
 #include "core/variant/variant_parser.h"
 
@@ -699,6 +700,95 @@ TEST_CASE("[Variant] Assignment To Color from Bool,Int,Float,String,Vec2,Vec2i,V
 	vec3i_v = col_v;
 	CHECK(vec3i_v.get_type() == Variant::COLOR);
 }
+
+TEST_CASE("[Variant] Pooled types through copies and reassignment") {
+	const Transform xform(Basis(Vector3(0, 1, 0), 0.5), Vector3(1, 2, 3));
+	Variant a = xform;
+	Variant b = a;
+	a = Transform();
+	CHECK(Transform(b) == xform);
+	CHECK(Transform(a) == Transform());
+
+	// Switch between the types sharing each pool.
+	a = Basis(Vector3(1, 0, 0), 0.25);
+	CHECK(a.get_type() == Variant::BASIS);
+	a = AABB(Vector3(1, 2, 3), Vector3(4, 5, 6));
+	CHECK(AABB(a) == AABB(Vector3(1, 2, 3), Vector3(4, 5, 6)));
+	a = Transform2D(0.5, Vector2(1, 2));
+	CHECK(Transform2D(a) == Transform2D(0.5, Vector2(1, 2)));
+	a = 1;
+	CHECK(a.get_type() == Variant::INT);
+
+	Vector<Variant> many;
+	for (int i = 0; i < 10000; i++) {
+		many.push_back(Transform(Basis(), Vector3(i, 0, 0)));
+	}
+	for (int i = 0; i < many.size(); i += 2) {
+		many.write[i] = AABB(Vector3(i, 0, 0), Vector3(1, 1, 1));
+	}
+	for (int i = 0; i < many.size(); i++) {
+		if (i % 2) {
+			CHECK(Transform(many[i]).origin.x == i);
+		} else {
+			CHECK(AABB(many[i]).position.x == i);
+		}
+	}
+}
+
+// Microbenchmarks for the types Variant allocates from its pools. Skipped by default,
+// run them with `--test --test-case="*Benchmark*" --no-skip`.
+template <class T>
+static void _benchmark(const String &p_name, int p_iterations, T p_function) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_iterations; i++) {
+		p_function(i);
+	}
+	uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+	print_line(vformat("%s: %d ns/op, %.2f Mops/s", p_name, elapsed * 1000 / p_iterations, p_iterations / (double)elapsed));
+}
+
+TEST_CASE("[Variant][Benchmark] Copy, construct and operator throughput" * doctest::skip()) {
+	const int iterations = 1000000;
+	const Transform xform(Basis(Vector3(0, 1, 0), 0.5), Vector3(1, 2, 3));
+	const Variant values[] = { Transform2D(0.5, Vector2(1, 2)), AABB(Vector3(1, 2, 3), Vector3(4, 5, 6)), xform.basis, xform };
+
+	for (const Variant &value : values) {
+		const String type_name = Variant::get_type_name(value.get_type());
+
+		_benchmark(type_name + " copy", iterations, [&](int) {
+			Variant copy = value;
+		});
+
+		Variant target;
+		_benchmark(type_name + " assign", iterations, [&](int i) {
+			target = (i & 1) ? value : Variant(i);
+		});
+
+		_benchmark(type_name + " construct", iterations, [&](int) {
+			Variant copy;
+			Callable::CallError ce;
+			const Variant *args[1] = { &value };
+			Variant::construct(value.get_type(), copy, args, 1, ce);
+		});
+	}
+
+	Variant a = xform;
+	const Variant b = xform.affine_inverse();
+	_benchmark("Transform * Transform", iterations, [&](int) {
+		Variant result;
+		bool valid;
+		Variant::evaluate(Variant::OP_MULTIPLY, a, b, result, valid);
+		a = result;
+	});
+	CHECK(a.get_type() == Variant::TRANSFORM);
+
+	const Variant vector = Vector3(1, 2, 3);
+	_benchmark("Transform * Vector3", iterations, [&](int) {
+		Variant result;
+		bool valid;
+		Variant::evaluate(Variant::OP_MULTIPLY, b, vector, result, valid);
+	});
+}
 } // namespace TestVariant
 
 #endif // TEST_VARIANT_H